@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "zeus/container/flat_hash_map.hpp"
+#include "zeus/core/string_id.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Benchmarks for flat_hash_map.hpp against std::unordered_map.
+ *
+ * Both containers use the same Zeus::Hash so only the table layout differs.
+ * Every benchmark runs with 2^10, 2^16 and 2^20 elements to cover tables
+ * that fit in L1, in L2 and in neither.
+ */
+namespace {
+
+template <typename Key>
+using StdMap = std::unordered_map<Key, std::uint32_t, Zeus::Hash<Key>>;
+
+template <typename Key>
+using FlatMap = Zeus::FlatHashMap<Key, std::uint32_t>;
+
+/**
+ * Creates \p count distinct keys, offset by \p seed so that different seeds
+ * produce disjoint sets.
+ */
+template <typename Key>
+std::vector<Key> makeKeys(std::size_t count, std::uint64_t seed) {
+    std::vector<Key> keys;
+    keys.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t const value = (seed << 32U) | i;
+
+        if constexpr (std::is_same_v<Key, Zeus::StringId>) {
+            keys.push_back(Key{std::to_string(value)});
+        } else if constexpr (std::is_same_v<Key, Zeus::Math::Vector3D>) {
+            keys.push_back(Key{static_cast<float>(i % 128),
+                               static_cast<float>(i / 128 % 128),
+                               static_cast<float>(i / 16384 + seed * 1024)});
+        } else {
+            keys.push_back(Key{value * 0x9E3779B97F4A7C15ULL});
+        }
+    }
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{seed});
+
+    return keys;
+}
+
+template <typename Map>
+Map makeMap(std::vector<typename Map::key_type> const& keys) {
+    Map map;
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        map.emplace(keys[i], static_cast<std::uint32_t>(i));
+    }
+
+    return map;
+}
+
+template <typename Map>
+void BM_insert(benchmark::State& state) {
+    auto const keys = makeKeys<typename Map::key_type>(
+        static_cast<std::size_t>(state.range(0)), 1);
+
+    for (auto _ : state) {
+        Map map = makeMap<Map>(keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_find_hit(benchmark::State& state) {
+    auto keys = makeKeys<typename Map::key_type>(
+        static_cast<std::size_t>(state.range(0)), 1);
+    Map const map = makeMap<Map>(keys);
+
+    // Look up in a different order than the keys were inserted
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{2});
+
+    for (auto _ : state) {
+        std::uint32_t sum = 0;
+
+        for (auto const& key : keys) {
+            sum += map.find(key)->second;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_find_miss(benchmark::State& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    Map const map = makeMap<Map>(makeKeys<typename Map::key_type>(count, 1));
+    auto const missing = makeKeys<typename Map::key_type>(count, 2);
+
+    for (auto _ : state) {
+        std::size_t found = 0;
+
+        for (auto const& key : missing) {
+            found += map.count(key);
+        }
+
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_erase(benchmark::State& state) {
+    auto const keys = makeKeys<typename Map::key_type>(
+        static_cast<std::size_t>(state.range(0)), 1);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Map map = makeMap<Map>(keys);
+        state.ResumeTiming();
+
+        for (auto const& key : keys) {
+            map.erase(key);
+        }
+
+        benchmark::DoNotOptimize(map.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_iterate(benchmark::State& state) {
+    Map const map = makeMap<Map>(makeKeys<typename Map::key_type>(
+        static_cast<std::size_t>(state.range(0)), 1));
+
+    for (auto _ : state) {
+        std::uint32_t sum = 0;
+
+        for (auto const& entry : map) {
+            sum += entry.second;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define ZEUS_HASH_MAP_BENCHMARK(FUNCTION, KEY)                          \
+    BENCHMARK_TEMPLATE(FUNCTION, StdMap<KEY>)                           \
+        ->Arg(1 << 10)                                                  \
+        ->Arg(1 << 16)                                                  \
+        ->Arg(1 << 20);                                                 \
+    BENCHMARK_TEMPLATE(FUNCTION, FlatMap<KEY>)                          \
+        ->Arg(1 << 10)                                                  \
+        ->Arg(1 << 16)                                                  \
+        ->Arg(1 << 20)
+
+#define ZEUS_HASH_MAP_BENCHMARKS(KEY)              \
+    ZEUS_HASH_MAP_BENCHMARK(BM_insert, KEY);       \
+    ZEUS_HASH_MAP_BENCHMARK(BM_find_hit, KEY);     \
+    ZEUS_HASH_MAP_BENCHMARK(BM_find_miss, KEY);    \
+    ZEUS_HASH_MAP_BENCHMARK(BM_erase, KEY);        \
+    ZEUS_HASH_MAP_BENCHMARK(BM_iterate, KEY)
+
+using Vector3D = Zeus::Math::Vector3D;
+
+ZEUS_HASH_MAP_BENCHMARKS(std::uint64_t);
+ZEUS_HASH_MAP_BENCHMARKS(Zeus::StringId);
+ZEUS_HASH_MAP_BENCHMARKS(Vector3D);
+
+}  // namespace
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+#include "zeus/core/binary_log.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Latency benchmarks of the calling thread for binary_log.hpp.
+ *
+ * Messages are written to /dev/null so the numbers show the cost paid by the
+ * logging thread, including the writes of full buffers.
+ */
+namespace {
+
+void setUp() {
+    static bool const opened = Zeus::BinaryLog::open("/dev/null");
+
+    benchmark::DoNotOptimize(opened);
+}
+
+void BM_binary_log_no_arguments(benchmark::State& state) {
+    setUp();
+
+    for (auto _ : state) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Benchmark", "Frame started");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_binary_log_numbers(benchmark::State& state) {
+    setUp();
+
+    int entity = 0;
+
+    for (auto _ : state) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Benchmark",
+                        "Entity {} has {} hit points and {} armor", entity++,
+                        75.5F, 12U);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_binary_log_vector(benchmark::State& state) {
+    setUp();
+
+    Zeus::Math::Vector3D position{1.0F, 2.0F, 3.0F};
+
+    for (auto _ : state) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Benchmark",
+                        "Entity {} moved to {}", 1234, position);
+        position.x += 1.0F;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_binary_log_string(benchmark::State& state) {
+    setUp();
+
+    std::string_view const name = "player_spawn_point";
+
+    for (auto _ : state) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Benchmark",
+                        "Loaded {} from {}", name, "level.zeus");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_binary_log_no_arguments)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_binary_log_numbers)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_binary_log_vector)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_binary_log_string)->ThreadRange(1, 8)->UseRealTime();
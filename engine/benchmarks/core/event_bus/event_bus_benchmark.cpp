@@ -0,0 +1,188 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "zeus/core/event_bus.hpp"
+
+/**
+ * Benchmarks for event_bus.hpp.
+ *
+ * Every frame 10K collision events and 10K damage events are delivered to
+ * the subscribers of each type, once as a callback per event and once in
+ * batches. The argument is the number of subscribers per type; half of them
+ * sum a field and the other half count the events.
+ */
+namespace {
+
+constexpr std::size_t event_count = 10000;
+
+struct Collision {
+    int first;
+    int second;
+    float impulse;
+};
+
+struct Damage {
+    int target;
+    float amount;
+};
+
+/**
+ * State that the subscribers update.
+ */
+struct Totals {
+    float impulse = 0.0F;
+    float damage = 0.0F;
+    int contacts = 0;
+    int hits = 0;
+};
+
+std::vector<Collision> makeCollisions() {
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> entity{0, 1000};
+    std::vector<Collision> collisions;
+
+    for (std::size_t i = 0; i < event_count; ++i) {
+        collisions.push_back({entity(random), entity(random), 1.0F});
+    }
+
+    return collisions;
+}
+
+/**
+ * Dispatches every event on its own, the way a signal with listeners does.
+ */
+class Callbacks {
+   public:
+    template <typename Function>
+    void onCollision(Function&& function) {
+        collision_.emplace_back(std::forward<Function>(function));
+    }
+
+    template <typename Function>
+    void onDamage(Function&& function) {
+        damage_.emplace_back(std::forward<Function>(function));
+    }
+
+    void publish(Collision const& event) {
+        for (auto const& callback : collision_) {
+            callback(event);
+        }
+    }
+
+    void publish(Damage const& event) {
+        for (auto const& callback : damage_) {
+            callback(event);
+        }
+    }
+
+   private:
+    std::vector<std::function<void(Collision const&)>> collision_;
+    std::vector<std::function<void(Damage const&)>> damage_;
+};
+
+void BM_callbacks(benchmark::State& state) {
+    std::vector<Collision> const collisions = makeCollisions();
+    Totals totals;
+    Callbacks callbacks;
+
+    for (std::int64_t i = 0; i < state.range(0); i += 2) {
+        callbacks.onCollision([&totals](Collision const& event) {
+            totals.impulse += event.impulse;
+        });
+        callbacks.onCollision(
+            [&totals](Collision const&) { ++totals.contacts; });
+        callbacks.onDamage([&totals](Damage const& event) {
+            totals.damage += event.amount;
+        });
+        callbacks.onDamage([&totals](Damage const&) { ++totals.hits; });
+    }
+
+    for (auto _ : state) {
+        for (Collision const& collision : collisions) {
+            callbacks.publish(collision);
+            callbacks.publish(Damage{collision.second, 2.0F});
+        }
+
+        benchmark::DoNotOptimize(totals);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(2 * event_count));
+}
+
+void BM_event_bus(benchmark::State& state) {
+    std::vector<Collision> const collisions = makeCollisions();
+    Totals totals;
+    Zeus::EventBus bus;
+
+    for (std::int64_t i = 0; i < state.range(0); i += 2) {
+        bus.subscribe<Collision>(
+            [&totals](Collision const* events, std::size_t count) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    totals.impulse += events[j].impulse;
+                }
+            });
+        bus.subscribe<Collision>(
+            [&totals](Collision const*, std::size_t count) {
+                totals.contacts += static_cast<int>(count);
+            });
+        bus.subscribe<Damage>(
+            [&totals](Damage const* events, std::size_t count) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    totals.damage += events[j].amount;
+                }
+            });
+        bus.subscribe<Damage>([&totals](Damage const*, std::size_t count) {
+            totals.hits += static_cast<int>(count);
+        });
+    }
+
+    for (auto _ : state) {
+        for (Collision const& collision : collisions) {
+            bus.publish(collision);
+            bus.publish(Damage{collision.second, 2.0F});
+        }
+
+        bus.dispatch();
+
+        benchmark::DoNotOptimize(totals);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(2 * event_count));
+}
+
+void BM_event_bus_publish_array(benchmark::State& state) {
+    std::vector<Collision> const collisions = makeCollisions();
+    Totals totals;
+    Zeus::EventBus bus;
+
+    bus.subscribe<Collision>(
+        [&totals](Collision const* events, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                totals.impulse += events[i].impulse;
+            }
+        });
+
+    for (auto _ : state) {
+        bus.publish(collisions.data(), collisions.size());
+        bus.dispatch();
+
+        benchmark::DoNotOptimize(totals);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(event_count));
+}
+
+BENCHMARK(BM_callbacks)->Arg(2)->Arg(8);
+BENCHMARK(BM_event_bus)->Arg(2)->Arg(8);
+BENCHMARK(BM_event_bus_publish_array);
+
+}  // namespace
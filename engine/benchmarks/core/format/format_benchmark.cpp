@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "zeus/core/format.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Benchmarks for format.hpp against std::stringstream and std::snprintf.
+ *
+ * Every iteration formats a typical diagnostic line with an integer, a float
+ * and a vector.
+ */
+namespace {
+
+constexpr int entity = 4096;
+constexpr float milliseconds = 16.6667F;
+constexpr Zeus::Math::Vector3D position{1.5F, -20.25F, 300.0F};
+
+void BM_format_stringstream(benchmark::State& state) {
+    for (auto _ : state) {
+        std::stringstream stream;
+        stream << "Entity " << entity << " at (" << position.x << ", "
+               << position.y << ", " << position.z << ") took " << milliseconds
+               << " ms";
+
+        std::string const text = stream.str();
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+void BM_format_snprintf(benchmark::State& state) {
+    for (auto _ : state) {
+        std::array<char, 128> text{};
+        std::snprintf(text.data(), text.size(),
+                      "Entity %d at (%g, %g, %g) took %g ms", entity,
+                      static_cast<double>(position.x),
+                      static_cast<double>(position.y),
+                      static_cast<double>(position.z),
+                      static_cast<double>(milliseconds));
+
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+void BM_format_zeus(benchmark::State& state) {
+    for (auto _ : state) {
+        auto const text = ZEUS_FORMAT(128, "Entity {} at {} took {} ms",
+                                      entity, position, milliseconds);
+
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+BENCHMARK(BM_format_stringstream);
+BENCHMARK(BM_format_snprintf);
+BENCHMARK(BM_format_zeus);
+
+}  // namespace
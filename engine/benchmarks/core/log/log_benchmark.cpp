@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/log_limit.hpp"
+
+/**
+ * Latency benchmarks of the calling thread for log.hpp.
+ *
+ * Messages are written to /dev/null so the numbers show the cost paid by the
+ * logging thread and not the cost of the terminal.
+ */
+namespace {
+
+void setUp(Zeus::Log::OverflowPolicy policy) {
+    static int const null_device = open("/dev/null", O_WRONLY);
+
+    Zeus::Log::setOutput(null_device);
+    Zeus::Log::setOverflowPolicy(policy);
+}
+
+void BM_log_block(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setUp(Zeus::Log::OverflowPolicy::Block);
+    }
+
+    for (auto _ : state) {
+        Zeus::Log::info("Benchmark", "Entity 1234 moved to (1.0, 2.0, 3.0)");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_log_drop(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setUp(Zeus::Log::OverflowPolicy::Drop);
+    }
+
+    for (auto _ : state) {
+        Zeus::Log::info("Benchmark", "Entity 1234 moved to (1.0, 2.0, 3.0)");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] =
+            static_cast<double>(Zeus::Log::droppedCount());
+    }
+}
+
+void BM_log_crash_log(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setUp(Zeus::Log::OverflowPolicy::Drop);
+        Zeus::Log::openCrashLog("zeus_benchmark_crash.log",
+                                std::size_t{4} << 20);
+    }
+
+    for (auto _ : state) {
+        Zeus::Log::info("Benchmark", "Entity 1234 moved to (1.0, 2.0, 3.0)");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        Zeus::Log::closeCrashLog();
+        std::remove("zeus_benchmark_crash.log");
+    }
+}
+
+void BM_log_disabled(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        Zeus::Log::setLevel("Benchmark", Zeus::Log::Level::Error);
+    }
+
+    int entity = 0;
+
+    for (auto _ : state) {
+        ZEUS_DEBUG_LOG("Benchmark", "Entity " + std::to_string(entity) +
+                                        " moved to (1.0, 2.0, 3.0)");
+        benchmark::DoNotOptimize(++entity);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        Zeus::Log::resetLevel("Benchmark");
+    }
+}
+
+void BM_log_every_n(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setUp(Zeus::Log::OverflowPolicy::Drop);
+    }
+
+    for (auto _ : state) {
+        ZEUS_LOG_EVERY_N(Zeus::Log::Level::Warning, 1000, "Benchmark",
+                         "Entity 1234 left the world");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_log_every_t(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setUp(Zeus::Log::OverflowPolicy::Drop);
+    }
+
+    for (auto _ : state) {
+        ZEUS_LOG_EVERY_T(Zeus::Log::Level::Warning,
+                         std::chrono::milliseconds{10}, "Benchmark",
+                         "Entity 1234 left the world");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_log_crash_log)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_log_every_n)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_log_every_t)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_log_disabled)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_log_block)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_log_drop)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+
+#include "zeus/core/metrics.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Benchmarks for metrics.hpp.
+ *
+ * Every iteration records one value. The shared atomic counter is the
+ * alternative that per-thread slots avoid, compare them with more threads.
+ */
+namespace {
+
+std::atomic<Zeus::u64> shared_counter{0};
+
+void BM_shared_atomic_counter(benchmark::State& state) {
+    for (auto _ : state) {
+        shared_counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void BM_counter_add(benchmark::State& state) {
+    static Zeus::Metrics::Counter counter{"benchmark.counter"};
+
+    for (auto _ : state) {
+        counter.add();
+    }
+}
+
+void BM_histogram_record(benchmark::State& state) {
+    static Zeus::Metrics::Histogram histogram{"benchmark.histogram"};
+    Zeus::u64 value = 1;
+
+    for (auto _ : state) {
+        histogram.record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        value >>= 40U;
+    }
+}
+
+void BM_scoped_timer(benchmark::State& state) {
+    static Zeus::Metrics::Histogram histogram{"benchmark.scoped_timer"};
+
+    for (auto _ : state) {
+        Zeus::Metrics::ScopedTimer const timer{histogram};
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_shared_atomic_counter)->ThreadRange(1, 8);
+BENCHMARK(BM_counter_add)->ThreadRange(1, 8);
+BENCHMARK(BM_histogram_record)->ThreadRange(1, 8);
+BENCHMARK(BM_scoped_timer);
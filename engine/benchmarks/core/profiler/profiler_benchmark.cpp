@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "zeus/core/profiler.hpp"
+#include "zeus/core/tsc.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Benchmarks for profiler.hpp.
+ *
+ * Every iteration opens and closes one zone, so the reported time is the
+ * overhead of a zone.
+ */
+namespace {
+
+/**
+ * Zones recorded between resets, kept below the profiler's memory budget so
+ * that no event is dropped.
+ */
+constexpr std::int64_t zones_per_capture = 1 << 20;
+
+/**
+ * Empties the profiler every zones_per_capture iterations.
+ */
+void resetPeriodically(benchmark::State& state, std::int64_t& recorded) {
+    if (++recorded < zones_per_capture) {
+        return;
+    }
+
+    state.PauseTiming();
+    Zeus::Profiler::stop();
+    Zeus::Profiler::reset();
+    Zeus::Profiler::start();
+    state.ResumeTiming();
+
+    recorded = 0;
+}
+
+void BM_tsc_pair(benchmark::State& state) {
+    for (auto _ : state) {
+        Zeus::u64 const begin = Zeus::Tsc::now();
+        benchmark::DoNotOptimize(Zeus::Tsc::now() - begin);
+    }
+}
+
+void BM_zone_stopped(benchmark::State& state) {
+    for (auto _ : state) {
+        ZEUS_PROFILE_SCOPE("Zone");
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_zone_recording(benchmark::State& state) {
+    std::int64_t recorded = 0;
+    Zeus::Profiler::reset();
+    Zeus::Profiler::start();
+
+    for (auto _ : state) {
+        {
+            ZEUS_PROFILE_SCOPE("Zone");
+            benchmark::ClobberMemory();
+        }
+
+        resetPeriodically(state, recorded);
+    }
+
+    Zeus::Profiler::stop();
+    Zeus::Profiler::reset();
+}
+
+void BM_nested_zones_recording(benchmark::State& state) {
+    std::int64_t recorded = 0;
+    Zeus::Profiler::reset();
+    Zeus::Profiler::start();
+
+    for (auto _ : state) {
+        {
+            ZEUS_PROFILE_SCOPE("Outer");
+            ZEUS_PROFILE_SCOPE("Middle");
+            ZEUS_PROFILE_SCOPE("Inner");
+            benchmark::ClobberMemory();
+        }
+
+        recorded += 2;
+        resetPeriodically(state, recorded);
+    }
+
+    Zeus::Profiler::stop();
+    Zeus::Profiler::reset();
+
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+
+}  // namespace
+
+BENCHMARK(BM_tsc_pair);
+BENCHMARK(BM_zone_stopped);
+BENCHMARK(BM_zone_recording);
+BENCHMARK(BM_nested_zones_recording);
@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/blocking_queue.hpp"
+#include "zeus/core/mpmc_queue.hpp"
+#include "zeus/core/spsc_queue.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Benchmarks for spsc_queue.hpp, mpmc_queue.hpp and blocking_queue.hpp.
+ *
+ * Throughput benchmarks move a fixed number of messages through a queue per
+ * iteration and report messages per second. Latency benchmarks bounce one
+ * message between two threads and report the time of a round trip. Every
+ * queue is compared against a std::deque guarded by a std::mutex.
+ *
+ * @note Threads that find the queue full or empty yield, so the results stay
+ * meaningful on machines with fewer cores than threads.
+ */
+namespace {
+
+using Zeus::u64;
+
+constexpr std::size_t queue_capacity = 1024;
+constexpr u64 message_count = u64{1} << 18U;
+
+/**
+ * A bounded queue guarded by a mutex, with the same interface as the
+ * lock-free queues.
+ */
+class MutexQueue {
+   public:
+    using value_type = u64;
+    using size_type = std::size_t;
+
+    explicit MutexQueue(size_type capacity) : capacity_{capacity} {}
+
+    bool tryPush(u64 value) {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        if (queue_.size() == capacity_) {
+            return false;
+        }
+
+        queue_.push_back(value);
+
+        return true;
+    }
+
+    std::optional<u64> tryPop() {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+
+        u64 const value = queue_.front();
+        queue_.pop_front();
+
+        return value;
+    }
+
+   private:
+    size_type const capacity_;
+    std::mutex mutex_;
+    std::deque<u64> queue_;
+};
+
+template <typename Queue>
+void push(Queue& queue, u64 value) {
+    while (!queue.tryPush(value)) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename Queue>
+u64 pop(Queue& queue) {
+    for (;;) {
+        if (auto value = queue.tryPop()) {
+            return *value;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+template <typename Queue>
+void BM_spsc_throughput(benchmark::State& state) {
+    Queue queue{queue_capacity};
+
+    for (auto _ : state) {
+        std::thread producer{[&queue] {
+            for (u64 value = 0; value < message_count; ++value) {
+                push(queue, value);
+            }
+        }};
+
+        u64 sum = 0;
+
+        for (u64 index = 0; index < message_count; ++index) {
+            sum += pop(queue);
+        }
+
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(message_count));
+}
+
+void BM_spsc_throughput_batched(benchmark::State& state) {
+    Zeus::SpscQueue<u64> queue{queue_capacity};
+    u64 batch[64];
+
+    for (auto _ : state) {
+        std::thread producer{[&queue] {
+            for (u64 value = 0; value < message_count; ++value) {
+                push(queue, value);
+            }
+        }};
+
+        u64 sum = 0;
+
+        for (u64 received = 0; received < message_count;) {
+            std::size_t const count = queue.popBatch(batch, 64);
+
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+
+            for (std::size_t index = 0; index < count; ++index) {
+                sum += batch[index];
+            }
+
+            received += count;
+        }
+
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(message_count));
+}
+
+template <typename Queue>
+void BM_mpmc_throughput(benchmark::State& state) {
+    auto const thread_count = static_cast<u64>(state.range(0));
+    u64 const per_thread = message_count / thread_count;
+    Queue queue{queue_capacity};
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+
+        for (u64 thread = 0; thread < thread_count; ++thread) {
+            threads.emplace_back([&queue, per_thread] {
+                for (u64 value = 0; value < per_thread; ++value) {
+                    push(queue, value);
+                }
+            });
+
+            threads.emplace_back([&queue, per_thread] {
+                u64 sum = 0;
+
+                for (u64 index = 0; index < per_thread; ++index) {
+                    sum += pop(queue);
+                }
+
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(per_thread) *
+        static_cast<std::int64_t>(thread_count));
+}
+
+template <typename Queue>
+void BM_round_trip(benchmark::State& state) {
+    Queue requests{queue_capacity};
+    Queue replies{queue_capacity};
+
+    std::thread partner{[&requests, &replies] {
+        for (u64 value; (value = pop(requests)) != 0;) {
+            push(replies, value);
+        }
+    }};
+
+    for (auto _ : state) {
+        push(requests, 1);
+        benchmark::DoNotOptimize(pop(replies));
+    }
+
+    push(requests, 0);
+    partner.join();
+}
+
+template <typename Queue>
+void BM_blocking_round_trip(benchmark::State& state) {
+    Zeus::BlockingQueue<Queue> requests{queue_capacity};
+    Zeus::BlockingQueue<Queue> replies{queue_capacity};
+
+    std::thread partner{[&requests, &replies] {
+        for (u64 value; (value = requests.pop()) != 0;) {
+            replies.push(value);
+        }
+    }};
+
+    for (auto _ : state) {
+        requests.push(1);
+        benchmark::DoNotOptimize(replies.pop());
+    }
+
+    requests.push(0);
+    partner.join();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_spsc_throughput, Zeus::SpscQueue<u64>)->UseRealTime();
+BENCHMARK(BM_spsc_throughput_batched)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_spsc_throughput, Zeus::MpmcQueue<u64>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_spsc_throughput, MutexQueue)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_mpmc_throughput, Zeus::MpmcQueue<u64>)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_mpmc_throughput, MutexQueue)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_round_trip, Zeus::SpscQueue<u64>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, Zeus::MpmcQueue<u64>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, MutexQueue)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_blocking_round_trip, Zeus::SpscQueue<u64>)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_blocking_round_trip, Zeus::MpmcQueue<u64>)
+    ->UseRealTime();
@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/types.hpp"
+#include "zeus/ecs/query.hpp"
+#include "zeus/ecs/transform.hpp"
+#include "zeus/ecs/world.hpp"
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Benchmarks for query.hpp.
+ *
+ * Every benchmark integrates the positions of 1M moving objects, once as
+ * heap allocated game objects behind pointers and once as entities of an
+ * archetype ECS.
+ */
+namespace {
+
+using Zeus::Ecs::Entity;
+using Zeus::Ecs::Query;
+using Zeus::Ecs::Transform;
+using Zeus::Ecs::World;
+using Zeus::Math::Vector3D;
+
+constexpr std::size_t entity_count = std::size_t{1} << 20U;
+constexpr float delta_time = 1.0F / 60.0F;
+
+struct Velocity {
+    Vector3D value;
+};
+
+struct Health {
+    float value;
+};
+
+/**
+ * A game object the way it looks without an ECS, with a virtual update and
+ * state that the update does not touch.
+ */
+class GameObject {
+   public:
+    GameObject(std::string name, Vector3D velocity)
+        : name_{std::move(name)}, velocity_{velocity} {}
+
+    GameObject(GameObject const&) = delete;
+    GameObject(GameObject&&) = delete;
+    GameObject& operator=(GameObject const&) = delete;
+    GameObject& operator=(GameObject&&) = delete;
+
+    virtual ~GameObject() = default;
+
+    virtual void update(float dt) noexcept {
+        transform_.position += velocity_ * dt;
+    }
+
+   private:
+    std::string name_;
+    Transform transform_;
+    Vector3D velocity_;
+    Health health_{100.0F};
+};
+
+Vector3D velocityOf(std::size_t i) noexcept {
+    auto const value = static_cast<float>(i % 1024);
+
+    return {value, value * 0.5F, 1.0F};
+}
+
+void BM_game_objects(benchmark::State& state) {
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(entity_count);
+
+    for (std::size_t i = 0; i < entity_count; ++i) {
+        objects.push_back(std::make_unique<GameObject>(
+            "Object " + std::to_string(i), velocityOf(i)));
+    }
+
+    // Objects are created and destroyed over a game's lifetime, which
+    // scatters them across the heap
+    std::shuffle(objects.begin(), objects.end(), std::mt19937{42});
+
+    for (auto _ : state) {
+        for (auto const& object : objects) {
+            object->update(delta_time);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(entity_count));
+}
+
+/**
+ * Creates the entities, a quarter of them with an extra component so the
+ * query spans two archetypes.
+ */
+void populate(World& world) {
+    for (std::size_t i = 0; i < entity_count; ++i) {
+        Entity const entity =
+            world.create(Transform{}, Velocity{velocityOf(i)});
+
+        if (i % 4 == 0) {
+            world.add<Health>(entity, 100.0F);
+        }
+    }
+}
+
+void BM_ecs_each(benchmark::State& state) {
+    World world;
+    populate(world);
+
+    Query<Transform, Velocity const> query{world};
+
+    for (auto _ : state) {
+        query.each([](Transform& transform, Velocity const& velocity) {
+            transform.position += velocity.value * delta_time;
+        });
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(entity_count));
+}
+
+void BM_ecs_each_chunk(benchmark::State& state) {
+    World world;
+    populate(world);
+
+    Query<Transform, Velocity const> query{world};
+
+    for (auto _ : state) {
+        query.eachChunk([](Zeus::u32 count, Entity const*,
+                           Transform* transforms, Velocity const* velocities) {
+            for (Zeus::u32 i = 0; i < count; ++i) {
+                transforms[i].position += velocities[i].value * delta_time;
+            }
+        });
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(entity_count));
+}
+
+void BM_ecs_parallel_each(benchmark::State& state) {
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0))};
+    World world;
+    populate(world);
+
+    Query<Transform, Velocity const> query{world};
+
+    for (auto _ : state) {
+        query.parallelEach(system, [](Transform& transform,
+                                      Velocity const& velocity) {
+            transform.position += velocity.value * delta_time;
+        });
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(entity_count));
+}
+
+int coreCount() {
+    return static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+BENCHMARK(BM_game_objects)->UseRealTime();
+BENCHMARK(BM_ecs_each)->UseRealTime();
+BENCHMARK(BM_ecs_each_chunk)->UseRealTime();
+BENCHMARK(BM_ecs_parallel_each)->DenseRange(1, coreCount())->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,227 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ucontext.h>
+
+#include "zeus/job/fiber_system.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * Benchmarks for fiber.hpp and fiber_system.hpp.
+ *
+ * The context switch benchmarks bounce between two contexts, one iteration
+ * is two switches. The frame benchmarks run a frame of tasks that each wait
+ * on child jobs halfway through, with 1 to N workers.
+ */
+namespace {
+
+constexpr std::size_t stack_size = 64 * 1024;
+
+struct FiberPingPong {
+    Zeus::Job::Fiber main;
+    Zeus::Job::Fiber* other = nullptr;
+};
+
+[[noreturn]] void bounceFiber(void* argument) noexcept {
+    auto& state = *static_cast<FiberPingPong*>(argument);
+
+    for (;;) {
+        state.other->switchTo(state.main);
+    }
+}
+
+void BM_context_switch_fiber(benchmark::State& state) {
+    std::vector<std::byte> stack(stack_size);
+    FiberPingPong ping_pong;
+    Zeus::Job::Fiber other{stack.data(), stack.size(), &bounceFiber,
+                           &ping_pong};
+    ping_pong.other = &other;
+
+    for (auto _ : state) {
+        ping_pong.main.switchTo(other);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+ucontext_t ucontext_main;
+ucontext_t ucontext_other;
+
+void bounceUcontext() {
+    for (;;) {
+        swapcontext(&ucontext_other, &ucontext_main);
+    }
+}
+
+void BM_context_switch_ucontext(benchmark::State& state) {
+    std::vector<std::byte> stack(stack_size);
+
+    getcontext(&ucontext_other);
+    ucontext_other.uc_stack.ss_sp = stack.data();
+    ucontext_other.uc_stack.ss_size = stack.size();
+    makecontext(&ucontext_other, &bounceUcontext, 0);
+
+    for (auto _ : state) {
+        swapcontext(&ucontext_main, &ucontext_other);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void BM_context_switch_thread(benchmark::State& state) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool ping = false;
+    bool stop = false;
+
+    std::thread other{[&] {
+        std::unique_lock lock{mutex};
+
+        while (!stop) {
+            condition.wait(lock, [&] { return ping || stop; });
+            ping = false;
+            condition.notify_one();
+        }
+    }};
+
+    for (auto _ : state) {
+        std::unique_lock lock{mutex};
+        ping = true;
+        condition.notify_one();
+        condition.wait(lock, [&] { return !ping; });
+    }
+
+    {
+        std::lock_guard const lock{mutex};
+        stop = true;
+    }
+
+    condition.notify_one();
+    other.join();
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/**
+ * The shape of a frame: every task does some work, waits on its children
+ * and then does some more work.
+ */
+constexpr int task_count = 32;
+constexpr int children_per_task = 8;
+constexpr int work_per_job = 2000;
+
+float work(int seed) noexcept {
+    float sum = 0.0F;
+
+    for (int i = 0; i < work_per_job; ++i) {
+        sum += std::sqrt(static_cast<float>(seed + i));
+    }
+
+    return sum;
+}
+
+/**
+ * How a task waits for its children.
+ */
+template <typename Scheduler>
+struct Suspend {
+    static void wait(Scheduler& system, Zeus::Job::Counter const& counter) {
+        system.wait(counter);
+    }
+};
+
+/**
+ * Blocks the worker thread without running other jobs.
+ */
+struct Block {
+    static void wait(Zeus::Job::System&, Zeus::Job::Counter const& counter) {
+        while (!counter.done()) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <typename Scheduler, typename Wait>
+void runFrame(Scheduler& system, std::vector<float>& results) {
+    Zeus::Job::Counter frame;
+
+    for (int task = 0; task < task_count; ++task) {
+        system.run(frame, [&system, &results, task] {
+            float* const out = &results[static_cast<std::size_t>(task) *
+                                        (children_per_task + 2)];
+            Zeus::Job::Counter children;
+
+            out[0] = work(task);
+
+            for (int child = 0; child < children_per_task; ++child) {
+                system.run(children, [out, child] {
+                    out[child + 1] = work(child);
+                });
+            }
+
+            Wait::wait(system, children);
+            out[children_per_task + 1] = work(task + 1);
+        });
+    }
+
+    system.wait(frame);
+}
+
+template <typename Scheduler, typename Wait>
+void benchmarkFrames(benchmark::State& state, Scheduler& system) {
+    std::vector<float> results(task_count * (children_per_task + 2));
+
+    for (auto _ : state) {
+        runFrame<Scheduler, Wait>(system, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_frame_fiber_suspend(benchmark::State& state) {
+    Zeus::Job::FiberSystem system{static_cast<std::size_t>(state.range(0))};
+
+    benchmarkFrames<Zeus::Job::FiberSystem, Suspend<Zeus::Job::FiberSystem>>(
+        state, system);
+}
+
+void BM_frame_help_while_waiting(benchmark::State& state) {
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0))};
+
+    benchmarkFrames<Zeus::Job::System, Suspend<Zeus::Job::System>>(state,
+                                                                   system);
+}
+
+void BM_frame_thread_blocking(benchmark::State& state) {
+    // Blocked tasks hold on to their thread, so every task needs one on top
+    // of the workers running the children
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0)) +
+                                 task_count,
+                             Zeus::Job::Affinity::Unpinned};
+
+    benchmarkFrames<Zeus::Job::System, Block>(state, system);
+}
+
+int coreCount() {
+    return static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+BENCHMARK(BM_context_switch_fiber);
+BENCHMARK(BM_context_switch_ucontext);
+BENCHMARK(BM_context_switch_thread)->UseRealTime();
+BENCHMARK(BM_frame_fiber_suspend)->DenseRange(1, coreCount())->UseRealTime();
+BENCHMARK(BM_frame_help_while_waiting)
+    ->DenseRange(1, coreCount())
+    ->UseRealTime();
+BENCHMARK(BM_frame_thread_blocking)->DenseRange(1, coreCount())->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Benchmarks for job_system.hpp.
+ *
+ * Every benchmark runs with 1 to N workers, where N is the number of cores,
+ * to show how the job system scales.
+ */
+namespace {
+
+using Zeus::Math::Vector3D;
+
+constexpr std::size_t vector_count = std::size_t{1} << 20U;
+
+std::vector<Vector3D> makeVectors() {
+    std::vector<Vector3D> vectors;
+    vectors.reserve(vector_count);
+
+    for (std::size_t i = 0; i < vector_count; ++i) {
+        auto const value = static_cast<float>(i);
+        vectors.emplace_back(value + 1.0F, value * 0.5F, 3.0F);
+    }
+
+    return vectors;
+}
+
+void normalizeAll(Vector3D* first, Vector3D* last) noexcept {
+    for (; first != last; ++first) {
+        *first = Zeus::Math::normalize(*first);
+    }
+}
+
+void BM_normalize_serial(benchmark::State& state) {
+    auto vectors = makeVectors();
+
+    for (auto _ : state) {
+        normalizeAll(vectors.data(), vectors.data() + vectors.size());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(vector_count));
+}
+
+void BM_normalize_parallel_for(benchmark::State& state) {
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0))};
+    auto vectors = makeVectors();
+
+    for (auto _ : state) {
+        Zeus::Job::parallelFor(system, vectors, 0, normalizeAll);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(vector_count));
+}
+
+void BM_empty_jobs(benchmark::State& state) {
+    constexpr int job_count = 4096;
+
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0))};
+
+    for (auto _ : state) {
+        Zeus::Job::Counter counter;
+
+        for (int i = 0; i < job_count; ++i) {
+            system.run(counter, [] {});
+        }
+
+        system.wait(counter);
+    }
+
+    state.SetItemsProcessed(state.iterations() * job_count);
+}
+
+int coreCount() {
+    return static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+BENCHMARK(BM_normalize_serial)->UseRealTime();
+BENCHMARK(BM_normalize_parallel_for)->DenseRange(1, coreCount())->UseRealTime();
+BENCHMARK(BM_empty_jobs)->DenseRange(1, coreCount())->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Debug build throughput benchmarks for vector_3d.hpp element access.
+ *
+ * Compares the tiered assertion in operator[] against the previous inlined
+ * assertion, which built its failure message in the caller, and against
+ * unchecked access.
+ */
+namespace {
+
+using Zeus::Math::Vector3D;
+
+constexpr std::size_t vector_count = 4096;
+
+/**
+ * The assertion as it was before the failure path was outlined.
+ */
+ZEUS_FORCE_INLINE inline void legacyAssert(
+    bool condition, std::string_view assertion_text,
+    std::optional<std::string_view> message, std::string_view file_name,
+    std::int64_t line_number) {
+    if (!condition) {
+        std::stringstream stream;
+
+        stream << "\n=========== ZEUS ASSERTION FAILED ===========\n";
+        stream << "Assertion (" << assertion_text << ") failed!\n";
+        stream << "File: " << file_name << '\n';
+        stream << "Line: " << line_number << '\n';
+
+        if (message.has_value()) {
+            stream << "Message: " << message.value() << "\n";
+        }
+
+        stream << "==============================================\n";
+
+        std::fputs(stream.str().c_str(), stderr);
+
+        std::terminate();
+    }
+}
+
+struct LegacyIndex {
+    static float get(Vector3D const& vector, Zeus::ssize position) {
+        legacyAssert(position <= 2 && position >= 0,
+                     "position <= 2 && position >= 0", std::nullopt,
+                     __FILE__, __LINE__);
+
+        return (&vector.x)[position];
+    }
+};
+
+struct TieredIndex {
+    static float get(Vector3D const& vector, Zeus::ssize position) {
+        return vector[position];
+    }
+};
+
+struct UncheckedIndex {
+    static float get(Vector3D const& vector, Zeus::ssize position) {
+        return (&vector.x)[position];
+    }
+};
+
+template <typename Index>
+void BM_vector_index(benchmark::State& state) {
+    std::vector<Vector3D> vectors(vector_count, Vector3D{1.0F, 2.0F, 3.0F});
+    std::vector<Zeus::ssize> positions(vector_count);
+    std::vector<float> elements(vector_count);
+
+    for (std::size_t i = 0; i < vector_count; ++i) {
+        positions[i] = static_cast<Zeus::ssize>(i % 3);
+    }
+
+    for (auto _ : state) {
+        // Independent loads so the checks are not hidden behind a dependency
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            elements[i] = Index::get(vectors[i], positions[i]);
+        }
+
+        benchmark::DoNotOptimize(elements.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * vector_count);
+}
+
+BENCHMARK_TEMPLATE(BM_vector_index, LegacyIndex);
+BENCHMARK_TEMPLATE(BM_vector_index, TieredIndex);
+BENCHMARK_TEMPLATE(BM_vector_index, UncheckedIndex);
+
+}  // namespace
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdlib>
+#include <new>
+
+#include "zeus/memory/pool_allocator.hpp"
+
+/**
+ * Multithreaded benchmarks for pool_allocator.hpp against glibc malloc.
+ */
+namespace {
+
+constexpr std::size_t batch = 64;
+
+struct Particle {
+    float position[3];
+    float velocity[3];
+    float color[4];
+    int lifetime;
+};
+
+Zeus::Memory::PoolAllocator<Particle>& pool() {
+    static Zeus::Memory::PoolAllocator<Particle> pool;
+
+    return pool;
+}
+
+/**
+ * Allocates a burst of objects and frees them again, like a particle emitter.
+ */
+void BM_pool_burst(benchmark::State& state) {
+    std::array<Particle*, batch> particles{};
+
+    for (auto _ : state) {
+        for (auto& particle : particles) {
+            particle = pool().allocate();
+            benchmark::DoNotOptimize(particle);
+        }
+
+        for (auto* particle : particles) {
+            pool().deallocate(particle);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+void BM_malloc_burst(benchmark::State& state) {
+    std::array<Particle*, batch> particles{};
+
+    for (auto _ : state) {
+        for (auto& particle : particles) {
+            particle = static_cast<Particle*>(std::malloc(sizeof(Particle)));
+            benchmark::DoNotOptimize(particle);
+        }
+
+        for (auto* particle : particles) {
+            std::free(particle);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+/**
+ * Keeps a working set alive and replaces its members in a scattered order,
+ * like entities spawning and dying.
+ */
+void BM_pool_churn(benchmark::State& state) {
+    std::array<Particle*, batch> particles{};
+
+    for (auto& particle : particles) {
+        particle = pool().allocate();
+    }
+
+    std::size_t slot = 0;
+
+    for (auto _ : state) {
+        slot = (slot + 17) % batch;
+
+        pool().deallocate(particles[slot]);
+        particles[slot] = pool().allocate();
+        benchmark::DoNotOptimize(particles[slot]);
+    }
+
+    for (auto* particle : particles) {
+        pool().deallocate(particle);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_malloc_churn(benchmark::State& state) {
+    std::array<Particle*, batch> particles{};
+
+    for (auto& particle : particles) {
+        particle = static_cast<Particle*>(std::malloc(sizeof(Particle)));
+    }
+
+    std::size_t slot = 0;
+
+    for (auto _ : state) {
+        slot = (slot + 17) % batch;
+
+        std::free(particles[slot]);
+        particles[slot] = static_cast<Particle*>(std::malloc(sizeof(Particle)));
+        benchmark::DoNotOptimize(particles[slot]);
+    }
+
+    for (auto* particle : particles) {
+        std::free(particle);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_pool_burst)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_malloc_burst)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_pool_churn)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_malloc_churn)->ThreadRange(1, 8)->UseRealTime();
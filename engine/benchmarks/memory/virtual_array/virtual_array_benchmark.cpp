@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "zeus/math/vector_3d.hpp"
+#include "zeus/memory/virtual_array.hpp"
+
+/**
+ * Growth spike benchmarks for virtual_array.hpp against std::vector.
+ *
+ * Every iteration grows a container of large components from empty and
+ * records the slowest single push_back, which is where std::vector copies its
+ * whole contents.
+ */
+namespace {
+
+struct Component {
+    std::array<Zeus::Math::Vector3D, 16> points;
+};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Grows the given container and returns the slowest single push_back.
+ */
+template <typename Container>
+Clock::duration growAndMeasure(Container& container, std::size_t count) {
+    Clock::duration worst{};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const start = Clock::now();
+        container.push_back(Component{});
+        worst = std::max(worst, Clock::now() - start);
+    }
+
+    benchmark::DoNotOptimize(container.data());
+
+    return worst;
+}
+
+void reportWorst(benchmark::State& state, Clock::duration worst) {
+    state.counters["worst_push_us"] =
+        std::chrono::duration<double, std::micro>(worst).count();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_vector_growth(benchmark::State& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    Clock::duration worst{};
+
+    for (auto _ : state) {
+        std::vector<Component> components;
+        worst = std::max(worst, growAndMeasure(components, count));
+    }
+
+    reportWorst(state, worst);
+}
+
+void BM_virtual_array_growth(benchmark::State& state) {
+    auto const count = static_cast<std::size_t>(state.range(0));
+    Clock::duration worst{};
+
+    for (auto _ : state) {
+        Zeus::Memory::VirtualArray<Component> components{count};
+        worst = std::max(worst, growAndMeasure(components, count));
+    }
+
+    reportWorst(state, worst);
+}
+
+}  // namespace
+
+BENCHMARK(BM_vector_growth)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 18);
+BENCHMARK(BM_virtual_array_growth)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 18);
@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/vector_3d.hpp"
+#include "zeus/scene/hierarchy.hpp"
+
+/**
+ * Benchmarks for hierarchy.hpp.
+ *
+ * The scene has 256K nodes in trees of 256 nodes, where every node has four
+ * children. A frame either moves every node, which is what recomputing every
+ * transform costs, or a share of the nodes picked at random.
+ */
+namespace {
+
+using Zeus::Math::Vector3D;
+using Zeus::Scene::Hierarchy;
+using Zeus::Scene::Node;
+
+constexpr std::size_t node_count = std::size_t{1} << 18U;
+constexpr std::size_t tree_size = 256;
+constexpr std::size_t children_per_node = 4;
+
+/**
+ * Creates the trees and returns their nodes in creation order.
+ */
+std::vector<Node> populate(Hierarchy& hierarchy) {
+    std::mt19937 random{42};
+    std::uniform_real_distribution<float> value{-1.0F, 1.0F};
+    std::vector<Node> nodes;
+    nodes.reserve(node_count);
+
+    for (std::size_t index = 0; index < node_count; ++index) {
+        std::size_t const offset = index % tree_size;
+        Node const parent =
+            offset == 0 ? Node{}
+                        : nodes[index - offset +
+                                (offset - 1) / children_per_node];
+
+        Node const node = hierarchy.create(parent);
+        hierarchy.setPosition(
+            node, Vector3D{value(random), value(random), value(random)});
+        hierarchy.setRotation(
+            node, Vector3D{value(random), value(random), value(random)});
+        nodes.push_back(node);
+    }
+
+    hierarchy.update();
+
+    return nodes;
+}
+
+/**
+ * Picks the nodes that move every frame.
+ */
+std::vector<Node> pickMoving(std::vector<Node> const& nodes,
+                             std::size_t percent) {
+    std::vector<Node> moving{nodes};
+    std::shuffle(moving.begin(), moving.end(), std::mt19937{7});
+    moving.resize(nodes.size() * percent / 100);
+
+    return moving;
+}
+
+void move(Hierarchy& hierarchy, std::vector<Node> const& moving,
+          float frame) {
+    for (Node const node : moving) {
+        hierarchy.setRotation(node, Vector3D{0.0F, frame, 0.0F});
+    }
+}
+
+void BM_update_all(benchmark::State& state) {
+    Hierarchy hierarchy;
+    std::vector<Node> const nodes = populate(hierarchy);
+
+    float frame = 0.0F;
+
+    for (auto _ : state) {
+        move(hierarchy, nodes, frame += 0.01F);
+        hierarchy.update();
+
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["updated"] =
+        static_cast<double>(hierarchy.updatedCount());
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(node_count));
+}
+
+void BM_update_dirty(benchmark::State& state) {
+    Hierarchy hierarchy;
+    std::vector<Node> const moving = pickMoving(
+        populate(hierarchy), static_cast<std::size_t>(state.range(0)));
+
+    float frame = 0.0F;
+
+    for (auto _ : state) {
+        move(hierarchy, moving, frame += 0.01F);
+        hierarchy.update();
+
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["updated"] =
+        static_cast<double>(hierarchy.updatedCount());
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(node_count));
+}
+
+void BM_update_dirty_parallel(benchmark::State& state) {
+    Zeus::Job::System system{static_cast<std::size_t>(state.range(0))};
+    Hierarchy hierarchy;
+    std::vector<Node> const moving = pickMoving(populate(hierarchy), 5);
+
+    float frame = 0.0F;
+
+    for (auto _ : state) {
+        move(hierarchy, moving, frame += 0.01F);
+        hierarchy.update(system);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["updated"] =
+        static_cast<double>(hierarchy.updatedCount());
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(node_count));
+}
+
+void BM_update_static(benchmark::State& state) {
+    Hierarchy hierarchy;
+    populate(hierarchy);
+
+    for (auto _ : state) {
+        hierarchy.update();
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(node_count));
+}
+
+int coreCount() {
+    return static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+BENCHMARK(BM_update_all)->UseRealTime();
+BENCHMARK(BM_update_dirty)->Arg(1)->Arg(5)->Arg(20)->UseRealTime();
+BENCHMARK(BM_update_dirty_parallel)
+    ->DenseRange(1, coreCount())
+    ->UseRealTime();
+BENCHMARK(BM_update_static)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,34 @@
+# AddZeusBenchmark.cmake
+
+# A simple wrapper to add benchmarks to Zeus
+macro(ADD_ZEUS_BENCHMARK arg_benchmark_target)
+    get_target_property(ZEUS_INCLUDES Zeus INCLUDE_DIRECTORIES)
+    get_target_property(ZEUS_CXX_STANDARD Zeus CXX_STANDARD)
+
+    target_include_directories(${arg_benchmark_target}
+        PUBLIC
+            "${ZEUS_INCLUDES}"
+    )
+
+    target_link_libraries(${arg_benchmark_target}
+        benchmark::benchmark_main
+    )
+
+    # Stack traces and futexes call into windows.h, which is kept in source
+    # files on Windows
+    if(WIN32)
+        target_sources(${arg_benchmark_target}
+            PRIVATE
+                "${PROJECT_SOURCE_DIR}/engine/src/core/futex.cpp"
+                "${PROJECT_SOURCE_DIR}/engine/src/core/stack_trace.cpp"
+        )
+    endif()
+
+    set_target_properties(${arg_benchmark_target}
+        PROPERTIES
+            CXX_STANDARD ${ZEUS_CXX_STANDARD}
+            CXX_STANDARD_REQUIRED YES
+            CXX_EXTENSIONS NO
+            RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/benchmarks"
+    )
+endmacro()
@@ -10,6 +10,16 @@ macro(ADD_ZEUS_EXAMPLE arg_test_target)
             "${ZEUS_INCLUDES}"
     )
 
+    # Stack traces and futexes call into windows.h, which is kept in source
+    # files on Windows
+    if(WIN32)
+        target_sources(${arg_test_target}
+            PRIVATE
+                "${PROJECT_SOURCE_DIR}/engine/src/core/futex.cpp"
+                "${PROJECT_SOURCE_DIR}/engine/src/core/stack_trace.cpp"
+        )
+    endif()
+
     set_target_properties(${arg_test_target}
         PROPERTIES
             CXX_STANDARD ${ZEUS_CXX_STANDARD}
@@ -0,0 +1,30 @@
+# AddZeusTool.cmake
+
+# A simple wrapper to add command line tools to Zeus
+macro(ADD_ZEUS_TOOL arg_tool_target)
+    get_target_property(ZEUS_INCLUDES Zeus INCLUDE_DIRECTORIES)
+    get_target_property(ZEUS_CXX_STANDARD Zeus CXX_STANDARD)
+
+    target_include_directories(${arg_tool_target}
+        PUBLIC
+            "${ZEUS_INCLUDES}"
+    )
+
+    # Stack traces and futexes call into windows.h, which is kept in source
+    # files on Windows
+    if(WIN32)
+        target_sources(${arg_tool_target}
+            PRIVATE
+                "${PROJECT_SOURCE_DIR}/engine/src/core/futex.cpp"
+                "${PROJECT_SOURCE_DIR}/engine/src/core/stack_trace.cpp"
+        )
+    endif()
+
+    set_target_properties(${arg_tool_target}
+        PROPERTIES
+            CXX_STANDARD ${ZEUS_CXX_STANDARD}
+            CXX_STANDARD_REQUIRED YES
+            CXX_EXTENSIONS NO
+            RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/tools"
+    )
+endmacro()
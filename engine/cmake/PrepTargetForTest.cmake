@@ -13,6 +13,16 @@ macro(PREP_TARGET_FOR_TEST arg_test_target)
         gtest_main
     )
 
+    # Stack traces and futexes call into windows.h, which is kept in source
+    # files on Windows
+    if(WIN32)
+        target_sources(${arg_test_target}
+            PRIVATE
+                "${PROJECT_SOURCE_DIR}/engine/src/core/futex.cpp"
+                "${PROJECT_SOURCE_DIR}/engine/src/core/stack_trace.cpp"
+        )
+    endif()
+
     set_target_properties(${arg_test_target}
         PROPERTIES
             CXX_STANDARD ${ZEUS_CXX_STANDARD}
@@ -20,3 +30,25 @@ macro(PREP_TARGET_FOR_TEST arg_test_target)
             CXX_EXTENSIONS NO
     )
 endmacro()
+
+# Builds a test with ThreadSanitizer when ZEUS_ENABLE_THREAD_SANITIZER is on.
+# Meant for tests that stress lock-free code from several threads.
+#
+# Note: Not used for fiber tests since switching stacks by hand confuses TSAN
+macro(ENABLE_THREAD_SANITIZER_FOR_TEST arg_test_target)
+    if(ZEUS_ENABLE_THREAD_SANITIZER AND NOT MSVC)
+        target_compile_options(${arg_test_target}
+            PRIVATE
+                -fsanitize=thread
+                -g
+                # TSAN ignores standalone fences, which only matter for
+                # wakeups and not for data races
+                $<$<CXX_COMPILER_ID:GNU>:-Wno-tsan>
+        )
+
+        target_link_options(${arg_test_target}
+            PRIVATE
+                -fsanitize=thread
+        )
+    endif()
+endmacro()
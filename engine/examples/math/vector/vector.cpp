@@ -1,4 +1,5 @@
-#include <iostream>
+#include <cstdio>
+#include <cstdlib>
 
 #include "zeus/math/vector_2d.hpp"
 
@@ -6,7 +7,9 @@ int main() {
     // A super simple example
     constexpr Zeus::Math::Vector2D const vector = {1, 2};
 
-    std::cout << "x: " << vector.x << " y: " << vector.y << std::endl;
+    auto const text =
+        ZEUS_FORMAT(64, "x: {} y: {} vector: {}\n", vector.x, vector.y, vector);
+    std::fputs(text.c_str(), stdout);
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "zeus/core/perf_counters.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+namespace {
+
+using Zeus::Math::Vector3D;
+using Zeus::Perf::Event;
+
+// 16 Mi vectors, 192 MiB, far larger than the last level cache
+constexpr std::size_t vector_count = std::size_t{1} << 24U;
+
+void report(char const* kernel, Zeus::Perf::Counts const& counts) {
+    std::printf("%-22s %8.2f %8.2f %12.4f %13.4f\n", kernel,
+                counts.nanosecondsPerElement(), counts.ipc(),
+                counts.perElement(Event::CacheMisses),
+                counts.perElement(Event::BranchMisses));
+}
+
+/**
+ * Sums the magnitudes of the vectors in the given order.
+ */
+float sumMagnitudes(std::vector<Vector3D> const& vectors,
+                    std::vector<std::size_t> const& order) {
+    float sum = 0.0F;
+
+    for (std::size_t const index : order) {
+        sum += Zeus::Math::magnitude(vectors[index]);
+    }
+
+    return sum;
+}
+
+/**
+ * Counts the vectors that point up, branching on every vector.
+ */
+std::size_t countUp(std::vector<Vector3D> const& vectors) {
+    std::size_t count = 0;
+
+    for (auto const& vector : vectors) {
+        if (vector.y > 0.0F) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 random{42};
+    std::uniform_real_distribution<float> distribution{-1.0F, 1.0F};
+
+    std::vector<Vector3D> vectors;
+    vectors.reserve(vector_count);
+
+    for (std::size_t i = 0; i < vector_count; ++i) {
+        vectors.emplace_back(distribution(random), distribution(random),
+                             distribution(random));
+    }
+
+    std::vector<std::size_t> order(vector_count);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+
+    Zeus::Perf::CounterGroup group;
+    Zeus::Perf::Counts counts;
+
+    if (!group.isAvailable()) {
+        std::printf("Hardware counters are unavailable: %s\n"
+                    "Only times are reported.\n\n",
+                    group.error());
+    }
+
+    std::printf("%-22s %8s %8s %12s %13s\n", "kernel", "ns/elem", "IPC",
+                "LLC miss/elem", "br miss/elem");
+
+    // The same work in a cache friendly and a cache hostile order
+    float sequential = 0.0F;
+    {
+        Zeus::Perf::Scope const scope{group, counts, vector_count};
+        sequential = sumMagnitudes(vectors, order);
+    }
+    report("magnitude sequential", counts);
+
+    std::shuffle(order.begin(), order.end(), random);
+
+    float shuffled = 0.0F;
+    {
+        Zeus::Perf::Scope const scope{group, counts, vector_count};
+        shuffled = sumMagnitudes(vectors, order);
+    }
+    report("magnitude shuffled", counts);
+
+    // The same branch on random and on sorted data
+    std::size_t unsorted_up = 0;
+    {
+        Zeus::Perf::Scope const scope{group, counts, vector_count};
+        unsorted_up = countUp(vectors);
+    }
+    report("count up unsorted", counts);
+
+    std::sort(vectors.begin(), vectors.end(),
+              [](Vector3D const& lhs, Vector3D const& rhs) {
+                  return lhs.y < rhs.y;
+              });
+
+    std::size_t sorted_up = 0;
+    {
+        Zeus::Perf::Scope const scope{group, counts, vector_count};
+        sorted_up = countUp(vectors);
+    }
+    report("count up sorted", counts);
+
+    std::printf("\nchecksum: %f %f %zu %zu\n", static_cast<double>(sequential),
+                static_cast<double>(shuffled), unsorted_up, sorted_up);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "zeus/core/perf_counters.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+namespace {
+
+using Zeus::Math::Vector3D;
+using Zeus::Perf::Event;
+
+constexpr std::size_t vector_count = std::size_t{1} << 20U;
+
+/**
+ * Prints one row of the report.
+ */
+void report(char const* kernel, Zeus::Perf::Counts const& counts) {
+    std::printf("%-12s %8.2f %8.2f %10.2f %12.4f %13.4f\n", kernel,
+                counts.nanosecondsPerElement(), counts.ipc(),
+                counts.perElement(Event::Instructions),
+                counts.perElement(Event::CacheMisses),
+                counts.perElement(Event::BranchMisses));
+}
+
+/**
+ * Runs the kernel once to warm up the caches, then counts a second run.
+ */
+template <typename Kernel>
+void measure(char const* name, Zeus::Perf::CounterGroup& group,
+             Kernel&& kernel) {
+    kernel();
+
+    Zeus::Perf::Counts counts;
+
+    {
+        Zeus::Perf::Scope const scope{group, counts, vector_count};
+        kernel();
+    }
+
+    report(name, counts);
+}
+
+}  // namespace
+
+int main() {
+    std::vector<Vector3D> lhs;
+    std::vector<Vector3D> rhs;
+    std::vector<Vector3D> out(vector_count);
+    std::vector<float> scalars(vector_count);
+
+    lhs.reserve(vector_count);
+    rhs.reserve(vector_count);
+
+    for (std::size_t i = 0; i < vector_count; ++i) {
+        auto const value = static_cast<float>(i % 1000);
+        lhs.emplace_back(value + 1.0F, value * 0.5F, 3.0F);
+        rhs.emplace_back(2.0F, value, value * 0.25F);
+    }
+
+    Zeus::Perf::CounterGroup group;
+
+    if (!group.isAvailable()) {
+        std::printf("Hardware counters are unavailable: %s\n"
+                    "Only times are reported.\n\n",
+                    group.error());
+    }
+
+    std::printf("%-12s %8s %8s %10s %12s %13s\n", "kernel", "ns/elem", "IPC",
+                "instr/elem", "LLC miss/elem", "br miss/elem");
+
+    measure("add", group, [&] {
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            out[i] = lhs[i] + rhs[i];
+        }
+    });
+
+    measure("scale", group, [&] {
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            out[i] = lhs[i] * 0.5F;
+        }
+    });
+
+    measure("dot", group, [&] {
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            scalars[i] = Zeus::Math::dot(lhs[i], rhs[i]);
+        }
+    });
+
+    measure("magnitude", group, [&] {
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            scalars[i] = Zeus::Math::magnitude(lhs[i]);
+        }
+    });
+
+    measure("normalize", group, [&] {
+        for (std::size_t i = 0; i < vector_count; ++i) {
+            out[i] = Zeus::Math::normalize(lhs[i]);
+        }
+    });
+
+    // Keep the results alive
+    std::printf("\nchecksum: %f %f\n", static_cast<double>(out[42].x),
+                static_cast<double>(scalars[42]));
+
+    return EXIT_SUCCESS;
+}
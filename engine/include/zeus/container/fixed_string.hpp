@@ -0,0 +1,281 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+/**
+ * @file fixed_string.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A string with a fixed capacity that stores its characters inline.
+ *
+ * The string is always null terminated. Appending past the capacity
+ * truncates instead of failing, which suits diagnostic messages and names
+ * where losing the tail is better than allocating.
+ *
+ * @tparam N The maximum number of characters, not counting the terminator
+ */
+template <std::size_t N>
+class FixedString {
+   public:
+    using value_type = char;
+    using size_type = std::size_t;
+    using iterator = char*;
+    using const_iterator = char const*;
+
+    /**
+     * Constructs an empty string.
+     */
+    constexpr FixedString() noexcept = default;
+
+    /**
+     * Constructs a string holding the given characters, truncated to the
+     * capacity.
+     *
+     * @param text The characters to copy
+     */
+    constexpr FixedString(std::string_view text) noexcept {
+        append(text);
+    }
+
+    /**
+     * Constructs a string from the given string literal.
+     *
+     * @param text The string literal to copy
+     */
+    template <std::size_t M>
+    constexpr FixedString(char const (&text)[M]) noexcept
+        : FixedString{std::string_view{text, M - 1}} {}
+
+    /**
+     * Appends the given characters, truncated to the capacity.
+     *
+     * @param text The characters to append
+     *
+     * @return A reference to this string
+     */
+    constexpr FixedString& append(std::string_view text) noexcept {
+        for (char const c : text) {
+            if (size_ == N) {
+                break;
+            }
+
+            data_[size_++] = c;
+        }
+
+        data_[size_] = '\0';
+
+        return *this;
+    }
+
+    /**
+     * Appends the given character if there is room.
+     *
+     * @param c The character to append
+     */
+    constexpr void push_back(char c) noexcept {
+        if (size_ < N) {
+            data_[size_++] = c;
+            data_[size_] = '\0';
+        }
+    }
+
+    constexpr FixedString& operator+=(std::string_view text) noexcept {
+        return append(text);
+    }
+
+    constexpr FixedString& operator+=(char c) noexcept {
+        push_back(c);
+
+        return *this;
+    }
+
+    /**
+     * Shortens the string to the given number of characters.
+     *
+     * @param count The new number of characters
+     */
+    constexpr void resize(size_type count) noexcept {
+        size_ = (count < size_) ? count : size_;
+        data_[size_] = '\0';
+    }
+
+    constexpr void clear() noexcept {
+        resize(0);
+    }
+
+    /**
+     * Lets the given operation write directly into the string, like
+     * std::string::resize_and_overwrite from C++23.
+     *
+     * @param count     The number of characters the operation may write, at
+     *                  most the capacity
+     * @param operation Called with the characters and the count, returns the
+     *                  new size of the string
+     */
+    template <typename Operation>
+    constexpr void resize_and_overwrite(size_type count,
+                                        Operation operation) noexcept {
+        count = (count < N) ? count : N;
+
+        auto const size =
+            static_cast<size_type>(operation(data_.data(), count));
+
+        size_ = (size < count) ? size : count;
+        data_[size_] = '\0';
+    }
+
+    [[nodiscard]] constexpr char& operator[](size_type position) noexcept {
+        return data_[position];
+    }
+
+    [[nodiscard]] constexpr char operator[](
+        size_type position) const noexcept {
+        return data_[position];
+    }
+
+    [[nodiscard]] constexpr size_type size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+        return size_ == N;
+    }
+
+    [[nodiscard]] constexpr char const* c_str() const noexcept {
+        return data_.data();
+    }
+
+    [[nodiscard]] constexpr char* data() noexcept {
+        return data_.data();
+    }
+
+    [[nodiscard]] constexpr char const* data() const noexcept {
+        return data_.data();
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return std::string_view{data_.data(), size_};
+    }
+
+    constexpr operator std::string_view() const noexcept {
+        return view();
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return data_.data();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return data_.data();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return data_.data() + size_;
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return data_.data() + size_;
+    }
+
+   private:
+    std::array<char, N + 1> data_{};
+    size_type size_ = 0;
+};
+
+/**
+ * Deduces the capacity of a string from a string literal.
+ */
+template <std::size_t M>
+FixedString(char const (&)[M]) -> FixedString<M - 1>;
+
+/**
+ * Checks if the two given strings are equal.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are equal, otherwise false
+ */
+template <std::size_t N, std::size_t M>
+constexpr bool operator==(FixedString<N> const& lhs,
+                          FixedString<M> const& rhs) noexcept {
+    return lhs.view() == rhs.view();
+}
+
+template <std::size_t N>
+constexpr bool operator==(FixedString<N> const& lhs,
+                          std::string_view rhs) noexcept {
+    return lhs.view() == rhs;
+}
+
+template <std::size_t N>
+constexpr bool operator==(std::string_view lhs,
+                          FixedString<N> const& rhs) noexcept {
+    return lhs == rhs.view();
+}
+
+template <std::size_t N, std::size_t M>
+constexpr bool operator!=(FixedString<N> const& lhs,
+                          FixedString<M> const& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <std::size_t N>
+constexpr bool operator!=(FixedString<N> const& lhs,
+                          std::string_view rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <std::size_t N>
+constexpr bool operator!=(std::string_view lhs,
+                          FixedString<N> const& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace Zeus
+
+/**
+ * Sends the given string to the given output stream.
+ *
+ * @param stream The output stream to send the string to
+ * @param string The string to output to the given output stream
+ *
+ * @return A reference to the given output stream
+ */
+template <std::size_t N>
+std::ostream& operator<<(std::ostream& stream,
+                         Zeus::FixedString<N> const& string) {
+    return stream << string.view();
+}
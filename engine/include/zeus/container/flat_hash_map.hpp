@@ -0,0 +1,207 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "zeus/container/flat_hash_table.hpp"
+#include "zeus/core/hash.hpp"
+
+/**
+ * @file flat_hash_map.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+struct PairFirst {
+    template <typename Pair>
+    constexpr auto const& operator()(Pair const& pair) const noexcept {
+        return pair.first;
+    }
+};
+
+}  // namespace Detail
+
+/**
+ * A hash map that stores its elements inline in a single open addressing
+ * table, a drop in replacement for std::unordered_map on hot paths.
+ *
+ * Lookups probe 16 slots at once with SSE2 and keep the elements contiguous,
+ * so they avoid the pointer chasing of node based maps. When both the hash
+ * function and the key comparison are transparent, lookups accept any type
+ * comparable with the key, like std::string_view for std::string keys.
+ *
+ * @note Unlike std::unordered_map, inserting invalidates iterators,
+ * references and pointers to elements, and the key of an element must not be
+ * modified through an iterator.
+ *
+ * @tparam Key          The key type
+ * @tparam T            The mapped type
+ * @tparam Hash         The hash function for keys
+ * @tparam KeyEqual     The equality comparison for keys
+ * @tparam Allocator    The allocator for the elements
+ */
+template <typename Key, typename T, typename Hash = Zeus::Hash<Key>,
+          typename KeyEqual = std::equal_to<>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class FlatHashMap
+    : public Detail::FlatHashTable<std::pair<Key, T>, Detail::PairFirst, Hash,
+                                   KeyEqual, Allocator> {
+    using Base = Detail::FlatHashTable<std::pair<Key, T>, Detail::PairFirst,
+                                       Hash, KeyEqual, Allocator>;
+
+   public:
+    using mapped_type = T;
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+    using typename Base::key_type;
+    using typename Base::size_type;
+    using typename Base::value_type;
+
+    template <typename K>
+    using key_arg = typename Base::template key_arg<K>;
+
+    using Base::Base;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> values,
+                size_type bucket_count = 0, Hash const& hash = Hash{},
+                KeyEqual const& equal = KeyEqual{},
+                Allocator const& allocator = Allocator{})
+        : Base{std::max(bucket_count, values.size()), hash, equal,
+               allocator} {
+        Base::insert(values.begin(), values.end());
+    }
+
+    /**
+     * Inserts a value constructed from the given arguments if the key is not
+     * in the map, otherwise does nothing.
+     *
+     * @param key   The key
+     * @param args  The arguments to construct the mapped value from
+     *
+     * @return The element with the key and whether it was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type const& key,
+                                          Args&&... args) {
+        return Base::emplaceWithKey(
+            key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        // The key is only moved from once its slot was found
+        return Base::emplaceWithKey(
+            key, std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Inserts the given value, or assigns it if the key is in the map.
+     *
+     * @param key   The key
+     * @param value The mapped value
+     *
+     * @return The element with the key and whether it was inserted
+     */
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type const& key,
+                                               M&& value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+
+        return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value) {
+        auto result = try_emplace(std::move(key), std::forward<M>(value));
+
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the mapped value of the given key, inserting a value
+     * initialized one if the key is not in the map.
+     *
+     * @param key The key
+     *
+     * @return A reference to the mapped value
+     */
+    mapped_type& operator[](key_type const& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * Returns the mapped value of the given key.
+     *
+     * @throws std::out_of_range if the key is not in the map
+     *
+     * @param key The key
+     *
+     * @return A reference to the mapped value
+     */
+    template <typename K = key_type>
+    [[nodiscard]] mapped_type& at(key_arg<K> const& key) {
+        auto const position = Base::find(key);
+
+        if (position == Base::end()) {
+            throw std::out_of_range("Key not found in FlatHashMap.");
+        }
+
+        return position->second;
+    }
+
+    template <typename K = key_type>
+    [[nodiscard]] mapped_type const& at(key_arg<K> const& key) const {
+        return const_cast<FlatHashMap*>(this)->at(key);
+    }
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void swap(FlatHashMap<Key, T, Hash, KeyEqual, Allocator>& lhs,
+          FlatHashMap<Key, T, Hash, KeyEqual, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace Zeus
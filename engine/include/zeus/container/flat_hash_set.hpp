@@ -0,0 +1,92 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+
+#include "zeus/container/flat_hash_table.hpp"
+#include "zeus/core/hash.hpp"
+
+/**
+ * @file flat_hash_set.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+struct Identity {
+    template <typename T>
+    constexpr T const& operator()(T const& value) const noexcept {
+        return value;
+    }
+};
+
+}  // namespace Detail
+
+/**
+ * A hash set that stores its elements inline in a single open addressing
+ * table, a drop in replacement for std::unordered_set on hot paths.
+ *
+ * @note Inserting invalidates iterators, references and pointers to
+ * elements. See FlatHashMap for the details of the layout.
+ *
+ * @tparam Key          The element type
+ * @tparam Hash         The hash function for elements
+ * @tparam KeyEqual     The equality comparison for elements
+ * @tparam Allocator    The allocator for the elements
+ */
+template <typename Key, typename Hash = Zeus::Hash<Key>,
+          typename KeyEqual = std::equal_to<>,
+          typename Allocator = std::allocator<Key>>
+class FlatHashSet : public Detail::FlatHashTable<Key, Detail::Identity, Hash,
+                                                 KeyEqual, Allocator> {
+    using Base =
+        Detail::FlatHashTable<Key, Detail::Identity, Hash, KeyEqual, Allocator>;
+
+   public:
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+    using typename Base::size_type;
+    using typename Base::value_type;
+
+    using Base::Base;
+
+    FlatHashSet() = default;
+
+    FlatHashSet(std::initializer_list<value_type> values,
+                size_type bucket_count = 0, Hash const& hash = Hash{},
+                KeyEqual const& equal = KeyEqual{},
+                Allocator const& allocator = Allocator{})
+        : Base{std::max(bucket_count, values.size()), hash, equal,
+               allocator} {
+        Base::insert(values.begin(), values.end());
+    }
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void swap(FlatHashSet<Key, Hash, KeyEqual, Allocator>& lhs,
+          FlatHashSet<Key, Hash, KeyEqual, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace Zeus
@@ -0,0 +1,1011 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZEUS_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define ZEUS_FLAT_HASH_SSE2 0
+#endif
+
+#include "zeus/core/bit.hpp"
+#include "zeus/core/hash.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file flat_hash_table.hpp
+ *
+ * The open addressing table behind FlatHashMap and FlatHashSet.
+ *
+ * The layout follows the SwissTable design: every slot has a control byte
+ * that is either empty, deleted or holds the low 7 bits of the hash of its
+ * key. Lookups compare 16 control bytes at once against those bits with
+ * SSE2 and only compare keys of slots that matched, so a miss usually costs
+ * a single group load without touching the slots.
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+using ctrl_t = signed char;
+
+// Control byte values, full slots store the 7-bit H2 hash which is positive
+inline constexpr ctrl_t ctrl_empty = -128;
+inline constexpr ctrl_t ctrl_deleted = -2;
+inline constexpr ctrl_t ctrl_sentinel = -1;
+
+inline constexpr std::size_t group_width = 16;
+
+// Bytes after the sentinel that mirror the start of the control bytes
+inline constexpr std::size_t cloned_ctrl_bytes = group_width - 1;
+
+/**
+ * The control bytes of tables that have not allocated yet.
+ */
+alignas(16) inline constexpr ctrl_t empty_group[group_width] = {
+    ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty};
+
+/**
+ * A set of slot positions within a group, one bit per control byte.
+ */
+class GroupMask {
+   public:
+    explicit GroupMask(u32 mask) noexcept : mask_{mask} {}
+
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return mask_ != 0;
+    }
+
+    [[nodiscard]] int lowest() const noexcept {
+        return countTrailingZeros(mask_);
+    }
+
+    [[nodiscard]] int leadingZeros() const noexcept {
+        return countLeadingZeros(mask_) -
+               static_cast<int>(32 - group_width);
+    }
+
+    GroupMask& operator++() noexcept {
+        mask_ &= mask_ - 1;
+
+        return *this;
+    }
+
+   private:
+    u32 mask_;
+};
+
+/**
+ * Sixteen control bytes loaded at once.
+ */
+class Group {
+   public:
+#if ZEUS_FLAT_HASH_SSE2
+    explicit Group(ctrl_t const* position) noexcept
+        : ctrl_{_mm_loadu_si128(reinterpret_cast<__m128i const*>(position))} {
+    }
+
+    [[nodiscard]] GroupMask match(ctrl_t h2) const noexcept {
+        return toMask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+    }
+
+    [[nodiscard]] GroupMask matchEmpty() const noexcept {
+        return match(ctrl_empty);
+    }
+
+    [[nodiscard]] GroupMask matchEmptyOrDeleted() const noexcept {
+        return toMask(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_));
+    }
+
+   private:
+    static GroupMask toMask(__m128i bytes) noexcept {
+        return GroupMask{static_cast<u32>(_mm_movemask_epi8(bytes))};
+    }
+
+    __m128i ctrl_;
+#else
+    explicit Group(ctrl_t const* position) noexcept {
+        std::memcpy(ctrl_, position, group_width);
+    }
+
+    [[nodiscard]] GroupMask match(ctrl_t h2) const noexcept {
+        u32 mask = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= static_cast<u32>(ctrl_[i] == h2) << i;
+        }
+
+        return GroupMask{mask};
+    }
+
+    [[nodiscard]] GroupMask matchEmpty() const noexcept {
+        return match(ctrl_empty);
+    }
+
+    [[nodiscard]] GroupMask matchEmptyOrDeleted() const noexcept {
+        u32 mask = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i) {
+            mask |= static_cast<u32>(ctrl_[i] < ctrl_sentinel) << i;
+        }
+
+        return GroupMask{mask};
+    }
+
+   private:
+    ctrl_t ctrl_[group_width];
+#endif
+};
+
+/**
+ * Walks the groups of a table in triangular steps, which visits every group
+ * once for capacities of the form 2^n - 1.
+ */
+class ProbeSequence {
+   public:
+    ProbeSequence(std::size_t hash, std::size_t mask) noexcept
+        : mask_{mask}, offset_{hash & mask} {}
+
+    [[nodiscard]] std::size_t offset() const noexcept {
+        return offset_;
+    }
+
+    [[nodiscard]] std::size_t offset(int i) const noexcept {
+        return (offset_ + static_cast<std::size_t>(i)) & mask_;
+    }
+
+    void next() noexcept {
+        index_ += group_width;
+        offset_ = (offset_ + index_) & mask_;
+    }
+
+   private:
+    std::size_t mask_;
+    std::size_t offset_;
+    std::size_t index_ = 0;
+};
+
+[[nodiscard]] inline std::size_t h1(std::size_t hash) noexcept {
+    return hash >> 7;
+}
+
+[[nodiscard]] inline ctrl_t h2(std::size_t hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+}
+
+[[nodiscard]] inline bool isFull(ctrl_t ctrl) noexcept {
+    return ctrl >= 0;
+}
+
+/**
+ * Returns the number of elements a table of the given capacity holds before
+ * it grows, a maximum load factor of 7/8.
+ */
+[[nodiscard]] inline std::size_t capacityToGrowth(
+    std::size_t capacity) noexcept {
+    return capacity - capacity / 8;
+}
+
+/**
+ * Returns the smallest valid capacity that holds the given number of
+ * elements without growing.
+ */
+[[nodiscard]] inline std::size_t growthToCapacity(std::size_t growth) noexcept {
+    std::size_t const minimum = growth + (growth > 0 ? (growth - 1) / 7 : 0);
+    std::size_t capacity = group_width - 1;
+
+    while (capacity < minimum) {
+        capacity = capacity * 2 + 1;
+    }
+
+    return capacity;
+}
+
+/**
+ * Checks if the hash function and the key comparison both accept other key
+ * types.
+ */
+template <typename Hash, typename KeyEqual, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Hash, typename KeyEqual>
+struct IsTransparent<Hash, KeyEqual,
+                     std::void_t<typename Hash::is_transparent,
+                                 typename KeyEqual::is_transparent>>
+    : std::true_type {};
+
+/**
+ * Picks the type of lookup keys, the alias keeps K deducible.
+ */
+template <bool Transparent>
+struct KeyArg {
+    template <typename K, typename Key>
+    using type = K;
+};
+
+template <>
+struct KeyArg<false> {
+    template <typename K, typename Key>
+    using type = Key;
+};
+
+/**
+ * The open addressing hash table shared by FlatHashMap and FlatHashSet.
+ *
+ * @note Inserting may move elements and invalidates iterators, pointers and
+ * references. Erasing only invalidates the erased element.
+ *
+ * @tparam Value        The stored type
+ * @tparam KeyOf        Returns the key of a stored value
+ * @tparam Hash         The hash function for keys
+ * @tparam KeyEqual     The equality comparison for keys
+ * @tparam Allocator    The allocator for the values
+ */
+template <typename Value, typename KeyOf, typename Hash, typename KeyEqual,
+          typename Allocator>
+class FlatHashTable {
+    using key_of_result =
+        decltype(KeyOf{}(std::declval<Value const&>()));
+
+   public:
+    using key_type = std::remove_cv_t<std::remove_reference_t<key_of_result>>;
+    using value_type = Value;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+
+   private:
+    using allocator_traits = std::allocator_traits<Allocator>;
+    using slot_allocator =
+        typename allocator_traits::template rebind_alloc<value_type>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+    using ctrl_allocator =
+        typename allocator_traits::template rebind_alloc<ctrl_t>;
+    using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+    static constexpr bool is_transparent =
+        IsTransparent<Hash, KeyEqual>::value;
+
+   public:
+    // Lookups accept any key type when the hash and comparison allow it
+    template <typename K>
+    using key_arg =
+        typename KeyArg<is_transparent>::template type<K, key_type>;
+
+    template <bool Const>
+    class Iterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer =
+            std::conditional_t<Const, value_type const*, value_type*>;
+        using reference =
+            std::conditional_t<Const, value_type const&, value_type&>;
+
+        Iterator() noexcept = default;
+
+        // Allows converting iterators to const iterators
+        template <bool OtherConst,
+                  typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(Iterator<OtherConst> const& other) noexcept
+            : ctrl_{other.ctrl_}, slot_{other.slot_} {}
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return *slot_;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return slot_;
+        }
+
+        Iterator& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skipEmpty();
+
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator copy = *this;
+            ++(*this);
+
+            return copy;
+        }
+
+        [[nodiscard]] friend bool operator==(Iterator const& lhs,
+                                             Iterator const& rhs) noexcept {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+        [[nodiscard]] friend bool operator!=(Iterator const& lhs,
+                                             Iterator const& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+       private:
+        friend class FlatHashTable;
+
+        template <bool>
+        friend class Iterator;
+
+        Iterator(ctrl_t const* ctrl, pointer slot) noexcept
+            : ctrl_{ctrl}, slot_{slot} {}
+
+        void skipEmpty() noexcept {
+            // The sentinel stops the walk at the end
+            while (*ctrl_ < ctrl_sentinel) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        ctrl_t const* ctrl_ = nullptr;
+        pointer slot_ = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() = default;
+
+    explicit FlatHashTable(size_type bucket_count, Hash const& hash = Hash{},
+                           KeyEqual const& equal = KeyEqual{},
+                           Allocator const& allocator = Allocator{})
+        : hash_{hash}, equal_{equal}, allocator_{allocator} {
+        if (bucket_count > 0) {
+            resize(growthToCapacity(bucket_count));
+        }
+    }
+
+    explicit FlatHashTable(Allocator const& allocator)
+        : allocator_{allocator} {}
+
+    FlatHashTable(FlatHashTable const& other, Allocator const& allocator)
+        : FlatHashTable{other.size(), other.hash_, other.equal_, allocator} {
+        for (auto const& value : other) {
+            insertUnique(value);
+        }
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+        : FlatHashTable{other.size(), other.hash_, other.equal_,
+                        allocator_traits::select_on_container_copy_construction(
+                            other.allocator_)} {
+        for (auto const& value : other) {
+            insertUnique(value);
+        }
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : hash_{std::move(other.hash_)},
+          equal_{std::move(other.equal_)},
+          allocator_{std::move(other.allocator_)} {
+        steal(other);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other) {
+        if (this != &other) {
+            FlatHashTable copy{other};
+
+            destroyAndDeallocate();
+
+            if constexpr (allocator_traits::
+                              propagate_on_container_copy_assignment::value) {
+                allocator_ = other.allocator_;
+            }
+
+            hash_ = copy.hash_;
+            equal_ = copy.equal_;
+
+            for (auto& value : copy) {
+                insertUnique(std::move(value));
+            }
+        }
+
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept(
+        allocator_traits::propagate_on_container_move_assignment::value ||
+        allocator_traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroyAndDeallocate();
+        hash_ = std::move(other.hash_);
+        equal_ = std::move(other.equal_);
+
+        if constexpr (allocator_traits::
+                          propagate_on_container_move_assignment::value) {
+            allocator_ = std::move(other.allocator_);
+            steal(other);
+        } else {
+            if (allocator_ == other.allocator_) {
+                steal(other);
+            } else {
+                // Memory of the other allocator can not be adopted
+                reserve(other.size());
+
+                for (auto& value : other) {
+                    insertUnique(std::move(value));
+                }
+
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    ~FlatHashTable() {
+        destroyAndDeallocate();
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        iterator it{ctrl_, slots_};
+        it.skipEmpty();
+
+        return it;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_cast<FlatHashTable*>(this)->begin();
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return iterator{ctrl_ + capacity_, slots_ + capacity_};
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_cast<FlatHashTable*>(this)->end();
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] size_type max_size() const noexcept {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    /**
+     * Returns the number of slots, including the ones kept free to bound the
+     * load factor.
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] size_type bucket_count() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] float load_factor() const noexcept {
+        return (capacity_ == 0) ? 0.0F
+                                : static_cast<float>(size_) /
+                                      static_cast<float>(capacity_);
+    }
+
+    /**
+     * Returns the load factor at which the table grows, which is fixed.
+     */
+    [[nodiscard]] static constexpr float max_load_factor() noexcept {
+        return 7.0F / 8.0F;
+    }
+
+    /**
+     * Destroys every element but keeps the allocated slots.
+     */
+    void clear() noexcept {
+        if (capacity_ == 0) {
+            return;
+        }
+
+        destroyElements();
+        resetCtrl();
+        size_ = 0;
+        growth_left_ = capacityToGrowth(capacity_);
+    }
+
+    /**
+     * Makes room for at least the given number of elements without growing.
+     *
+     * @param count The number of elements
+     */
+    void reserve(size_type count) {
+        if (count > size_ + growth_left_) {
+            resize(growthToCapacity(count));
+        }
+    }
+
+    /**
+     * Rebuilds the table with room for at least the given number of elements,
+     * dropping the markers of erased elements.
+     *
+     * @note A count of zero shrinks the table to fit its elements.
+     *
+     * @param count The number of elements
+     */
+    void rehash(size_type count) {
+        count = std::max(count, size_);
+
+        if (count == 0) {
+            destroyAndDeallocate();
+
+            return;
+        }
+
+        resize(growthToCapacity(count));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        // The key is needed first, build the value on the stack
+        value_type value(std::forward<Args>(args)...);
+        auto const [index, inserted] = findOrPrepareInsert(KeyOf{}(value));
+
+        if (inserted) {
+            construct(index, std::move(value));
+        }
+
+        return {iteratorAt(index), inserted};
+    }
+
+    /**
+     * Inserts a value built from the given arguments if no element has the
+     * given key.
+     *
+     * @param key   The key of the value
+     * @param args  The arguments to construct the value from if it is
+     *              inserted
+     *
+     * @return The element with the key and whether it was inserted
+     */
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> emplaceWithKey(K const& key, Args&&... args) {
+        auto const [index, inserted] = findOrPrepareInsert(key);
+
+        if (inserted) {
+            construct(index, std::forward<Args>(args)...);
+        }
+
+        return {iteratorAt(index), inserted};
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value) {
+        return emplaceWithKey(KeyOf{}(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplaceWithKey(KeyOf{}(value), std::move(value));
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> values) {
+        reserve(size_ + values.size());
+        insert(values.begin(), values.end());
+    }
+
+    /**
+     * Erases the element at the given position.
+     *
+     * @note Returns nothing, the position of the next element is not needed
+     * by most callers and finding it costs a scan.
+     *
+     * @param position The element to erase
+     */
+    void erase(const_iterator position) noexcept {
+        eraseAt(static_cast<size_type>(position.ctrl_ - ctrl_));
+    }
+
+    void erase(iterator position) noexcept {
+        erase(const_iterator{position});
+    }
+
+    template <typename K = key_type>
+    size_type erase(key_arg<K> const& key) {
+        auto const position = find(key);
+
+        if (position == end()) {
+            return 0;
+        }
+
+        erase(position);
+
+        return 1;
+    }
+
+    template <typename K = key_type>
+    [[nodiscard]] iterator find(key_arg<K> const& key) {
+        size_type const index = findIndex(key);
+
+        return (index == capacity_) ? end() : iteratorAt(index);
+    }
+
+    template <typename K = key_type>
+    [[nodiscard]] const_iterator find(key_arg<K> const& key) const {
+        return const_cast<FlatHashTable*>(this)->find(key);
+    }
+
+    template <typename K = key_type>
+    [[nodiscard]] bool contains(key_arg<K> const& key) const {
+        return findIndex(key) != capacity_;
+    }
+
+    template <typename K = key_type>
+    [[nodiscard]] size_type count(key_arg<K> const& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    void swap(FlatHashTable& other) noexcept {
+        using std::swap;
+
+        swap(hash_, other.hash_);
+        swap(equal_, other.equal_);
+
+        if constexpr (allocator_traits::propagate_on_container_swap::value) {
+            swap(allocator_, other.allocator_);
+        }
+
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+    }
+
+    [[nodiscard]] hasher hash_function() const {
+        return hash_;
+    }
+
+    [[nodiscard]] key_equal key_eq() const {
+        return equal_;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const {
+        return allocator_type{allocator_};
+    }
+
+    /**
+     * Checks if both tables hold equal elements.
+     */
+    [[nodiscard]] friend bool operator==(FlatHashTable const& lhs,
+                                         FlatHashTable const& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (auto const& value : lhs) {
+            auto const position = rhs.find(KeyOf{}(value));
+
+            if (position == rhs.end() || !(*position == value)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] friend bool operator!=(FlatHashTable const& lhs,
+                                         FlatHashTable const& rhs) {
+        return !(lhs == rhs);
+    }
+
+   private:
+    template <typename K>
+    [[nodiscard]] size_type hashOf(K const& key) const {
+        return static_cast<size_type>(hashMix(static_cast<u64>(hash_(key))));
+    }
+
+    /**
+     * Returns the index of the element with the given key or the capacity.
+     */
+    template <typename K>
+    [[nodiscard]] size_type findIndex(K const& key) const {
+        size_type const hash = hashOf(key);
+        ctrl_t const tag = h2(hash);
+        ProbeSequence probe{h1(hash), capacity_};
+
+        while (true) {
+            Group const group{ctrl_ + probe.offset()};
+
+            for (GroupMask match = group.match(tag); match; ++match) {
+                size_type const index = probe.offset(match.lowest());
+
+                if (equal_(KeyOf{}(slots_[index]), key)) {
+                    return index;
+                }
+            }
+
+            if (group.matchEmpty()) {
+                return capacity_;
+            }
+
+            probe.next();
+        }
+    }
+
+    /**
+     * Returns the first empty or deleted slot for the given hash.
+     */
+    [[nodiscard]] size_type findFirstNonFull(size_type hash) const noexcept {
+        ProbeSequence probe{h1(hash), capacity_};
+
+        while (true) {
+            Group const group{ctrl_ + probe.offset()};
+
+            if (GroupMask const free = group.matchEmptyOrDeleted()) {
+                return probe.offset(free.lowest());
+            }
+
+            probe.next();
+        }
+    }
+
+    /**
+     * Finds the element with the given key, or claims a slot for it.
+     *
+     * @return The index of the slot and whether a value must be constructed
+     * in it
+     */
+    template <typename K>
+    std::pair<size_type, bool> findOrPrepareInsert(K const& key) {
+        size_type const hash = hashOf(key);
+        ctrl_t const tag = h2(hash);
+        ProbeSequence probe{h1(hash), capacity_};
+
+        while (true) {
+            Group const group{ctrl_ + probe.offset()};
+
+            for (GroupMask match = group.match(tag); match; ++match) {
+                size_type const index = probe.offset(match.lowest());
+
+                if (equal_(KeyOf{}(slots_[index]), key)) {
+                    return {index, false};
+                }
+            }
+
+            if (group.matchEmpty()) {
+                break;
+            }
+
+            probe.next();
+        }
+
+        size_type index = findFirstNonFull(hash);
+
+        // Reusing a deleted slot does not use up growth
+        if (growth_left_ == 0 && ctrl_[index] != ctrl_deleted) {
+            grow();
+            index = findFirstNonFull(hash);
+        }
+
+        ++size_;
+        growth_left_ -= (ctrl_[index] == ctrl_empty) ? 1 : 0;
+        setCtrl(index, tag);
+
+        return {index, true};
+    }
+
+    template <typename... Args>
+    void construct(size_type index, Args&&... args) {
+        try {
+            slot_traits::construct(allocator_, slots_ + index,
+                                   std::forward<Args>(args)...);
+        } catch (...) {
+            // Give the claimed slot back
+            --size_;
+            setCtrl(index, ctrl_deleted);
+
+            throw;
+        }
+    }
+
+    template <typename V>
+    void insertUnique(V&& value) {
+        emplaceWithKey(KeyOf{}(value), std::forward<V>(value));
+    }
+
+    void eraseAt(size_type index) noexcept {
+        slot_traits::destroy(allocator_, slots_ + index);
+        --size_;
+
+        // A slot can become empty again if no probe ever passed it while
+        // its group was full
+        size_type const index_before = (index - group_width) & capacity_;
+        GroupMask const empty_after = Group{ctrl_ + index}.matchEmpty();
+        GroupMask const empty_before = Group{ctrl_ + index_before}.matchEmpty();
+
+        bool const was_never_full =
+            empty_before && empty_after &&
+            static_cast<size_type>(empty_after.lowest() +
+                                   empty_before.leadingZeros()) < group_width;
+
+        setCtrl(index, was_never_full ? ctrl_empty : ctrl_deleted);
+        growth_left_ += was_never_full ? 1 : 0;
+    }
+
+    /**
+     * Writes a control byte and its mirror after the sentinel.
+     */
+    void setCtrl(size_type index, ctrl_t value) noexcept {
+        ctrl_[index] = value;
+        ctrl_[((index - cloned_ctrl_bytes) & capacity_) +
+              (cloned_ctrl_bytes & capacity_)] = value;
+    }
+
+    void resetCtrl() noexcept {
+        std::memset(ctrl_, ctrl_empty, capacity_ + 1 + cloned_ctrl_bytes);
+        ctrl_[capacity_] = ctrl_sentinel;
+    }
+
+    void grow() {
+        if (capacity_ == 0) {
+            resize(group_width - 1);
+        } else if (size_ <= capacity_ * 25 / 32) {
+            // Mostly deleted markers, rebuilding in place is enough
+            resize(capacity_);
+        } else {
+            resize(capacity_ * 2 + 1);
+        }
+    }
+
+    void resize(size_type new_capacity) {
+        ctrl_t* const old_ctrl = ctrl_;
+        value_type* const old_slots = slots_;
+        size_type const old_capacity = capacity_;
+
+        ctrl_allocator ctrl_alloc{allocator_};
+        ctrl_t* const new_ctrl = ctrl_traits::allocate(
+            ctrl_alloc, new_capacity + 1 + cloned_ctrl_bytes);
+        value_type* new_slots = nullptr;
+
+        try {
+            new_slots = slot_traits::allocate(allocator_, new_capacity);
+        } catch (...) {
+            ctrl_traits::deallocate(ctrl_alloc, new_ctrl,
+                                    new_capacity + 1 + cloned_ctrl_bytes);
+
+            throw;
+        }
+
+        ctrl_ = new_ctrl;
+        slots_ = new_slots;
+        capacity_ = new_capacity;
+        resetCtrl();
+        growth_left_ = capacityToGrowth(capacity_) - size_;
+
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if (!isFull(old_ctrl[i])) {
+                continue;
+            }
+
+            size_type const hash = hashOf(KeyOf{}(old_slots[i]));
+            size_type const index = findFirstNonFull(hash);
+
+            setCtrl(index, h2(hash));
+            slot_traits::construct(allocator_, slots_ + index,
+                                   std::move(old_slots[i]));
+            slot_traits::destroy(allocator_, old_slots + i);
+        }
+
+        if (old_capacity > 0) {
+            deallocate(old_ctrl, old_slots, old_capacity);
+        }
+    }
+
+    void destroyElements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (isFull(ctrl_[i])) {
+                    slot_traits::destroy(allocator_, slots_ + i);
+                }
+            }
+        }
+    }
+
+    void deallocate(ctrl_t* ctrl, value_type* slots,
+                    size_type capacity) noexcept {
+        ctrl_allocator ctrl_alloc{allocator_};
+
+        ctrl_traits::deallocate(ctrl_alloc, ctrl,
+                                capacity + 1 + cloned_ctrl_bytes);
+        slot_traits::deallocate(allocator_, slots, capacity);
+    }
+
+    void destroyAndDeallocate() noexcept {
+        if (capacity_ > 0) {
+            destroyElements();
+            deallocate(ctrl_, slots_, capacity_);
+        }
+
+        ctrl_ = const_cast<ctrl_t*>(empty_group);
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    void steal(FlatHashTable& other) noexcept {
+        ctrl_ = std::exchange(other.ctrl_, const_cast<ctrl_t*>(empty_group));
+        slots_ = std::exchange(other.slots_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
+        size_ = std::exchange(other.size_, 0);
+        growth_left_ = std::exchange(other.growth_left_, 0);
+    }
+
+    [[nodiscard]] iterator iteratorAt(size_type index) noexcept {
+        return iterator{ctrl_ + index, slots_ + index};
+    }
+
+    Hash hash_{};
+    KeyEqual equal_{};
+    slot_allocator allocator_{};
+    ctrl_t* ctrl_ = const_cast<ctrl_t*>(empty_group);
+    value_type* slots_ = nullptr;
+    size_type capacity_ = 0;
+    size_type size_ = 0;
+    size_type growth_left_ = 0;
+};
+
+}  // namespace Detail
+
+}  // namespace Zeus
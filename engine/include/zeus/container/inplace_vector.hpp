@@ -0,0 +1,416 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/assert.hpp"
+
+/**
+ * @file inplace_vector.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+/**
+ * Checks if the given type can be stored in a plain array, which keeps the
+ * owning container usable in constant expressions.
+ */
+template <typename T>
+inline constexpr bool is_trivial_storage_v =
+    std::is_trivially_default_constructible_v<T> &&
+    std::is_trivially_destructible_v<T> &&
+    std::is_trivially_copyable_v<T>;
+
+/**
+ * Storage for trivial types.
+ */
+template <typename T, std::size_t N, bool = is_trivial_storage_v<T>>
+struct InplaceStorage {
+    constexpr T* data() noexcept {
+        return elements.data();
+    }
+
+    constexpr T const* data() const noexcept {
+        return elements.data();
+    }
+
+    template <typename... Args>
+    constexpr T& construct(std::size_t position, Args&&... args) {
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            elements[position] = T(std::forward<Args>(args)...);
+        } else {
+            elements[position] = T{std::forward<Args>(args)...};
+        }
+
+        return elements[position];
+    }
+
+    constexpr void destroy([[maybe_unused]] std::size_t first,
+                           [[maybe_unused]] std::size_t last) noexcept {}
+
+    std::array<T, N> elements{};
+    std::size_t size = 0;
+};
+
+/**
+ * Storage for types that need their constructors and destructors run.
+ */
+template <typename T, std::size_t N>
+struct InplaceStorage<T, N, false> {
+    InplaceStorage() noexcept = default;
+
+    InplaceStorage(InplaceStorage const& other) {
+        std::uninitialized_copy(other.data(), other.data() + other.size,
+                                data());
+        size = other.size;
+    }
+
+    InplaceStorage(InplaceStorage&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move(other.data(), other.data() + other.size,
+                                data());
+        size = other.size;
+    }
+
+    InplaceStorage& operator=(InplaceStorage const& other) {
+        if (this != &other) {
+            destroy(0, size);
+            size = 0;
+
+            std::uninitialized_copy(other.data(), other.data() + other.size,
+                                    data());
+            size = other.size;
+        }
+
+        return *this;
+    }
+
+    InplaceStorage& operator=(InplaceStorage&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            destroy(0, size);
+            size = 0;
+
+            std::uninitialized_move(other.data(), other.data() + other.size,
+                                    data());
+            size = other.size;
+        }
+
+        return *this;
+    }
+
+    ~InplaceStorage() {
+        destroy(0, size);
+    }
+
+    T* data() noexcept {
+        return std::launder(reinterpret_cast<T*>(bytes.data()));
+    }
+
+    T const* data() const noexcept {
+        return std::launder(reinterpret_cast<T const*>(bytes.data()));
+    }
+
+    template <typename... Args>
+    T& construct(std::size_t position, Args&&... args) {
+        void* address = bytes.data() + position * sizeof(T);
+
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            return *::new (address) T(std::forward<Args>(args)...);
+        } else {
+            return *::new (address) T{std::forward<Args>(args)...};
+        }
+    }
+
+    void destroy(std::size_t first, std::size_t last) noexcept {
+        std::destroy(data() + first, data() + last);
+    }
+
+    alignas(T) std::array<std::byte, sizeof(T) * N> bytes;
+    std::size_t size = 0;
+};
+
+}  // namespace Detail
+
+/**
+ * A vector with a fixed capacity that stores its elements inline.
+ *
+ * The container never allocates. Exceeding its capacity is a programming
+ * error that is caught by an assertion, use tryEmplaceBack() when running
+ * out of room is expected.
+ *
+ * @note The container can be used in constant expressions when T is trivial.
+ *
+ * @tparam T The type of the elements
+ * @tparam N The capacity of the vector
+ */
+template <typename T, std::size_t N>
+class InplaceVector {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = value_type*;
+    using const_iterator = value_type const*;
+
+    /**
+     * Constructs an empty vector.
+     */
+    constexpr InplaceVector() noexcept = default;
+
+    /**
+     * Constructs a vector containing the given values.
+     *
+     * @param values The values to copy into the vector
+     */
+    constexpr InplaceVector(std::initializer_list<value_type> values) {
+        for (auto const& value : values) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * Constructs an element at the end of the vector using the given
+     * arguments.
+     *
+     * @note The vector must not be full.
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return A reference to the new element
+     */
+    template <typename... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, storage_.size < N,
+                           "InplaceVector capacity exceeded.");
+
+        reference element =
+            storage_.construct(storage_.size, std::forward<Args>(args)...);
+        ++storage_.size;
+
+        return element;
+    }
+
+    /**
+     * Constructs an element at the end of the vector if there is room.
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return A pointer to the new element or nullptr if the vector is full
+     */
+    template <typename... Args>
+    constexpr value_type* tryEmplaceBack(Args&&... args) {
+        if (full()) {
+            return nullptr;
+        }
+
+        return &emplace_back(std::forward<Args>(args)...);
+    }
+
+    constexpr void push_back(value_type const& value) {
+        emplace_back(value);
+    }
+
+    constexpr void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * Removes the last element of the vector.
+     */
+    constexpr void pop_back() noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, storage_.size > 0,
+                           "pop_back() called on an empty vector.");
+
+        --storage_.size;
+        storage_.destroy(storage_.size, storage_.size + 1);
+    }
+
+    /**
+     * Removes the element at the given position, shifting the following
+     * elements down.
+     *
+     * @param position The element to remove
+     *
+     * @return An iterator to the element after the removed one
+     */
+    constexpr iterator erase(const_iterator position) {
+        auto* target = begin() + (position - begin());
+
+        for (iterator it = target; it + 1 != end(); ++it) {
+            *it = std::move(*(it + 1));
+        }
+
+        pop_back();
+
+        return target;
+    }
+
+    /**
+     * Resizes the vector to the given number of elements, value initializing
+     * any new elements.
+     *
+     * @param count The new number of elements
+     */
+    constexpr void resize(size_type count) {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, count <= N,
+                           "InplaceVector capacity exceeded.");
+
+        if (count < storage_.size) {
+            storage_.destroy(count, storage_.size);
+            storage_.size = count;
+        }
+
+        while (storage_.size < count) {
+            emplace_back();
+        }
+    }
+
+    /**
+     * Destructs every element.
+     */
+    constexpr void clear() noexcept {
+        storage_.destroy(0, storage_.size);
+        storage_.size = 0;
+    }
+
+    [[nodiscard]] constexpr reference operator[](size_type position) noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, position < storage_.size,
+                           "Index out of bounds.");
+
+        return data()[position];
+    }
+
+    [[nodiscard]] constexpr const_reference operator[](
+        size_type position) const noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, position < storage_.size,
+                           "Index out of bounds.");
+
+        return data()[position];
+    }
+
+    [[nodiscard]] constexpr reference front() noexcept {
+        return data()[0];
+    }
+
+    [[nodiscard]] constexpr const_reference front() const noexcept {
+        return data()[0];
+    }
+
+    [[nodiscard]] constexpr reference back() noexcept {
+        return data()[storage_.size - 1];
+    }
+
+    [[nodiscard]] constexpr const_reference back() const noexcept {
+        return data()[storage_.size - 1];
+    }
+
+    [[nodiscard]] constexpr size_type size() const noexcept {
+        return storage_.size;
+    }
+
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return storage_.size == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+        return storage_.size == N;
+    }
+
+    [[nodiscard]] constexpr value_type* data() noexcept {
+        return storage_.data();
+    }
+
+    [[nodiscard]] constexpr value_type const* data() const noexcept {
+        return storage_.data();
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return data();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return data() + storage_.size;
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return data() + storage_.size;
+    }
+
+   private:
+    Detail::InplaceStorage<T, N> storage_;
+};
+
+/**
+ * Checks if the two given vectors contain equal elements.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are equal, otherwise false
+ */
+template <typename T, std::size_t N>
+constexpr bool operator==(InplaceVector<T, N> const& lhs,
+                          InplaceVector<T, N> const& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks if the two given vectors do not contain equal elements.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are not equal, otherwise false
+ */
+template <typename T, std::size_t N>
+constexpr bool operator!=(InplaceVector<T, N> const& lhs,
+                          InplaceVector<T, N> const& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace Zeus
@@ -0,0 +1,350 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/handle.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file slot_map.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A densely packed container addressed by generational handles.
+ *
+ * Values are kept contiguous in memory so iterating over the live elements is
+ * a linear walk. Handles go through a slot table that maps them to their
+ * current dense position and rejects stale handles by comparing generations.
+ * Insertion, erasure and lookup are all O(1).
+ *
+ * @note Erasing an element moves the last element into its place, so the
+ * iteration order is not stable. Handles stay valid across erasures of other
+ * elements.
+ *
+ * @tparam T        The type of the stored values
+ * @tparam Handle   The handle type used to address the values
+ */
+template <typename T, typename Handle = Zeus::Handle<T>>
+class SlotMap {
+   public:
+    using value_type = T;
+    using handle_type = Handle;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    /**
+     * Constructs an empty slot map.
+     */
+    SlotMap() noexcept = default;
+
+    /**
+     * Inserts the given value.
+     *
+     * @throws std::length_error if the handle type cannot address more slots
+     *
+     * @param value The value to insert
+     *
+     * @return The handle to the inserted value
+     */
+    handle_type insert(value_type const& value) {
+        return emplace(value);
+    }
+
+    /**
+     * Inserts the given value.
+     *
+     * @throws std::length_error if the handle type cannot address more slots
+     *
+     * @param value The value to insert
+     *
+     * @return The handle to the inserted value
+     */
+    handle_type insert(value_type&& value) {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * Constructs a value in place using the given arguments.
+     *
+     * @throws std::length_error if the handle type cannot address more slots
+     *
+     * @param args The arguments to construct the value with
+     *
+     * @return The handle to the new value
+     */
+    template <typename... Args>
+    handle_type emplace(Args&&... args) {
+        index_type const slot = acquireSlot();
+
+        dense_to_slot_.push_back(slot);
+
+        try {
+            values_.emplace_back(std::forward<Args>(args)...);
+        } catch (...) {
+            dense_to_slot_.pop_back();
+
+            throw;
+        }
+
+        // Take the slot off the free list only once nothing can throw
+        free_head_ = slots_[slot].position;
+        slots_[slot].position = static_cast<index_type>(values_.size() - 1);
+
+        return handle_type{slot, slots_[slot].generation};
+    }
+
+    /**
+     * Erases the value referenced by the given handle.
+     *
+     * @param handle The handle to the value to erase
+     *
+     * @return True if a value was erased, false if the handle was stale
+     */
+    bool erase(handle_type handle) noexcept {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        index_type const slot = handle.index();
+        index_type const position = slots_[slot].position;
+        index_type const last = static_cast<index_type>(values_.size() - 1);
+
+        if (position != last) {
+            values_[position] = std::move(values_[last]);
+            dense_to_slot_[position] = dense_to_slot_[last];
+            slots_[dense_to_slot_[position]].position = position;
+        }
+
+        values_.pop_back();
+        dense_to_slot_.pop_back();
+
+        releaseSlot(slot);
+
+        return true;
+    }
+
+    /**
+     * Checks if the given handle references a live value.
+     *
+     * @param handle The handle to check
+     *
+     * @return True if the handle is live, otherwise false
+     */
+    [[nodiscard]] bool contains(handle_type handle) const noexcept {
+        return handle.index() < slots_.size() &&
+               slots_[handle.index()].generation == handle.generation() &&
+               !handle.isNull();
+    }
+
+    /**
+     * Returns a pointer to the value referenced by the given handle.
+     *
+     * @param handle The handle to look up
+     *
+     * @return A pointer to the value or nullptr if the handle is stale
+     */
+    [[nodiscard]] value_type* get(handle_type handle) noexcept {
+        return contains(handle) ? &values_[slots_[handle.index()].position]
+                                : nullptr;
+    }
+
+    /**
+     * Returns a constant pointer to the value referenced by the given handle.
+     *
+     * @param handle The handle to look up
+     *
+     * @return A constant pointer to the value or nullptr if the handle is stale
+     */
+    [[nodiscard]] value_type const* get(handle_type handle) const noexcept {
+        return contains(handle) ? &values_[slots_[handle.index()].position]
+                                : nullptr;
+    }
+
+    /**
+     * Returns a reference to the value referenced by the given handle.
+     *
+     * @note The handle must be live.
+     *
+     * @param handle The handle to look up
+     *
+     * @return A reference to the value
+     */
+    [[nodiscard]] reference operator[](handle_type handle) noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, contains(handle),
+                           "Stale or null slot map handle.");
+
+        return values_[slots_[handle.index()].position];
+    }
+
+    /**
+     * Returns a constant reference to the value referenced by the given
+     * handle.
+     *
+     * @note The handle must be live.
+     *
+     * @param handle The handle to look up
+     *
+     * @return A constant reference to the value
+     */
+    [[nodiscard]] const_reference operator[](
+        handle_type handle) const noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, contains(handle),
+                           "Stale or null slot map handle.");
+
+        return values_[slots_[handle.index()].position];
+    }
+
+    /**
+     * Returns the handle of the value at the given dense position.
+     *
+     * @param position The position of the value in iteration order
+     *
+     * @return The handle to the value
+     */
+    [[nodiscard]] handle_type handleAt(size_type position) const noexcept {
+        index_type const slot = dense_to_slot_[position];
+
+        return handle_type{slot, slots_[slot].generation};
+    }
+
+    /**
+     * Reserves storage for the given number of values.
+     *
+     * @param capacity The number of values to reserve storage for
+     */
+    void reserve(size_type capacity) {
+        values_.reserve(capacity);
+        dense_to_slot_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    /**
+     * Erases every value and invalidates every handle.
+     */
+    void clear() noexcept {
+        while (!dense_to_slot_.empty()) {
+            releaseSlot(dense_to_slot_.back());
+            dense_to_slot_.pop_back();
+        }
+
+        values_.clear();
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return values_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return values_.empty();
+    }
+
+    [[nodiscard]] value_type* data() noexcept {
+        return values_.data();
+    }
+
+    [[nodiscard]] value_type const* data() const noexcept {
+        return values_.data();
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return values_.begin();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return values_.begin();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return values_.end();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return values_.end();
+    }
+
+   private:
+    using index_type = typename handle_type::value_type;
+
+    static constexpr index_type null_slot = handle_type::max_index;
+
+    /**
+     * Maps a handle index to a dense position.
+     *
+     * @note Free slots reuse the position as the link of the free list.
+     */
+    struct Slot {
+        index_type position;
+        index_type generation;
+    };
+
+    /**
+     * Returns a free slot without taking it off the free list.
+     */
+    index_type acquireSlot() {
+        if (free_head_ != null_slot) {
+            return free_head_;
+        }
+
+        // The largest index is reserved as the free list terminator
+        if (slots_.size() >= null_slot) {
+            throw std::length_error("Slot map handles are exhausted.");
+        }
+
+        auto const slot = static_cast<index_type>(slots_.size());
+
+        slots_.push_back(Slot{null_slot, 1});
+        free_head_ = slot;
+
+        return slot;
+    }
+
+    void releaseSlot(index_type slot) noexcept {
+        Slot& entry = slots_[slot];
+
+        // A slot whose generation would wrap is retired so that old handles
+        // can never match it again
+        if (entry.generation == handle_type::max_generation) {
+            entry.generation = 0;
+
+            return;
+        }
+
+        ++entry.generation;
+        entry.position = free_head_;
+        free_head_ = slot;
+    }
+
+    std::vector<value_type> values_;
+    std::vector<index_type> dense_to_slot_;
+    std::vector<Slot> slots_;
+    index_type free_head_ = null_slot;
+};
+
+}  // namespace Zeus
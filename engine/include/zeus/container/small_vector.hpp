@@ -0,0 +1,439 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/assert.hpp"
+
+/**
+ * @file small_vector.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A vector that stores up to N elements inline before moving them to the
+ * heap.
+ *
+ * Short-lived containers that usually stay small never touch the allocator.
+ * Once the inline capacity is exceeded the container behaves like
+ * std::vector.
+ *
+ * @note Moving a vector whose elements are on the heap steals the heap
+ * buffer. Moving an inline vector moves its elements one by one.
+ *
+ * @note Like std::vector, growing copies the elements instead of moving them
+ * if their move constructor may throw, so a failed push leaves the vector
+ * unchanged.
+ *
+ * @note Unlike InplaceVector and FixedString, SmallVector is not usable in
+ * constant expressions. It needs a destructor to free its heap buffer, which
+ * keeps it from being a literal type in C++17, and neither heap allocation
+ * nor placement new into its byte buffer is allowed during constant
+ * evaluation before C++20. Use InplaceVector for compile time tables.
+ *
+ * @tparam T The type of the elements
+ * @tparam N The number of elements stored inline
+ */
+template <typename T, std::size_t N>
+class SmallVector {
+   public:
+    static_assert(N > 0, "SmallVector needs an inline capacity.");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = value_type*;
+    using const_iterator = value_type const*;
+
+    /**
+     * Constructs an empty vector.
+     */
+    SmallVector() noexcept = default;
+
+    /**
+     * Constructs a vector containing the given values.
+     *
+     * @param values The values to copy into the vector
+     */
+    SmallVector(std::initializer_list<value_type> values) {
+        reserve(values.size());
+
+        for (auto const& value : values) {
+            push_back(value);
+        }
+    }
+
+    SmallVector(SmallVector const& other) {
+        reserve(other.size_);
+
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        takeFrom(std::move(other));
+    }
+
+    SmallVector& operator=(SmallVector const& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            deallocate();
+
+            takeFrom(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        deallocate();
+    }
+
+    /**
+     * Constructs an element at the end of the vector using the given
+     * arguments.
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return A reference to the new element
+     */
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // The arguments may refer to an element of this vector, so build
+            // the new element before the old ones are moved
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+
+        reference element = construct(data_ + size_,
+                                      std::forward<Args>(args)...);
+        ++size_;
+
+        return element;
+    }
+
+    void push_back(value_type const& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * Removes the last element of the vector.
+     */
+    void pop_back() noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, size_ > 0,
+                           "pop_back() called on an empty vector.");
+
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    /**
+     * Removes the element at the given position, shifting the following
+     * elements down.
+     *
+     * @param position The element to remove
+     *
+     * @return An iterator to the element after the removed one
+     */
+    iterator erase(const_iterator position) {
+        iterator target = begin() + (position - begin());
+
+        std::move(target + 1, end(), target);
+        pop_back();
+
+        return target;
+    }
+
+    /**
+     * Resizes the vector to the given number of elements, value initializing
+     * any new elements.
+     *
+     * @param count The new number of elements
+     */
+    void resize(size_type count) {
+        if (count < size_) {
+            std::destroy(data_ + count, data_ + size_);
+            size_ = count;
+
+            return;
+        }
+
+        reserve(count);
+
+        std::uninitialized_value_construct(data_ + size_, data_ + count);
+        size_ = count;
+    }
+
+    /**
+     * Makes room for at least the given number of elements.
+     *
+     * @param count The number of elements to make room for
+     */
+    void reserve(size_type count) {
+        if (count > capacity_) {
+            relocate(count);
+        }
+    }
+
+    /**
+     * Destructs every element.
+     *
+     * @note The heap buffer, if any, is kept.
+     */
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    [[nodiscard]] reference operator[](size_type position) noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, position < size_,
+                           "Index out of bounds.");
+
+        return data_[position];
+    }
+
+    [[nodiscard]] const_reference operator[](
+        size_type position) const noexcept {
+        ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, position < size_,
+                           "Index out of bounds.");
+
+        return data_[position];
+    }
+
+    [[nodiscard]] reference front() noexcept {
+        return data_[0];
+    }
+
+    [[nodiscard]] const_reference front() const noexcept {
+        return data_[0];
+    }
+
+    [[nodiscard]] reference back() noexcept {
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] const_reference back() const noexcept {
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] static constexpr size_type inlineCapacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /**
+     * Checks if the elements are stored inline.
+     *
+     * @return True if no heap memory is used, otherwise false
+     */
+    [[nodiscard]] bool isInline() const noexcept {
+        return data_ == inlineData();
+    }
+
+    [[nodiscard]] value_type* data() noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] value_type const* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+   private:
+    template <typename... Args>
+    static reference construct(value_type* address, Args&&... args) {
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            return *::new (static_cast<void*>(address))
+                T(std::forward<Args>(args)...);
+        } else {
+            return *::new (static_cast<void*>(address))
+                T{std::forward<Args>(args)...};
+        }
+    }
+
+    value_type* inlineData() noexcept {
+        return std::launder(reinterpret_cast<value_type*>(buffer_.data()));
+    }
+
+    value_type const* inlineData() const noexcept {
+        return std::launder(
+            reinterpret_cast<value_type const*>(buffer_.data()));
+    }
+
+    /**
+     * Moves the elements into uninitialized storage, or copies them if moving
+     * could throw, so that the elements are unchanged if an exception is
+     * thrown.
+     *
+     * @note The elements constructed in the storage are destroyed again if
+     * an exception is thrown.
+     */
+    void transfer(value_type* buffer) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(data_, data_ + size_, buffer);
+        } else {
+            std::uninitialized_copy(data_, data_ + size_, buffer);
+        }
+    }
+
+    /**
+     * Moves the elements into a heap buffer with the given capacity.
+     */
+    void relocate(size_type capacity) {
+        value_type* buffer = std::allocator<value_type>{}.allocate(capacity);
+
+        try {
+            transfer(buffer);
+        } catch (...) {
+            std::allocator<value_type>{}.deallocate(buffer, capacity);
+
+            throw;
+        }
+
+        std::destroy(data_, data_ + size_);
+
+        deallocate();
+
+        data_ = buffer;
+        capacity_ = capacity;
+    }
+
+    template <typename... Args>
+    reference growAndEmplace(Args&&... args) {
+        size_type const capacity = std::max(capacity_ * 2, size_type{N});
+        value_type* buffer = std::allocator<value_type>{}.allocate(capacity);
+
+        try {
+            construct(buffer + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<value_type>{}.deallocate(buffer, capacity);
+
+            throw;
+        }
+
+        try {
+            transfer(buffer);
+        } catch (...) {
+            std::destroy_at(buffer + size_);
+            std::allocator<value_type>{}.deallocate(buffer, capacity);
+
+            throw;
+        }
+
+        std::destroy(data_, data_ + size_);
+
+        deallocate();
+
+        data_ = buffer;
+        capacity_ = capacity;
+
+        return data_[size_++];
+    }
+
+    void deallocate() noexcept {
+        if (!isInline()) {
+            std::allocator<value_type>{}.deallocate(data_, capacity_);
+
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    /**
+     * Takes the elements of the given vector which must be empty afterwards.
+     */
+    void takeFrom(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+
+            other.clear();
+
+            return;
+        }
+
+        data_ = std::exchange(other.data_, other.inlineData());
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, N);
+    }
+
+    alignas(T) std::array<std::byte, sizeof(T) * N> buffer_;
+    value_type* data_ = inlineData();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+};
+
+}  // namespace Zeus
@@ -19,25 +19,139 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdio>
+#include <exception>
 #include <optional>
-#include <sstream>
+#include <string>
 #include <string_view>
 
 #include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/format.hpp"
 #include "zeus/core/log.hpp"
 #include "zeus/core/macro_helpers.hpp"
+#include "zeus/core/stack_trace.hpp"
 
 /**
  * @file assert.hpp
+ *
+ * Assertions come in three tiers:
+ *
+ * - ALWAYS assertions are checked in every build.
+ * - DEBUG assertions are checked when ZEUS_DEBUG is defined.
+ * - PARANOID assertions are expensive checks that are only turned on by
+ *   setting the assertion level to 2.
+ *
+ * The assertion level is ZEUS_ASSERT_LEVEL and can be overridden per module
+ * with ZEUS_ASSERT_LEVEL_<MODULE>, for example ZEUS_ASSERT_LEVEL_MATH=0 turns
+ * the debug assertions of the math module off in a debug build.
+ *
+ * A passing assertion costs a single branch that is predicted not taken. The
+ * failure path lives in an out of line cold function so the checks do not
+ * bloat the code they guard. Assertions that are turned off do not evaluate
+ * their condition.
  */
 
+// The tiers of assertions, in order of cost
+#define ZEUS_ASSERT_TIER_ALWAYS 0
+#define ZEUS_ASSERT_TIER_DEBUG 1
+#define ZEUS_ASSERT_TIER_PARANOID 2
+
+#ifndef ZEUS_ASSERT_LEVEL
+#ifdef ZEUS_DEBUG
+#define ZEUS_ASSERT_LEVEL ZEUS_ASSERT_TIER_DEBUG
+#else
+#define ZEUS_ASSERT_LEVEL ZEUS_ASSERT_TIER_ALWAYS
+#endif
+#endif
+
+// Used by assertions that do not name a module
+#define ZEUS_ASSERT_LEVEL_DEFAULT ZEUS_ASSERT_LEVEL
+
+#ifndef ZEUS_ASSERT_LEVEL_CORE
+#define ZEUS_ASSERT_LEVEL_CORE ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_MATH
+#define ZEUS_ASSERT_LEVEL_MATH ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_MEMORY
+#define ZEUS_ASSERT_LEVEL_MEMORY ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_CONTAINER
+#define ZEUS_ASSERT_LEVEL_CONTAINER ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_JOB
+#define ZEUS_ASSERT_LEVEL_JOB ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_ECS
+#define ZEUS_ASSERT_LEVEL_ECS ZEUS_ASSERT_LEVEL
+#endif
+
+#ifndef ZEUS_ASSERT_LEVEL_SCENE
+#define ZEUS_ASSERT_LEVEL_SCENE ZEUS_ASSERT_LEVEL
+#endif
+
 namespace Zeus {
 
+namespace Detail {
+
+/**
+ * Reports a failed assertion together with a stack trace and terminates the
+ * program.
+ *
+ * @param assertion_text    A string representation of the assertion
+ * @param message           The message to output or nullptr
+ * @param file_name         The file name where the assertion occurred
+ * @param line_number       The line number where the assertion occurred
+ */
+[[noreturn]] ZEUS_NOINLINE ZEUS_COLD inline void assertionFailed(
+    char const* assertion_text, char const* message, char const* file_name,
+    int line_number) noexcept {
+    FixedString<8192> text;
+
+    ZEUS_FORMAT_TO(text,
+                   "\n=========== ZEUS ASSERTION FAILED ===========\n"
+                   "Assertion ({}) failed!\nFile: {}\nLine: {}\n",
+                   assertion_text, file_name, line_number);
+
+    if (message != nullptr) {
+        ZEUS_FORMAT_TO(text, "Message: {}\n", message);
+    }
+
+    // Skips this function, the trace starts at the failed assertion
+    std::string const trace = StackTrace::current(1);
+
+    if (!trace.empty()) {
+        text += "Stack trace:\n";
+        text += trace;
+    }
+
+    text += "==============================================\n";
+
+    StackTrace::Detail::trace_reported.store(true, std::memory_order_relaxed);
+
+#ifdef ZEUS_ENABLE_LOGGING
+    Log::error(text);
+    Log::flush();
+#else
+    std::fputs(text.c_str(), stderr);
+#endif
+
+    std::terminate();
+}
+
+}  // namespace Detail
+
 /**
  * Assertion against the given condition.
  *
  * @note Terminates the program if the given condition is false, otherwise the
- * program continues.
+ * program continues. Prefer the ZEUS_ASSERT macros, which do not evaluate the
+ * condition when they are turned off.
  *
  * @param condition         The condition to assert against
  * @param assertion_text    A string representation of the assertion
@@ -45,40 +159,63 @@ namespace Zeus {
  * @param file_name         The file name where the assertion occurred
  * @param line_number       The line number where the assertion occurred
  */
-ZEUS_FORCE_INLINE inline void assert_condition(
-    bool condition, std::string_view assertion_text,
-    std::optional<std::string_view> message, std::string_view file_name,
-    std::int64_t line_number) {
-    if (!condition) {
-        std::stringstream stream;
-
-        stream << "\n=========== ZEUS ASSERTION FAILED ===========\n";
-        stream << "Assertion (" << assertion_text << ") failed!\n";
-        stream << "File: " << file_name << '\n';
-        stream << "Line: " << line_number << '\n';
-
-        if (message.has_value()) {
-            stream << "Message: " << message.value() << "\n";
-        }
-
-        stream << "==============================================\n";
-
-        ZEUS_ERROR_LOG(stream.str());
+inline void assert_condition(bool condition, std::string_view assertion_text,
+                             std::optional<std::string_view> message,
+                             std::string_view file_name,
+                             std::int64_t line_number) {
+    if (ZEUS_UNLIKELY(!condition)) {
+        std::string const assertion{assertion_text};
+        std::string const file{file_name};
+        std::string const text{message.value_or("")};
 
-        std::terminate();
+        Detail::assertionFailed(assertion.c_str(),
+                                message.has_value() ? text.c_str() : nullptr,
+                                file.c_str(), static_cast<int>(line_number));
     }
 }
 
 }  // namespace Zeus
 
-#define ZEUS_ASSERT_2(ASSERTION, MESSAGE)                                     \
-    Zeus::assert_condition(ASSERTION, ZEUS_STR(ASSERTION), MESSAGE, __FILE__, \
-                           __LINE__)
+/**
+ * Asserts a condition if the given tier is turned on for the given module.
+ *
+ * Takes the module (CORE, MATH, MEMORY, CONTAINER, JOB, ECS, SCENE or DEFAULT),
+ * the tier (ALWAYS, DEBUG or PARANOID), the condition and an optional message
+ * literal.
+ *
+ * @note Usable in constexpr functions, a failing assertion during constant
+ * evaluation is a compile error.
+ */
+#define ZEUS_MODULE_ASSERT(MODULE, TIER, ...) \
+    ZEUS_VA_SELECT(ZEUS_DETAIL_ASSERT, MODULE, TIER, __VA_ARGS__)
 
-#define ZEUS_ASSERT_1(ASSERTION) ZEUS_ASSERT_2(ASSERTION, std::nullopt)
+#define ZEUS_DETAIL_ASSERT_3(MODULE, TIER, ASSERTION) \
+    ZEUS_DETAIL_ASSERT_4(MODULE, TIER, ASSERTION, nullptr)
 
-#ifdef ZEUS_DEBUG
-#define ZEUS_ASSERT(...) ZEUS_VA_SELECT(ZEUS_ASSERT, __VA_ARGS__)
-#else
-#define ZEUS_ASSERT(...)
-#endif
+#define ZEUS_DETAIL_ASSERT_4(MODULE, TIER, ASSERTION, MESSAGE)            \
+    do {                                                                  \
+        if constexpr (ZEUS_ASSERT_LEVEL_##MODULE >=                       \
+                      ZEUS_ASSERT_TIER_##TIER) {                          \
+            if (ZEUS_UNLIKELY(!(ASSERTION))) {                            \
+                Zeus::Detail::assertionFailed(ZEUS_STR(ASSERTION),        \
+                                              MESSAGE, __FILE__, __LINE__); \
+            }                                                             \
+        }                                                                 \
+    } while (false)
+
+/**
+ * Asserts a condition in every build.
+ */
+#define ZEUS_ASSERT_ALWAYS(...) \
+    ZEUS_MODULE_ASSERT(DEFAULT, ALWAYS, __VA_ARGS__)
+
+/**
+ * Asserts a condition in debug builds.
+ */
+#define ZEUS_ASSERT(...) ZEUS_MODULE_ASSERT(DEFAULT, DEBUG, __VA_ARGS__)
+
+/**
+ * Asserts an expensive condition when paranoid assertions are turned on.
+ */
+#define ZEUS_ASSERT_PARANOID(...) \
+    ZEUS_MODULE_ASSERT(DEFAULT, PARANOID, __VA_ARGS__)
@@ -0,0 +1,562 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/tsc.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/math/vector_2d.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * @file binary_log.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A logging mode that defers formatting to an offline decoder.
+ *
+ * Every call site registers its level, logger name, format string and
+ * argument types once. A log call then only copies a timestamp, the id of its
+ * call site and the raw bytes of its arguments into a buffer owned by the
+ * calling thread. A full buffer is swapped for a spare one and written out as
+ * a single block by a background writer thread, so the logging thread never
+ * waits for the output. Buffers are also written when BinaryLog::flush() is
+ * called or when the thread exits. The resulting stream is turned into text by
+ * the zeus_log_decoder tool.
+ *
+ * Format strings use "{}" as the placeholder for the next argument.
+ *
+ * @note A thread only writes its own buffer, so call BinaryLog::flush() from
+ * every thread that should have its messages written before a crash.
+ */
+namespace BinaryLog {
+
+/**
+ * The argument types that can be written to a binary log.
+ */
+enum class ArgumentType : u8 {
+    Bool,
+    Char,
+    Int,
+    UInt,
+    F32,
+    F64,
+    String,
+    Vector2D,
+    Vector3D
+};
+
+/**
+ * The static description of a log call site.
+ *
+ * @note Only constructed by the ZEUS_BINARY_*_LOG macros. The strings are
+ * kept as pointers so that the site is constant initialized and needs no
+ * guard on every call.
+ */
+struct Site {
+    Log::Level level;
+    char const* name;
+    char const* file;
+    u32 line;
+
+    // Assigned when the call site is first used, 0 until then
+    std::atomic<u32> id{0};
+
+    constexpr Site(Log::Level level, char const* name, char const* file,
+                   u32 line) noexcept
+        : level{level}, name{name}, file{file}, line{line} {}
+};
+
+/**
+ * Identifies the stream and stores the information needed to convert
+ * timestamps.
+ */
+struct StreamHeader {
+    u32 magic;
+    u16 version;
+    u16 reserved;
+
+    // The timestamp of the first message and its ticks per second
+    u64 start_ticks;
+    f64 ticks_per_second;
+};
+
+/**
+ * The kinds of blocks that follow the stream header.
+ */
+enum class BlockType : u32 { Site = 1, Events = 2 };
+
+/**
+ * Precedes every block of a binary log stream.
+ */
+struct BlockHeader {
+    BlockType type;
+
+    // The size of the block excluding this header
+    u32 size;
+};
+
+/**
+ * The fixed part of a site block, followed by the argument types, the logger
+ * name, the format string and the file name.
+ */
+struct SiteHeader {
+    u32 id;
+    u32 line;
+    u8 level;
+    u8 argument_count;
+    u16 name_size;
+    u16 format_size;
+    u16 file_size;
+};
+
+/**
+ * The size of the site id and the timestamp that start every event, followed
+ * by the encoded arguments.
+ */
+inline constexpr std::size_t event_header_size = sizeof(u32) + sizeof(u64);
+
+inline constexpr u32 stream_magic = 0x4C42525A;  // "ZRBL"
+
+inline constexpr u16 stream_version = 1;
+
+/**
+ * The size of the event buffer of a single thread.
+ */
+inline constexpr std::size_t buffer_size = std::size_t{64} * 1024;
+
+/**
+ * Longer string arguments are truncated.
+ */
+inline constexpr std::size_t max_string_size = 1024;
+
+/**
+ * Opens the given file and writes every following message to it.
+ *
+ * @param path The path of the file to create or truncate
+ *
+ * @return True if the file was opened, otherwise false
+ */
+bool open(std::string const& path) noexcept;
+
+/**
+ * Writes every following message to the given file descriptor.
+ *
+ * @note The file descriptor is not closed by the binary log.
+ *
+ * @param file_descriptor The file descriptor to write messages to
+ */
+void setOutput(int file_descriptor) noexcept;
+
+/**
+ * Flushes the calling thread and stops writing messages.
+ *
+ * @note Messages logged while there is no output are discarded.
+ */
+void close() noexcept;
+
+/**
+ * Writes the pending messages of the calling thread.
+ *
+ * @note Waits until the writer thread has written every full buffer.
+ */
+void flush() noexcept;
+
+/**
+ * Returns the number of messages that were too large for a buffer or were
+ * logged while too many full buffers were waiting to be written.
+ *
+ * @return The number of dropped messages
+ */
+[[nodiscard]] std::uint64_t droppedCount() noexcept;
+
+namespace Detail {
+
+template <typename T>
+inline constexpr bool unsupported_argument = false;
+
+/**
+ * Describes how an argument type is stored in a binary log.
+ *
+ * @tparam T The decayed argument type
+ */
+template <typename T, typename Enable = void>
+struct Argument {
+    static_assert(unsupported_argument<T>,
+                  "The argument type cannot be written to a binary log.");
+};
+
+template <>
+struct Argument<bool> {
+    static constexpr ArgumentType type = ArgumentType::Bool;
+
+    static std::size_t size(bool /*value*/) noexcept { return 1; }
+
+    static std::byte* encode(std::byte* out, bool value) noexcept {
+        *out = static_cast<std::byte>(value);
+
+        return out + 1;
+    }
+};
+
+template <>
+struct Argument<char> {
+    static constexpr ArgumentType type = ArgumentType::Char;
+
+    static std::size_t size(char /*value*/) noexcept { return 1; }
+
+    static std::byte* encode(std::byte* out, char value) noexcept {
+        *out = static_cast<std::byte>(value);
+
+        return out + 1;
+    }
+};
+
+template <typename T>
+struct Argument<T, std::enable_if_t<std::is_integral_v<T> &&
+                                    !std::is_same_v<T, bool> &&
+                                    !std::is_same_v<T, char>>> {
+    using stored_type = std::conditional_t<std::is_signed_v<T>, i64, u64>;
+
+    static constexpr ArgumentType type =
+        std::is_signed_v<T> ? ArgumentType::Int : ArgumentType::UInt;
+
+    static std::size_t size(T /*value*/) noexcept {
+        return sizeof(stored_type);
+    }
+
+    static std::byte* encode(std::byte* out, T value) noexcept {
+        auto const stored = static_cast<stored_type>(value);
+        std::memcpy(out, &stored, sizeof(stored));
+
+        return out + sizeof(stored);
+    }
+};
+
+template <typename T>
+struct Argument<T, std::enable_if_t<std::is_enum_v<T>>>
+    : Argument<std::underlying_type_t<T>> {
+    using underlying_type = std::underlying_type_t<T>;
+
+    static std::size_t size(T value) noexcept {
+        return Argument<underlying_type>::size(
+            static_cast<underlying_type>(value));
+    }
+
+    static std::byte* encode(std::byte* out, T value) noexcept {
+        return Argument<underlying_type>::encode(
+            out, static_cast<underlying_type>(value));
+    }
+};
+
+template <typename T>
+struct Argument<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    using stored_type = std::conditional_t<std::is_same_v<T, f32>, f32, f64>;
+
+    static constexpr ArgumentType type = std::is_same_v<T, f32>
+                                             ? ArgumentType::F32
+                                             : ArgumentType::F64;
+
+    static std::size_t size(T /*value*/) noexcept {
+        return sizeof(stored_type);
+    }
+
+    static std::byte* encode(std::byte* out, T value) noexcept {
+        auto const stored = static_cast<stored_type>(value);
+        std::memcpy(out, &stored, sizeof(stored));
+
+        return out + sizeof(stored);
+    }
+};
+
+/**
+ * Copies the given bytes.
+ *
+ * @note Short strings are copied with overlapping 16 byte moves since the
+ * inlined rep movs that compilers emit for bounded sizes has a large startup
+ * cost.
+ */
+inline void copyBytes(std::byte* out, char const* data,
+                      std::size_t size) noexcept {
+    constexpr std::size_t chunk = 16;
+
+    if (size >= chunk) {
+        for (std::size_t i = 0; i + chunk < size; i += chunk) {
+            std::memcpy(out + i, data + i, chunk);
+        }
+
+        std::memcpy(out + size - chunk, data + size - chunk, chunk);
+    } else if (size >= 8) {
+        std::memcpy(out, data, 8);
+        std::memcpy(out + size - 8, data + size - 8, 8);
+    } else if (size >= 4) {
+        std::memcpy(out, data, 4);
+        std::memcpy(out + size - 4, data + size - 4, 4);
+    } else {
+        for (std::size_t i = 0; i < size; ++i) {
+            out[i] = static_cast<std::byte>(data[i]);
+        }
+    }
+}
+
+template <>
+struct Argument<std::string_view> {
+    static constexpr ArgumentType type = ArgumentType::String;
+
+    static std::size_t size(std::string_view value) noexcept {
+        return sizeof(u16) + std::min(value.size(), max_string_size);
+    }
+
+    static std::byte* encode(std::byte* out, std::string_view value) noexcept {
+        auto const length =
+            static_cast<u16>(std::min(value.size(), max_string_size));
+
+        std::memcpy(out, &length, sizeof(length));
+        copyBytes(out + sizeof(length), value.data(), length);
+
+        return out + sizeof(length) + length;
+    }
+};
+
+template <>
+struct Argument<std::string> : Argument<std::string_view> {};
+
+template <>
+struct Argument<char const*> : Argument<std::string_view> {};
+
+template <>
+struct Argument<char*> : Argument<std::string_view> {};
+
+template <>
+struct Argument<Math::Vector2D> {
+    static constexpr ArgumentType type = ArgumentType::Vector2D;
+
+    static std::size_t size(Math::Vector2D const& /*value*/) noexcept {
+        return 2 * sizeof(f32);
+    }
+
+    static std::byte* encode(std::byte* out,
+                             Math::Vector2D const& value) noexcept {
+        std::array<f32, 2> const stored{value.x, value.y};
+        std::memcpy(out, stored.data(), sizeof(stored));
+
+        return out + sizeof(stored);
+    }
+};
+
+template <>
+struct Argument<Math::Vector3D> {
+    static constexpr ArgumentType type = ArgumentType::Vector3D;
+
+    static std::size_t size(Math::Vector3D const& /*value*/) noexcept {
+        return 3 * sizeof(f32);
+    }
+
+    static std::byte* encode(std::byte* out,
+                             Math::Vector3D const& value) noexcept {
+        std::array<f32, 3> const stored{value.x, value.y, value.z};
+        std::memcpy(out, stored.data(), sizeof(stored));
+
+        return out + sizeof(stored);
+    }
+};
+
+template <typename T>
+using ArgumentOf = Argument<std::decay_t<T>>;
+
+/**
+ * The argument types of a call site, stored in the site block.
+ */
+template <typename... Args>
+inline constexpr std::array<ArgumentType, sizeof...(Args)> argument_types{
+    ArgumentOf<Args>::type...};
+
+/**
+ * The events of a thread that have not been written yet.
+ */
+struct ThreadBuffer {
+    std::size_t size = 0;
+    std::array<std::byte, buffer_size> data;
+};
+
+/**
+ * The buffer of the calling thread or nullptr before its first message.
+ */
+inline thread_local ThreadBuffer* thread_buffer = nullptr;
+
+/**
+ * Assigns an id to the given call site and writes its description.
+ *
+ * @note A site that cannot be registered because memory ran out counts as a
+ * dropped event and stays unregistered.
+ *
+ * @return The id of the call site or 0 if it could not be registered
+ */
+u32 registerSite(Site& site, std::string_view format, ArgumentType const* types,
+                 std::size_t count) noexcept;
+
+/**
+ * Makes room for an event of the given size in the buffer of the calling
+ * thread, handing a full buffer to the writer thread if needed.
+ *
+ * @return The buffer or nullptr if the event cannot be logged
+ */
+ThreadBuffer* reserve(std::size_t size) noexcept;
+
+/**
+ * Returns the current timestamp in ticks.
+ */
+inline u64 ticks() noexcept { return Tsc::now(); }
+
+}  // namespace Detail
+
+/**
+ * Logs a message from the given call site.
+ *
+ * @note Use the ZEUS_BINARY_*_LOG macros instead of calling this directly.
+ *
+ * @tparam Args The argument types
+ *
+ * @param site      The call site, registered on first use
+ * @param format    The format string of the call site
+ * @param args      The arguments substituted into the format string
+ */
+template <typename... Args>
+void write(Site& site, std::string_view format, Args const&... args) noexcept {
+    u32 id = site.id.load(std::memory_order_acquire);
+
+    if (id == 0) {
+        id = Detail::registerSite(site, format,
+                                  Detail::argument_types<Args...>.data(),
+                                  sizeof...(Args));
+
+        if (id == 0) {
+            return;
+        }
+    }
+
+    std::size_t const size =
+        (event_header_size + ... + Detail::ArgumentOf<Args>::size(args));
+
+    Detail::ThreadBuffer* buffer = Detail::thread_buffer;
+
+    if (buffer == nullptr || buffer->size + size > buffer_size) {
+        buffer = Detail::reserve(size);
+
+        if (buffer == nullptr) {
+            return;
+        }
+    }
+
+    std::byte* out = buffer->data.data() + buffer->size;
+    u64 const ticks = Detail::ticks();
+
+    std::memcpy(out, &id, sizeof(id));
+    std::memcpy(out + sizeof(id), &ticks, sizeof(ticks));
+    out += event_header_size;
+
+    ((out = Detail::ArgumentOf<Args>::encode(out, args)), ...);
+
+    buffer->size += size;
+}
+
+}  // namespace BinaryLog
+
+}  // namespace Zeus
+
+/**
+ * Logs a message in the binary format from a static call site.
+ *
+ * The logger name must be a string literal and the first variadic argument is
+ * the format string. The arguments are only evaluated when the level is
+ * enabled for the logger at runtime.
+ */
+#define ZEUS_BINARY_LOG(LEVEL, NAME, ...)                                      \
+    do {                                                                       \
+        constexpr Zeus::Log::LoggerId zeus_logger_id =                         \
+            Zeus::Log::loggerId(NAME);                                         \
+        if (Zeus::Log::isEnabled(zeus_logger_id, LEVEL)) {                     \
+            static Zeus::BinaryLog::Site zeus_binary_log_site{                 \
+                LEVEL, NAME, __FILE__, __LINE__};                              \
+            Zeus::BinaryLog::write(zeus_binary_log_site, __VA_ARGS__);         \
+        }                                                                      \
+    } while (false)
+
+// Check if logging is turned on
+#ifdef ZEUS_ENABLE_LOGGING
+
+#ifndef ZEUS_LOGGING_LEVEL
+// Set to lowest log level (accepts all logs)
+#define ZEUS_LOGGING_LEVEL 0
+#endif
+
+#if ZEUS_LOGGING_LEVEL <= 4
+#define ZEUS_BINARY_ERROR_LOG(NAME, ...) \
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Error, NAME, __VA_ARGS__)
+#else
+#define ZEUS_BINARY_ERROR_LOG(...)
+#endif
+
+#if ZEUS_LOGGING_LEVEL <= 3
+#define ZEUS_BINARY_WARNING_LOG(NAME, ...) \
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Warning, NAME, __VA_ARGS__)
+#else
+#define ZEUS_BINARY_WARNING_LOG(...)
+#endif
+
+#if ZEUS_LOGGING_LEVEL <= 2
+#define ZEUS_BINARY_INFO_LOG(NAME, ...) \
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, NAME, __VA_ARGS__)
+#else
+#define ZEUS_BINARY_INFO_LOG(...)
+#endif
+
+#if ZEUS_LOGGING_LEVEL <= 1
+#define ZEUS_BINARY_CONFIG_LOG(NAME, ...) \
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Config, NAME, __VA_ARGS__)
+#else
+#define ZEUS_BINARY_CONFIG_LOG(...)
+#endif
+
+#if ZEUS_LOGGING_LEVEL <= 0
+#define ZEUS_BINARY_DEBUG_LOG(NAME, ...) \
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Debug, NAME, __VA_ARGS__)
+#else
+#define ZEUS_BINARY_DEBUG_LOG(...)
+#endif
+
+#else
+#define ZEUS_BINARY_ERROR_LOG(...)
+#define ZEUS_BINARY_WARNING_LOG(...)
+#define ZEUS_BINARY_INFO_LOG(...)
+#define ZEUS_BINARY_CONFIG_LOG(...)
+#define ZEUS_BINARY_DEBUG_LOG(...)
+#endif
@@ -0,0 +1,407 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "zeus/core/binary_log.hpp"
+#include "zeus/core/log.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file binary_log_decoder.hpp
+ */
+
+namespace Zeus {
+
+namespace BinaryLog {
+
+namespace Detail {
+
+/**
+ * A call site read back from a binary log stream.
+ */
+struct DecodedSite {
+    Log::Level level;
+    std::vector<ArgumentType> types;
+    std::string name;
+    std::string format;
+};
+
+/**
+ * A message waiting to be sorted by its timestamp.
+ */
+struct DecodedLine {
+    i64 ticks;
+    std::string text;
+};
+
+/**
+ * Reads values from a block of a binary log stream.
+ */
+class BlockReader {
+   public:
+    explicit BlockReader(std::string_view block) noexcept : block_{block} {}
+
+    template <typename T>
+    bool read(T& value) noexcept {
+        if (block_.size() < sizeof(T)) {
+            return false;
+        }
+
+        std::memcpy(&value, block_.data(), sizeof(T));
+        block_.remove_prefix(sizeof(T));
+
+        return true;
+    }
+
+    bool read(std::string& value, std::size_t size) {
+        if (block_.size() < size) {
+            return false;
+        }
+
+        value.assign(block_.data(), size);
+        block_.remove_prefix(size);
+
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return block_.empty(); }
+
+   private:
+    std::string_view block_;
+};
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    std::array<char, 32> digits{};
+    auto const result =
+        std::to_chars(digits.data(), digits.data() + digits.size(), value);
+
+    out.append(digits.data(), result.ptr);
+}
+
+template <std::size_t N>
+bool appendVector(std::string& out, BlockReader& reader) {
+    std::array<f32, N> values{};
+
+    if (!reader.read(values)) {
+        return false;
+    }
+
+    out += '(';
+
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i != 0) {
+            out += ", ";
+        }
+
+        appendNumber(out, values[i]);
+    }
+
+    out += ')';
+
+    return true;
+}
+
+/**
+ * Reads a single argument and appends its text to the given string.
+ *
+ * @return True if the argument was read, otherwise false
+ */
+inline bool appendArgument(std::string& out, ArgumentType type,
+                           BlockReader& reader) {
+    switch (type) {
+        case ArgumentType::Bool: {
+            u8 value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            out += (value != 0) ? "true" : "false";
+
+            return true;
+        }
+        case ArgumentType::Char: {
+            char value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            out += value;
+
+            return true;
+        }
+        case ArgumentType::Int: {
+            i64 value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            appendNumber(out, value);
+
+            return true;
+        }
+        case ArgumentType::UInt: {
+            u64 value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            appendNumber(out, value);
+
+            return true;
+        }
+        case ArgumentType::F32: {
+            f32 value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            appendNumber(out, value);
+
+            return true;
+        }
+        case ArgumentType::F64: {
+            f64 value = 0;
+
+            if (!reader.read(value)) {
+                return false;
+            }
+
+            appendNumber(out, value);
+
+            return true;
+        }
+        case ArgumentType::String: {
+            u16 size = 0;
+            std::string value;
+
+            if (!reader.read(size) || !reader.read(value, size)) {
+                return false;
+            }
+
+            out += value;
+
+            return true;
+        }
+        case ArgumentType::Vector2D:
+            return appendVector<2>(out, reader);
+        case ArgumentType::Vector3D:
+            return appendVector<3>(out, reader);
+    }
+
+    return false;
+}
+
+/**
+ * Formats the timestamp and level in the same way as the text log.
+ */
+inline void appendPrefix(std::string& out, i64 ticks, f64 ticks_per_second,
+                         Log::Level level) {
+    auto const micros = static_cast<i64>(static_cast<f64>(ticks) /
+                                         ticks_per_second * 1000000.0);
+    std::string const fraction = std::to_string(std::abs(micros % 1000000));
+
+    out += '[';
+
+    if (micros < 0) {
+        out += '-';
+    }
+
+    appendNumber(out, std::abs(micros / 1000000));
+    out += '.';
+    out.append(6 - fraction.size(), '0');
+    out += fraction;
+    out += "] [";
+    out += to_string(level);
+    out += "] [";
+}
+
+/**
+ * Decodes the events of an events block.
+ *
+ * @return True if every event was decoded, otherwise false
+ */
+inline bool decodeEvents(
+    BlockReader& reader,
+    std::unordered_map<u32, DecodedSite> const& sites, u64 start_ticks,
+    f64 ticks_per_second, std::vector<DecodedLine>& lines) {
+    while (!reader.empty()) {
+        u32 id = 0;
+        u64 ticks = 0;
+
+        if (!reader.read(id) || !reader.read(ticks)) {
+            return false;
+        }
+
+        auto const site = sites.find(id);
+
+        if (site == sites.end()) {
+            return false;
+        }
+
+        DecodedLine line{static_cast<i64>(ticks - start_ticks), {}};
+
+        appendPrefix(line.text, line.ticks, ticks_per_second,
+                     site->second.level);
+        line.text += site->second.name;
+        line.text += "] ";
+
+        std::string_view format = site->second.format;
+
+        for (ArgumentType const type : site->second.types) {
+            std::size_t const placeholder = format.find("{}");
+
+            line.text += format.substr(0, placeholder);
+            format.remove_prefix((placeholder == std::string_view::npos)
+                                     ? format.size()
+                                     : placeholder + 2);
+
+            // Arguments without a placeholder are still read to skip them
+            std::string argument;
+
+            if (!appendArgument(argument, type, reader)) {
+                return false;
+            }
+
+            if (placeholder != std::string_view::npos) {
+                line.text += argument;
+            }
+        }
+
+        line.text += format;
+        line.text += '\n';
+
+        lines.push_back(std::move(line));
+    }
+
+    return true;
+}
+
+}  // namespace Detail
+
+/**
+ * Converts a binary log stream into the text format of Zeus::Log.
+ *
+ * @note The messages of all threads are sorted by their timestamps.
+ *
+ * @param input     The binary log stream
+ * @param output    The stream to write the text to
+ *
+ * @return True if the whole stream was decoded, false if it is malformed or
+ * truncated
+ */
+inline bool decode(std::istream& input, std::ostream& output) {
+    StreamHeader stream{};
+
+    if (!input.read(reinterpret_cast<char*>(&stream), sizeof(stream)) ||
+        stream.magic != stream_magic || stream.version != stream_version ||
+        stream.ticks_per_second <= 0) {
+        return false;
+    }
+
+    std::unordered_map<u32, Detail::DecodedSite> sites;
+    std::vector<Detail::DecodedLine> lines;
+    std::string block;
+    bool complete = true;
+
+    BlockHeader header{};
+
+    while (input.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        block.resize(header.size);
+
+        if (!input.read(block.data(),
+                        static_cast<std::streamsize>(block.size()))) {
+            complete = false;
+
+            break;
+        }
+
+        Detail::BlockReader reader{block};
+
+        if (header.type == BlockType::Site) {
+            SiteHeader site_header{};
+            Detail::DecodedSite site{};
+            std::string types;
+            std::string file;
+
+            if (!reader.read(site_header) ||
+                !reader.read(types, site_header.argument_count) ||
+                !reader.read(site.name, site_header.name_size) ||
+                !reader.read(site.format, site_header.format_size) ||
+                !reader.read(file, site_header.file_size)) {
+                complete = false;
+
+                break;
+            }
+
+            site.level = static_cast<Log::Level>(site_header.level);
+
+            for (char const type : types) {
+                site.types.push_back(static_cast<ArgumentType>(type));
+            }
+
+            sites[site_header.id] = std::move(site);
+        } else if (header.type == BlockType::Events) {
+            if (!Detail::decodeEvents(reader, sites, stream.start_ticks,
+                                      stream.ticks_per_second, lines)) {
+                complete = false;
+
+                break;
+            }
+        }
+    }
+
+    // A partially read block header means the stream was cut off
+    if (input.gcount() != 0) {
+        complete = false;
+    }
+
+    std::stable_sort(lines.begin(), lines.end(),
+                     [](auto const& lhs, auto const& rhs) {
+                         return lhs.ticks < rhs.ticks;
+                     });
+
+    for (auto const& line : lines) {
+        output << line.text;
+    }
+
+    return complete;
+}
+
+}  // namespace BinaryLog
+
+}  // namespace Zeus
@@ -0,0 +1,158 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file bit.hpp
+ *
+ * Bit manipulation helpers in the spirit of C++20's <bit>.
+ */
+
+namespace Zeus {
+
+/**
+ * Returns the number of consecutive zero bits starting at the least
+ * significant bit.
+ *
+ * @param value The value to inspect
+ *
+ * @return The number of trailing zero bits, the width of the type for zero
+ */
+template <typename T>
+[[nodiscard]] ZEUS_FORCE_INLINE inline int countTrailingZeros(
+    T value) noexcept {
+    static_assert(std::is_same_v<T, u32> || std::is_same_v<T, u64>,
+                  "Only 32 and 64-bit unsigned integers are supported.");
+
+    if (value == 0) {
+        return static_cast<int>(sizeof(T) * 8);
+    }
+
+#if ZEUS_IS_GCC_OR_CLANG
+    if constexpr (std::is_same_v<T, u32>) {
+        return __builtin_ctz(value);
+    } else {
+        return __builtin_ctzll(value);
+    }
+#elif ZEUS_IS_MSVC
+    unsigned long index = 0;
+
+    if constexpr (std::is_same_v<T, u32>) {
+        _BitScanForward(&index, value);
+    } else {
+        _BitScanForward64(&index, value);
+    }
+
+    return static_cast<int>(index);
+#else
+    int count = 0;
+
+    while ((value & 1) == 0) {
+        value >>= 1;
+        ++count;
+    }
+
+    return count;
+#endif
+}
+
+/**
+ * Returns the number of consecutive zero bits starting at the most
+ * significant bit.
+ *
+ * @param value The value to inspect
+ *
+ * @return The number of leading zero bits, the width of the type for zero
+ */
+template <typename T>
+[[nodiscard]] ZEUS_FORCE_INLINE inline int countLeadingZeros(
+    T value) noexcept {
+    static_assert(std::is_same_v<T, u32> || std::is_same_v<T, u64>,
+                  "Only 32 and 64-bit unsigned integers are supported.");
+
+    constexpr int width = static_cast<int>(sizeof(T) * 8);
+
+    if (value == 0) {
+        return width;
+    }
+
+#if ZEUS_IS_GCC_OR_CLANG
+    if constexpr (std::is_same_v<T, u32>) {
+        return __builtin_clz(value);
+    } else {
+        return __builtin_clzll(value);
+    }
+#elif ZEUS_IS_MSVC
+    unsigned long index = 0;
+
+    if constexpr (std::is_same_v<T, u32>) {
+        _BitScanReverse(&index, value);
+    } else {
+        _BitScanReverse64(&index, value);
+    }
+
+    return width - 1 - static_cast<int>(index);
+#else
+    int count = 0;
+
+    while ((value & (T{1} << (width - 1))) == 0) {
+        value <<= 1;
+        ++count;
+    }
+
+    return count;
+#endif
+}
+
+/**
+ * Returns the number of bits needed to represent the given value.
+ *
+ * @param value The value to inspect
+ *
+ * @return The index of the highest set bit plus one, zero for zero
+ */
+template <typename T>
+[[nodiscard]] ZEUS_FORCE_INLINE inline int bitWidth(T value) noexcept {
+    return static_cast<int>(sizeof(T) * 8) - countLeadingZeros(value);
+}
+
+/**
+ * Checks if the given value is a power of two.
+ *
+ * @param value The value to check
+ *
+ * @return True if exactly one bit is set, otherwise false
+ */
+template <typename T>
+[[nodiscard]] constexpr bool isPowerOfTwo(T value) noexcept {
+    static_assert(std::is_unsigned_v<T>, "Only unsigned integers.");
+
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+}  // namespace Zeus
@@ -0,0 +1,231 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+#include "zeus/core/futex.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file blocking_queue.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Adds blocking push and pop operations to a bounded lock-free queue.
+ *
+ * Blocked threads sleep on a futex word that is bumped whenever the other
+ * side makes progress. The words are only touched when someone is actually
+ * waiting, so as long as the queue is neither empty nor full the adapter
+ * costs one fence per operation and makes no system calls.
+ *
+ * @note The producer and consumer rules of the underlying queue still
+ * apply, e.g. a BlockingQueue<SpscQueue<T>> must only be pushed to by one
+ * thread and popped from by one thread.
+ *
+ * @tparam Queue The queue type, either SpscQueue or MpmcQueue
+ */
+template <typename Queue>
+class BlockingQueue {
+   public:
+    using value_type = typename Queue::value_type;
+    using size_type = typename Queue::size_type;
+
+    /**
+     * Constructs an empty queue.
+     *
+     * @param capacity The number of elements the queue can hold, rounded up
+     *                 to a power of two
+     */
+    explicit BlockingQueue(size_type capacity) : queue_{capacity} {}
+
+    /**
+     * Constructs an element at the back of the queue, waiting for space if
+     * the queue is full.
+     *
+     * @param args The arguments to construct the element with
+     */
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        value_type value{std::forward<Args>(args)...};
+
+        for (;;) {
+            if (queue_.tryPush(std::move(value))) {
+                break;
+            }
+
+            u32 const seen = popped_.load(std::memory_order_relaxed);
+            push_waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool const pushed = queue_.tryPush(std::move(value));
+
+            if (!pushed) {
+                Futex::wait(popped_, seen);
+            }
+
+            push_waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+            if (pushed) {
+                break;
+            }
+        }
+
+        notify(pop_waiters_, pushed_);
+    }
+
+    /**
+     * Copies an element to the back of the queue, waiting for space if the
+     * queue is full.
+     *
+     * @param value The element to add
+     */
+    void push(value_type const& value) { emplace(value); }
+
+    /**
+     * Moves an element to the back of the queue, waiting for space if the
+     * queue is full.
+     *
+     * @param value The element to add
+     */
+    void push(value_type&& value) { emplace(std::move(value)); }
+
+    /**
+     * Removes the element at the front of the queue, waiting for one to
+     * arrive if the queue is empty.
+     *
+     * @return The element
+     */
+    [[nodiscard]] value_type pop() noexcept {
+        for (;;) {
+            if (auto value = queue_.tryPop()) {
+                notify(push_waiters_, popped_);
+                return std::move(*value);
+            }
+
+            u32 const seen = pushed_.load(std::memory_order_relaxed);
+            pop_waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto value = queue_.tryPop();
+
+            if (!value) {
+                Futex::wait(pushed_, seen);
+            }
+
+            pop_waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+            if (value) {
+                notify(push_waiters_, popped_);
+                return std::move(*value);
+            }
+        }
+    }
+
+    /**
+     * Moves an element to the back of the queue if there is space.
+     *
+     * @param value The element to add
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    [[nodiscard]] bool tryPush(value_type value) noexcept {
+        if (!queue_.tryPush(std::move(value))) {
+            return false;
+        }
+
+        notify(pop_waiters_, pushed_);
+
+        return true;
+    }
+
+    /**
+     * Removes the element at the front of the queue if there is one.
+     *
+     * @return The element or an empty optional if the queue is empty
+     */
+    [[nodiscard]] std::optional<value_type> tryPop() noexcept {
+        auto value = queue_.tryPop();
+
+        if (value) {
+            notify(push_waiters_, popped_);
+        }
+
+        return value;
+    }
+
+    /**
+     * Returns the number of elements in the queue.
+     *
+     * @return The number of elements, which may be stale by the time it is
+     * used
+     */
+    [[nodiscard]] size_type size() const noexcept { return queue_.size(); }
+
+    /**
+     * Returns whether the queue appears to be empty.
+     *
+     * @return True if the queue was empty when checked
+     */
+    [[nodiscard]] bool empty() const noexcept { return queue_.empty(); }
+
+    /**
+     * Returns the number of elements the queue can hold.
+     *
+     * @return The capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return queue_.capacity();
+    }
+
+   private:
+    /**
+     * Wakes a thread waiting for the progress that was just made.
+     *
+     * The fence pairs with the one a waiter issues after registering itself:
+     * either the waiter's second attempt sees our progress, or we see the
+     * waiter and bump the word it sleeps on.
+     */
+    static void notify(std::atomic<u32>& waiters,
+                       std::atomic<u32>& word) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            word.fetch_add(1, std::memory_order_relaxed);
+            Futex::wakeOne(word);
+        }
+    }
+
+    Queue queue_;
+
+    // Bumped by producers and waited on by blocked consumers
+    alignas(Memory::cache_line_size) std::atomic<u32> pushed_{0};
+    std::atomic<u32> pop_waiters_{0};
+
+    // Bumped by consumers and waited on by blocked producers
+    alignas(Memory::cache_line_size) std::atomic<u32> popped_{0};
+    std::atomic<u32> push_waiters_{0};
+};
+
+}  // namespace Zeus
@@ -0,0 +1,91 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <ratio>
+
+#include "zeus/core/tsc.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file clock.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A monotonic std::chrono clock driven by the time stamp counter.
+ *
+ * Reading it costs a TSC read and a multiplication instead of a system call,
+ * which matters when a frame reads the clock many times. Time points count
+ * nanoseconds since the clock was first used.
+ *
+ * @note The tick rate is calibrated against std::chrono::steady_clock once,
+ * so the clock can drift from it by the calibration error, about 0.01%.
+ */
+struct TscClock {
+    using rep = i64;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<TscClock>;
+
+    static constexpr bool is_steady = true;
+
+    /**
+     * Returns the current time.
+     *
+     * @return The time since the clock was first used
+     */
+    [[nodiscard]] static time_point now() noexcept {
+        static Epoch const epoch;
+
+        u64 const ticks = Tsc::now() - epoch.ticks;
+
+        return time_point{duration{
+            static_cast<rep>(static_cast<f64>(ticks) * epoch.nanoseconds)}};
+    }
+
+   private:
+    /**
+     * The timestamp that time points count from and the length of a tick.
+     *
+     * @note Counting from the first use keeps the tick counts small enough to
+     * convert to f64 without losing precision.
+     */
+    struct Epoch {
+        f64 nanoseconds = 1e9 / Tsc::ticksPerSecond();
+        u64 ticks = Tsc::now();
+    };
+};
+
+/**
+ * Converts a duration to seconds.
+ *
+ * @param duration The duration to convert
+ *
+ * @return The duration in seconds
+ */
+template <typename Rep, typename Period>
+[[nodiscard]] constexpr f64 toSeconds(
+    std::chrono::duration<Rep, Period> duration) noexcept {
+    return std::chrono::duration<f64>{duration}.count();
+}
+
+}  // namespace Zeus
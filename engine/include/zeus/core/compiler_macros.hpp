@@ -58,4 +58,53 @@
 #define ZEUS_FORCE_INLINE
 #endif
 
+// Keeps a function out of line
+#if ZEUS_IS_GCC_OR_CLANG
+#define ZEUS_NOINLINE __attribute__((noinline))
+#elif ZEUS_IS_MSVC
+#define ZEUS_NOINLINE __declspec(noinline)
+#else
+#define ZEUS_NOINLINE
+#endif
+
+// Marks a function as rarely called so it is placed away from hot code
+#if ZEUS_IS_GCC_OR_CLANG
+#define ZEUS_COLD __attribute__((cold))
+#else
+#define ZEUS_COLD
+#endif
+
+// Branch prediction hints
+#if ZEUS_IS_GCC_OR_CLANG
+#define ZEUS_LIKELY(x) __builtin_expect(!!(x), 1)
+#define ZEUS_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define ZEUS_LIKELY(x) (x)
+#define ZEUS_UNLIKELY(x) (x)
+#endif
+
+// Tells the processor it is in a spin-wait loop
+#if ZEUS_IS_MSVC
+#include <intrin.h>
+#if defined(_M_ARM64)
+#define ZEUS_CPU_PAUSE() __yield()
+#else
+#define ZEUS_CPU_PAUSE() _mm_pause()
+#endif
+#elif (ZEUS_IS_GCC_OR_CLANG) && (defined(__x86_64__) || defined(__i386__))
+#define ZEUS_CPU_PAUSE() __builtin_ia32_pause()
+#elif (ZEUS_IS_GCC_OR_CLANG) && defined(__aarch64__)
+#define ZEUS_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#define ZEUS_CPU_PAUSE() ((void)0)
+#endif
+
+// Whether the SSE intrinsics of <xmmintrin.h> can be used
+#if defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ZEUS_HAS_SSE 1
+#else
+#define ZEUS_HAS_SSE 0
+#endif
+
 #define ZEUS_ERROR(x) static_assert(false, x);
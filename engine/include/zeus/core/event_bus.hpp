@@ -0,0 +1,393 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/thread_index.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file event_bus.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+// The number of event types that have been given an index
+inline std::atomic<std::size_t> event_type_count{0};
+
+/**
+ * Returns a small dense index that is unique to the event type, handed out
+ * the first time the type is used with any bus.
+ *
+ * @note Two types never share an index, so it can be used to pick the queue
+ * of a type without checking the type of the queue.
+ */
+template <typename Event>
+std::size_t eventTypeIndex() noexcept {
+    static std::size_t const index =
+        event_type_count.fetch_add(1, std::memory_order_relaxed);
+
+    return index;
+}
+
+/**
+ * The events of one type, collected until the next dispatch.
+ */
+class EventQueueBase {
+   public:
+    EventQueueBase() noexcept = default;
+
+    EventQueueBase(EventQueueBase const&) = delete;
+    EventQueueBase(EventQueueBase&&) = delete;
+    EventQueueBase& operator=(EventQueueBase const&) = delete;
+    EventQueueBase& operator=(EventQueueBase&&) = delete;
+
+    virtual ~EventQueueBase() = default;
+
+    /**
+     * Hands the collected events to the subscribers and forgets them.
+     */
+    virtual void dispatch() = 0;
+
+    /**
+     * Forgets the collected events.
+     */
+    virtual void clear() noexcept = 0;
+
+    /**
+     * Returns the number of collected events.
+     */
+    [[nodiscard]] virtual std::size_t pending() const noexcept = 0;
+};
+
+/**
+ * The events of one type in one contiguous buffer per publishing thread.
+ */
+template <typename Event>
+class EventQueue final : public EventQueueBase {
+   public:
+    using Subscriber = std::function<void(Event const*, std::size_t)>;
+
+    EventQueue() noexcept = default;
+
+    EventQueue(EventQueue const&) = delete;
+    EventQueue(EventQueue&&) = delete;
+    EventQueue& operator=(EventQueue const&) = delete;
+    EventQueue& operator=(EventQueue&&) = delete;
+
+    ~EventQueue() override {
+        for (auto& slot : buffers_) {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Appends events to the buffer of the calling thread.
+     */
+    void publish(Event const* events, std::size_t count) {
+        std::size_t const thread = threadIndex();
+
+        if (ZEUS_UNLIKELY(thread == invalid_thread_index)) {
+            std::lock_guard<std::mutex> const lock{overflow_mutex_};
+            overflow_.insert(overflow_.end(), events, events + count);
+
+            return;
+        }
+
+        std::vector<Event>& buffer = bufferFor(thread);
+
+        if (count == 1) {
+            buffer.push_back(*events);
+        } else {
+            buffer.insert(buffer.end(), events, events + count);
+        }
+    }
+
+    void subscribe(Subscriber subscriber) {
+        subscribers_.push_back(std::move(subscriber));
+    }
+
+    void dispatch() override {
+        gather();
+
+        if (!merged_.empty()) {
+            for (Subscriber const& subscriber : subscribers_) {
+                subscriber(merged_.data(), merged_.size());
+            }
+        }
+
+        merged_.clear();
+    }
+
+    void clear() noexcept override {
+        forEachBuffer([](std::vector<Event>& events) { events.clear(); });
+        overflow_.clear();
+    }
+
+    [[nodiscard]] std::size_t pending() const noexcept override {
+        std::size_t count = overflow_.size();
+
+        forEachBuffer(
+            [&count](std::vector<Event>& events) { count += events.size(); });
+
+        return count;
+    }
+
+   private:
+    struct alignas(Memory::cache_line_size) ThreadBuffer {
+        std::vector<Event> events;
+    };
+
+    std::vector<Event>& bufferFor(std::size_t thread) {
+        ThreadBuffer* buffer =
+            buffers_[thread].load(std::memory_order_acquire);
+
+        if (ZEUS_UNLIKELY(buffer == nullptr)) {
+            buffer = new ThreadBuffer;
+            buffers_[thread].store(buffer, std::memory_order_release);
+
+            std::size_t used = used_.load(std::memory_order_relaxed);
+
+            while (used <= thread &&
+                   !used_.compare_exchange_weak(used, thread + 1,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+            }
+        }
+
+        return buffer->events;
+    }
+
+    template <typename Function>
+    void forEachBuffer(Function&& function) const noexcept {
+        std::size_t const used = used_.load(std::memory_order_acquire);
+
+        for (std::size_t thread = 0; thread < used; ++thread) {
+            if (ThreadBuffer* const buffer =
+                    buffers_[thread].load(std::memory_order_acquire)) {
+                function(buffer->events);
+            }
+        }
+    }
+
+    /**
+     * Moves the events of every thread into merged_, in the order of the
+     * thread indices.
+     */
+    void gather() {
+        std::vector<Event>* only = nullptr;
+        std::size_t sources = overflow_.empty() ? 0 : 1;
+
+        forEachBuffer([&only, &sources](std::vector<Event>& events) {
+            if (!events.empty()) {
+                only = &events;
+                ++sources;
+            }
+        });
+
+        // A single producer hands over its buffer, which gets the capacity
+        // of merged_ in return
+        if (sources == 1 && only != nullptr) {
+            merged_.swap(*only);
+
+            return;
+        }
+
+        forEachBuffer([this](std::vector<Event>& events) {
+            merged_.insert(merged_.end(), events.begin(), events.end());
+            events.clear();
+        });
+
+        merged_.insert(merged_.end(), overflow_.begin(), overflow_.end());
+        overflow_.clear();
+    }
+
+    std::array<std::atomic<ThreadBuffer*>, max_thread_count> buffers_{};
+
+    // One past the highest thread index with a buffer
+    std::atomic<std::size_t> used_{0};
+
+    std::mutex overflow_mutex_;
+    std::vector<Event> overflow_;
+
+    std::vector<Event> merged_;
+    std::vector<Subscriber> subscribers_;
+};
+
+}  // namespace Detail
+
+/**
+ * Collects events during a frame and hands them to their subscribers in
+ * batches, one contiguous array per event type.
+ *
+ * Publishing appends the event to a buffer of the calling thread, so any
+ * number of threads can publish at once without contention. dispatch() then
+ * concatenates the buffers of each type and calls every subscriber of the
+ * type once with all of its events. A subscriber loops over plain arrays
+ * instead of being called through a pointer per event.
+ *
+ * The bus keeps the queue of every event type in a slot indexed by
+ * Detail::eventTypeIndex(), so publishing does not hash. The buffers keep
+ * their capacity, so once they have grown to the busiest frame publishing and
+ * dispatching do not allocate.
+ *
+ * @note Subscribing and dispatching must not overlap with publishing, e.g.
+ * dispatch at the end of the frame after the jobs of the frame are done.
+ * Events published by subscribers during dispatch() are dispatched by the
+ * next dispatch().
+ */
+class EventBus {
+   public:
+    EventBus() = default;
+
+    EventBus(EventBus const&) = delete;
+    EventBus(EventBus&&) = delete;
+    EventBus& operator=(EventBus const&) = delete;
+    EventBus& operator=(EventBus&&) = delete;
+
+    ~EventBus() = default;
+
+    /**
+     * Adds a subscriber for an event type.
+     *
+     * @tparam Event The event type
+     *
+     * @param function Called as function(events, count) with a pointer to
+     *                 the events of a dispatch, in the order of the threads'
+     *                 indices and, for each thread, in the order they were
+     *                 published
+     */
+    template <typename Event, typename Function>
+    void subscribe(Function&& function) {
+        queueFor<Event>().subscribe(std::forward<Function>(function));
+    }
+
+    /**
+     * Publishes an event, does nothing if the event type has no subscribers.
+     *
+     * @param event The event to publish
+     */
+    template <typename Event>
+    void publish(Event const& event) {
+        publish(&event, 1);
+    }
+
+    /**
+     * Publishes several events of a type at once.
+     *
+     * @param events    The first event
+     * @param count     The number of events
+     */
+    template <typename Event>
+    void publish(Event const* events, std::size_t count) {
+        if (Detail::EventQueue<Event>* const queue = find<Event>()) {
+            queue->publish(events, count);
+        }
+    }
+
+    /**
+     * Returns the number of events of a type waiting to be dispatched.
+     */
+    template <typename Event>
+    [[nodiscard]] std::size_t pending() const noexcept {
+        Detail::EventQueue<Event> const* const queue = find<Event>();
+
+        return queue == nullptr ? 0 : queue->pending();
+    }
+
+    /**
+     * Hands the published events to the subscribers, one event type after
+     * the other in the order they were first subscribed to.
+     */
+    void dispatch();
+
+    /**
+     * Drops the published events without dispatching them.
+     */
+    void clear() noexcept;
+
+    /**
+     * Returns the number of event types with subscribers.
+     */
+    [[nodiscard]] std::size_t typeCount() const noexcept {
+        return queues_.size();
+    }
+
+   private:
+    template <typename Event>
+    static void checkEvent() noexcept {
+        static_assert(std::is_trivially_copyable_v<Event>,
+                      "Events are copied around as plain bytes.");
+        static_assert(!std::is_const_v<Event> && !std::is_volatile_v<Event>);
+    }
+
+    template <typename Event>
+    Detail::EventQueue<Event>* find() const noexcept {
+        checkEvent<Event>();
+
+        std::size_t const index = Detail::eventTypeIndex<Event>();
+
+        if (index >= queue_of_type_.size()) {
+            return nullptr;
+        }
+
+        // Only a queue of this type is ever stored at its index
+        return static_cast<Detail::EventQueue<Event>*>(queue_of_type_[index]);
+    }
+
+    template <typename Event>
+    Detail::EventQueue<Event>& queueFor() {
+        if (Detail::EventQueue<Event>* const queue = find<Event>()) {
+            return *queue;
+        }
+
+        std::size_t const index = Detail::eventTypeIndex<Event>();
+        auto queue = std::make_unique<Detail::EventQueue<Event>>();
+        Detail::EventQueue<Event>& result = *queue;
+
+        if (index >= queue_of_type_.size()) {
+            queue_of_type_.resize(index + 1, nullptr);
+        }
+
+        queue_of_type_[index] = queue.get();
+        queues_.push_back(std::move(queue));
+
+        return result;
+    }
+
+    std::vector<std::unique_ptr<Detail::EventQueueBase>> queues_;
+
+    // Indexed by Detail::eventTypeIndex(), null for types without subscribers
+    std::vector<Detail::EventQueueBase*> queue_of_type_;
+};
+
+}  // namespace Zeus
@@ -0,0 +1,514 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "zeus/container/fixed_string.hpp"
+
+/**
+ * @file format.hpp
+ *
+ * Text formatting that never allocates.
+ *
+ * Format strings use "{}" as the placeholder for the next argument, "{{" and
+ * "}}" write a literal brace. Output goes into a caller provided buffer or a
+ * FixedString on the stack and is truncated at its capacity.
+ *
+ * Types are made formattable by specializing Zeus::Formatter. The
+ * ZEUS_FORMAT macros check the format string against the arguments at
+ * compile time.
+ */
+
+namespace Zeus {
+
+/**
+ * Writes characters into a caller provided buffer.
+ *
+ * Writing past the capacity truncates the output and marks the buffer as
+ * truncated instead of failing.
+ */
+class FormatBuffer {
+   public:
+    /**
+     * Constructs an empty buffer over the given characters.
+     *
+     * @param data      The characters to write into
+     * @param capacity  The number of characters that can be written
+     */
+    constexpr FormatBuffer(char* data, std::size_t capacity) noexcept
+        : data_{data}, capacity_{capacity} {}
+
+    /**
+     * Appends the given characters, truncated to the capacity.
+     *
+     * @param text The characters to append
+     */
+    void append(std::string_view text) noexcept {
+        std::size_t count = text.size();
+
+        if (count > available()) {
+            count = available();
+            truncated_ = true;
+        }
+
+        std::memcpy(data_ + size_, text.data(), count);
+        size_ += count;
+    }
+
+    /**
+     * Appends the given character if there is room.
+     *
+     * @param c The character to append
+     */
+    void push_back(char c) noexcept {
+        if (size_ < capacity_) {
+            data_[size_++] = c;
+        } else {
+            truncated_ = true;
+        }
+    }
+
+    /**
+     * Returns the position of the next character to write.
+     *
+     * @note Used by formatters that write directly into the buffer, followed
+     * by advance().
+     */
+    [[nodiscard]] char* cursor() noexcept {
+        return data_ + size_;
+    }
+
+    /**
+     * Commits the given number of characters written at cursor().
+     *
+     * @param count The number of characters written, at most available()
+     */
+    void advance(std::size_t count) noexcept {
+        size_ += count;
+    }
+
+    /**
+     * Marks the output as truncated.
+     */
+    void markTruncated() noexcept {
+        truncated_ = true;
+    }
+
+    [[nodiscard]] std::size_t available() const noexcept {
+        return capacity_ - size_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool truncated() const noexcept {
+        return truncated_;
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+        return std::string_view{data_, size_};
+    }
+
+   private:
+    char* data_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+    bool truncated_ = false;
+};
+
+/**
+ * Formats values of the given type.
+ *
+ * Specializations provide:
+ *
+ * static void format(FormatBuffer& out, T const& value) noexcept;
+ *
+ * @tparam T        The type to format
+ * @tparam Enable   Used to constrain partial specializations
+ */
+template <typename T, typename Enable = void>
+struct Formatter;
+
+namespace Detail {
+
+// Returned by placeholderCount() for malformed format strings
+inline constexpr std::size_t invalid_format = static_cast<std::size_t>(-1);
+
+/**
+ * Writes the given number with std::to_chars.
+ */
+template <typename T>
+void formatNumber(FormatBuffer& out, T value) noexcept {
+    auto const result =
+        std::to_chars(out.cursor(), out.cursor() + out.available(), value);
+
+    if (result.ec == std::errc{}) {
+        out.advance(static_cast<std::size_t>(result.ptr - out.cursor()));
+
+        return;
+    }
+
+    // Not enough room, keep as much as fits
+    std::array<char, 64> digits{};
+    auto const fallback =
+        std::to_chars(digits.data(), digits.data() + digits.size(), value);
+
+    out.append({digits.data(), static_cast<std::size_t>(fallback.ptr -
+                                                        digits.data())});
+}
+
+template <typename T>
+inline constexpr bool is_character_v =
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+    std::is_same_v<T, unsigned char>;
+
+/**
+ * A type erased argument, keeps the parsing loop out of the templates.
+ */
+struct FormatArgument {
+    void const* value;
+    void (*format)(FormatBuffer&, void const*) noexcept;
+};
+
+template <typename T>
+using FormatterFor =
+    std::conditional_t<std::is_array_v<T>, std::remove_extent_t<T> const*, T>;
+
+/**
+ * Writes the format string, replacing every placeholder with the next
+ * argument.
+ *
+ * @note Placeholders without an argument are written as they are, arguments
+ * without a placeholder are ignored.
+ */
+inline void formatArguments(FormatBuffer& out, std::string_view format,
+                            FormatArgument const* arguments,
+                            std::size_t count) noexcept {
+    std::size_t next = 0;
+    std::size_t position = 0;
+
+    while (position < format.size()) {
+        std::size_t const brace = format.find_first_of("{}", position);
+
+        if (brace == std::string_view::npos) {
+            out.append(format.substr(position));
+
+            return;
+        }
+
+        out.append(format.substr(position, brace - position));
+
+        char const c = format[brace];
+        bool const doubled =
+            brace + 1 < format.size() && format[brace + 1] == c;
+
+        if (c == '{' && !doubled && brace + 1 < format.size() &&
+            format[brace + 1] == '}' && next < count) {
+            arguments[next].format(out, arguments[next].value);
+            ++next;
+            position = brace + 2;
+        } else {
+            out.push_back(c);
+            position = brace + (doubled ? 2 : 1);
+        }
+    }
+}
+
+/**
+ * Counts the placeholders in the given format string.
+ *
+ * @return The number of placeholders or invalid_format if a brace is not
+ * escaped or closed
+ */
+constexpr std::size_t placeholderCount(std::string_view format) noexcept {
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        char const c = format[i];
+        char const next = (i + 1 < format.size()) ? format[i + 1] : '\0';
+
+        if (c == '{' && next == '}') {
+            ++count;
+            ++i;
+        } else if ((c == '{' || c == '}') && next == c) {
+            ++i;
+        } else if (c == '{' || c == '}') {
+            return invalid_format;
+        }
+    }
+
+    return count;
+}
+
+template <typename T, typename = void>
+struct IsFormattable : std::false_type {};
+
+template <typename T>
+struct IsFormattable<
+    T, std::void_t<decltype(Formatter<FormatterFor<T>>::format(
+           std::declval<FormatBuffer&>(),
+           std::declval<FormatterFor<T> const&>()))>> : std::true_type {};
+
+}  // namespace Detail
+
+/**
+ * Checks if the given type has a Formatter.
+ */
+template <typename T>
+inline constexpr bool is_formattable_v = Detail::IsFormattable<T>::value;
+
+/**
+ * Writes a single value.
+ *
+ * @param out   The buffer to write to
+ * @param value The value to write
+ */
+template <typename T>
+void formatValue(FormatBuffer& out, T const& value) noexcept {
+    static_assert(is_formattable_v<T>, "Type has no Zeus::Formatter.");
+
+    Formatter<Detail::FormatterFor<T>>::format(out, value);
+}
+
+namespace Detail {
+
+template <typename T>
+void formatErased(FormatBuffer& out, void const* value) noexcept {
+    formatValue(out, *static_cast<T const*>(value));
+}
+
+template <typename T>
+FormatArgument makeArgument(T const& value) noexcept {
+    return {&value, &formatErased<T>};
+}
+
+}  // namespace Detail
+
+/**
+ * Writes the format string into the given buffer, replacing every "{}" with
+ * the next argument.
+ *
+ * @param out       The buffer to write to
+ * @param format    The format string
+ * @param args      The arguments to write
+ */
+template <typename... Args>
+void formatTo(FormatBuffer& out, std::string_view format,
+              Args const&... args) noexcept {
+    static_assert((is_formattable_v<Args> && ...),
+                  "Type has no Zeus::Formatter.");
+
+    std::array<Detail::FormatArgument, sizeof...(Args)> const arguments{
+        Detail::makeArgument(args)...};
+
+    Detail::formatArguments(out, format, arguments.data(), arguments.size());
+}
+
+/**
+ * Appends the formatted text to the given string.
+ *
+ * @param out       The string to append to
+ * @param format    The format string
+ * @param args      The arguments to write
+ */
+template <std::size_t N, typename... Args>
+void formatTo(FixedString<N>& out, std::string_view format,
+              Args const&... args) noexcept {
+    std::size_t const size = out.size();
+
+    out.resize_and_overwrite(N, [&](char* data, std::size_t count) {
+        FormatBuffer buffer{data + size, count - size};
+        formatTo(buffer, format, args...);
+
+        return size + buffer.size();
+    });
+}
+
+/**
+ * Formats the arguments into a string on the stack.
+ *
+ * @tparam N The capacity of the string, the output is truncated to it
+ *
+ * @param format    The format string
+ * @param args      The arguments to write
+ *
+ * @return The formatted string
+ */
+template <std::size_t N, typename... Args>
+[[nodiscard]] FixedString<N> format(std::string_view format,
+                                    Args const&... args) noexcept {
+    FixedString<N> out;
+    formatTo(out, format, args...);
+
+    return out;
+}
+
+namespace Detail {
+
+template <std::size_t Placeholders>
+struct CheckedFormat {
+    template <std::size_t N, typename... Args>
+    static FixedString<N> format(std::string_view format,
+                                 Args const&... args) noexcept {
+        check<Args...>();
+
+        return Zeus::format<N>(format, args...);
+    }
+
+    template <typename Out, typename... Args>
+    static void formatTo(Out& out, std::string_view format,
+                         Args const&... args) noexcept {
+        check<Args...>();
+
+        Zeus::formatTo(out, format, args...);
+    }
+
+    template <typename... Args>
+    static constexpr void check() noexcept {
+        static_assert(Placeholders != invalid_format,
+                      "Unmatched brace in format string, use {{ or }}.");
+        static_assert(Placeholders == invalid_format ||
+                          Placeholders == sizeof...(Args),
+                      "Format string placeholders do not match the number "
+                      "of arguments.");
+    }
+};
+
+}  // namespace Detail
+
+}  // namespace Zeus
+
+#define ZEUS_DETAIL_FORMAT_STRING(FORMAT, ...) FORMAT
+
+/**
+ * Formats into a FixedString of the given capacity, checking the format
+ * string at compile time.
+ *
+ * ZEUS_FORMAT(CAPACITY, FORMAT, ARGS...)
+ *
+ * @note The format string must be a string literal.
+ */
+#define ZEUS_FORMAT(CAPACITY, ...)                                \
+    Zeus::Detail::CheckedFormat<Zeus::Detail::placeholderCount(  \
+        ZEUS_DETAIL_FORMAT_STRING(__VA_ARGS__, ))>::format<CAPACITY>( \
+        __VA_ARGS__)
+
+/**
+ * Formats into a FormatBuffer or appends to a FixedString, checking the
+ * format string at compile time.
+ *
+ * ZEUS_FORMAT_TO(OUT, FORMAT, ARGS...)
+ *
+ * @note The format string must be a string literal.
+ */
+#define ZEUS_FORMAT_TO(OUT, ...)                                 \
+    Zeus::Detail::CheckedFormat<Zeus::Detail::placeholderCount( \
+        ZEUS_DETAIL_FORMAT_STRING(__VA_ARGS__, ))>::formatTo(OUT, __VA_ARGS__)
+
+namespace Zeus {
+
+template <>
+struct Formatter<bool> {
+    static void format(FormatBuffer& out, bool value) noexcept {
+        out.append(value ? "true" : "false");
+    }
+};
+
+template <typename T>
+struct Formatter<T, std::enable_if_t<Detail::is_character_v<T>>> {
+    static void format(FormatBuffer& out, T value) noexcept {
+        out.push_back(static_cast<char>(value));
+    }
+};
+
+template <typename T>
+struct Formatter<T, std::enable_if_t<std::is_integral_v<T> &&
+                                     !std::is_same_v<T, bool> &&
+                                     !Detail::is_character_v<T>>> {
+    static void format(FormatBuffer& out, T value) noexcept {
+        Detail::formatNumber(out, value);
+    }
+};
+
+/**
+ * Writes the shortest representation that reads back to the same value.
+ */
+template <typename T>
+struct Formatter<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static void format(FormatBuffer& out, T value) noexcept {
+        Detail::formatNumber(out, value);
+    }
+};
+
+template <typename T>
+struct Formatter<T, std::enable_if_t<
+                        std::is_convertible_v<T const&, std::string_view> &&
+                        !std::is_pointer_v<T>>> {
+    static void format(FormatBuffer& out, T const& value) noexcept {
+        out.append(std::string_view{value});
+    }
+};
+
+template <>
+struct Formatter<char const*> {
+    static void format(FormatBuffer& out, char const* value) noexcept {
+        out.append((value != nullptr) ? std::string_view{value} : "(null)");
+    }
+};
+
+template <>
+struct Formatter<char*> : Formatter<char const*> {};
+
+/**
+ * Writes the address in hexadecimal.
+ */
+template <typename T>
+struct Formatter<T*, std::enable_if_t<!Detail::is_character_v<
+                         std::remove_cv_t<T>>>> {
+    static void format(FormatBuffer& out, T const* value) noexcept {
+        std::array<char, 2 + sizeof(std::uintptr_t) * 2> digits{'0', 'x'};
+        auto const result =
+            std::to_chars(digits.data() + 2, digits.data() + digits.size(),
+                          reinterpret_cast<std::uintptr_t>(value), 16);
+
+        out.append({digits.data(), static_cast<std::size_t>(result.ptr -
+                                                            digits.data())});
+    }
+};
+
+template <>
+struct Formatter<std::nullptr_t> {
+    static void format(FormatBuffer& out, std::nullptr_t) noexcept {
+        out.append("nullptr");
+    }
+};
+
+}  // namespace Zeus
@@ -0,0 +1,67 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "zeus/core/clock.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file frame_limiter.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Waits until a deadline with sub-millisecond precision without spinning
+ * for the whole wait.
+ *
+ * Sleeping alone wakes up late by up to a scheduler tick, and spinning alone
+ * keeps a core busy. The limiter sleeps in 1 ms steps while more time is
+ * left than a sleep is expected to take and spins for the rest. The expected
+ * length of a sleep is learned from the sleeps themselves as their mean plus
+ * one standard deviation.
+ */
+class FrameLimiter {
+   public:
+    /**
+     * Blocks the calling thread until the given time.
+     *
+     * @param deadline The time to wait for, returns at once if it has passed
+     */
+    void waitUntil(TscClock::time_point deadline) noexcept;
+
+    /**
+     * Returns how long a 1 ms sleep is currently expected to take.
+     *
+     * @return The expected sleep time in nanoseconds
+     */
+    [[nodiscard]] f64 expectedSleep() const noexcept { return estimate_; }
+
+   private:
+    void learn(f64 sleep) noexcept;
+
+    // Welford's running mean and variance of the observed sleeps, in
+    // nanoseconds
+    f64 estimate_ = 2e6;
+    f64 mean_ = 2e6;
+    f64 m2_ = 0.0;
+    u64 samples_ = 1;
+};
+
+}  // namespace Zeus
@@ -0,0 +1,124 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <thread>
+
+#include "zeus/core/types.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file futex.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Waits on and wakes threads through the address of a 32-bit atomic, without
+ * a mutex or condition variable.
+ *
+ * The usual pattern is to read the word, check the condition and then wait
+ * with the value that was read. The wait returns immediately if the word no
+ * longer holds that value, so a wake between the check and the wait is never
+ * lost.
+ *
+ * @note Uses futex on Linux and WaitOnAddress on Windows. Other systems fall
+ * back to yielding until the word changes.
+ *
+ * @note Waits may return spuriously, always recheck the condition.
+ */
+namespace Futex {
+
+static_assert(sizeof(std::atomic<u32>) == sizeof(u32) &&
+                  std::atomic<u32>::is_always_lock_free,
+              "Futex words must be plain 32-bit integers.");
+
+#if defined(_WIN32)
+namespace Detail {
+
+/**
+ * The WaitOnAddress and WakeByAddress calls behind wait(), wakeOne() and
+ * wakeAll().
+ *
+ * @note Defined in futex.cpp so windows.h stays out of this header.
+ */
+void waitWindows(std::atomic<u32>& word, u32 expected) noexcept;
+void wakeOneWindows(std::atomic<u32>& word) noexcept;
+void wakeAllWindows(std::atomic<u32>& word) noexcept;
+
+}  // namespace Detail
+#endif
+
+/**
+ * Blocks the calling thread while the word holds the expected value.
+ *
+ * @param word      The word to wait on
+ * @param expected  The value the word was last seen to hold
+ */
+inline void wait(std::atomic<u32>& word, u32 expected) noexcept {
+#if defined(_WIN32)
+    Detail::waitWindows(word, expected);
+#elif defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+#else
+    while (word.load(std::memory_order_relaxed) == expected) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+/**
+ * Wakes one thread waiting on the word.
+ *
+ * @param word The word to wake a waiter of
+ */
+inline void wakeOne([[maybe_unused]] std::atomic<u32>& word) noexcept {
+#if defined(_WIN32)
+    Detail::wakeOneWindows(word);
+#elif defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE, 1,
+            nullptr, nullptr, 0);
+#endif
+}
+
+/**
+ * Wakes every thread waiting on the word.
+ *
+ * @param word The word to wake the waiters of
+ */
+inline void wakeAll([[maybe_unused]] std::atomic<u32>& word) noexcept {
+#if defined(_WIN32)
+    Detail::wakeAllWindows(word);
+#elif defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+}  // namespace Futex
+
+}  // namespace Zeus
@@ -0,0 +1,188 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "zeus/core/clock.hpp"
+#include "zeus/core/frame_limiter.hpp"
+#include "zeus/core/histogram.hpp"
+#include "zeus/core/metrics.hpp"
+#include "zeus/core/profiler.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file game_loop.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Runs a fixed timestep simulation and renders as often as the frame limit
+ * allows.
+ *
+ * Every frame adds the real time since the previous frame to an accumulator
+ * and runs as many fixed simulation steps as fit into it, so the simulation
+ * behaves the same at any frame rate. Rendering gets the fraction of a step
+ * left in the accumulator to interpolate between the last two simulation
+ * states. Frame times are recorded into a histogram and their p50, p99 and
+ * maximum are logged periodically and when the loop ends. They are also
+ * recorded into the loop.frame_time_ns metric and frames and steps are
+ * counted by the loop.frames and loop.updates metrics.
+ */
+class GameLoop {
+   public:
+    struct Settings {
+        // Fixed simulation steps per second
+        f64 update_rate = 60.0;
+
+        // Frames per second to limit rendering to, 0 for no limit
+        f64 frame_rate_limit = 0.0;
+
+        // The number of frames to run, 0 to run until stop() is called
+        u64 frame_count = 0;
+
+        // Bounds the steps of a single frame so that a slow frame cannot
+        // make the next frame even slower, time above it is dropped
+        u32 max_updates_per_frame = 5;
+
+        // Seconds between frame time reports, 0 to only report at the end
+        f64 report_interval = 1.0;
+
+        // Run exactly one simulation step per frame instead of following
+        // real time, so that a run does the same work on any machine, e.g.
+        // for benchmarking
+        bool headless = false;
+    };
+
+    /**
+     * Constructs a loop that has not run yet.
+     *
+     * @param settings How to run the loop
+     */
+    explicit GameLoop(Settings const& settings) noexcept;
+
+    /**
+     * Runs frames until the frame count is reached or stop() is called.
+     *
+     * @param update Called with the fixed step in seconds for every
+     *               simulation step
+     * @param render Called once per frame with the interpolation factor
+     *               between the previous and the current simulation state,
+     *               from 0 to 1
+     */
+    template <typename Update, typename Render>
+    void run(Update&& update, Render&& render) {
+        begin();
+
+        while (!isDone()) {
+            ZEUS_PROFILE_FRAME();
+
+            u32 const updates = beginFrame();
+
+            for (u32 i = 0; i < updates; ++i) {
+                ZEUS_PROFILE_SCOPE("Update");
+                update(step_seconds_);
+            }
+
+            {
+                ZEUS_PROFILE_SCOPE("Render");
+                render(interpolation());
+            }
+
+            endFrame();
+        }
+
+        end();
+    }
+
+    /**
+     * Makes the loop return after the current frame.
+     *
+     * @note Safe to call from other threads and signal handlers.
+     */
+    void stop() noexcept { stop_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Returns the number of frames run so far.
+     */
+    [[nodiscard]] u64 frameCount() const noexcept { return frames_; }
+
+    /**
+     * Returns the number of simulation steps run so far.
+     */
+    [[nodiscard]] u64 updateCount() const noexcept { return updates_; }
+
+    /**
+     * Returns the time between the starts of consecutive frames in
+     * nanoseconds, over the whole run.
+     */
+    [[nodiscard]] Histogram const& frameTimes() const noexcept {
+        return frame_times_;
+    }
+
+    /**
+     * Logs the frame rate and the p50, p99 and maximum frame time of the
+     * given frame times.
+     *
+     * @param label         Names the period the frame times cover
+     * @param frame_times   The frame times in nanoseconds
+     */
+    static void report(char const* label, Histogram const& frame_times);
+
+   private:
+    using Clock = TscClock;
+
+    void begin() noexcept;
+    [[nodiscard]] bool isDone() const noexcept;
+    [[nodiscard]] u32 beginFrame() noexcept;
+    void endFrame();
+    void end();
+
+    [[nodiscard]] f64 interpolation() const noexcept {
+        return static_cast<f64>(accumulator_.count()) /
+               static_cast<f64>(step_.count());
+    }
+
+    Settings settings_;
+    Clock::duration step_;
+    Clock::duration frame_period_;
+    Clock::duration report_period_;
+    f64 step_seconds_;
+
+    Clock::time_point frame_start_;
+    Clock::time_point next_frame_;
+    Clock::time_point next_report_;
+    Clock::duration accumulator_{0};
+
+    u64 frames_ = 0;
+    u64 updates_ = 0;
+    std::atomic<bool> stop_{false};
+
+    FrameLimiter limiter_;
+    Histogram frame_times_;
+    Histogram report_times_;
+
+    Metrics::Histogram frame_time_metric_{"loop.frame_time_ns"};
+    Metrics::Counter frame_metric_{"loop.frames"};
+    Metrics::Counter update_metric_{"loop.updates"};
+};
+
+}  // namespace Zeus
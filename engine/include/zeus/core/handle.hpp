@@ -0,0 +1,217 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "zeus/core/types.hpp"
+
+/**
+ * @file handle.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A typed generational handle made of a slot index and a generation.
+ *
+ * The generation of a slot changes every time the slot is freed, so a handle
+ * to a destroyed object can be detected instead of silently aliasing the next
+ * object stored in the same slot.
+ *
+ * @note A default constructed handle is null. Live handles never use
+ * generation zero.
+ *
+ * @tparam Tag  A type that makes handles of different resources incompatible
+ * @tparam T    The underlying integer type, either u32 or u64
+ */
+template <typename Tag, typename T = u32>
+class Handle {
+   public:
+    static_assert(std::is_same_v<T, u32> || std::is_same_v<T, u64>,
+                  "Handles must be 32 or 64 bits wide.");
+
+    using tag_type = Tag;
+    using value_type = T;
+
+    /**
+     * The number of bits used to store the index.
+     *
+     * @note 32-bit handles address about a million slots and keep 12 bits of
+     * generation, 64-bit handles split their bits evenly.
+     */
+    static constexpr u32 index_bits = std::is_same_v<T, u32> ? 20 : 32;
+
+    /**
+     * The number of bits used to store the generation.
+     */
+    static constexpr u32 generation_bits = sizeof(T) * 8 - index_bits;
+
+    /**
+     * The largest index a handle can store.
+     */
+    static constexpr value_type max_index =
+        (value_type{1} << index_bits) - 1;
+
+    /**
+     * The largest generation a handle can store.
+     */
+    static constexpr value_type max_generation =
+        (value_type{1} << generation_bits) - 1;
+
+    /**
+     * Constructs a null handle.
+     */
+    constexpr Handle() noexcept = default;
+
+    /**
+     * Constructs a handle using the given index and the given generation.
+     *
+     * @param index         The slot index
+     * @param generation    The generation of the slot
+     */
+    constexpr Handle(value_type index, value_type generation) noexcept
+        : value_{static_cast<value_type>((generation << index_bits) |
+                                         (index & max_index))} {}
+
+    /**
+     * Reconstructs a handle from its raw integer representation.
+     *
+     * @param value The raw value previously returned by value()
+     *
+     * @return The handle
+     */
+    [[nodiscard]] static constexpr Handle fromValue(value_type value) noexcept {
+        Handle handle;
+        handle.value_ = value;
+
+        return handle;
+    }
+
+    /**
+     * Returns the slot index of this handle.
+     *
+     * @return The slot index
+     */
+    [[nodiscard]] constexpr value_type index() const noexcept {
+        return value_ & max_index;
+    }
+
+    /**
+     * Returns the generation of this handle.
+     *
+     * @return The generation
+     */
+    [[nodiscard]] constexpr value_type generation() const noexcept {
+        return value_ >> index_bits;
+    }
+
+    /**
+     * Returns the raw integer representation of this handle.
+     *
+     * @return The raw value
+     */
+    [[nodiscard]] constexpr value_type value() const noexcept {
+        return value_;
+    }
+
+    /**
+     * Checks if this handle is null.
+     *
+     * @return True if this handle is null, otherwise false
+     */
+    [[nodiscard]] constexpr bool isNull() const noexcept {
+        return generation() == 0;
+    }
+
+    /**
+     * Checks if this handle is not null.
+     *
+     * @return True if this handle is not null, otherwise false
+     */
+    constexpr explicit operator bool() const noexcept {
+        return !isNull();
+    }
+
+   private:
+    value_type value_ = 0;
+};
+
+/**
+ * An alias of a 64-bit generational handle.
+ */
+template <typename Tag>
+using Handle64 = Handle<Tag, u64>;
+
+/**
+ * Checks if the two given handles are equal.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are equal, otherwise false
+ */
+template <typename Tag, typename T>
+constexpr bool operator==(Handle<Tag, T> lhs, Handle<Tag, T> rhs) noexcept {
+    return lhs.value() == rhs.value();
+}
+
+/**
+ * Checks if the two given handles are not equal.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are not equal, otherwise false
+ */
+template <typename Tag, typename T>
+constexpr bool operator!=(Handle<Tag, T> lhs, Handle<Tag, T> rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+/**
+ * Orders the two given handles by their raw values.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if the left-hand side is ordered first, otherwise false
+ */
+template <typename Tag, typename T>
+constexpr bool operator<(Handle<Tag, T> lhs, Handle<Tag, T> rhs) noexcept {
+    return lhs.value() < rhs.value();
+}
+
+}  // namespace Zeus
+
+namespace std {
+
+/**
+ * Hashes handles by their raw values.
+ */
+template <typename Tag, typename T>
+struct hash<Zeus::Handle<Tag, T>> {
+    std::size_t operator()(Zeus::Handle<Tag, T> handle) const noexcept {
+        return std::hash<T>{}(handle.value());
+    }
+};
+
+}  // namespace std
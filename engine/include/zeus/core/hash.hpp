@@ -0,0 +1,124 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "zeus/core/types.hpp"
+
+/**
+ * @file hash.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Mixes the bits of the given hash so every input bit affects the high and
+ * the low bits of the result.
+ *
+ * @note Needed for hashes like std::hash<int>, which is the identity.
+ *
+ * @param hash The hash to mix
+ *
+ * @return The mixed hash
+ */
+[[nodiscard]] constexpr u64 hashMix(u64 hash) noexcept {
+    hash *= 0x9E3779B97F4A7C15U;
+
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * Combines the given seed with the hash of another value.
+ *
+ * @param seed  The hash of the previous values
+ * @param hash  The hash of the next value
+ *
+ * @return The combined hash
+ */
+[[nodiscard]] constexpr u64 hashCombine(u64 seed, u64 hash) noexcept {
+    return hashMix(seed ^ (hash + 0x9E3779B97F4A7C15U));
+}
+
+/**
+ * Returns the hash of a floating point value.
+ *
+ * @note 0.0 and -0.0 compare equal, so they hash equally too.
+ *
+ * @param value The value to hash
+ *
+ * @return The hash of the given value
+ */
+template <typename T>
+[[nodiscard]] inline u64 hashFloat(T value) noexcept {
+    static_assert(std::is_floating_point_v<T>, "Only floating point types.");
+
+    if (value == T{0}) {
+        value = T{0};
+    }
+
+    std::conditional_t<sizeof(T) == 4, u32, u64> bits = 0;
+    static_assert(sizeof(bits) == sizeof(T));
+    std::memcpy(&bits, &value, sizeof(T));
+
+    return hashMix(bits);
+}
+
+/**
+ * The default hash function of Zeus containers.
+ *
+ * Uses std::hash unless specialized. Specializations can declare
+ * is_transparent to allow lookups with other key types.
+ *
+ * @tparam T The type to hash
+ */
+template <typename T, typename Enable = void>
+struct Hash : std::hash<T> {};
+
+template <typename T>
+struct Hash<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    std::size_t operator()(T value) const noexcept {
+        return static_cast<std::size_t>(hashFloat(value));
+    }
+};
+
+/**
+ * Hashes strings and anything convertible to std::string_view alike, so
+ * std::string keys can be looked up with literals and views.
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view text) const noexcept {
+        return std::hash<std::string_view>{}(text);
+    }
+};
+
+template <>
+struct Hash<std::string> : StringHash {};
+
+template <>
+struct Hash<std::string_view> : StringHash {};
+
+}  // namespace Zeus
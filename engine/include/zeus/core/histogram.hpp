@@ -0,0 +1,261 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "zeus/core/bit.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file histogram.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A histogram of u64 values with a bounded relative error, e.g. for latencies
+ * in nanoseconds.
+ *
+ * Values below 128 get a bucket each. Above that, every power of two range is
+ * split into 64 equal buckets, so a bucket is never wider than 1/64 of the
+ * values it holds and any value from 0 to 2^64 - 1 can be recorded into a
+ * fixed table of 3776 buckets. Recording is an index computation and an
+ * increment, and histograms can be merged by adding up their buckets.
+ *
+ * @note This is the log-linear bucketing used by HdrHistogram with two
+ * significant binary digits less than its common configuration.
+ */
+class Histogram {
+   public:
+    /**
+     * Values below this get a bucket each.
+     */
+    static constexpr u64 linear_count = 128;
+
+    /**
+     * The number of buckets.
+     */
+    static constexpr std::size_t bucket_count =
+        (64 - 7) * (linear_count / 2) + linear_count;
+
+    /**
+     * Constructs an empty histogram.
+     */
+    Histogram() : buckets_(bucket_count, 0) {}
+
+    /**
+     * Adds a value to the histogram.
+     *
+     * @param value The value to add
+     * @param count How many times to add it
+     */
+    void record(u64 value, u64 count = 1) noexcept {
+        buckets_[bucketOf(value)] += count;
+        count_ += count;
+        sum_ += static_cast<f64>(value) * static_cast<f64>(count);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * Adds every value of another histogram.
+     *
+     * @param other The histogram to add
+     */
+    void merge(Histogram const& other) noexcept {
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            buckets_[bucket] += other.buckets_[bucket];
+        }
+
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /**
+     * Adds values that were counted into buckets elsewhere, e.g. by a
+     * recorder that has to use atomic buckets.
+     *
+     * @param buckets   Returns the number of values in the given bucket,
+     *                  called once for every bucket
+     * @param sum       The sum of the values
+     * @param min       The smallest value
+     * @param max       The largest value
+     */
+    template <typename Buckets>
+    void merge(Buckets&& buckets, f64 sum, u64 min, u64 max) noexcept {
+        u64 count = 0;
+
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            u64 const values = buckets(bucket);
+
+            buckets_[bucket] += values;
+            count += values;
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        count_ += count;
+        sum_ += sum;
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+    }
+
+    /**
+     * Removes every value.
+     */
+    void reset() noexcept {
+        std::fill(buckets_.begin(), buckets_.end(), 0);
+        count_ = 0;
+        sum_ = 0.0;
+        min_ = std::numeric_limits<u64>::max();
+        max_ = 0;
+    }
+
+    /**
+     * Returns the value below or at which the given percentage of the values
+     * fall.
+     *
+     * @param percentile The percentage, from 0 to 100
+     *
+     * @return The highest value of the bucket that reaches the percentile,
+     * at most max(), or 0 if the histogram is empty
+     */
+    [[nodiscard]] u64 percentile(f64 percentile) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+
+        f64 const clamped = std::clamp(percentile, 0.0, 100.0);
+        auto const rank = std::max<u64>(
+            1, static_cast<u64>(
+                   std::ceil(clamped / 100.0 * static_cast<f64>(count_))));
+
+        u64 seen = 0;
+
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            seen += buckets_[bucket];
+
+            if (seen >= rank) {
+                return std::clamp(highestOf(bucket), min_, max_);
+            }
+        }
+
+        return max_;
+    }
+
+    /**
+     * Returns the number of recorded values.
+     */
+    [[nodiscard]] u64 count() const noexcept { return count_; }
+
+    /**
+     * Returns the smallest recorded value or 0 if the histogram is empty.
+     */
+    [[nodiscard]] u64 min() const noexcept {
+        return count_ == 0 ? 0 : min_;
+    }
+
+    /**
+     * Returns the largest recorded value or 0 if the histogram is empty.
+     */
+    [[nodiscard]] u64 max() const noexcept { return max_; }
+
+    /**
+     * Returns the mean of the recorded values or 0 if the histogram is empty.
+     */
+    [[nodiscard]] f64 mean() const noexcept {
+        return count_ == 0 ? 0.0 : sum_ / static_cast<f64>(count_);
+    }
+
+    /**
+     * Returns the number of values in the given bucket.
+     */
+    [[nodiscard]] u64 bucketCount(std::size_t bucket) const noexcept {
+        return buckets_[bucket];
+    }
+
+    /**
+     * Returns the bucket the given value is counted in.
+     *
+     * @param value The value
+     *
+     * @return The index of its bucket
+     */
+    [[nodiscard]] static std::size_t bucketOf(u64 value) noexcept {
+        if (value < linear_count) {
+            return static_cast<std::size_t>(value);
+        }
+
+        // Keep the 7 most significant bits, the top one is always set
+        auto const shift = static_cast<u32>(bitWidth(value) - 7);
+
+        return static_cast<std::size_t>(shift * (linear_count / 2) +
+                                        (value >> shift));
+    }
+
+    /**
+     * Returns the smallest value counted in the given bucket.
+     *
+     * @param bucket The index of the bucket
+     *
+     * @return The lowest value of the bucket
+     */
+    [[nodiscard]] static u64 lowestOf(std::size_t bucket) noexcept {
+        if (bucket < linear_count) {
+            return bucket;
+        }
+
+        u64 const shift = bucket / (linear_count / 2) - 1;
+
+        return (bucket - shift * (linear_count / 2)) << shift;
+    }
+
+    /**
+     * Returns the largest value counted in the given bucket.
+     *
+     * @param bucket The index of the bucket
+     *
+     * @return The highest value of the bucket
+     */
+    [[nodiscard]] static u64 highestOf(std::size_t bucket) noexcept {
+        if (bucket + 1 == bucket_count) {
+            return std::numeric_limits<u64>::max();
+        }
+
+        return lowestOf(bucket + 1) - 1;
+    }
+
+   private:
+    std::vector<u64> buckets_;
+    u64 count_ = 0;
+    f64 sum_ = 0.0;
+    u64 min_ = std::numeric_limits<u64>::max();
+    u64 max_ = 0;
+};
+
+}  // namespace Zeus
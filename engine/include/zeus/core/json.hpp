@@ -0,0 +1,61 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+/**
+ * @file json.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Helpers for the JSON written by the profiler and the metrics.
+ */
+namespace Json {
+
+/**
+ * Writes text as a quoted JSON string, escaping quotes, backslashes and
+ * control characters.
+ *
+ * @param out   The stream to write to
+ * @param text  The text to write
+ */
+inline void writeString(std::ostream& out, std::string_view text) {
+    out << '"';
+
+    for (char const c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF]
+                << "0123456789abcdef"[c & 0xF];
+        } else {
+            out << c;
+        }
+    }
+
+    out << '"';
+}
+
+}  // namespace Json
+
+}  // namespace Zeus
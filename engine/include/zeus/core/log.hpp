@@ -18,20 +18,59 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
+#include "zeus/core/macro_helpers.hpp"
+
 /**
  * @file log.hpp
  */
 
 namespace Zeus {
 
+namespace Detail {
+
+/**
+ * The number of entries in the runtime level table, a power of two.
+ */
+inline constexpr std::size_t logger_level_slots = 65536;
+
+/**
+ * The lowest enabled log level of the loggers whose ids map to each entry.
+ *
+ * @note Zero initialized so every level is enabled before the first call to
+ * Log::setLevel() or Log::setDefaultLevel().
+ */
+inline std::array<std::atomic<std::uint8_t>, logger_level_slots>
+    logger_levels{};
+
+}  // namespace Detail
+
 /**
  * A simple logging system.
+ *
+ * Messages are copied into a lock-free ring buffer owned by the calling
+ * thread and written out in batches by a background writer thread, so the
+ * calling thread never waits on I/O. Pending messages are flushed when the
+ * program exits or when std::terminate is called.
  */
 class Log {
    public:
+    /**
+     * Identifies a logger by the hash of its name.
+     */
+    using LoggerId = std::uint32_t;
+
+    /**
+     * The logger name used when no name is given.
+     */
+    static constexpr std::string_view default_logger_name = "Zeus";
+
     /**
      * Log levels.
      *
@@ -45,9 +84,26 @@ class Log {
         Debug = 0
     };
 
+    /**
+     * What a thread does when its log buffer is full.
+     */
+    enum class OverflowPolicy {
+        /**
+         * Wait for the writer thread to make room.
+         */
+        Block,
+
+        /**
+         * Discard the message and count it as dropped.
+         */
+        Drop
+    };
+
     /**
      * Logs the given message using the given logger name and given log level.
      *
+     * @note The message is discarded if the level is disabled for the logger.
+     *
      * @param name      The name of the logger
      * @param message   The message to log
      * @param level     The log level of the message
@@ -148,6 +204,142 @@ class Log {
      * @param message The message to log
      */
     static void debug(std::string_view message);
+
+    /**
+     * Returns the id of the logger with the given name.
+     *
+     * @note Computed at compile time by the logging macros. The id is the
+     * 32-bit FNV-1a hash of the name.
+     *
+     * @param name The name of the logger
+     *
+     * @return The id of the logger
+     */
+    [[nodiscard]] static constexpr LoggerId loggerId(
+        std::string_view name) noexcept {
+        LoggerId hash = 2166136261U;
+
+        for (char const character : name) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 16777619U;
+        }
+
+        return hash;
+    }
+
+    /**
+     * Returns whether messages of the given level are enabled for the given
+     * logger.
+     *
+     * @note Costs a single relaxed load and a compare. Loggers whose ids map
+     * to the same table entry share the lowest level set for any of them.
+     *
+     * @param id    The id of the logger
+     * @param level The log level of the message
+     *
+     * @return True if the message should be logged, otherwise false
+     */
+    [[nodiscard]] static bool isEnabled(LoggerId id,
+                                        Log::Level level) noexcept {
+        return static_cast<std::uint8_t>(level) >=
+               Detail::logger_levels[levelSlot(id)].load(
+                   std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets the lowest log level that is logged by the given logger.
+     *
+     * @note Levels that are compiled out by ZEUS_LOGGING_LEVEL stay disabled.
+     *
+     * @throws std::bad_alloc if the level of a new logger could not be stored
+     *
+     * @param name  The name of the logger
+     * @param level The lowest enabled log level
+     */
+    static void setLevel(std::string_view name, Log::Level level);
+
+    /**
+     * Makes the given logger use the default log level again.
+     *
+     * @param name The name of the logger
+     */
+    static void resetLevel(std::string_view name);
+
+    /**
+     * Sets the lowest log level that is logged by loggers without their own
+     * log level.
+     *
+     * @note The default level is Log::Level::Debug.
+     *
+     * @param level The lowest enabled log level
+     */
+    static void setDefaultLevel(Log::Level level) noexcept;
+
+    /**
+     * Returns the entry of the runtime level table used by the given logger.
+     *
+     * @param id The id of the logger
+     *
+     * @return The index of the entry
+     */
+    [[nodiscard]] static constexpr std::size_t levelSlot(LoggerId id) noexcept {
+        return (id ^ (id >> 16U)) & (Detail::logger_level_slots - 1);
+    }
+
+    /**
+     * Sets what threads do when their log buffer is full.
+     *
+     * @note The default policy is OverflowPolicy::Block.
+     *
+     * @param policy The overflow policy
+     */
+    static void setOverflowPolicy(Log::OverflowPolicy policy) noexcept;
+
+    /**
+     * Flushes pending messages and sends every following message to the given
+     * file descriptor.
+     *
+     * @note The default file descriptor is the standard error stream. The
+     * file descriptor is not closed by the logging system.
+     *
+     * @param file_descriptor The file descriptor to write messages to
+     */
+    static void setOutput(int file_descriptor) noexcept;
+
+    /**
+     * Copies every following message into a crash log.
+     *
+     * The crash log is a memory mapped file of the given size used as a ring.
+     * Messages are copied into it by the logging thread, so the newest
+     * messages survive crashes and the process being killed. Read it with the
+     * zeus_log_ring_reader tool.
+     *
+     * @note The size is rounded up to a power of two of at least 64 KiB.
+     *
+     * @param path  The path of the file to create or truncate
+     * @param size  The size of the ring in bytes
+     *
+     * @return True if the crash log was opened, otherwise false
+     */
+    static bool openCrashLog(std::string const& path,
+                             std::size_t size) noexcept;
+
+    /**
+     * Stops copying messages into the crash log.
+     */
+    static void closeCrashLog() noexcept;
+
+    /**
+     * Writes every pending message before returning.
+     */
+    static void flush() noexcept;
+
+    /**
+     * Returns the number of messages dropped because a log buffer was full.
+     *
+     * @return The number of dropped messages
+     */
+    [[nodiscard]] static std::uint64_t droppedCount() noexcept;
 };
 
 /**
@@ -161,6 +353,27 @@ class Log {
 
 }  // namespace Zeus
 
+/**
+ * Logs a message if its level is enabled for its logger at runtime.
+ *
+ * Takes either a logger name and a message or only a message. The logger
+ * name must be a string literal so that its id is computed at compile time.
+ * The message is only evaluated when the level is enabled.
+ */
+#define ZEUS_LOG(LEVEL, ...) ZEUS_VA_SELECT(ZEUS_DETAIL_LOG, LEVEL, __VA_ARGS__)
+
+#define ZEUS_DETAIL_LOG_2(LEVEL, MESSAGE) \
+    ZEUS_DETAIL_LOG_3(LEVEL, Zeus::Log::default_logger_name, MESSAGE)
+
+#define ZEUS_DETAIL_LOG_3(LEVEL, NAME, MESSAGE)                           \
+    do {                                                                  \
+        constexpr Zeus::Log::LoggerId zeus_logger_id =                    \
+            Zeus::Log::loggerId(NAME);                                    \
+        if (Zeus::Log::isEnabled(zeus_logger_id, LEVEL)) {                \
+            Zeus::Log::msg(NAME, MESSAGE, LEVEL);                         \
+        }                                                                 \
+    } while (false)
+
 // Check if logging is turned on
 #ifdef ZEUS_ENABLE_LOGGING
 
@@ -170,31 +383,31 @@ class Log {
 #endif
 
 #if ZEUS_LOGGING_LEVEL <= 4
-#define ZEUS_ERROR_LOG(...) Zeus::Log::error(__VA_ARGS__)
+#define ZEUS_ERROR_LOG(...) ZEUS_LOG(Zeus::Log::Level::Error, __VA_ARGS__)
 #else
 #define ZEUS_ERROR_LOG(...)
 #endif
 
 #if ZEUS_LOGGING_LEVEL <= 3
-#define ZEUS_WARNING_LOG(...) Zeus::Log::warning(__VA_ARGS__)
+#define ZEUS_WARNING_LOG(...) ZEUS_LOG(Zeus::Log::Level::Warning, __VA_ARGS__)
 #else
 #define ZEUS_WARNING_LOG(...)
 #endif
 
 #if ZEUS_LOGGING_LEVEL <= 2
-#define ZEUS_INFO_LOG(...) Zeus::Log::info(__VA_ARGS__)
+#define ZEUS_INFO_LOG(...) ZEUS_LOG(Zeus::Log::Level::Info, __VA_ARGS__)
 #else
 #define ZEUS_INFO_LOG(...)
 #endif
 
 #if ZEUS_LOGGING_LEVEL <= 1
-#define ZEUS_CONFIG_LOG(...) Zeus::Log::config(__VA_ARGS__)
+#define ZEUS_CONFIG_LOG(...) ZEUS_LOG(Zeus::Log::Level::Config, __VA_ARGS__)
 #else
 #define ZEUS_CONFIG_LOG(...)
 #endif
 
 #if ZEUS_LOGGING_LEVEL <= 0
-#define ZEUS_DEBUG_LOG(...) Zeus::Log::debug(__VA_ARGS__)
+#define ZEUS_DEBUG_LOG(...) ZEUS_LOG(Zeus::Log::Level::Debug, __VA_ARGS__)
 #else
 #define ZEUS_DEBUG_LOG(...)
 #endif
@@ -0,0 +1,462 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/macro_helpers.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file log_limit.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * How often a call site that only logs its first messages reports the
+ * messages it suppressed.
+ */
+inline constexpr std::chrono::seconds log_suppression_report_interval{10};
+
+namespace Detail {
+
+/**
+ * The size of the stack buffer a message with a suppression report is
+ * formatted into. Longer messages are truncated to fit the report.
+ */
+inline constexpr std::size_t max_suppressed_log_size = 512;
+
+/**
+ * The static description of a rate limited call site, used to report
+ * suppressed messages when the call site has gone quiet.
+ */
+struct LimitedLogSite {
+    std::string_view name;
+    Log::Level level;
+    char const* file;
+    u32 line;
+};
+
+class EveryTLimiter;
+
+/**
+ * Returns the first limiter that has suppressed a message.
+ *
+ * @note Limiters are only ever added. They are trivially destructible
+ * statics, so the list stays valid while the program exits.
+ */
+inline std::atomic<EveryTLimiter*>& suppressingLimiters() noexcept {
+    static std::atomic<EveryTLimiter*> head{nullptr};
+
+    return head;
+}
+
+/**
+ * Returns the time used by the rate limited call sites in nanoseconds.
+ */
+inline i64 logLimitNow() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * Lets every Nth message of a call site through.
+ */
+class EveryNLimiter {
+   public:
+    explicit constexpr EveryNLimiter(u64 n) noexcept : n_{(n > 0) ? n : 1} {}
+
+    /**
+     * Returns whether the current message should be logged.
+     *
+     * @param suppressed Set to the number of messages suppressed since the
+     * last logged message
+     *
+     * @return True if the message should be logged, otherwise false
+     */
+    bool allow(u64& suppressed,
+               [[maybe_unused]] LimitedLogSite const* site = nullptr) noexcept {
+        u64 const count = count_.fetch_add(1, std::memory_order_relaxed);
+
+        if (count % n_ != 0) {
+            return false;
+        }
+
+        suppressed = (count == 0) ? 0 : n_ - 1;
+
+        return true;
+    }
+
+   private:
+    u64 n_;
+    std::atomic<u64> count_{0};
+};
+
+/**
+ * A token bucket holding a single token that is refilled once per interval.
+ *
+ * @note Implemented as the generic cell rate algorithm so the bucket is a
+ * single atomic timestamp.
+ */
+class EveryTLimiter {
+   public:
+    template <typename Rep, typename Period>
+    explicit constexpr EveryTLimiter(
+        std::chrono::duration<Rep, Period> interval) noexcept
+        : interval_{std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        interval)
+                        .count()} {}
+
+    /**
+     * Returns whether the current message should be logged.
+     *
+     * @param suppressed Set to the number of messages suppressed since the
+     * last logged message
+     * @param site The call site, registered for periodic reports the first
+     * time a message is suppressed. The limiter must then live until the
+     * program exits.
+     * @param now The current time from logLimitNow()
+     *
+     * @return True if the message should be logged, otherwise false
+     */
+    bool allow(u64& suppressed, LimitedLogSite const* site = nullptr,
+               i64 now = logLimitNow()) noexcept {
+        if (!take(now)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+
+            if (site != nullptr &&
+                !registered_.load(std::memory_order_relaxed) &&
+                !registered_.exchange(true, std::memory_order_relaxed)) {
+                enroll(site);
+            }
+
+            return false;
+        }
+
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    /**
+     * Takes the pending suppressed messages once the call site has been
+     * quiet for a full interval, so a burst followed by silence is still
+     * reported.
+     *
+     * @note Leaves the token alone. While the call site is active, its next
+     * logged message reports the suppressed messages instead.
+     *
+     * @param suppressed Set to the number of messages suppressed since the
+     * last logged message
+     * @param now The current time from logLimitNow()
+     *
+     * @return True if there are suppressed messages to report
+     */
+    bool takeQuietSuppressed(u64& suppressed,
+                             i64 now = logLimitNow()) noexcept {
+        // Suppressed messages all came before the token was available again,
+        // and a message after that would have taken it
+        if (suppressed_.load(std::memory_order_relaxed) == 0 ||
+            now - available_at_.load(std::memory_order_relaxed) < interval_) {
+            return false;
+        }
+
+        // A racing message that takes the token gets the count instead
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+
+        return suppressed > 0;
+    }
+
+    [[nodiscard]] LimitedLogSite const* site() const noexcept {
+        return site_;
+    }
+
+    [[nodiscard]] EveryTLimiter* next() const noexcept { return next_; }
+
+    /**
+     * Takes the token if it is available.
+     *
+     * @param now The current time from logLimitNow()
+     *
+     * @return True if the token was taken, otherwise false
+     */
+    bool take(i64 now = logLimitNow()) noexcept {
+        i64 next = available_at_.load(std::memory_order_relaxed);
+
+        // Only one of the threads racing for the token gets it
+        return now >= next &&
+               available_at_.compare_exchange_strong(
+                   next, now + interval_, std::memory_order_relaxed);
+    }
+
+   private:
+    void enroll(LimitedLogSite const* site) noexcept {
+        std::atomic<EveryTLimiter*>& head = suppressingLimiters();
+
+        site_ = site;
+        next_ = head.load(std::memory_order_relaxed);
+
+        while (!head.compare_exchange_weak(next_, this,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    i64 interval_;
+
+    // The time the token is available again
+    std::atomic<i64> available_at_{0};
+    std::atomic<u64> suppressed_{0};
+
+    // Set once the limiter is in the list of suppressing limiters
+    std::atomic<bool> registered_{false};
+    LimitedLogSite const* site_ = nullptr;
+    EveryTLimiter* next_ = nullptr;
+};
+
+/**
+ * Lets the first N messages of a call site through and then reports the
+ * suppressed messages every log_suppression_report_interval.
+ */
+class FirstNLimiter {
+   public:
+    explicit constexpr FirstNLimiter(
+        u64 n, std::chrono::nanoseconds report_interval =
+                   log_suppression_report_interval) noexcept
+        : n_{n}, report_{report_interval} {}
+
+    /**
+     * Returns whether the current message should be logged.
+     *
+     * @param suppressed Set to the number of messages suppressed since the
+     * last logged message
+     * @param site The call site, registered for periodic reports the first
+     * time a message is suppressed. The limiter must then live until the
+     * program exits.
+     * @param now The current time from logLimitNow()
+     *
+     * @return True if the message should be logged, otherwise false
+     */
+    bool allow(u64& suppressed, LimitedLogSite const* site = nullptr,
+               i64 now = logLimitNow()) noexcept {
+        // Stop counting once past the limit so the counter cannot wrap
+        if (count_.load(std::memory_order_relaxed) < n_ &&
+            count_.fetch_add(1, std::memory_order_relaxed) < n_) {
+            suppressed = 0;
+
+            // Start the report interval so the first report comes one
+            // interval after the first message
+            static_cast<void>(report_.take(now));
+
+            return true;
+        }
+
+        return report_.allow(suppressed, site, now);
+    }
+
+   private:
+    u64 n_;
+    std::atomic<u64> count_{0};
+    EveryTLimiter report_;
+};
+
+/**
+ * Appends the given text to the buffer, truncating it at the end of the
+ * buffer.
+ */
+inline char* appendLogText(char* out, char const* end,
+                           std::string_view text) noexcept {
+    std::size_t const size =
+        std::min(text.size(), static_cast<std::size_t>(end - out));
+
+    return std::copy_n(text.data(), size, out);
+}
+
+/**
+ * Formats the suppression report of the given count into the buffer.
+ */
+inline char* appendSuppressedCount(char* out, char const* end,
+                                   u64 suppressed) noexcept {
+    std::array<char, 24> count{};
+    char* const count_end =
+        std::to_chars(count.data(), count.data() + count.size(), suppressed)
+            .ptr;
+
+    out = appendLogText(out, end, "[");
+    out = appendLogText(
+        out, end,
+        std::string_view(count.data(),
+                         static_cast<std::size_t>(count_end - count.data())));
+
+    return appendLogText(out, end, " similar messages suppressed");
+}
+
+/**
+ * Logs the given message with the number of suppressed messages appended.
+ *
+ * @note Formatted into a stack buffer of max_suppressed_log_size bytes so the
+ * logging path does not allocate.
+ */
+inline void logSuppressed(std::string_view name, std::string_view message,
+                          Log::Level level, u64 suppressed) noexcept {
+    if (suppressed == 0) {
+        Log::msg(name, message, level);
+
+        return;
+    }
+
+    std::array<char, max_suppressed_log_size> buffer;
+    char const* const end = buffer.data() + buffer.size();
+
+    // Leave room for the report at the end of long messages
+    constexpr std::size_t report_size = 64;
+
+    char* out = appendLogText(buffer.data(), end - report_size, message);
+    out = appendLogText(out, end, " ");
+    out = appendSuppressedCount(out, end, suppressed);
+    out = appendLogText(out, end, "]");
+
+    Log::msg(name,
+             std::string_view(buffer.data(),
+                              static_cast<std::size_t>(out - buffer.data())),
+             level);
+}
+
+/**
+ * Reports the messages suppressed by call sites that have been quiet for a
+ * full report interval.
+ *
+ * @note Called periodically by the log writer thread.
+ *
+ * @param now The current time from logLimitNow()
+ */
+inline void reportSuppressedLogs(i64 now = logLimitNow()) noexcept {
+    for (EveryTLimiter* limiter =
+             suppressingLimiters().load(std::memory_order_acquire);
+         limiter != nullptr; limiter = limiter->next()) {
+        u64 suppressed = 0;
+
+        if (!limiter->takeQuietSuppressed(suppressed, now)) {
+            continue;
+        }
+
+        LimitedLogSite const& site = *limiter->site();
+
+        std::array<char, max_suppressed_log_size> buffer;
+        char const* const end = buffer.data() + buffer.size();
+        std::array<char, 12> line{};
+        char* const line_end =
+            std::to_chars(line.data(), line.data() + line.size(), site.line)
+                .ptr;
+
+        char* out = appendSuppressedCount(buffer.data(), end, suppressed);
+        out = appendLogText(out, end, " at ");
+        out = appendLogText(out, end, site.file);
+        out = appendLogText(out, end, ":");
+        out = appendLogText(
+            out, end,
+            std::string_view(line.data(),
+                             static_cast<std::size_t>(line_end - line.data())));
+        out = appendLogText(out, end, "]");
+
+        Log::msg(site.name,
+                 std::string_view(
+                     buffer.data(),
+                     static_cast<std::size_t>(out - buffer.data())),
+                 site.level);
+    }
+}
+
+}  // namespace Detail
+
+}  // namespace Zeus
+
+#define ZEUS_DETAIL_LIMITED_LOG(LEVEL, LIMITER, LIMIT, ...) \
+    ZEUS_VA_SELECT(ZEUS_DETAIL_LIMITED_LOG, LEVEL, LIMITER, LIMIT, __VA_ARGS__)
+
+#define ZEUS_DETAIL_LIMITED_LOG_4(LEVEL, LIMITER, LIMIT, MESSAGE) \
+    ZEUS_DETAIL_LIMITED_LOG_5(LEVEL, LIMITER, LIMIT,              \
+                              Zeus::Log::default_logger_name, MESSAGE)
+
+#define ZEUS_DETAIL_LIMITED_LOG_5(LEVEL, LIMITER, LIMIT, NAME, MESSAGE)    \
+    do {                                                                   \
+        if constexpr (static_cast<int>(LEVEL) >= ZEUS_LOGGING_LEVEL) {     \
+            constexpr Zeus::Log::LoggerId zeus_logger_id =                 \
+                Zeus::Log::loggerId(NAME);                                 \
+            if (Zeus::Log::isEnabled(zeus_logger_id, LEVEL)) {             \
+                static constexpr Zeus::Detail::LimitedLogSite              \
+                    zeus_log_site{NAME, LEVEL, __FILE__, __LINE__};        \
+                static Zeus::Detail::LIMITER zeus_log_limiter{LIMIT};      \
+                if (Zeus::u64 zeus_suppressed = 0;                         \
+                    zeus_log_limiter.allow(zeus_suppressed,                \
+                                           &zeus_log_site)) {              \
+                    Zeus::Detail::logSuppressed(NAME, MESSAGE, LEVEL,      \
+                                                zeus_suppressed);          \
+                }                                                          \
+            }                                                              \
+        }                                                                  \
+    } while (false)
+
+// Check if logging is turned on
+#ifdef ZEUS_ENABLE_LOGGING
+
+#ifndef ZEUS_LOGGING_LEVEL
+// Set to lowest log level (accepts all logs)
+#define ZEUS_LOGGING_LEVEL 0
+#endif
+
+/**
+ * Logs every Nth message of the call site.
+ *
+ * Takes the log level, N and then either a logger name and a message or only
+ * a message. Each logged message reports how many were skipped.
+ */
+#define ZEUS_LOG_EVERY_N(LEVEL, N, ...) \
+    ZEUS_DETAIL_LIMITED_LOG(LEVEL, EveryNLimiter, N, __VA_ARGS__)
+
+/**
+ * Logs the first N messages of the call site and then one message with the
+ * number of suppressed messages every log_suppression_report_interval. The
+ * log writer reports the suppressed messages of call sites that went quiet.
+ */
+#define ZEUS_LOG_FIRST_N(LEVEL, N, ...) \
+    ZEUS_DETAIL_LIMITED_LOG(LEVEL, FirstNLimiter, N, __VA_ARGS__)
+
+/**
+ * Logs at most one message of the call site per given std::chrono duration.
+ * Each logged message reports how many were suppressed, and the log writer
+ * reports the suppressed messages of call sites that went quiet.
+ */
+#define ZEUS_LOG_EVERY_T(LEVEL, DURATION, ...) \
+    ZEUS_DETAIL_LIMITED_LOG(LEVEL, EveryTLimiter, DURATION, __VA_ARGS__)
+
+#else
+#define ZEUS_LOG_EVERY_N(...)
+#define ZEUS_LOG_FIRST_N(...)
+#define ZEUS_LOG_EVERY_T(...)
+#endif
@@ -0,0 +1,282 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file log_ring.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * The file format of the crash log written by Log::openCrashLog().
+ *
+ * The file starts with a RingHeader followed by the ring itself. Messages are
+ * written into the ring by the logging threads as they are logged, so the
+ * newest messages are in the page cache even if the process is killed before
+ * the log writer thread ran. Every record stores its own position and a
+ * checksum so that records torn by a crash or overwritten by a later lap of
+ * the ring can be recognized and skipped.
+ */
+namespace LogRing {
+
+/**
+ * Starts the file.
+ */
+struct RingHeader {
+    u32 magic;
+    u16 version;
+
+    // The offset of the ring from the start of the file
+    u16 header_size;
+
+    // The size of the ring, a power of two
+    u64 capacity;
+
+    // The total number of bytes reserved in the ring so far
+    u64 cursor;
+};
+
+/**
+ * Precedes every message in the ring.
+ *
+ * @note Records are 8 byte aligned and wrap around the end of the ring.
+ */
+struct RecordHeader {
+    u32 magic;
+
+    // The size of the record including the header and padding
+    u32 size;
+
+    // The position of the record in the stream of reserved bytes
+    u64 position;
+    i64 timestamp;
+    u32 message_size;
+    u16 name_size;
+    u8 level;
+    u8 reserved;
+
+    // Covers the header with this field set to zero, the name and the message
+    u32 checksum;
+    u32 reserved2;
+};
+
+inline constexpr u32 file_magic = 0x474E525A;  // "ZRNG"
+
+inline constexpr u32 record_magic = 0x4345525A;  // "ZREC"
+
+inline constexpr u16 file_version = 1;
+
+inline constexpr std::size_t record_alignment = 8;
+
+/**
+ * The smallest ring a crash log can have.
+ */
+inline constexpr std::size_t min_capacity = std::size_t{64} * 1024;
+
+static_assert(sizeof(RingHeader) % record_alignment == 0,
+              "The ring must start aligned.");
+static_assert(sizeof(RecordHeader) % record_alignment == 0,
+              "Records must stay aligned.");
+
+namespace Detail {
+
+/**
+ * Continues a 64-bit FNV-1a hash with the given bytes.
+ *
+ * @note Eight bytes are mixed in at a time since the checksum is computed on
+ * the logging thread.
+ */
+inline u64 checksum(u64 hash, void const* data, std::size_t size) noexcept {
+    constexpr u64 prime = 1099511628211U;
+
+    auto const* bytes = static_cast<unsigned char const*>(data);
+    std::size_t i = 0;
+
+    for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+        u64 word = 0;
+        std::memcpy(&word, bytes + i, sizeof(word));
+
+        hash = (hash ^ word) * prime;
+    }
+
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * prime;
+    }
+
+    return hash;
+}
+
+inline constexpr u64 checksum_seed = 14695981039346656037U;
+
+/**
+ * Returns the checksum stored in a record.
+ */
+inline u32 recordChecksum(RecordHeader const& header, std::string_view name,
+                          std::string_view message) noexcept {
+    u64 hash = checksum(checksum_seed, &header, sizeof(header));
+    hash = checksum(hash, name.data(), name.size());
+    hash = checksum(hash, message.data(), message.size());
+
+    return static_cast<u32>(hash ^ (hash >> 32U));
+}
+
+/**
+ * Copies bytes out of the ring, wrapping around its end.
+ */
+inline void readRing(std::string_view ring, u64 position, void* out,
+                     std::size_t size) noexcept {
+    std::size_t const offset = position & (ring.size() - 1);
+    std::size_t const first = std::min(size, ring.size() - offset);
+
+    std::memcpy(out, ring.data() + offset, first);
+    std::memcpy(static_cast<char*>(out) + first, ring.data(), size - first);
+}
+
+/**
+ * Formats a record in the same way as the text log.
+ */
+inline void appendRecord(std::string& out, RecordHeader const& header,
+                         std::string_view name, std::string_view message) {
+    i64 const micros = header.timestamp / 1000;
+    std::array<char, 24> digits{};
+
+    auto append_number = [&out, &digits](i64 value) {
+        out.append(digits.data(),
+                   std::to_chars(digits.data(), digits.data() + digits.size(),
+                                 value)
+                       .ptr);
+    };
+
+    std::string fraction;
+    fraction.append(digits.data(),
+                    std::to_chars(digits.data(), digits.data() + digits.size(),
+                                  std::abs(micros % 1000000))
+                        .ptr);
+
+    out += '[';
+    append_number(micros / 1000000);
+    out += '.';
+    out.append(6 - fraction.size(), '0');
+    out += fraction;
+    out += "] [";
+    out += to_string(static_cast<Log::Level>(header.level));
+    out += "] [";
+    out += name;
+    out += "] ";
+    out += message;
+    out += '\n';
+}
+
+}  // namespace Detail
+
+/**
+ * Writes the messages that survived in the given crash log, oldest first.
+ *
+ * @param file      The contents of the crash log file
+ * @param output    The stream to write the messages to
+ *
+ * @return True if the file is a crash log, otherwise false
+ */
+inline bool decode(std::string_view file, std::ostream& output) {
+    RingHeader header{};
+
+    if (file.size() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != file_magic || header.version != file_version ||
+        header.capacity < min_capacity ||
+        (header.capacity & (header.capacity - 1)) != 0 ||
+        file.size() < header.header_size + header.capacity) {
+        return false;
+    }
+
+    std::string_view const ring =
+        file.substr(header.header_size, header.capacity);
+    u64 position =
+        (header.cursor > header.capacity) ? header.cursor - header.capacity : 0;
+    std::string text;
+    std::string payload;
+
+    // Records are found by their magic, position and checksum since the
+    // oldest record could have been partly overwritten
+    while (position + sizeof(RecordHeader) <= header.cursor) {
+        RecordHeader record{};
+        Detail::readRing(ring, position, &record, sizeof(record));
+
+        std::size_t const payload_size =
+            std::size_t{record.name_size} + record.message_size;
+
+        bool valid = record.magic == record_magic &&
+                     record.position == position &&
+                     record.size >= sizeof(RecordHeader) + payload_size &&
+                     record.size <= header.capacity &&
+                     position + record.size <= header.cursor;
+
+        std::string_view name;
+        std::string_view message;
+
+        if (valid) {
+            payload.resize(payload_size);
+            Detail::readRing(ring, position + sizeof(RecordHeader),
+                             payload.data(), payload.size());
+
+            name = std::string_view{payload}.substr(0, record.name_size);
+            message = std::string_view{payload}.substr(record.name_size);
+
+            u32 const checksum = record.checksum;
+            record.checksum = 0;
+
+            valid = Detail::recordChecksum(record, name, message) == checksum;
+        }
+
+        if (!valid) {
+            position += record_alignment;
+
+            continue;
+        }
+
+        Detail::appendRecord(text, record, name, message);
+        position += record.size;
+    }
+
+    output << text;
+
+    return true;
+}
+
+}  // namespace LogRing
+
+}  // namespace Zeus
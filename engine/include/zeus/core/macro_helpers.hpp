@@ -28,6 +28,12 @@
 // Concatenate two arguments together
 #define ZEUS_CAT(A, B) A##B
 
+// Concatenate two arguments together after expanding them
+#define ZEUS_EXPAND_CAT(A, B) ZEUS_CAT(A, B)
+
+// Creates an identifier that is unique to the line it is used on
+#define ZEUS_UNIQUE_NAME(PREFIX) ZEUS_EXPAND_CAT(PREFIX, __LINE__)
+
 // Creates NAME_NUM output
 #define ZEUS_SELECT(NAME, NUM) ZEUS_CAT(NAME##_, NUM)
 
@@ -23,9 +23,32 @@
  */
 
 #include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/handle.hpp"
 #include "zeus/core/macro_helpers.hpp"
 
 /**
  * Defines an opaque handle.
  */
 #define ZEUS_DEFINE_HANDLE(name) using name = void*
+
+/**
+ * Defines a typed 32-bit generational handle.
+ *
+ * @note A drop-in replacement for ZEUS_DEFINE_HANDLE for handles that index
+ * into a Zeus::SlotMap. Declares the tag type name##Tag in the current
+ * namespace.
+ *
+ * @see Zeus::Handle
+ */
+#define ZEUS_DEFINE_GENERATIONAL_HANDLE(name) \
+    struct ZEUS_CAT(name, Tag);               \
+    using name = Zeus::Handle<ZEUS_CAT(name, Tag)>
+
+/**
+ * Defines a typed 64-bit generational handle.
+ *
+ * @see ZEUS_DEFINE_GENERATIONAL_HANDLE
+ */
+#define ZEUS_DEFINE_GENERATIONAL_HANDLE_64(name) \
+    struct ZEUS_CAT(name, Tag);                  \
+    using name = Zeus::Handle64<ZEUS_CAT(name, Tag)>
@@ -0,0 +1,432 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "zeus/core/clock.hpp"
+#include "zeus/core/histogram.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file metrics.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Runtime metrics that are always on, unlike the profiler.
+ *
+ * Counters count events, gauges hold the current level of something and
+ * histograms keep the distribution of values such as latencies. Counters and
+ * histograms are recorded into slots owned by the calling thread with plain
+ * relaxed loads and stores, so recording never contends with other threads
+ * and costs about as much as a non-atomic increment. Reading a metric merges
+ * the slots of every thread, including the threads that have exited.
+ *
+ * A snapshot() of every metric can be written as JSON or CSV, appended to a
+ * file periodically with startDumping() or formatted as text with query(),
+ * e.g. for a debug console.
+ *
+ * @note Metrics are registered by name and live until the program exits.
+ * Constructing a metric with the name of an existing metric of the same kind
+ * refers to the existing metric.
+ */
+namespace Metrics {
+
+/**
+ * The maximum number of counters, gauges and histograms.
+ */
+inline constexpr u32 max_counters = 256;
+inline constexpr u32 max_gauges = 256;
+inline constexpr u32 max_histograms = 64;
+
+/**
+ * The id of a metric that could not be registered because its kind has
+ * reached its maximum, recording into it does nothing.
+ */
+inline constexpr u32 invalid_id = ~u32{0};
+
+/**
+ * The formats of dumped snapshots.
+ */
+enum class Format {
+    // A JSON object per line
+    Json,
+
+    // Rows of time, kind, name, statistic and value with a header
+    Csv
+};
+
+/**
+ * The value of a counter in a snapshot.
+ */
+struct CounterValue {
+    std::string name;
+    u64 value = 0;
+};
+
+/**
+ * The value of a gauge in a snapshot.
+ */
+struct GaugeValue {
+    std::string name;
+    f64 value = 0.0;
+};
+
+/**
+ * The values recorded into a histogram in a snapshot.
+ */
+struct HistogramValue {
+    std::string name;
+    Zeus::Histogram values;
+};
+
+/**
+ * The values of every metric at one point in time, each kind sorted by name.
+ */
+struct Snapshot {
+    // Milliseconds since the Unix epoch
+    i64 timestamp_ms = 0;
+
+    std::vector<CounterValue> counters;
+    std::vector<GaugeValue> gauges;
+    std::vector<HistogramValue> histograms;
+};
+
+namespace Detail {
+
+/**
+ * The values a thread recorded into a histogram.
+ *
+ * @note Only the owning thread writes, readers merge it with relaxed loads
+ * while it keeps recording. A reader can see a value in a bucket before its
+ * sum, min or max, which only skews a snapshot for values recorded during the
+ * read.
+ */
+struct ThreadHistogram {
+    std::atomic<u64> buckets[Zeus::Histogram::bucket_count] = {};
+    std::atomic<u64> sum{0};
+    std::atomic<u64> min{~u64{0}};
+    std::atomic<u64> max{0};
+};
+
+/**
+ * The counters and histograms of a thread, indexed by metric id.
+ */
+struct ThreadSlots {
+    std::atomic<u64> counters[max_counters] = {};
+
+    // Allocated on the first value recorded into the histogram
+    std::atomic<ThreadHistogram*> histograms[max_histograms] = {};
+};
+
+/**
+ * The slots of the calling thread or nullptr before its first value.
+ */
+inline thread_local ThreadSlots* thread_slots = nullptr;
+
+/**
+ * Creates and registers the slots of the calling thread.
+ *
+ * @return The slots or nullptr if they could not be allocated
+ */
+ThreadSlots* registerThread() noexcept;
+
+/**
+ * Returns the slots of the calling thread, creating them on first use.
+ */
+inline ThreadSlots* threadSlots() noexcept {
+    ThreadSlots* slots = thread_slots;
+
+    return slots != nullptr ? slots : registerThread();
+}
+
+/**
+ * Allocates the histogram with the given id in the given slots.
+ *
+ * @return The histogram or nullptr if it could not be allocated
+ */
+ThreadHistogram* addHistogram(ThreadSlots& slots, u32 id) noexcept;
+
+/**
+ * Adds to a value that only the calling thread writes.
+ */
+inline void add(std::atomic<u64>& value, u64 amount) noexcept {
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+
+}  // namespace Detail
+
+/**
+ * Counts events, e.g. allocations or dropped messages.
+ */
+class Counter {
+   public:
+    /**
+     * Registers the counter with the given name or refers to the existing
+     * one.
+     *
+     * @param name The name of the counter
+     */
+    explicit Counter(std::string_view name);
+
+    /**
+     * Adds to the counter.
+     *
+     * @param amount The number of events to count
+     */
+    void add(u64 amount = 1) noexcept {
+        if (id_ == invalid_id) {
+            return;
+        }
+
+        if (Detail::ThreadSlots* slots = Detail::threadSlots()) {
+            Detail::add(slots->counters[id_], amount);
+        }
+    }
+
+    /**
+     * Returns the sum of what every thread has added.
+     */
+    [[nodiscard]] u64 value() const;
+
+   private:
+    u32 id_;
+};
+
+/**
+ * Holds the current level of something, e.g. memory in use or the length of
+ * a queue.
+ *
+ * @note A gauge is a single shared value rather than one per thread since a
+ * level set by one thread replaces the level set by another.
+ */
+class Gauge {
+   public:
+    /**
+     * Registers the gauge with the given name or refers to the existing one.
+     *
+     * @param name The name of the gauge
+     */
+    explicit Gauge(std::string_view name);
+
+    /**
+     * Sets the level.
+     *
+     * @param value The new level
+     */
+    void set(f64 value) noexcept;
+
+    /**
+     * Adds to the level, atomically with respect to other threads.
+     *
+     * @param delta The amount to add, negative to subtract
+     */
+    void add(f64 delta) noexcept;
+
+    /**
+     * Returns the current level.
+     */
+    [[nodiscard]] f64 value() const noexcept;
+
+   private:
+    // The bits of the level or nullptr if the gauge is not registered
+    std::atomic<u64>* value_;
+};
+
+/**
+ * Keeps the distribution of values with a bounded relative error, see
+ * Zeus::Histogram.
+ */
+class Histogram {
+   public:
+    /**
+     * Registers the histogram with the given name or refers to the existing
+     * one.
+     *
+     * @param name The name of the histogram, e.g. with the unit as a suffix
+     */
+    explicit Histogram(std::string_view name);
+
+    /**
+     * Adds a value.
+     *
+     * @param value The value to add
+     */
+    void record(u64 value) noexcept {
+        if (id_ == invalid_id) {
+            return;
+        }
+
+        Detail::ThreadSlots* slots = Detail::threadSlots();
+
+        if (slots == nullptr) {
+            return;
+        }
+
+        Detail::ThreadHistogram* histogram =
+            slots->histograms[id_].load(std::memory_order_relaxed);
+
+        if (histogram == nullptr) {
+            histogram = Detail::addHistogram(*slots, id_);
+
+            if (histogram == nullptr) {
+                return;
+            }
+        }
+
+        Detail::add(histogram->buckets[Zeus::Histogram::bucketOf(value)], 1);
+        Detail::add(histogram->sum, value);
+
+        if (value < histogram->min.load(std::memory_order_relaxed)) {
+            histogram->min.store(value, std::memory_order_relaxed);
+        }
+
+        if (value > histogram->max.load(std::memory_order_relaxed)) {
+            histogram->max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Returns the values recorded by every thread.
+     */
+    [[nodiscard]] Zeus::Histogram values() const;
+
+   private:
+    u32 id_;
+};
+
+/**
+ * Records the time between its construction and destruction into a
+ * histogram in nanoseconds.
+ */
+class ScopedTimer {
+   public:
+    /**
+     * Starts timing.
+     *
+     * @param histogram The histogram to record into
+     */
+    explicit ScopedTimer(Histogram& histogram) noexcept
+        : histogram_{histogram}, start_{TscClock::now()} {}
+
+    ScopedTimer(ScopedTimer const&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    ScopedTimer& operator=(ScopedTimer const&) = delete;
+    ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+    /**
+     * Records the elapsed time.
+     */
+    ~ScopedTimer() {
+        auto const elapsed = TscClock::now() - start_;
+
+        histogram_.record(static_cast<u64>(elapsed.count()));
+    }
+
+   private:
+    Histogram& histogram_;
+    TscClock::time_point start_;
+};
+
+/**
+ * Reads every metric.
+ *
+ * @return The current values
+ */
+[[nodiscard]] Snapshot snapshot();
+
+/**
+ * Writes a snapshot as a single line of JSON.
+ *
+ * Histograms are written as their count, mean, min, p50, p90, p99, p99.9 and
+ * max.
+ *
+ * @param out       The stream to write to
+ * @param snapshot  The snapshot to write
+ */
+void writeJson(std::ostream& out, Snapshot const& snapshot);
+
+/**
+ * Writes a snapshot as CSV rows of time, kind, name, statistic and value.
+ *
+ * @param out           The stream to write to
+ * @param snapshot      The snapshot to write
+ * @param with_header   Whether to write the column names first
+ */
+void writeCsv(std::ostream& out, Snapshot const& snapshot,
+              bool with_header = true);
+
+/**
+ * Writes a snapshot as a table for reading.
+ *
+ * @param out       The stream to write to
+ * @param snapshot  The snapshot to write
+ * @param prefix    Only write the metrics whose name starts with it
+ */
+void writeText(std::ostream& out, Snapshot const& snapshot,
+               std::string_view prefix = {});
+
+/**
+ * Formats the current value of the metrics whose name starts with the given
+ * prefix as a table, e.g. for a debug console.
+ *
+ * @param prefix Selects the metrics, every metric if empty
+ *
+ * @return The table
+ */
+[[nodiscard]] std::string query(std::string_view prefix = {});
+
+/**
+ * Appends a snapshot to a file, CSV headers are only written to new files.
+ *
+ * @param path      The file to append to
+ * @param format    The format to write in
+ *
+ * @return False if the file could not be written
+ */
+bool dump(std::string const& path, Format format);
+
+/**
+ * Appends a snapshot to a file periodically from a background thread until
+ * stopDumping() is called, replacing dumping that is already running.
+ *
+ * @param path      The file to append to
+ * @param format    The format to write in
+ * @param interval  The seconds between snapshots
+ *
+ * @return False if the file could not be opened
+ */
+bool startDumping(std::string const& path, Format format, f64 interval);
+
+/**
+ * Stops periodic dumping after appending a final snapshot.
+ */
+void stopDumping();
+
+}  // namespace Metrics
+
+}  // namespace Zeus
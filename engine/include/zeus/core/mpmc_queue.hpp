@@ -0,0 +1,248 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/spsc_queue.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file mpmc_queue.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A bounded lock-free queue for any number of producer and consumer threads.
+ *
+ * Every cell carries a sequence number that says whose turn it is. A producer
+ * claims position p once the cell's sequence equals p and publishes it by
+ * setting the sequence to p + 1. A consumer claims it once the sequence
+ * equals p + 1 and hands the cell to the next lap by setting the sequence to
+ * p + capacity. Claiming a position is a single compare-and-swap on the
+ * shared enqueue or dequeue index, and producers and consumers never touch
+ * each other's index.
+ *
+ * @note This is the bounded queue described by Dmitry Vyukov.
+ *
+ * @tparam T The type of the elements
+ */
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+                      std::is_nothrow_destructible_v<T>,
+                  "Queue elements must be nothrow movable and destructible.");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * Constructs an empty queue.
+     *
+     * @param capacity The number of elements the queue can hold, rounded up
+     *                 to a power of two
+     */
+    explicit MpmcQueue(size_type capacity)
+        : mask_{Detail::queueCapacity(capacity) - 1},
+          cells_{std::make_unique<Cell[]>(mask_ + 1)} {
+        for (size_type index = 0; index <= mask_; ++index) {
+            cells_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(MpmcQueue const&) = delete;
+    MpmcQueue(MpmcQueue&&) = delete;
+    MpmcQueue& operator=(MpmcQueue const&) = delete;
+    MpmcQueue& operator=(MpmcQueue&&) = delete;
+
+    /**
+     * Destroys the elements left in the queue.
+     */
+    ~MpmcQueue() {
+        size_type const tail =
+            enqueue_position_.load(std::memory_order_relaxed);
+
+        for (size_type head =
+                 dequeue_position_.load(std::memory_order_relaxed);
+             head != tail; ++head) {
+            std::destroy_at(cells_[head & mask_].slot.get());
+        }
+    }
+
+    /**
+     * Constructs an element at the back of the queue.
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    template <typename... Args>
+    [[nodiscard]] bool tryEmplace(Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args&&...>) {
+        size_type position = enqueue_position_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells_[position & mask_];
+            size_type const sequence =
+                cell->sequence.load(std::memory_order_acquire);
+            auto const lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lag == 0) {
+                if (enqueue_position_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(cell->slot.storage))
+            T(std::forward<Args>(args)...);
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Copies an element to the back of the queue.
+     *
+     * @param value The element to add
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    [[nodiscard]] bool tryPush(T const& value) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+        return tryEmplace(value);
+    }
+
+    /**
+     * Moves an element to the back of the queue.
+     *
+     * @param value The element to add
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    [[nodiscard]] bool tryPush(T&& value) noexcept {
+        return tryEmplace(std::move(value));
+    }
+
+    /**
+     * Removes the element at the front of the queue.
+     *
+     * @return The element or an empty optional if the queue is empty
+     */
+    [[nodiscard]] std::optional<T> tryPop() noexcept {
+        size_type position = dequeue_position_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells_[position & mask_];
+            size_type const sequence =
+                cell->sequence.load(std::memory_order_acquire);
+            auto const lag =
+                static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (lag == 0) {
+                if (dequeue_position_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                return std::nullopt;
+            } else {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* const element = cell->slot.get();
+        std::optional<T> value{std::move(*element)};
+        std::destroy_at(element);
+        cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+
+        return value;
+    }
+
+    /**
+     * Returns the number of elements in the queue.
+     *
+     * @return The number of elements, which may be stale by the time it is
+     * used
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        size_type const head =
+            dequeue_position_.load(std::memory_order_acquire);
+        size_type const tail =
+            enqueue_position_.load(std::memory_order_acquire);
+
+        // Positions are claimed before the element is written or read, so
+        // the difference can briefly fall outside of [0, capacity]
+        auto const count = static_cast<std::ptrdiff_t>(tail - head);
+
+        if (count < 0) {
+            return 0;
+        }
+
+        return std::min(static_cast<size_type>(count), capacity());
+    }
+
+    /**
+     * Returns whether the queue appears to be empty.
+     *
+     * @return True if the queue was empty when checked
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * Returns the number of elements the queue can hold.
+     *
+     * @return The capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+   private:
+    struct Cell {
+        std::atomic<size_type> sequence;
+        Detail::QueueSlot<T> slot;
+    };
+
+    // Read by every thread but never written after construction
+    size_type const mask_;
+    std::unique_ptr<Cell[]> const cells_;
+
+    alignas(Memory::cache_line_size)
+        std::atomic<size_type> enqueue_position_{0};
+    alignas(Memory::cache_line_size)
+        std::atomic<size_type> dequeue_position_{0};
+};
+
+}  // namespace Zeus
@@ -0,0 +1,254 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "zeus/core/types.hpp"
+
+/**
+ * @file perf_counters.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Hardware performance counters of the calling thread.
+ *
+ * Time says that a kernel is slow, the counters say why: few instructions per
+ * cycle point at stalls, cache misses at the memory layout and branch misses
+ * at data dependent control flow.
+ *
+ * @note Uses perf_event_open on Linux. The counters are often not permitted,
+ * e.g. with kernel.perf_event_paranoid above 2 or in virtual machines that do
+ * not expose a PMU. Counters that cannot be opened are reported as
+ * unavailable and everything else keeps working, so code using them runs
+ * unchanged everywhere.
+ */
+namespace Perf {
+
+/**
+ * The hardware events counted by a CounterGroup.
+ */
+enum class Event : u8 { Cycles, Instructions, CacheMisses, BranchMisses };
+
+/**
+ * The number of events in Event.
+ */
+inline constexpr std::size_t event_count = 4;
+
+/**
+ * Returns the name of the given event.
+ *
+ * @param event The event
+ *
+ * @return The name, e.g. "cache-misses"
+ */
+[[nodiscard]] constexpr std::string_view name(Event event) noexcept {
+    constexpr std::array<std::string_view, event_count> names{
+        "cycles", "instructions", "cache-misses", "branch-misses"};
+
+    return names[static_cast<std::size_t>(event)];
+}
+
+/**
+ * The counter values of a measured region.
+ */
+struct Counts {
+    std::array<u64, event_count> values{};
+
+    // Which of the values were actually counted
+    std::array<bool, event_count> available{};
+
+    // The number of elements the region processed, used for per element
+    // ratios
+    u64 elements = 1;
+    f64 seconds = 0.0;
+
+    /**
+     * Returns whether the given event was counted.
+     */
+    [[nodiscard]] bool has(Event event) const noexcept {
+        return available[static_cast<std::size_t>(event)];
+    }
+
+    /**
+     * Returns the value of the given event, 0 if it was not counted.
+     */
+    [[nodiscard]] u64 operator[](Event event) const noexcept {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    /**
+     * Returns the instructions retired per cycle.
+     *
+     * @return The IPC or 0 if cycles or instructions were not counted
+     */
+    [[nodiscard]] f64 ipc() const noexcept {
+        if (!has(Event::Cycles) || !has(Event::Instructions) ||
+            (*this)[Event::Cycles] == 0) {
+            return 0.0;
+        }
+
+        return static_cast<f64>((*this)[Event::Instructions]) /
+               static_cast<f64>((*this)[Event::Cycles]);
+    }
+
+    /**
+     * Returns the value of the given event divided by the number of
+     * elements.
+     *
+     * @param event The event
+     *
+     * @return The value per element or 0 if the event was not counted
+     */
+    [[nodiscard]] f64 perElement(Event event) const noexcept {
+        if (!has(event) || elements == 0) {
+            return 0.0;
+        }
+
+        return static_cast<f64>((*this)[event]) / static_cast<f64>(elements);
+    }
+
+    /**
+     * Returns the elapsed nanoseconds per element.
+     */
+    [[nodiscard]] f64 nanosecondsPerElement() const noexcept {
+        return elements == 0 ? 0.0
+                             : seconds * 1e9 / static_cast<f64>(elements);
+    }
+};
+
+/**
+ * A group of hardware counters that are started and stopped together for the
+ * thread that created the group.
+ *
+ * @note The counters only count user space code. Values are scaled up if
+ * the kernel had to multiplex the counters with other users of the PMU.
+ */
+class CounterGroup {
+   public:
+    /**
+     * Opens every event that is permitted for the calling thread.
+     */
+    CounterGroup() noexcept;
+
+    CounterGroup(CounterGroup const&) = delete;
+    CounterGroup(CounterGroup&&) = delete;
+    CounterGroup& operator=(CounterGroup const&) = delete;
+    CounterGroup& operator=(CounterGroup&&) = delete;
+
+    ~CounterGroup();
+
+    /**
+     * Resets the counters to zero and starts counting.
+     */
+    void start() noexcept;
+
+    /**
+     * Stops counting and reads the counters.
+     *
+     * @param elements The number of elements processed since start()
+     *
+     * @return The counts since start()
+     */
+    Counts stop(u64 elements = 1) noexcept;
+
+    /**
+     * Returns whether the given event could be opened.
+     *
+     * @param event The event
+     *
+     * @return True if the event is counted
+     */
+    [[nodiscard]] bool isAvailable(Event event) const noexcept {
+        return descriptors_[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    /**
+     * Returns whether any event could be opened.
+     *
+     * @return True if at least one event is counted
+     */
+    [[nodiscard]] bool isAvailable() const noexcept { return leader_ >= 0; }
+
+    /**
+     * Explains why events could not be opened.
+     *
+     * @return The reason or an empty string if every event was opened
+     */
+    [[nodiscard]] char const* error() const noexcept { return error_.data(); }
+
+   private:
+    std::array<int, event_count> descriptors_{-1, -1, -1, -1};
+    std::array<u64, event_count> ids_{};
+    int leader_ = -1;
+    u64 start_ticks_ = 0;
+
+    // Formatted in place so that constructing a group cannot throw
+    std::array<char, 160> error_{};
+};
+
+/**
+ * Counts the region between its construction and destruction.
+ *
+ * Usage:
+ *
+ * Perf::Counts counts;
+ * {
+ *     Perf::Scope const scope{group, counts, vectors.size()};
+ *     ...
+ * }
+ * print(counts.ipc(), counts.perElement(Perf::Event::CacheMisses));
+ */
+class Scope {
+   public:
+    /**
+     * Starts the counters of the group.
+     *
+     * @param group     The counters to use
+     * @param result    Where to store the counts when the scope ends
+     * @param elements  The number of elements the region processes
+     */
+    Scope(CounterGroup& group, Counts& result, u64 elements = 1) noexcept
+        : group_{group}, result_{result}, elements_{elements} {
+        group_.start();
+    }
+
+    Scope(Scope const&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(Scope const&) = delete;
+    Scope& operator=(Scope&&) = delete;
+
+    /**
+     * Stops the counters and stores the counts.
+     */
+    ~Scope() { result_ = group_.stop(elements_); }
+
+   private:
+    CounterGroup& group_;
+    Counts& result_;
+    u64 elements_;
+};
+
+}  // namespace Perf
+
+}  // namespace Zeus
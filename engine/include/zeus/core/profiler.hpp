@@ -0,0 +1,426 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "zeus/core/macro_helpers.hpp"
+#include "zeus/core/tsc.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file profiler.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A hierarchical frame profiler.
+ *
+ * Zones are marked with ZEUS_PROFILE_SCOPE and ZEUS_PROFILE_FUNCTION, frames
+ * with ZEUS_PROFILE_FRAME and counter tracks with ZEUS_PROFILE_COUNTER.
+ * Nothing is recorded until Profiler::start() is called. While a capture is
+ * running, every closed zone appends its begin and end timestamp and its
+ * nesting depth to a buffer owned by the calling thread, without locks or
+ * system calls. The captured events can then be written as a Chrome trace,
+ * which chrome://tracing and Perfetto open, or summed up into per-zone
+ * statistics.
+ *
+ * @note The macros compile to nothing unless ZEUS_ENABLE_PROFILING is
+ * defined.
+ */
+namespace Profiler {
+
+/**
+ * The static description of a profiled zone or counter.
+ *
+ * @note Only constructed by the ZEUS_PROFILE macros, which keep it in a
+ * constant initialized static, and by internSite() for names that are only
+ * known at runtime.
+ */
+struct Site {
+    char const* name;
+    char const* file;
+    u32 line;
+};
+
+/**
+ * The time spent in the zones with the same name.
+ */
+struct ZoneStatistics {
+    std::string name;
+
+    // The number of times the zone was entered
+    u64 count = 0;
+
+    // Total time includes nested zones while self time excludes them
+    f64 total_ms = 0.0;
+    f64 self_ms = 0.0;
+    f64 min_ms = 0.0;
+    f64 max_ms = 0.0;
+};
+
+/**
+ * The time between consecutive frame markers.
+ */
+struct FrameStatistics {
+    u64 count = 0;
+    f64 mean_ms = 0.0;
+    f64 min_ms = 0.0;
+    f64 max_ms = 0.0;
+};
+
+namespace Detail {
+
+/**
+ * The kinds of recorded events.
+ */
+enum class EventType : u32 { Zone, Frame, Counter };
+
+/**
+ * A recorded zone, frame marker or counter value.
+ */
+struct Event {
+    u64 begin;
+
+    // The end timestamp of a zone or the bits of a counter's value
+    u64 end;
+    Site const* site;
+    u32 depth;
+    EventType type;
+};
+
+/**
+ * The number of events in a chunk, a chunk is 32 KiB.
+ */
+inline constexpr u32 chunk_capacity = 1024;
+
+/**
+ * A block of events in a thread's buffer.
+ *
+ * @note Only the owning thread writes events. It publishes every event by
+ * storing the new count with release semantics so that the exporter can read
+ * a buffer while the thread keeps recording.
+ */
+struct Chunk {
+    std::atomic<u32> count{0};
+    std::atomic<Chunk*> next{nullptr};
+    Event events[chunk_capacity];
+};
+
+/**
+ * The events recorded by a single thread.
+ */
+struct ThreadBuffer {
+    // Written by the owning thread only
+    Chunk* tail = nullptr;
+    u32 depth = 0;
+
+    Chunk head;
+};
+
+/**
+ * Set while a capture is running.
+ */
+inline std::atomic<bool> active{false};
+
+/**
+ * The buffer of the calling thread or nullptr before its first event.
+ */
+inline thread_local ThreadBuffer* thread_buffer = nullptr;
+
+/**
+ * Creates and registers the buffer of the calling thread.
+ *
+ * @return The buffer or nullptr if it could not be allocated
+ */
+ThreadBuffer* registerThread() noexcept;
+
+/**
+ * Appends a chunk to the given buffer when its last chunk is full.
+ *
+ * @return The new chunk or nullptr if the memory budget is used up
+ */
+Chunk* grow(ThreadBuffer& buffer) noexcept;
+
+/**
+ * Returns the buffer of the calling thread, creating it on first use.
+ */
+inline ThreadBuffer* threadBuffer() noexcept {
+    ThreadBuffer* buffer = thread_buffer;
+
+    return buffer != nullptr ? buffer : registerThread();
+}
+
+/**
+ * Appends an event to the given buffer.
+ */
+inline void record(ThreadBuffer& buffer, Event const& event) noexcept {
+    Chunk* chunk = buffer.tail;
+    u32 count = chunk->count.load(std::memory_order_relaxed);
+
+    if (count == chunk_capacity) {
+        chunk = grow(buffer);
+
+        if (chunk == nullptr) {
+            return;
+        }
+
+        count = 0;
+    }
+
+    chunk->events[count] = event;
+    chunk->count.store(count + 1, std::memory_order_release);
+}
+
+}  // namespace Detail
+
+/**
+ * Measures the time between its construction and destruction as a zone.
+ *
+ * @note Use ZEUS_PROFILE_SCOPE or ZEUS_PROFILE_FUNCTION instead of
+ * constructing a zone directly.
+ */
+class Zone {
+   public:
+    /**
+     * Opens a zone if a capture is running.
+     *
+     * @param site The description of the zone
+     */
+    explicit Zone(Site const& site) noexcept : site_{&site} {
+        // Acquire pairs with start() so that a buffer cleared by reset() is
+        // seen in its cleared state
+        if (!Detail::active.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        buffer_ = Detail::threadBuffer();
+
+        if (buffer_ != nullptr) {
+            depth_ = buffer_->depth++;
+            begin_ = Tsc::now();
+        }
+    }
+
+    Zone(Zone const&) = delete;
+    Zone(Zone&&) = delete;
+    Zone& operator=(Zone const&) = delete;
+    Zone& operator=(Zone&&) = delete;
+
+    /**
+     * Closes the zone and records it.
+     */
+    ~Zone() {
+        if (buffer_ == nullptr) {
+            return;
+        }
+
+        u64 const end = Tsc::now();
+        --buffer_->depth;
+
+        Detail::record(*buffer_, {begin_, end, site_, depth_,
+                                  Detail::EventType::Zone});
+    }
+
+   private:
+    Site const* site_;
+    Detail::ThreadBuffer* buffer_ = nullptr;
+    u64 begin_ = 0;
+    u32 depth_ = 0;
+};
+
+/**
+ * Records the start of a new frame.
+ *
+ * @note Use ZEUS_PROFILE_FRAME instead of calling this directly.
+ *
+ * @param site The description of the frame marker
+ */
+void markFrame(Site const& site) noexcept;
+
+/**
+ * Records the value of a counter track.
+ *
+ * @note Use ZEUS_PROFILE_COUNTER instead of calling this directly.
+ *
+ * @param site  The description of the counter
+ * @param value The current value of the counter
+ */
+void recordCounter(Site const& site, f64 value) noexcept;
+
+/**
+ * Starts recording events.
+ */
+void start() noexcept;
+
+/**
+ * Stops recording events, zones that are still open are recorded when they
+ * close.
+ */
+void stop() noexcept;
+
+/**
+ * Returns whether a capture is running.
+ *
+ * @return True between start() and stop()
+ */
+[[nodiscard]] bool isActive() noexcept;
+
+/**
+ * Discards every recorded event.
+ *
+ * @note Must only be called while no thread is recording, i.e. after stop()
+ * once the zones that were open during the capture have closed.
+ */
+void reset() noexcept;
+
+/**
+ * Names the calling thread in exported traces.
+ *
+ * @param name The name of the thread
+ */
+void setThreadName(std::string_view name);
+
+/**
+ * Returns the site of a zone whose name is only known at runtime.
+ *
+ * @note Sites are kept until the process exits and the same name always
+ * returns the same site, so only use this for a bounded set of names such as
+ * the systems of a schedule.
+ *
+ * @param name The name of the zone
+ * @param file The file the zone is opened in
+ * @param line The line the zone is opened at
+ *
+ * @return The site to open zones with
+ */
+[[nodiscard]] Site const& internSite(std::string_view name, char const* file,
+                                     u32 line);
+
+/**
+ * Returns the number of events dropped because the memory budget for events
+ * was used up.
+ *
+ * @return The number of dropped events
+ */
+[[nodiscard]] u64 droppedCount() noexcept;
+
+/**
+ * Writes the recorded events in the Chrome trace event format.
+ *
+ * @param out The stream to write to
+ */
+void writeChromeTrace(std::ostream& out);
+
+/**
+ * Writes the recorded events in the Chrome trace event format.
+ *
+ * @param path The file to write to
+ *
+ * @return True if the file was written
+ */
+bool writeChromeTrace(std::string const& path);
+
+/**
+ * Sums up the recorded zones by name.
+ *
+ * @return The statistics of every zone, sorted by total time with the most
+ * expensive zone first
+ */
+[[nodiscard]] std::vector<ZoneStatistics> zoneStatistics();
+
+/**
+ * Sums up the time between the recorded frame markers of every thread.
+ *
+ * @return The frame statistics
+ */
+[[nodiscard]] FrameStatistics frameStatistics();
+
+/**
+ * Writes the frame and zone statistics as a table.
+ *
+ * @param out The stream to write to
+ */
+void writeStatistics(std::ostream& out);
+
+}  // namespace Profiler
+
+}  // namespace Zeus
+
+// Check if profiling is turned on
+#ifdef ZEUS_ENABLE_PROFILING
+
+/**
+ * Profiles the rest of the enclosing scope as a zone with the given name,
+ * which must be a string literal.
+ */
+#define ZEUS_PROFILE_SCOPE(NAME)                                               \
+    static constexpr Zeus::Profiler::Site ZEUS_UNIQUE_NAME(                    \
+        zeus_profile_site_){NAME, __FILE__, __LINE__};                         \
+    Zeus::Profiler::Zone const ZEUS_UNIQUE_NAME(zeus_profile_zone_) {          \
+        ZEUS_UNIQUE_NAME(zeus_profile_site_)                                   \
+    }
+
+/**
+ * Profiles the rest of the enclosing scope as a zone described by the given
+ * site, for zones named at runtime through internSite().
+ */
+#define ZEUS_PROFILE_SITE(SITE)                                                \
+    Zeus::Profiler::Zone const ZEUS_UNIQUE_NAME(zeus_profile_zone_) { SITE }
+
+/**
+ * Profiles the rest of the enclosing function as a zone named after it.
+ */
+#define ZEUS_PROFILE_FUNCTION() ZEUS_PROFILE_SCOPE(__func__)
+
+/**
+ * Marks the start of a new frame.
+ */
+#define ZEUS_PROFILE_FRAME()                                                   \
+    do {                                                                       \
+        static constexpr Zeus::Profiler::Site zeus_profile_site{               \
+            "Frame", __FILE__, __LINE__};                                      \
+        Zeus::Profiler::markFrame(zeus_profile_site);                          \
+    } while (false)
+
+/**
+ * Records the value of the counter track with the given name, which must be
+ * a string literal.
+ */
+#define ZEUS_PROFILE_COUNTER(NAME, VALUE)                                      \
+    do {                                                                       \
+        static constexpr Zeus::Profiler::Site zeus_profile_site{               \
+            NAME, __FILE__, __LINE__};                                         \
+        Zeus::Profiler::recordCounter(zeus_profile_site,                       \
+                                      static_cast<Zeus::f64>(VALUE));          \
+    } while (false)
+
+#else
+#define ZEUS_PROFILE_SCOPE(NAME)
+#define ZEUS_PROFILE_SITE(SITE)
+#define ZEUS_PROFILE_FUNCTION()
+#define ZEUS_PROFILE_FRAME()
+#define ZEUS_PROFILE_COUNTER(NAME, VALUE)
+#endif
@@ -0,0 +1,274 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/bit.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file spsc_queue.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+/**
+ * Uninitialized storage for a single queue element.
+ */
+template <typename T>
+struct QueueSlot {
+    alignas(T) std::byte storage[sizeof(T)];
+
+    T* get() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage));
+    }
+};
+
+/**
+ * Rounds a queue capacity up to a power of two of at least two.
+ */
+inline std::size_t queueCapacity(std::size_t capacity) noexcept {
+    auto const width =
+        bitWidth(static_cast<u64>(std::max<std::size_t>(capacity, 2) - 1));
+
+    return std::size_t{1} << width;
+}
+
+}  // namespace Detail
+
+/**
+ * A bounded lock-free queue for exactly one producer thread and one consumer
+ * thread.
+ *
+ * The producer and the consumer each own an index on their own cache line
+ * and keep a cached copy of the other side's index. They only read the
+ * other side's cache line when the cached copy says the queue is full or
+ * empty, so in the steady state neither side causes cache misses for the
+ * other.
+ *
+ * @tparam T The type of the elements
+ */
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+                      std::is_nothrow_destructible_v<T>,
+                  "Queue elements must be nothrow movable and destructible.");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * Constructs an empty queue.
+     *
+     * @param capacity The number of elements the queue can hold, rounded up
+     *                 to a power of two
+     */
+    explicit SpscQueue(size_type capacity)
+        : mask_{Detail::queueCapacity(capacity) - 1},
+          slots_{std::make_unique<Detail::QueueSlot<T>[]>(mask_ + 1)} {}
+
+    SpscQueue(SpscQueue const&) = delete;
+    SpscQueue(SpscQueue&&) = delete;
+    SpscQueue& operator=(SpscQueue const&) = delete;
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    /**
+     * Destroys the elements left in the queue.
+     */
+    ~SpscQueue() {
+        size_type const tail = tail_.load(std::memory_order_relaxed);
+
+        for (size_type head = head_.load(std::memory_order_relaxed);
+             head != tail; ++head) {
+            std::destroy_at(slots_[head & mask_].get());
+        }
+    }
+
+    /**
+     * Constructs an element at the back of the queue.
+     *
+     * @note Must only be called by the producer.
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    template <typename... Args>
+    [[nodiscard]] bool tryEmplace(Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args&&...>) {
+        size_type const tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+
+        ::new (static_cast<void*>(slots_[tail & mask_].storage))
+            T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Copies an element to the back of the queue.
+     *
+     * @note Must only be called by the producer.
+     *
+     * @param value The element to add
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    [[nodiscard]] bool tryPush(T const& value) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+        return tryEmplace(value);
+    }
+
+    /**
+     * Moves an element to the back of the queue.
+     *
+     * @note Must only be called by the producer.
+     *
+     * @param value The element to add
+     *
+     * @return True if the element was added, false if the queue is full
+     */
+    [[nodiscard]] bool tryPush(T&& value) noexcept {
+        return tryEmplace(std::move(value));
+    }
+
+    /**
+     * Removes the element at the front of the queue.
+     *
+     * @note Must only be called by the consumer.
+     *
+     * @return The element or an empty optional if the queue is empty
+     */
+    [[nodiscard]] std::optional<T> tryPop() noexcept {
+        size_type const head = head_.load(std::memory_order_relaxed);
+
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+
+            if (head == cached_tail_) {
+                return std::nullopt;
+            }
+        }
+
+        T* const element = slots_[head & mask_].get();
+        std::optional<T> value{std::move(*element)};
+        std::destroy_at(element);
+        head_.store(head + 1, std::memory_order_release);
+
+        return value;
+    }
+
+    /**
+     * Removes up to the given number of elements from the front of the queue.
+     *
+     * @note Must only be called by the consumer. The producer is only told
+     * about the freed space once, after the whole batch has been moved out.
+     *
+     * @param out       Where to move the elements to
+     * @param max_count The largest number of elements to remove
+     *
+     * @return The number of elements removed
+     */
+    template <typename OutputIt>
+    size_type popBatch(OutputIt out, size_type max_count) noexcept {
+        size_type const head = head_.load(std::memory_order_relaxed);
+
+        if (cached_tail_ - head < max_count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        size_type const count = std::min(cached_tail_ - head, max_count);
+
+        for (size_type index = head; index != head + count; ++index) {
+            T* const element = slots_[index & mask_].get();
+            *out = std::move(*element);
+            ++out;
+            std::destroy_at(element);
+        }
+
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+
+        return count;
+    }
+
+    /**
+     * Returns the number of elements in the queue.
+     *
+     * @return The number of elements, which may be stale by the time it is
+     * used
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        size_type const head = head_.load(std::memory_order_acquire);
+        size_type const tail = tail_.load(std::memory_order_acquire);
+
+        return tail - head;
+    }
+
+    /**
+     * Returns whether the queue appears to be empty.
+     *
+     * @return True if the queue was empty when checked
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * Returns the number of elements the queue can hold.
+     *
+     * @return The capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+   private:
+    // Read by both sides but never written after construction
+    size_type const mask_;
+    std::unique_ptr<Detail::QueueSlot<T>[]> const slots_;
+
+    // Owned by the consumer
+    alignas(Memory::cache_line_size) std::atomic<size_type> head_{0};
+    size_type cached_tail_ = 0;
+
+    // Owned by the producer
+    alignas(Memory::cache_line_size) std::atomic<size_type> tail_{0};
+    size_type cached_head_ = 0;
+};
+
+}  // namespace Zeus
@@ -0,0 +1,600 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#if defined(__linux__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <link.h>
+#include <unistd.h>
+#endif
+
+#include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file stack_trace.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Stack trace capture for assertion failures and fatal signals.
+ *
+ * Capturing a trace only records raw return addresses. Turning them into
+ * names is deferred until something failed: symbolize() resolves them in
+ * process, and the raw form written from signal handlers lists every frame as
+ * module+offset together with the build id of each module, which is enough to
+ * symbolize the trace offline, for example with
+ * "addr2line -C -f -e <module> <offset>".
+ *
+ * @note Names are only resolved in process for exported symbols, link with
+ * -rdynamic (ENABLE_EXPORTS in CMake) to export the symbols of an executable.
+ */
+namespace StackTrace {
+
+// The maximum number of frames captured for a trace
+inline constexpr std::size_t max_frames = 64;
+
+// The maximum number of loaded modules tracked for offline symbolization
+inline constexpr std::size_t max_modules = 64;
+
+namespace Detail {
+
+/**
+ * A module loaded into the process, used to map addresses to offsets.
+ */
+struct Module {
+    std::uintptr_t base = 0;
+    std::uintptr_t start = 0;
+    std::uintptr_t end = 0;
+    std::array<char, 256> path{};
+    std::array<u8, 20> build_id{};
+    std::size_t build_id_size = 0;
+};
+
+struct ModuleMap {
+    std::array<Module, max_modules> modules{};
+    std::size_t size = 0;
+};
+
+// Filled by prepare() so the signal handlers do not have to allocate
+inline ModuleMap module_map{};
+
+// Where the signal handlers write their report
+inline std::atomic<int> crash_output{2};
+
+// Set once a report with a stack trace was written for the current failure
+inline std::atomic<bool> trace_reported{false};
+
+// Set while a signal handler runs to catch faults inside the handler
+inline std::atomic_flag handling_signal = ATOMIC_FLAG_INIT;
+
+/**
+ * A fixed size line buffer that only uses async-signal-safe operations.
+ */
+class LineBuffer {
+   public:
+    void append(std::string_view text) noexcept {
+        std::size_t const count = std::min(text.size(), data_.size() - size_);
+
+        std::memcpy(data_.data() + size_, text.data(), count);
+        size_ += count;
+    }
+
+    void appendHex(std::uintptr_t value) noexcept {
+        std::array<char, 2 + sizeof(value) * 2> digits{};
+        std::size_t position = digits.size();
+
+        do {
+            digits[--position] = "0123456789abcdef"[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+
+        digits[--position] = 'x';
+        digits[--position] = '0';
+
+        append({digits.data() + position, digits.size() - position});
+    }
+
+    void appendDecimal(std::uintptr_t value) noexcept {
+        std::array<char, 24> digits{};
+        std::size_t position = digits.size();
+
+        do {
+            digits[--position] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        append({digits.data() + position, digits.size() - position});
+    }
+
+    void write(int file_descriptor) noexcept {
+#if defined(__linux__)
+        std::size_t written = 0;
+
+        while (written < size_) {
+            ssize_t const result = ::write(
+                file_descriptor, data_.data() + written, size_ - written);
+
+            if (result <= 0) {
+                break;
+            }
+
+            written += static_cast<std::size_t>(result);
+        }
+#else
+        (void)file_descriptor;
+#endif
+
+        size_ = 0;
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+        return {data_.data(), size_};
+    }
+
+   private:
+    std::array<char, 512> data_{};
+    std::size_t size_ = 0;
+};
+
+#if defined(__linux__)
+/**
+ * Copies the GNU build id out of the notes of a loaded module.
+ */
+inline void readBuildId(dl_phdr_info const& info, Module& module) noexcept {
+    for (ElfW(Half) i = 0; i < info.dlpi_phnum; ++i) {
+        ElfW(Phdr) const& header = info.dlpi_phdr[i];
+
+        if (header.p_type != PT_NOTE) {
+            continue;
+        }
+
+        auto const* note = reinterpret_cast<char const*>(info.dlpi_addr +
+                                                         header.p_vaddr);
+        auto const* const end = note + header.p_memsz;
+
+        while (note + sizeof(ElfW(Nhdr)) <= end) {
+            ElfW(Nhdr) note_header;
+            std::memcpy(&note_header, note, sizeof(note_header));
+
+            auto const name_size = (note_header.n_namesz + 3U) & ~3U;
+            auto const description_size = (note_header.n_descsz + 3U) & ~3U;
+            char const* const name = note + sizeof(note_header);
+            char const* const description = name + name_size;
+
+            if (note_header.n_type == NT_GNU_BUILD_ID &&
+                note_header.n_namesz == 4 &&
+                std::memcmp(name, "GNU", 4) == 0) {
+                module.build_id_size = std::min<std::size_t>(
+                    note_header.n_descsz, module.build_id.size());
+                std::memcpy(module.build_id.data(), description,
+                            module.build_id_size);
+
+                return;
+            }
+
+            note = description + description_size;
+        }
+    }
+}
+
+inline int addModule(dl_phdr_info* info, std::size_t /*size*/,
+                     void* data) noexcept {
+    auto& map = *static_cast<ModuleMap*>(data);
+
+    if (map.size == map.modules.size()) {
+        return 1;
+    }
+
+    Module& module = map.modules[map.size];
+    module = Module{};
+    module.base = static_cast<std::uintptr_t>(info->dlpi_addr);
+    module.start = UINTPTR_MAX;
+
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+        ElfW(Phdr) const& header = info->dlpi_phdr[i];
+
+        if (header.p_type == PT_LOAD) {
+            std::uintptr_t const start = module.base + header.p_vaddr;
+
+            module.start = std::min(module.start, start);
+            module.end = std::max(module.end, start + header.p_memsz);
+        }
+    }
+
+    if (module.start >= module.end) {
+        return 0;
+    }
+
+    // The executable itself is reported without a name
+    if (info->dlpi_name != nullptr && info->dlpi_name[0] != '\0') {
+        std::strncpy(module.path.data(), info->dlpi_name,
+                     module.path.size() - 1);
+    } else {
+        ssize_t const size = readlink("/proc/self/exe", module.path.data(),
+                                      module.path.size() - 1);
+
+        if (size > 0) {
+            module.path[static_cast<std::size_t>(size)] = '\0';
+        }
+    }
+
+    readBuildId(*info, module);
+    ++map.size;
+
+    return 0;
+}
+#endif
+
+/**
+ * Records the modules currently loaded into the process.
+ */
+inline void loadModules(ModuleMap& map) noexcept {
+    map.size = 0;
+
+#if defined(__linux__)
+    dl_iterate_phdr(addModule, &map);
+#endif
+}
+
+/**
+ * Returns the module containing the given address or nullptr.
+ */
+inline Module const* findModule(ModuleMap const& map,
+                                std::uintptr_t address) noexcept {
+    for (std::size_t i = 0; i < map.size; ++i) {
+        Module const& module = map.modules[i];
+
+        if (address >= module.start && address < module.end) {
+            return &module;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Formats a frame as its index, address and module+offset.
+ */
+inline void appendFrame(LineBuffer& line, ModuleMap const& map,
+                        std::size_t index, void* frame) noexcept {
+    auto const address = reinterpret_cast<std::uintptr_t>(frame);
+
+    line.append("#");
+    line.appendDecimal(index);
+    line.append(" ");
+    line.appendHex(address);
+
+    // Return addresses point after the call, look up the call itself
+    if (Module const* module = findModule(map, address - 1)) {
+        line.append(" ");
+        line.append(module->path.data());
+        line.append("+");
+        line.appendHex(address - module->base);
+    }
+}
+
+#if defined(_WIN32)
+/**
+ * Records the return addresses of the call stack of its caller.
+ *
+ * @note Defined in stack_trace.cpp so windows.h stays out of this header.
+ */
+std::size_t captureWindows(void** frames, std::size_t capacity) noexcept;
+#endif
+
+inline char const* signalName(int signal_number) noexcept {
+    switch (signal_number) {
+        case SIGSEGV:
+            return "SIGSEGV";
+        case SIGABRT:
+            return "SIGABRT";
+        case SIGFPE:
+            return "SIGFPE";
+        case SIGILL:
+            return "SIGILL";
+#if defined(SIGBUS)
+        case SIGBUS:
+            return "SIGBUS";
+#endif
+        default:
+            return "unknown signal";
+    }
+}
+
+}  // namespace Detail
+
+/**
+ * Records the return addresses of the current call stack.
+ *
+ * @note Async-signal-safe once prepare() was called.
+ *
+ * @param frames    Where to store the addresses
+ * @param capacity  The maximum number of addresses to store
+ * @param skip      The number of innermost frames to skip, the caller of this
+ *                  function is frame 0
+ *
+ * @return The number of addresses stored
+ */
+ZEUS_NOINLINE inline std::size_t capture(void** frames, std::size_t capacity,
+                                         std::size_t skip = 0) noexcept {
+    std::array<void*, max_frames> buffer{};
+
+#if defined(__linux__)
+    int const count = backtrace(buffer.data(), static_cast<int>(buffer.size()));
+    auto const captured = static_cast<std::size_t>(count > 0 ? count : 0);
+#elif defined(_WIN32)
+    std::size_t const captured =
+        Detail::captureWindows(buffer.data(), buffer.size());
+#else
+    std::size_t const captured = 0;
+#endif
+
+    // Frame 0 is this function
+    std::size_t const first = std::min(captured, skip + 1);
+    std::size_t const size = std::min(captured - first, capacity);
+
+    std::memcpy(frames, buffer.data() + first, size * sizeof(void*));
+
+    return size;
+}
+
+/**
+ * Makes capturing and writing traces async-signal-safe.
+ *
+ * Loads the unwinder, which would otherwise allocate on first use, and
+ * records the loaded modules. Call it again after loading libraries.
+ */
+inline void prepare() noexcept {
+    std::array<void*, 4> frames{};
+    (void)capture(frames.data(), frames.size());
+
+    Detail::loadModules(Detail::module_map);
+}
+
+/**
+ * Writes the given frames as module+offset, followed by the build id of every
+ * module that appears in the trace.
+ *
+ * @note Async-signal-safe, uses the modules recorded by prepare().
+ *
+ * @param file_descriptor   The file descriptor to write to
+ * @param frames            The captured addresses
+ * @param size              The number of captured addresses
+ */
+inline void writeRaw(int file_descriptor, void* const* frames,
+                     std::size_t size) noexcept {
+    Detail::ModuleMap const& map = Detail::module_map;
+    Detail::LineBuffer line;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        Detail::appendFrame(line, map, i, frames[i]);
+        line.append("\n");
+        line.write(file_descriptor);
+    }
+
+    for (std::size_t i = 0; i < map.size; ++i) {
+        Detail::Module const& module = map.modules[i];
+        bool used = false;
+
+        for (std::size_t j = 0; j < size && !used; ++j) {
+            auto const address = reinterpret_cast<std::uintptr_t>(frames[j]);
+            used = Detail::findModule(map, address - 1) == &module;
+        }
+
+        if (!used || module.build_id_size == 0) {
+            continue;
+        }
+
+        line.append("build-id ");
+
+        for (std::size_t j = 0; j < module.build_id_size; ++j) {
+            line.append({&"0123456789abcdef"[module.build_id[j] >> 4], 1});
+            line.append({&"0123456789abcdef"[module.build_id[j] & 0xF], 1});
+        }
+
+        line.append(" ");
+        line.append(module.path.data());
+        line.append("\n");
+        line.write(file_descriptor);
+    }
+}
+
+/**
+ * Resolves the given frames to names.
+ *
+ * @note Allocates, not async-signal-safe.
+ *
+ * @param frames    The captured addresses
+ * @param size      The number of captured addresses
+ *
+ * @return One line per frame with its address, module+offset and the
+ * demangled function name if it could be resolved
+ */
+[[nodiscard]] inline std::string symbolize(void* const* frames,
+                                           std::size_t size) {
+    std::string text;
+
+    // Libraries may have been loaded since prepare()
+    auto map = std::make_unique<Detail::ModuleMap>();
+    Detail::loadModules(*map);
+
+#if defined(__linux__)
+    std::unique_ptr<char*, decltype(&std::free)> symbols{
+        backtrace_symbols(frames, static_cast<int>(size)), &std::free};
+#endif
+
+    for (std::size_t i = 0; i < size; ++i) {
+        Detail::LineBuffer line;
+        Detail::appendFrame(line, *map, i, frames[i]);
+        text += line.view();
+
+#if defined(__linux__)
+        // Entries look like "module(name+0x12) [0x...]"
+        std::string_view const entry =
+            symbols != nullptr ? symbols.get()[i] : "";
+        std::size_t const open = entry.find('(');
+        std::size_t const plus = entry.find('+', open);
+
+        if (open != std::string_view::npos && plus != std::string_view::npos &&
+            plus > open + 1) {
+            std::string const name{entry.substr(open + 1, plus - open - 1)};
+            int status = 0;
+            std::unique_ptr<char, decltype(&std::free)> demangled{
+                abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status),
+                &std::free};
+
+            text += ' ';
+            text += (status == 0) ? demangled.get() : name.c_str();
+        }
+#endif
+
+        text += '\n';
+    }
+
+    return text;
+}
+
+/**
+ * Captures and symbolizes the current call stack.
+ *
+ * @param skip The number of innermost frames to skip, the caller of this
+ *             function is frame 0
+ *
+ * @return The symbolized trace
+ */
+[[nodiscard]] ZEUS_NOINLINE inline std::string current(std::size_t skip = 0) {
+    std::array<void*, max_frames> frames{};
+    std::size_t const size = capture(frames.data(), frames.size(), skip + 1);
+
+    return symbolize(frames.data(), size);
+}
+
+namespace Detail {
+
+#if defined(__linux__)
+[[noreturn]] inline void onFatalSignal(int signal_number, siginfo_t* info,
+                                       void* /*context*/) noexcept {
+    int const output = crash_output.load(std::memory_order_relaxed);
+
+    // A fault while reporting, give up on the report
+    if (handling_signal.test_and_set()) {
+        std::signal(signal_number, SIG_DFL);
+        raise(signal_number);
+        _exit(128 + signal_number);
+    }
+
+    LineBuffer line;
+    line.append("\n=========== ZEUS FATAL SIGNAL ===========\n");
+    line.append("Signal: ");
+    line.append(signalName(signal_number));
+    line.append(" (");
+    line.appendDecimal(static_cast<std::uintptr_t>(signal_number));
+    line.append(")\n");
+
+    if (signal_number != SIGABRT) {
+        line.append("Address: ");
+        line.appendHex(reinterpret_cast<std::uintptr_t>(info->si_addr));
+        line.append("\n");
+    }
+
+    line.write(output);
+
+    // An assertion failure already reported its own trace before aborting
+    if (!trace_reported.load(std::memory_order_relaxed)) {
+        std::array<void*, max_frames> frames{};
+        std::size_t const size = capture(frames.data(), frames.size(), 1);
+
+        line.append("Stack trace:\n");
+        line.write(output);
+        writeRaw(output, frames.data(), size);
+    }
+
+    line.append("=========================================\n");
+    line.write(output);
+
+    // The handler was installed with SA_RESETHAND, this runs the default
+    raise(signal_number);
+    _exit(128 + signal_number);
+}
+
+// Lets the handler run when the stack overflowed
+inline std::array<std::byte, std::size_t{64} * 1024> alternate_stack{};
+#endif
+
+}  // namespace Detail
+
+/**
+ * Reports a stack trace when the process receives SIGSEGV, SIGABRT, SIGBUS,
+ * SIGFPE or SIGILL, then lets the default action of the signal run.
+ *
+ * @note The report uses the raw, offline symbolized form since names can not
+ * be resolved safely inside a signal handler. The alternate signal stack is
+ * only set up for the calling thread, overflowing the stack of other threads
+ * terminates without a report.
+ *
+ * @param file_descriptor The file descriptor to write the report to
+ *
+ * @return True if the handlers were installed, otherwise false
+ */
+inline bool installCrashHandlers(int file_descriptor = 2) noexcept {
+    Detail::crash_output.store(file_descriptor, std::memory_order_relaxed);
+
+#if defined(__linux__)
+    prepare();
+
+    stack_t stack{};
+    stack.ss_sp = Detail::alternate_stack.data();
+    stack.ss_size = Detail::alternate_stack.size();
+    sigaltstack(&stack, nullptr);
+
+    struct sigaction action {};
+    action.sa_sigaction = Detail::onFatalSignal;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    bool installed = true;
+
+    for (int const signal_number : {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL}) {
+        installed &= sigaction(signal_number, &action, nullptr) == 0;
+    }
+
+    return installed;
+#else
+    return false;
+#endif
+}
+
+}  // namespace StackTrace
+
+}  // namespace Zeus
@@ -0,0 +1,434 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/format.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * @file string_id.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * A string identified by a 64-bit hash.
+ *
+ * Comparing ids and using them as hash map keys costs a single integer
+ * operation. Ids of literals are computed at compile time, runtime strings
+ * are interned with intern(), which keeps a copy of the characters for the
+ * lifetime of the program so the id can be turned back into its name.
+ *
+ * @note A default constructed id is null and differs from the id of the
+ * empty string.
+ */
+class StringId {
+   public:
+    using value_type = u64;
+
+    /**
+     * Constructs a null id.
+     */
+    constexpr StringId() noexcept = default;
+
+    /**
+     * Constructs the id of the given string without interning it.
+     *
+     * @param text The string to identify
+     */
+    constexpr explicit StringId(std::string_view text) noexcept
+        : value_{hash(text)} {}
+
+    /**
+     * Reconstructs an id from its raw value.
+     *
+     * @param value The raw value previously returned by value()
+     *
+     * @return The id with the given value
+     */
+    [[nodiscard]] static constexpr StringId fromValue(
+        value_type value) noexcept {
+        StringId id;
+        id.value_ = value;
+
+        return id;
+    }
+
+    /**
+     * Hashes the given string with 64-bit FNV-1a.
+     *
+     * @param text The string to hash
+     *
+     * @return The hash of the given string
+     */
+    [[nodiscard]] static constexpr value_type hash(
+        std::string_view text) noexcept {
+        value_type hash = 14695981039346656037U;
+
+        for (char const character : text) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 1099511628211U;
+        }
+
+        return hash;
+    }
+
+    /**
+     * Returns the id of the given string and records the string so the id
+     * can be turned back into its name.
+     *
+     * @note Thread safe. Strings that were interned before only take a shared
+     * lock.
+     *
+     * @param text The string to intern
+     *
+     * @return The id of the given string
+     */
+    [[nodiscard]] static StringId intern(std::string_view text);
+
+    /**
+     * Returns the interned string of this id.
+     *
+     * @return The string or an empty string if it was never interned
+     */
+    [[nodiscard]] std::string_view name() const;
+
+    [[nodiscard]] constexpr value_type value() const noexcept {
+        return value_;
+    }
+
+    /**
+     * Checks if this id is not null.
+     */
+    constexpr explicit operator bool() const noexcept {
+        return value_ != 0;
+    }
+
+   private:
+    value_type value_ = 0;
+};
+
+namespace Detail {
+
+// The size of the blocks interned strings are copied into
+inline constexpr std::size_t string_table_block_size = std::size_t{64} * 1024;
+
+/**
+ * The global table of interned strings.
+ *
+ * Strings are copied into large arena blocks which are never freed, so the
+ * views handed out stay valid for the lifetime of the program.
+ */
+class StringTable {
+   public:
+    /**
+     * Returns the table, which is leaked so it outlives static destructors.
+     */
+    [[nodiscard]] static StringTable& instance() {
+        static auto* const table = new StringTable;
+
+        return *table;
+    }
+
+    std::string_view insert(StringId::value_type id, std::string_view text) {
+        {
+            std::shared_lock const lock{mutex_};
+
+            if (auto const found = names_.find(id); found != names_.end()) {
+                checkCollision(found->second, text);
+
+                return found->second;
+            }
+        }
+
+        std::unique_lock const lock{mutex_};
+
+        auto const [position, inserted] = names_.try_emplace(id);
+
+        if (inserted) {
+            position->second = copy(text);
+        } else {
+            checkCollision(position->second, text);
+        }
+
+        return position->second;
+    }
+
+    [[nodiscard]] std::string_view find(StringId::value_type id) const {
+        std::shared_lock const lock{mutex_};
+
+        auto const found = names_.find(id);
+
+        return (found != names_.end()) ? found->second : std::string_view{};
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::shared_lock const lock{mutex_};
+
+        return names_.size();
+    }
+
+   private:
+    static void checkCollision(std::string_view stored,
+                               std::string_view text) noexcept {
+        ZEUS_MODULE_ASSERT(CORE, ALWAYS, stored == text,
+                           "Two strings share the same StringId.");
+    }
+
+    std::string_view copy(std::string_view text) {
+        if (text.size() > remaining_) {
+            std::size_t const size =
+                std::max(text.size(), string_table_block_size);
+
+            blocks_.push_back(std::make_unique<char[]>(size));
+            cursor_ = blocks_.back().get();
+            remaining_ = size;
+        }
+
+        if (!text.empty()) {
+            std::memcpy(cursor_, text.data(), text.size());
+        }
+
+        std::string_view const stored{cursor_, text.size()};
+        cursor_ += text.size();
+        remaining_ -= text.size();
+
+        return stored;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<StringId::value_type, std::string_view> names_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;
+    std::size_t remaining_ = 0;
+};
+
+}  // namespace Detail
+
+inline StringId StringId::intern(std::string_view text) {
+    StringId const id{text};
+    Detail::StringTable::instance().insert(id.value_, text);
+
+    return id;
+}
+
+inline std::string_view StringId::name() const {
+    return Detail::StringTable::instance().find(value_);
+}
+
+/**
+ * Checks if the two given ids are equal.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are equal, otherwise false
+ */
+constexpr bool operator==(StringId lhs, StringId rhs) noexcept {
+    return lhs.value() == rhs.value();
+}
+
+/**
+ * Checks if the two given ids are not equal.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if they are not equal, otherwise false
+ */
+constexpr bool operator!=(StringId lhs, StringId rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+/**
+ * Orders the two given ids by their raw values.
+ *
+ * @note The order has nothing to do with the order of the strings.
+ *
+ * @param lhs The left-hand side of the expression
+ * @param rhs The right-hand side of the expression
+ *
+ * @return True if the left-hand side is ordered first, otherwise false
+ */
+constexpr bool operator<(StringId lhs, StringId rhs) noexcept {
+    return lhs.value() < rhs.value();
+}
+
+namespace Detail {
+
+/**
+ * The longest literal ZEUS_SID registers for the reverse lookup.
+ */
+inline constexpr std::size_t max_registered_literal_size = 64;
+
+/**
+ * Returns the character of the given literal at the given index, or a null
+ * character past its end and for literals too long to register.
+ */
+template <std::size_t Size>
+constexpr char literalChar(char const (&text)[Size],
+                           std::size_t index) noexcept {
+    constexpr bool fits = Size - 1 <= max_registered_literal_size;
+
+    return (fits && index < Size - 1) ? text[index] : '\0';
+}
+
+/**
+ * Interns the literal spelled by the given characters during static
+ * initialization.
+ */
+template <char... Chars>
+struct LiteralRegistration {
+    static constexpr std::array<char, sizeof...(Chars)> text{Chars...};
+
+    static inline bool const registered = [] {
+        std::string_view const view{
+            text.data(),
+            static_cast<std::size_t>(
+                std::find(text.begin(), text.end(), '\0') - text.begin())};
+
+        if (!view.empty()) {
+            static_cast<void>(StringId::intern(view));
+        }
+
+        return true;
+    }();
+};
+
+/**
+ * Returns the given id and makes sure the literal spelled by the given
+ * characters is interned before main().
+ *
+ * @note Referencing the registration instantiates it even when the id is
+ * only ever used in constant expressions.
+ */
+template <char... Chars>
+constexpr StringId registerLiteral(StringId id) noexcept {
+    static_cast<void>(&LiteralRegistration<Chars...>::registered);
+
+    return id;
+}
+
+}  // namespace Detail
+
+namespace Literals {
+
+/**
+ * Returns the id of the given string literal, "name"_sid.
+ */
+constexpr StringId operator""_sid(char const* text,
+                                  std::size_t size) noexcept {
+    return StringId{std::string_view{text, size}};
+}
+
+}  // namespace Literals
+
+/**
+ * Formats an id as its interned name, or as its hash if it was never
+ * interned.
+ */
+template <>
+struct Formatter<StringId> {
+    static void format(FormatBuffer& out, StringId id) noexcept {
+        std::string_view name;
+
+        try {
+            name = id.name();
+        } catch (...) {
+            // Locking failed, fall back to the hash
+        }
+
+        if (!name.empty()) {
+            out.append(name);
+        } else {
+            out.push_back('#');
+            formatValue(out, id.value());
+        }
+    }
+};
+
+}  // namespace Zeus
+
+namespace std {
+
+/**
+ * Hashes ids by their raw values, which are already well mixed.
+ */
+template <>
+struct hash<Zeus::StringId> {
+    std::size_t operator()(Zeus::StringId id) const noexcept {
+        return static_cast<std::size_t>(id.value());
+    }
+};
+
+}  // namespace std
+
+#define ZEUS_DETAIL_SID_CHARS_8(LITERAL, INDEX)   \
+    Zeus::Detail::literalChar(LITERAL, INDEX + 0), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 1), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 2), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 3), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 4), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 5), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 6), \
+        Zeus::Detail::literalChar(LITERAL, INDEX + 7)
+
+#define ZEUS_DETAIL_SID_CHARS(LITERAL)                                     \
+    ZEUS_DETAIL_SID_CHARS_8(LITERAL, 0), ZEUS_DETAIL_SID_CHARS_8(LITERAL, 8), \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 16),                              \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 24),                              \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 32),                              \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 40),                              \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 48),                              \
+        ZEUS_DETAIL_SID_CHARS_8(LITERAL, 56)
+
+#define ZEUS_DETAIL_SID_VALUE(LITERAL)                      \
+    Zeus::StringId::fromValue(                              \
+        std::integral_constant<Zeus::StringId::value_type, \
+                               Zeus::StringId::hash(LITERAL)>::value)
+
+/**
+ * Returns the id of the given string literal as a constant expression.
+ *
+ * @note Debug builds also intern literals of up to
+ * max_registered_literal_size characters before main() so the id can be
+ * turned back into its name, other builds only use the compile time hash.
+ */
+#ifdef ZEUS_DEBUG
+// Parenthesized so the commas of the characters do not split macro arguments
+#define ZEUS_SID(LITERAL)                                            \
+    (Zeus::Detail::registerLiteral<ZEUS_DETAIL_SID_CHARS(LITERAL)>( \
+        ZEUS_DETAIL_SID_VALUE(LITERAL)))
+#else
+#define ZEUS_SID(LITERAL) ZEUS_DETAIL_SID_VALUE(LITERAL)
+#endif
@@ -0,0 +1,64 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+ * @file thread_exit.hpp
+ */
+
+namespace Zeus {
+
+namespace Detail {
+
+/**
+ * Calls a function when its thread exits.
+ */
+template <void (*Function)() noexcept>
+struct ThreadExitHook {
+    ThreadExitHook() noexcept = default;
+    ThreadExitHook(ThreadExitHook const&) = delete;
+    ThreadExitHook(ThreadExitHook&&) = delete;
+    ThreadExitHook& operator=(ThreadExitHook const&) = delete;
+    ThreadExitHook& operator=(ThreadExitHook&&) = delete;
+
+    ~ThreadExitHook() { Function(); }
+};
+
+}  // namespace Detail
+
+/**
+ * Makes sure the function is called when the calling thread exits.
+ *
+ * The hook is a thread_local created by the first call on a thread, so only
+ * threads that call this pay for it. Later calls on the same thread do
+ * nothing.
+ *
+ * @note Thread-local objects are destroyed in the reverse order of their
+ * construction, so the function may still use thread-local state created
+ * before the first call.
+ *
+ * @tparam Function The function to call
+ */
+template <void (*Function)() noexcept>
+void atThreadExit() noexcept {
+    static thread_local Detail::ThreadExitHook<Function> const hook;
+    static_cast<void>(hook);
+}
+
+}  // namespace Zeus
@@ -0,0 +1,144 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+
+#include "zeus/core/types.hpp"
+
+/**
+ * @file thread_index.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * The maximum number of threads that can hold a thread index at the same time.
+ */
+inline constexpr std::size_t max_thread_count = 256;
+
+/**
+ * The thread index returned when every thread index is in use.
+ */
+inline constexpr std::size_t invalid_thread_index =
+    std::numeric_limits<std::size_t>::max();
+
+namespace Detail {
+
+/**
+ * Hands out small dense indices to threads so that per-thread data can be kept
+ * in plain arrays instead of hash maps keyed by std::thread::id.
+ *
+ * @note An index is returned to the registry when its thread exits so that it
+ * can be reused by a later thread.
+ */
+class ThreadIndexRegistry {
+   public:
+    /**
+     * Claims the lowest free thread index.
+     *
+     * @return The claimed index or invalid_thread_index if none are free
+     */
+    static std::size_t acquire() noexcept {
+        for (std::size_t word = 0; word < word_count; ++word) {
+            auto& bits = words()[word];
+            u64 current = bits.load(std::memory_order_relaxed);
+
+            while (current != std::numeric_limits<u64>::max()) {
+                std::size_t bit = 0;
+
+                while ((current >> bit) & 1U) {
+                    ++bit;
+                }
+
+                if (bits.compare_exchange_weak(
+                        current, current | (u64{1} << bit),
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed)) {
+                    return word * bits_per_word + bit;
+                }
+            }
+        }
+
+        return invalid_thread_index;
+    }
+
+    /**
+     * Returns the given thread index to the registry.
+     *
+     * @param index The index to release
+     */
+    static void release(std::size_t index) noexcept {
+        words()[index / bits_per_word].fetch_and(
+            ~(u64{1} << (index % bits_per_word)), std::memory_order_release);
+    }
+
+   private:
+    static constexpr std::size_t bits_per_word = 64;
+    static constexpr std::size_t word_count = max_thread_count / bits_per_word;
+
+    static std::array<std::atomic<u64>, word_count>& words() noexcept {
+        static std::array<std::atomic<u64>, word_count> words{};
+
+        return words;
+    }
+};
+
+/**
+ * Owns the thread index of the calling thread for the lifetime of the thread.
+ */
+struct ThreadIndexHolder {
+    std::size_t index = ThreadIndexRegistry::acquire();
+
+    ThreadIndexHolder() noexcept = default;
+    ThreadIndexHolder(ThreadIndexHolder const&) = delete;
+    ThreadIndexHolder(ThreadIndexHolder&&) = delete;
+    ThreadIndexHolder& operator=(ThreadIndexHolder const&) = delete;
+    ThreadIndexHolder& operator=(ThreadIndexHolder&&) = delete;
+
+    ~ThreadIndexHolder() {
+        if (index != invalid_thread_index) {
+            ThreadIndexRegistry::release(index);
+        }
+    }
+};
+
+}  // namespace Detail
+
+/**
+ * Returns a small dense index that is unique among the running threads.
+ *
+ * @note The index is in the range [0, max_thread_count) or is
+ * invalid_thread_index if more than max_thread_count threads are alive.
+ *
+ * @return The index of the calling thread
+ */
+[[nodiscard]] inline std::size_t threadIndex() noexcept {
+    static thread_local Detail::ThreadIndexHolder const holder;
+
+    return holder.index;
+}
+
+static_assert(max_thread_count % 64 == 0,
+              "The maximum thread count must be a multiple of 64.");
+
+}  // namespace Zeus
@@ -0,0 +1,106 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#include "zeus/core/types.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+/**
+ * @file tsc.hpp
+ */
+
+namespace Zeus {
+
+/**
+ * Reads the time stamp counter, a timestamp that is much cheaper to read
+ * than the system clocks.
+ *
+ * @note Falls back to std::chrono::steady_clock in nanoseconds on CPUs
+ * without a time stamp counter. Modern x86 CPUs have an invariant counter
+ * that ticks at a constant rate on every core, older CPUs are not supported.
+ */
+namespace Tsc {
+
+/**
+ * Returns the current timestamp in ticks.
+ *
+ * @return The current timestamp
+ */
+[[nodiscard]] inline u64 now() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+/**
+ * Returns how many ticks now() advances per second.
+ *
+ * @note Measured against std::chrono::steady_clock on first use, which takes
+ * about 10 milliseconds.
+ *
+ * @return The number of ticks per second
+ */
+[[nodiscard]] inline f64 ticksPerSecond() noexcept {
+    static f64 const ticks_per_second = [] {
+        using Clock = std::chrono::steady_clock;
+
+        auto const start_time = Clock::now();
+        u64 const start_ticks = now();
+
+        while (Clock::now() - start_time < std::chrono::milliseconds{10}) {
+            std::this_thread::yield();
+        }
+
+        u64 const end_ticks = now();
+        std::chrono::duration<f64> const elapsed = Clock::now() - start_time;
+
+        return static_cast<f64>(end_ticks - start_ticks) / elapsed.count();
+    }();
+
+    return ticks_per_second;
+}
+
+/**
+ * Converts a number of ticks to seconds.
+ *
+ * @param ticks The number of ticks
+ *
+ * @return The number of seconds
+ */
+[[nodiscard]] inline f64 toSeconds(u64 ticks) noexcept {
+    return static_cast<f64>(ticks) / ticksPerSecond();
+}
+
+}  // namespace Tsc
+
+}  // namespace Zeus
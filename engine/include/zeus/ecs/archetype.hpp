@@ -0,0 +1,249 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/ecs/component.hpp"
+#include "zeus/ecs/entity.hpp"
+
+/**
+ * @file archetype.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * The size of a chunk unless a single row does not fit into it.
+ */
+inline constexpr std::size_t chunk_size = 16 * 1024;
+
+/**
+ * A block of rows of an archetype.
+ *
+ * A chunk stores its entities and every component type of its archetype as
+ * separate arrays (SoA), each starting on a cache line, so a system streams
+ * through exactly the components it uses.
+ */
+struct Chunk {
+    std::byte* data = nullptr;
+    u32 count = 0;
+};
+
+/**
+ * Stores every entity that has exactly the same set of component types.
+ *
+ * Rows are kept dense: only the last chunk can be partly filled, and
+ * removing a row moves the last row into its place.
+ */
+class Archetype {
+   public:
+    /**
+     * Marks a component that is not part of the archetype.
+     */
+    static constexpr u8 no_column = 0xFF;
+
+    /**
+     * Constructs an empty archetype.
+     *
+     * @param mask The component types of its entities
+     */
+    explicit Archetype(ComponentMask mask);
+
+    Archetype(Archetype const&) = delete;
+    Archetype(Archetype&&) = delete;
+    Archetype& operator=(Archetype const&) = delete;
+    Archetype& operator=(Archetype&&) = delete;
+
+    /**
+     * Destroys the remaining components and frees the chunks.
+     */
+    ~Archetype();
+
+    /**
+     * Returns the component types of the archetype.
+     */
+    [[nodiscard]] ComponentMask mask() const noexcept { return mask_; }
+
+    /**
+     * Returns whether the archetype has the given component type.
+     */
+    [[nodiscard]] bool has(ComponentId id) const noexcept {
+        return column_of_[id] != no_column;
+    }
+
+    /**
+     * Returns the number of rows a chunk holds.
+     */
+    [[nodiscard]] u32 capacity() const noexcept { return capacity_; }
+
+    /**
+     * Returns the number of rows.
+     */
+    [[nodiscard]] u32 size() const noexcept { return size_; }
+
+    /**
+     * Returns the number of chunks.
+     */
+    [[nodiscard]] std::size_t chunkCount() const noexcept {
+        return chunks_.size();
+    }
+
+    /**
+     * Returns a chunk.
+     */
+    [[nodiscard]] Chunk const& chunk(std::size_t index) const noexcept {
+        return chunks_[index];
+    }
+
+    /**
+     * Returns the entities of a chunk.
+     */
+    [[nodiscard]] Entity* entities(std::size_t chunk) const noexcept {
+        return reinterpret_cast<Entity*>(chunks_[chunk].data);
+    }
+
+    /**
+     * Returns the array of a component type in a chunk.
+     *
+     * @tparam T The component type, which the archetype must have
+     */
+    template <typename T>
+    [[nodiscard]] T* column(std::size_t chunk) const noexcept {
+        ComponentId const id = componentId<std::remove_cv_t<T>>();
+
+        ZEUS_MODULE_ASSERT(ECS, DEBUG, has(id),
+                           "The archetype does not have the component.");
+
+        return reinterpret_cast<T*>(chunks_[chunk].data +
+                                    columns_[column_of_[id]].offset);
+    }
+
+    /**
+     * Returns the entity in a row.
+     */
+    [[nodiscard]] Entity entity(u32 row) const noexcept {
+        return entities(row / capacity_)[row % capacity_];
+    }
+
+    /**
+     * Returns the storage of a component in a row.
+     *
+     * @param id    The component type, which the archetype must have
+     * @param row   The row
+     */
+    [[nodiscard]] void* component(ComponentId id, u32 row) const noexcept {
+        Column const& column = columns_[column_of_[id]];
+
+        return chunks_[row / capacity_].data + column.offset +
+               static_cast<std::size_t>(row % capacity_) * column.info->size;
+    }
+
+    /**
+     * Appends a row for an entity, allocating a chunk if the last one is
+     * full.
+     *
+     * @note The components of the row are not constructed.
+     *
+     * @param entity The entity of the row
+     *
+     * @return The new row
+     */
+    u32 allocate(Entity entity);
+
+    /**
+     * Removes a row by moving the last row into it.
+     *
+     * @param row       The row to remove
+     * @param destroy   Whether to destroy the components of the row, false
+     *                  if they have been moved out already
+     *
+     * @return The entity that was moved into the row, null if the removed
+     * row was the last one
+     */
+    Entity remove(u32 row, bool destroy) noexcept;
+
+    /**
+     * Returns the archetype with one more component type, nullptr until
+     * it has been set.
+     */
+    [[nodiscard]] Archetype* addEdge(ComponentId id) const noexcept {
+        return add_edges_[id];
+    }
+
+    /**
+     * Returns the archetype with one less component type, nullptr until
+     * it has been set.
+     */
+    [[nodiscard]] Archetype* removeEdge(ComponentId id) const noexcept {
+        return remove_edges_[id];
+    }
+
+    void setAddEdge(ComponentId id, Archetype* archetype) noexcept {
+        add_edges_[id] = archetype;
+    }
+
+    void setRemoveEdge(ComponentId id, Archetype* archetype) noexcept {
+        remove_edges_[id] = archetype;
+    }
+
+    /**
+     * Calls a function with the id of every component type, in order.
+     */
+    template <typename Function>
+    void forEachComponent(Function&& function) const {
+        for (Column const& column : columns_) {
+            function(column.id);
+        }
+    }
+
+   private:
+    struct Column {
+        ComponentId id;
+        ComponentInfo const* info;
+
+        // The byte offset of the array in a chunk
+        std::size_t offset;
+    };
+
+    void destroyRow(u32 row) noexcept;
+
+    ComponentMask mask_;
+    std::vector<Column> columns_;
+    std::array<u8, max_components> column_of_;
+    std::size_t chunk_bytes_ = chunk_size;
+    u32 capacity_ = 0;
+    u32 size_ = 0;
+    std::vector<Chunk> chunks_;
+
+    // Cached transitions to the archetypes that differ by one component
+    std::array<Archetype*, max_components> add_edges_{};
+    std::array<Archetype*, max_components> remove_edges_{};
+};
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,142 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/types.hpp"
+
+/**
+ * @file component.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * A dense id of a component type, from 0 to max_components - 1.
+ */
+using ComponentId = u32;
+
+/**
+ * A set of component types with one bit per component id.
+ */
+using ComponentMask = u64;
+
+/**
+ * The maximum number of component types, one per bit of a ComponentMask.
+ */
+inline constexpr u32 max_components = 64;
+
+/**
+ * How to store, move and destroy the components of a type without knowing
+ * the type.
+ */
+struct ComponentInfo {
+    std::size_t size;
+    std::size_t alignment;
+
+    // Move constructs a component at the destination from the source and
+    // destroys the source, nullptr if copying the bytes is enough
+    void (*relocate)(void* destination, void* source) noexcept;
+
+    // Destroys a component, nullptr if it is trivially destructible
+    void (*destroy)(void* component) noexcept;
+};
+
+namespace Detail {
+
+template <typename T>
+void relocate(void* destination, void* source) noexcept {
+    T* const from = std::launder(static_cast<T*>(source));
+
+    ::new (destination) T(std::move(*from));
+    from->~T();
+}
+
+template <typename T>
+void destroy(void* component) noexcept {
+    std::launder(static_cast<T*>(component))->~T();
+}
+
+/**
+ * Assigns the next component id to a component type.
+ *
+ * @param info How to handle components of the type
+ *
+ * @return The id
+ */
+ComponentId registerComponent(ComponentInfo const& info) noexcept;
+
+}  // namespace Detail
+
+/**
+ * Returns the id of a component type, assigning one on first use.
+ *
+ * @note Ids are assigned in the order of first use, so they can differ
+ * between runs.
+ *
+ * @tparam T The component type
+ *
+ * @return The id
+ */
+template <typename T>
+[[nodiscard]] ComponentId componentId() noexcept {
+    static_assert(std::is_same_v<T, std::remove_cv_t<T>>,
+                  "Components are identified by their unqualified type.");
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+                      std::is_nothrow_destructible_v<T>,
+                  "Components are moved between chunks and must not throw.");
+
+    static ComponentId const id = Detail::registerComponent(
+        {sizeof(T), alignof(T),
+         std::is_trivially_copyable_v<T> ? nullptr : &Detail::relocate<T>,
+         std::is_trivially_destructible_v<T> ? nullptr : &Detail::destroy<T>});
+
+    return id;
+}
+
+/**
+ * Returns the mask of a set of component types.
+ *
+ * @tparam Components The component types, cv qualifiers are ignored
+ */
+template <typename... Components>
+[[nodiscard]] ComponentMask componentMask() noexcept {
+    return (ComponentMask{0} | ... |
+            (ComponentMask{1}
+             << componentId<std::remove_cv_t<Components>>()));
+}
+
+/**
+ * Returns how to handle the components with the given id.
+ *
+ * @param id A component id returned by componentId()
+ *
+ * @return The description of the component type
+ */
+[[nodiscard]] ComponentInfo const& componentInfo(ComponentId id) noexcept;
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,46 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "zeus/core/handle.hpp"
+
+/**
+ * @file entity.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * Makes entity handles incompatible with other handles.
+ */
+struct EntityTag;
+
+/**
+ * Identifies an entity of a World.
+ *
+ * @note The generation detects handles to destroyed entities, even after
+ * their index has been reused.
+ */
+using Entity = Handle64<EntityTag>;
+
+}  // namespace Ecs
+
+}  // namespace Zeus
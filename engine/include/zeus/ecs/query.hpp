@@ -0,0 +1,253 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/types.hpp"
+#include "zeus/ecs/archetype.hpp"
+#include "zeus/ecs/component.hpp"
+#include "zeus/ecs/entity.hpp"
+#include "zeus/ecs/world.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * @file query.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * Iterates the entities of a World that have every given component type.
+ *
+ * The matching archetypes are cached. Each iteration only checks the
+ * archetypes created since the previous one, so a query costs nothing to
+ * find its data once the world's set of archetypes is stable.
+ *
+ * A const component type declares read access, e.g.
+ * Query<Transform, Velocity const> writes transforms and reads velocities,
+ * and its functions receive Transform& and Velocity const&.
+ *
+ * @note A query must not be iterated by two threads at once since iterating
+ * updates its cache. Structural changes to the world during an iteration
+ * are not allowed.
+ *
+ * @tparam Components The component types to match, each at most once
+ */
+template <typename... Components>
+class Query {
+   public:
+    static_assert(sizeof...(Components) > 0);
+
+    /**
+     * Constructs a query over a world.
+     *
+     * @param world The world to iterate
+     */
+    explicit Query(World& world) noexcept : world_{&world} {}
+
+    /**
+     * Returns the component types the query reads but does not write.
+     */
+    [[nodiscard]] static ComponentMask reads() noexcept {
+        return (ComponentMask{0} | ... |
+                (std::is_const_v<Components> ? componentMask<Components>()
+                                             : ComponentMask{0}));
+    }
+
+    /**
+     * Returns the component types the query writes.
+     */
+    [[nodiscard]] static ComponentMask writes() noexcept {
+        return (ComponentMask{0} | ... |
+                (std::is_const_v<Components> ? ComponentMask{0}
+                                             : componentMask<Components>()));
+    }
+
+    /**
+     * Returns the number of matching entities.
+     */
+    [[nodiscard]] std::size_t count() {
+        refresh();
+
+        std::size_t count = 0;
+
+        for (Archetype const* archetype : archetypes_) {
+            count += archetype->size();
+        }
+
+        return count;
+    }
+
+    /**
+     * Calls a function for every chunk of matching entities.
+     *
+     * @param function Called as function(count, entities, components...)
+     *                 with the number of entities in the chunk and a pointer
+     *                 to the array of each component type, in the order of
+     *                 the query's template arguments
+     */
+    template <typename Function>
+    void eachChunk(Function&& function) {
+        refresh();
+
+        for (Archetype const* archetype : archetypes_) {
+            for (std::size_t chunk = 0; chunk < archetype->chunkCount();
+                 ++chunk) {
+                visit(*archetype, chunk, function);
+            }
+        }
+    }
+
+    /**
+     * Calls a function for every matching entity.
+     *
+     * @param function Called as function(components&...) or as
+     *                 function(entity, components&...)
+     */
+    template <typename Function>
+    void each(Function&& function) {
+        eachChunk(
+            [&function](u32 count, Entity const* entities,
+                        Components*... components) {
+                forEachRow(function, count, entities, components...);
+            });
+    }
+
+    /**
+     * Calls a function for every chunk of matching entities in parallel and
+     * waits for all of them.
+     *
+     * @param system    The System or FiberSystem to run on
+     * @param function  Called like the function of eachChunk(), from several
+     *                  threads at once
+     * @param grain     The number of chunks not split any further, zero picks
+     *                  one automatically
+     */
+    template <typename Scheduler, typename Function>
+    void parallelEachChunk(Scheduler& system, Function&& function,
+                           std::size_t grain = 0) {
+        refresh();
+
+        chunks_.clear();
+
+        for (Archetype const* archetype : archetypes_) {
+            for (std::size_t chunk = 0; chunk < archetype->chunkCount();
+                 ++chunk) {
+                chunks_.push_back({archetype, chunk});
+            }
+        }
+
+        Job::parallelFor(system, chunks_, grain,
+                         [&function](ChunkRef const* first,
+                                     ChunkRef const* last) {
+                             for (; first != last; ++first) {
+                                 visit(*first->archetype, first->chunk,
+                                       function);
+                             }
+                         });
+    }
+
+    /**
+     * Calls a function for every matching entity in parallel and waits for
+     * all of them.
+     *
+     * @param system    The System or FiberSystem to run on
+     * @param function  Called like the function of each(), from several
+     *                  threads at once
+     * @param grain     The number of chunks not split any further, zero picks
+     *                  one automatically
+     */
+    template <typename Scheduler, typename Function>
+    void parallelEach(Scheduler& system, Function&& function,
+                      std::size_t grain = 0) {
+        parallelEachChunk(
+            system,
+            [&function](u32 count, Entity const* entities,
+                        Components*... components) {
+                forEachRow(function, count, entities, components...);
+            },
+            grain);
+    }
+
+   private:
+    /**
+     * A chunk to visit in a parallel iteration.
+     */
+    struct ChunkRef {
+        Archetype const* archetype;
+        std::size_t chunk;
+    };
+
+    /**
+     * Adds the matching archetypes created since the previous refresh.
+     */
+    void refresh() {
+        ComponentMask const required = componentMask<Components...>();
+
+        for (; seen_ < world_->archetypeCount(); ++seen_) {
+            Archetype const& archetype = world_->archetype(seen_);
+
+            if ((archetype.mask() & required) == required) {
+                archetypes_.push_back(&archetype);
+            }
+        }
+    }
+
+    template <typename Function>
+    static void visit(Archetype const& archetype, std::size_t chunk,
+                      Function& function) {
+        u32 const count = archetype.chunk(chunk).count;
+
+        if (count > 0) {
+            Entity const* const entities = archetype.entities(chunk);
+
+            function(count, entities,
+                     archetype.column<Components>(chunk)...);
+        }
+    }
+
+    template <typename Function>
+    static void forEachRow(Function& function, u32 count,
+                           Entity const* entities,
+                           Components*... components) {
+        for (u32 row = 0; row < count; ++row) {
+            if constexpr (std::is_invocable_v<Function&, Entity,
+                                              Components&...>) {
+                function(entities[row], components[row]...);
+            } else {
+                function(components[row]...);
+            }
+        }
+    }
+
+    World* world_;
+    std::size_t seen_ = 0;
+    std::vector<Archetype const*> archetypes_;
+    std::vector<ChunkRef> chunks_;
+};
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,193 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/profiler.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/ecs/component.hpp"
+#include "zeus/ecs/query.hpp"
+#include "zeus/ecs/world.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * @file schedule.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * Runs systems over a World, in parallel where their component access
+ * allows it.
+ *
+ * A system declares the components it reads and writes through the types
+ * of its query. Two systems conflict if one writes a component the other
+ * reads or writes. Each system is placed in the stage after the last
+ * earlier system it conflicts with, so systems keep the order they were
+ * added in wherever it matters. The systems of a stage run as parallel jobs
+ * and a stage starts when the previous one has finished.
+ */
+class Schedule {
+   public:
+    /**
+     * Constructs a schedule without systems.
+     *
+     * @param world The world the systems run on
+     */
+    explicit Schedule(World& world) noexcept : world_{&world} {}
+
+    /**
+     * Adds a system that iterates a query.
+     *
+     * @note The system must not make structural changes to the world, use
+     * addExclusive() for that.
+     *
+     * @param name      The name of the system and of its profile zone
+     * @param function  Called as function(query) with a cached
+     *                  Query<Components...> every time the schedule runs
+     */
+    template <typename... Components, typename Function>
+    void add(std::string name, Function&& function) {
+        using SystemQuery = Query<Components...>;
+
+        auto query = std::make_shared<SystemQuery>(*world_);
+
+        addSystem(std::move(name), SystemQuery::reads(),
+                  SystemQuery::writes(),
+                  [query, function = std::forward<Function>(function)]() {
+                      function(*query);
+                  });
+    }
+
+    /**
+     * Adds a system that runs alone and can change anything, e.g. to create
+     * and destroy entities.
+     *
+     * @param name      The name of the system and of its profile zone
+     * @param function  Called as function(world) every time the schedule
+     *                  runs
+     */
+    template <typename Function>
+    void addExclusive(std::string name, Function&& function) {
+        World* world = world_;
+
+        addSystem(std::move(name), ~ComponentMask{0}, ~ComponentMask{0},
+                  [world, function = std::forward<Function>(function)]() {
+                      function(*world);
+                  });
+    }
+
+    /**
+     * Runs every system once, stage by stage on the calling thread.
+     */
+    void run();
+
+    /**
+     * Runs every system once, the systems of a stage as parallel jobs.
+     *
+     * @param system The System or FiberSystem to run on
+     */
+    template <typename Scheduler>
+    void run(Scheduler& system) {
+        for (auto const& stage : stages_) {
+            if (stage.size() == 1) {
+                runSystem(systems_[stage.front()]);
+                continue;
+            }
+
+            Job::Counter counter;
+
+            for (std::size_t const index : stage) {
+                System const* entry = &systems_[index];
+
+                system.run(counter, [entry] { runSystem(*entry); });
+            }
+
+            system.wait(counter);
+        }
+    }
+
+    /**
+     * Returns the number of systems.
+     */
+    [[nodiscard]] std::size_t systemCount() const noexcept {
+        return systems_.size();
+    }
+
+    /**
+     * Returns the name of a system.
+     *
+     * @param system The index of the system in the order it was added
+     */
+    [[nodiscard]] std::string const& name(std::size_t system) const noexcept {
+        return systems_[system].name;
+    }
+
+    /**
+     * Returns the number of stages.
+     */
+    [[nodiscard]] std::size_t stageCount() const noexcept {
+        return stages_.size();
+    }
+
+    /**
+     * Returns the stage of a system.
+     *
+     * @param system The index of the system in the order it was added
+     */
+    [[nodiscard]] std::size_t stageOf(std::size_t system) const noexcept {
+        return systems_[system].stage;
+    }
+
+   private:
+    struct System {
+        std::string name;
+        ComponentMask reads;
+        ComponentMask writes;
+        std::size_t stage;
+        std::function<void()> function;
+
+        // The profile zone named after the system
+        Profiler::Site const* site;
+    };
+
+    static void runSystem(System const& system) {
+        ZEUS_PROFILE_SITE(*system.site);
+        system.function();
+    }
+
+    void addSystem(std::string name, ComponentMask reads, ComponentMask writes,
+                   std::function<void()> function);
+
+    World* world_;
+    std::vector<System> systems_;
+    std::vector<std::vector<std::size_t>> stages_;
+};
+
+}  // namespace Ecs
+
+}  // namespace Zeus
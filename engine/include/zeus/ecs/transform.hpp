@@ -0,0 +1,45 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * @file transform.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * The placement of an entity.
+ */
+struct Transform {
+    Math::Vector3D position{0.0F, 0.0F, 0.0F};
+
+    // Euler angles in radians, applied in the order x, y, z
+    Math::Vector3D rotation{0.0F, 0.0F, 0.0F};
+
+    Math::Vector3D scale{1.0F, 1.0F, 1.0F};
+};
+
+}  // namespace Ecs
+
+}  // namespace Zeus
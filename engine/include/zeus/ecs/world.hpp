@@ -0,0 +1,279 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "zeus/container/flat_hash_map.hpp"
+#include "zeus/core/assert.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/ecs/archetype.hpp"
+#include "zeus/ecs/component.hpp"
+#include "zeus/ecs/entity.hpp"
+
+/**
+ * @file world.hpp
+ */
+
+namespace Zeus {
+
+namespace Ecs {
+
+/**
+ * Owns entities and their components.
+ *
+ * Entities with the same set of component types share an Archetype, which
+ * stores them in 16 KiB chunks of component arrays. Adding or removing a
+ * component moves the entity to the archetype of its new set, found through
+ * edges cached on the archetypes. A Query iterates the matching archetypes
+ * chunk by chunk.
+ *
+ * @note Adding and removing entities and components changes the world's
+ * structure and must not overlap with any other use of the world. Reading and
+ * writing existing components can happen in parallel, which is what a
+ * Schedule coordinates.
+ */
+class World {
+   public:
+    /**
+     * Constructs a world without entities.
+     */
+    World();
+
+    World(World const&) = delete;
+    World(World&&) = delete;
+    World& operator=(World const&) = delete;
+    World& operator=(World&&) = delete;
+
+    ~World();
+
+    /**
+     * Creates an entity without components.
+     *
+     * @return The new entity
+     */
+    Entity create();
+
+    /**
+     * Creates an entity with the given components.
+     *
+     * @param components The components, each of a different type
+     *
+     * @return The new entity
+     */
+    template <typename... Components>
+    Entity create(Components&&... components) {
+        static_assert(sizeof...(Components) > 0);
+
+        ComponentMask const mask =
+            componentMask<std::decay_t<Components>...>();
+
+        ZEUS_MODULE_ASSERT(ECS, DEBUG,
+                           bitCount(mask) == sizeof...(Components),
+                           "An entity has at most one component of a type.");
+
+        // Copies can throw, so build the components before taking a row.
+        std::tuple<std::decay_t<Components>...> values(
+            std::forward<Components>(components)...);
+
+        Archetype& archetype = archetypeFor(mask);
+        Entity const entity = allocateEntity();
+        u32 const row = archetype.allocate(entity);
+
+        std::apply(
+            [&](auto&... value) {
+                (::new (archetype.component(
+                     componentId<std::decay_t<decltype(value)>>(), row))
+                     std::decay_t<decltype(value)>(std::move(value)),
+                 ...);
+            },
+            values);
+
+        place(entity, archetype, row);
+
+        return entity;
+    }
+
+    /**
+     * Destroys an entity and its components, does nothing if it is not
+     * alive.
+     *
+     * @param entity The entity to destroy
+     */
+    void destroy(Entity entity) noexcept;
+
+    /**
+     * Returns whether an entity has been created and not destroyed.
+     */
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept {
+        return entity.index() < records_.size() &&
+               records_[entity.index()].generation == entity.generation() &&
+               records_[entity.index()].archetype != nullptr;
+    }
+
+    /**
+     * Returns whether an entity is alive and has a component.
+     *
+     * @tparam T The component type
+     */
+    template <typename T>
+    [[nodiscard]] bool has(Entity entity) const noexcept {
+        return isAlive(entity) && records_[entity.index()].archetype->has(
+                                      componentId<T>());
+    }
+
+    /**
+     * Returns a component of an entity.
+     *
+     * @note The pointer is invalidated by structural changes to the world.
+     *
+     * @tparam T The component type
+     *
+     * @return The component or nullptr if the entity is not alive or does
+     * not have it
+     */
+    template <typename T>
+    [[nodiscard]] T* get(Entity entity) const noexcept {
+        if (!has<T>(entity)) {
+            return nullptr;
+        }
+
+        Record const& record = records_[entity.index()];
+
+        return std::launder(static_cast<T*>(
+            record.archetype->component(componentId<T>(), record.row)));
+    }
+
+    /**
+     * Adds a component to an entity, or replaces it if the entity already
+     * has one.
+     *
+     * @param entity    An entity that is alive
+     * @param args      The arguments to construct the component with
+     *
+     * @return The component
+     */
+    template <typename T, typename... Args>
+    T& add(Entity entity, Args&&... args) {
+        ZEUS_MODULE_ASSERT(ECS, DEBUG, isAlive(entity),
+                           "Components can only be added to live entities.");
+
+        ComponentId const id = componentId<T>();
+        Record& record = records_[entity.index()];
+
+        if (record.archetype->has(id)) {
+            T& component = *get<T>(entity);
+            component = make<T>(std::forward<Args>(args)...);
+
+            return component;
+        }
+
+        // The constructor can throw, so run it before the entity moves.
+        T value = make<T>(std::forward<Args>(args)...);
+
+        Archetype& target = withComponent(*record.archetype, id);
+        u32 const row = move(entity, target);
+
+        return *::new (target.component(id, row)) T(std::move(value));
+    }
+
+    /**
+     * Removes a component from an entity.
+     *
+     * @tparam T The component type
+     *
+     * @return False if the entity is not alive or did not have the component
+     */
+    template <typename T>
+    bool remove(Entity entity) {
+        return removeComponent(entity, componentId<T>());
+    }
+
+    /**
+     * Returns the number of live entities.
+     */
+    [[nodiscard]] std::size_t entityCount() const noexcept {
+        return entity_count_;
+    }
+
+    /**
+     * Returns the number of archetypes, which never shrinks.
+     */
+    [[nodiscard]] std::size_t archetypeCount() const noexcept {
+        return archetypes_.size();
+    }
+
+    /**
+     * Returns an archetype, in the order they were created.
+     */
+    [[nodiscard]] Archetype& archetype(std::size_t index) const noexcept {
+        return *archetypes_[index];
+    }
+
+   private:
+    /**
+     * Where the components of an entity are stored.
+     */
+    struct Record {
+        // Null while the entity index is free
+        Archetype* archetype = nullptr;
+        u32 row = 0;
+        u32 generation = 0;
+    };
+
+    static u32 bitCount(ComponentMask mask) noexcept;
+
+    /**
+     * Constructs a component with parentheses or, for aggregates, braces.
+     */
+    template <typename T, typename... Args>
+    static T make(Args&&... args) {
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+
+    Entity allocateEntity();
+    void place(Entity entity, Archetype& archetype, u32 row) noexcept;
+    Archetype& archetypeFor(ComponentMask mask);
+    Archetype& withComponent(Archetype& from, ComponentId id);
+    Archetype& withoutComponent(Archetype& from, ComponentId id);
+    u32 move(Entity entity, Archetype& to);
+    bool removeComponent(Entity entity, ComponentId id);
+
+    std::vector<Record> records_;
+    std::vector<u32> free_indices_;
+    std::size_t entity_count_ = 0;
+
+    std::vector<std::unique_ptr<Archetype>> archetypes_;
+    FlatHashMap<ComponentMask, Archetype*> archetype_of_mask_;
+    Archetype* empty_;
+};
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,114 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "zeus/core/compiler_macros.hpp"
+
+// The hand-written context switch covers x86-64 System V, everything else
+// goes through ucontext
+#ifndef ZEUS_FIBER_USE_UCONTEXT
+#if (ZEUS_IS_GCC_OR_CLANG) && defined(__x86_64__) && !defined(_WIN32)
+#define ZEUS_FIBER_USE_UCONTEXT 0
+#else
+#define ZEUS_FIBER_USE_UCONTEXT 1
+#endif
+#endif
+
+#if ZEUS_FIBER_USE_UCONTEXT
+#include <ucontext.h>
+#endif
+
+/**
+ * @file fiber.hpp
+ */
+
+namespace Zeus {
+
+namespace Job {
+
+/**
+ * A user-space execution context with its own stack.
+ *
+ * Switching between fibers saves the callee-saved registers of the running
+ * context and restores those of the target, which costs a few nanoseconds
+ * instead of the microseconds a kernel context switch takes.
+ *
+ * A default constructed fiber has no stack of its own, switching away from
+ * it saves the context of the calling thread so that it can be resumed
+ * later.
+ *
+ * @note Only available on POSIX systems. x86-64 uses a hand-written context
+ * switch, other architectures or ZEUS_FIBER_USE_UCONTEXT=1 use ucontext,
+ * which also saves the signal mask with a system call.
+ */
+class Fiber {
+   public:
+    /**
+     * The function a fiber starts in.
+     *
+     * @note The function must never return, switch to another fiber instead.
+     */
+    using Entry = void (*)(void* argument);
+
+    /**
+     * Constructs a fiber that is used to save the context of a thread.
+     */
+    Fiber() noexcept = default;
+
+    /**
+     * Constructs a fiber that starts in the given function the first time it
+     * is switched to.
+     *
+     * @param stack         The lowest address of the stack
+     * @param stack_size    The size of the stack in bytes
+     * @param entry         The function to start in
+     * @param argument      The argument passed to the function
+     */
+    Fiber(void* stack, std::size_t stack_size, Entry entry,
+          void* argument) noexcept;
+
+    Fiber(Fiber const&) = delete;
+    Fiber(Fiber&&) = delete;
+    Fiber& operator=(Fiber const&) = delete;
+    Fiber& operator=(Fiber&&) = delete;
+    ~Fiber() = default;
+
+    /**
+     * Saves the running context in this fiber and resumes the target.
+     *
+     * @note Returns once another fiber switches back to this one, possibly on
+     * another thread.
+     *
+     * @param target The fiber to resume
+     */
+    void switchTo(Fiber& target) noexcept;
+
+   private:
+#if ZEUS_FIBER_USE_UCONTEXT
+    ucontext_t context_{};
+#else
+    void* stack_pointer_ = nullptr;
+#endif
+};
+
+}  // namespace Job
+
+}  // namespace Zeus
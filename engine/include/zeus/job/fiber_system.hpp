@@ -0,0 +1,220 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/types.hpp"
+#include "zeus/job/fiber.hpp"
+#include "zeus/job/job_system.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file fiber_system.hpp
+ */
+
+namespace Zeus {
+
+namespace Job {
+
+namespace Detail {
+
+/**
+ * The state of a thread taking part in a fiber system.
+ */
+struct FiberWorker;
+
+/**
+ * What the fiber that was switched to does for the fiber it replaced.
+ */
+struct AfterSwitch;
+
+}  // namespace Detail
+
+/**
+ * A work-stealing job system that runs jobs on fibers.
+ *
+ * Works like System, but waiting on a counter that is not done yet suspends
+ * the waiting fiber instead of running other jobs on top of it. The worker
+ * switches to a fresh fiber from a pool and keeps running jobs. Once the
+ * counter reaches zero, the next worker looking for work resumes the
+ * suspended fiber, possibly on another thread.
+ *
+ * The thread that constructed the system is worker 0. When it waits, its own
+ * context is suspended the same way but is only ever resumed on that thread.
+ *
+ * If every fiber of the pool is suspended, waiting falls back to running
+ * other jobs on top of the waiting one like System::wait().
+ *
+ * @note Jobs that wait may continue on a different thread, so they must not
+ * keep pointers to thread_local data across a wait or hold locks across it.
+ *
+ * @note Only available on POSIX systems.
+ */
+class FiberSystem {
+   public:
+    /**
+     * The default number of fibers in the pool.
+     */
+    static constexpr std::size_t default_fiber_count = 128;
+
+    /**
+     * The default size of a fiber stack in bytes.
+     */
+    static constexpr std::size_t default_stack_size = 64 * 1024;
+
+    /**
+     * The index returned by workerIndex() for a thread that is not a worker
+     * of the system.
+     */
+    static constexpr std::size_t invalid_worker = System::invalid_worker;
+
+    /**
+     * Starts a fiber system.
+     *
+     * @note Every fiber stack is followed by an inaccessible guard page, so a
+     * stack overflow crashes instead of corrupting another stack.
+     *
+     * @param thread_count  The number of workers including the calling
+     *                      thread, zero means one per core
+     * @param affinity      Whether the started threads are pinned to cores
+     * @param fiber_count   The number of fibers in the pool, at least one more
+     *                      than the number of started threads
+     * @param stack_size    The size of every fiber stack, rounded up to the
+     *                      page size
+     */
+    explicit FiberSystem(std::size_t thread_count = 0,
+                         Affinity affinity = Affinity::Pinned,
+                         std::size_t fiber_count = default_fiber_count,
+                         std::size_t stack_size = default_stack_size);
+
+    FiberSystem(FiberSystem const&) = delete;
+    FiberSystem(FiberSystem&&) = delete;
+    FiberSystem& operator=(FiberSystem const&) = delete;
+    FiberSystem& operator=(FiberSystem&&) = delete;
+
+    /**
+     * Stops and joins the worker threads and releases the fiber stacks.
+     *
+     * @note Every counter must have been waited on before the system is
+     * destroyed.
+     */
+    ~FiberSystem();
+
+    /**
+     * Runs a function object as a job.
+     *
+     * @see System::run()
+     *
+     * @param counter   The counter to report to once the job has finished
+     * @param function  The function object to run, called with no arguments
+     */
+    template <typename Function>
+    void run(Counter& counter, Function&& function) {
+        Detail::Job& job = allocate();
+        Detail::emplaceJob(job, counter.value_,
+                           std::forward<Function>(function));
+        submit(job);
+    }
+
+    /**
+     * Suspends the calling fiber until every job reporting to the counter
+     * has finished.
+     *
+     * @param counter The counter to wait on
+     */
+    void wait(Counter const& counter) noexcept;
+
+    /**
+     * Returns the number of workers including the thread that constructed
+     * the system.
+     *
+     * @return The number of workers
+     */
+    [[nodiscard]] std::size_t threadCount() const noexcept {
+        return scheduler_.workerCount();
+    }
+
+    /**
+     * Returns the number of fibers in the pool.
+     *
+     * @return The number of fibers
+     */
+    [[nodiscard]] std::size_t fiberCount() const noexcept {
+        return fiber_count_;
+    }
+
+    /**
+     * Returns the index of the calling thread in the system.
+     *
+     * @return The worker index or invalid_worker
+     */
+    [[nodiscard]] std::size_t workerIndex() const noexcept;
+
+   private:
+    /**
+     * A fiber suspended until its counter is done.
+     */
+    struct Waiting {
+        Fiber* fiber;
+        Counter const* counter;
+
+        // The only worker allowed to resume the fiber, or invalid_worker
+        std::size_t owner;
+    };
+
+    static void fiberMain(void* system) noexcept;
+
+    Detail::FiberWorker& current() const noexcept;
+    Detail::FiberWorker& fiberWorker(std::size_t index) noexcept;
+    Detail::Job& allocate() noexcept;
+    void submit(Detail::Job& job);
+    Fiber* acquireFiber() noexcept;
+    Fiber* takeReady(Detail::FiberWorker& worker) noexcept;
+    bool hasWork(Detail::FiberWorker& worker) noexcept;
+    void switchTo(Fiber& target, Detail::AfterSwitch const& after) noexcept;
+    void afterSwitch() noexcept;
+    void schedule() noexcept;
+    void threadMain(Detail::FiberWorker& worker, Fiber& fiber) noexcept;
+    void idle(Detail::FiberWorker& worker) noexcept;
+
+    Detail::WorkStealingScheduler scheduler_;
+
+    // Every fiber stack lives in one reservation
+    void* stacks_ = nullptr;
+    std::size_t stack_stride_ = 0;
+    std::size_t fiber_count_ = 0;
+    std::vector<std::unique_ptr<Fiber>> fibers_;
+
+    std::mutex free_mutex_;
+    std::vector<Fiber*> free_fibers_;
+
+    alignas(Memory::cache_line_size) std::atomic<u32> waiting_count_{0};
+    std::mutex waiting_mutex_;
+    std::vector<Waiting> waiting_;
+};
+
+}  // namespace Job
+
+}  // namespace Zeus
@@ -0,0 +1,571 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "zeus/core/types.hpp"
+#include "zeus/job/work_stealing_deque.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file job_system.hpp
+ */
+
+namespace Zeus {
+
+namespace Job {
+
+namespace Detail {
+
+/**
+ * The number of bytes a job can store its function object in.
+ */
+inline constexpr std::size_t job_payload_size = 48;
+
+/**
+ * A unit of work together with the counter it reports to.
+ *
+ * Jobs live in per-thread rings and are recycled once their function has
+ * been moved out of the payload, so running jobs never allocates.
+ */
+struct alignas(Memory::cache_line_size) Job {
+    using Function = void (*)(Job&);
+
+    /**
+     * Runs the job, null while the slot is free.
+     */
+    std::atomic<Function> function{nullptr};
+
+    /**
+     * Decremented once the job has finished.
+     */
+    std::atomic<u32>* counter = nullptr;
+
+    alignas(std::max_align_t) std::array<std::byte, job_payload_size> payload;
+};
+
+static_assert(sizeof(Job) == Memory::cache_line_size,
+              "A job should fill exactly one cache line.");
+
+/**
+ * Runs a job whose payload holds a function object of type Callable.
+ */
+template <typename Callable>
+void invokeJob(Job& job) noexcept {
+    auto* stored =
+        std::launder(reinterpret_cast<Callable*>(job.payload.data()));
+
+    // Free the slot before running so a job can spawn any number of jobs
+    // without waiting on its own slot
+    Callable callable{std::move(*stored)};
+    stored->~Callable();
+    job.function.store(nullptr, std::memory_order_release);
+
+    callable();
+}
+
+/**
+ * Moves a function object into a free job and counts the job on the
+ * counter.
+ */
+template <typename Function>
+void emplaceJob(Job& job, std::atomic<u32>& counter, Function&& function) {
+    using Callable = std::decay_t<Function>;
+
+    static_assert(sizeof(Callable) <= job_payload_size,
+                  "The job does not fit in a job payload, capture large "
+                  "state by reference instead.");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                  "The job is over-aligned.");
+
+    ::new (static_cast<void*>(job.payload.data()))
+        Callable(std::forward<Function>(function));
+    job.counter = &counter;
+    job.function.store(&invokeJob<Callable>, std::memory_order_relaxed);
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Runs a job and counts it as finished.
+ */
+inline void executeJob(Job& job) noexcept {
+    // The job frees its slot while running, so read everything needed first
+    std::atomic<u32>* const counter = job.counter;
+    Job::Function const function = job.function.load(std::memory_order_relaxed);
+
+    function(job);
+    counter->fetch_sub(1, std::memory_order_release);
+}
+
+}  // namespace Detail
+
+/**
+ * Counts the jobs of a batch that have not finished yet.
+ *
+ * Pass a counter to System::run() for every job of a batch and then wait on
+ * it with System::wait() to join the batch.
+ *
+ * @note A counter must outlive every job that reports to it.
+ */
+class Counter {
+   public:
+    Counter() noexcept = default;
+    Counter(Counter const&) = delete;
+    Counter(Counter&&) = delete;
+    Counter& operator=(Counter const&) = delete;
+    Counter& operator=(Counter&&) = delete;
+    ~Counter() = default;
+
+    /**
+     * Returns whether every job reporting to the counter has finished.
+     *
+     * @note Writes made by the finished jobs are visible to the caller once
+     * this returns true.
+     *
+     * @return True if no jobs are pending
+     */
+    [[nodiscard]] bool done() const noexcept {
+        return value_.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * Returns the number of pending jobs.
+     *
+     * @return The number of jobs that have not finished
+     */
+    [[nodiscard]] u32 value() const noexcept {
+        return value_.load(std::memory_order_acquire);
+    }
+
+   private:
+    friend class FiberSystem;
+    friend class System;
+
+    std::atomic<u32> value_{0};
+};
+
+/**
+ * Whether worker threads are pinned to cores.
+ */
+enum class Affinity {
+    /**
+     * Worker i runs only on core i, which keeps its caches warm.
+     */
+    Pinned,
+
+    /**
+     * The operating system schedules the workers.
+     */
+    Unpinned
+};
+
+namespace Detail {
+
+/**
+ * Names the thread of a worker and pins it to a core if requested.
+ */
+void configureWorkerThread(std::thread& thread, std::size_t index,
+                           Affinity affinity) noexcept;
+
+class WorkStealingScheduler;
+
+/**
+ * The state of a thread taking part in a job system.
+ */
+struct Worker {
+    Worker(WorkStealingScheduler& owner, std::size_t worker_index,
+           std::size_t job_count);
+
+    Worker(Worker const&) = delete;
+    Worker(Worker&&) = delete;
+    Worker& operator=(Worker const&) = delete;
+    Worker& operator=(Worker&&) = delete;
+    virtual ~Worker();
+
+    WorkStealingDeque<Job*> deque;
+    WorkStealingScheduler* scheduler;
+    std::size_t index;
+
+    // The ring of jobs this worker hands out, next_job only grows
+    std::unique_ptr<Job[]> jobs;
+    std::size_t job_mask;
+    std::size_t next_job = 0;
+
+    // Picks the first victim to steal from
+    u64 random;
+
+    std::thread thread;
+};
+
+/**
+ * The work-stealing scheduler shared by System and FiberSystem.
+ *
+ * Every worker owns a WorkStealingDeque of jobs: it pushes and pops its own
+ * jobs at the bottom and, when it runs out, steals the oldest job of a random
+ * other worker. Workers that find nothing to do sleep until a new job is
+ * submitted.
+ *
+ * @note The systems decide what their threads run and how a worker waits,
+ * the scheduler only owns the workers and their jobs.
+ */
+class WorkStealingScheduler {
+   public:
+    /**
+     * The number of times an idle worker looks for work before it sleeps.
+     */
+    static constexpr int spin_count = 256;
+
+    /**
+     * The number of failed attempts after which a waiting thread yields its
+     * time slice instead of spinning.
+     */
+    static constexpr int yield_after = 64;
+
+    WorkStealingScheduler() noexcept = default;
+    WorkStealingScheduler(WorkStealingScheduler const&) = delete;
+    WorkStealingScheduler(WorkStealingScheduler&&) = delete;
+    WorkStealingScheduler& operator=(WorkStealingScheduler const&) = delete;
+    WorkStealingScheduler& operator=(WorkStealingScheduler&&) = delete;
+    ~WorkStealingScheduler() = default;
+
+    /**
+     * Adds a worker, the index of the worker is the number of workers added
+     * before it.
+     */
+    void addWorker(std::unique_ptr<Worker> worker);
+
+    [[nodiscard]] Worker& worker(std::size_t index) const noexcept {
+        return *workers_[index];
+    }
+
+    [[nodiscard]] std::size_t workerCount() const noexcept {
+        return workers_.size();
+    }
+
+    /**
+     * Returns the next free job of the given worker, running other jobs
+     * while every job of the worker is in flight.
+     */
+    Job& allocate(Worker& worker) noexcept;
+
+    /**
+     * Pushes a job onto the deque of the given worker and wakes a sleeping
+     * worker.
+     */
+    void submit(Worker& worker, Job& job);
+
+    /**
+     * Pops a job of the given worker or steals one from another worker.
+     *
+     * @return The job or nullptr if no worker has queued jobs
+     */
+    Job* find(Worker& worker) noexcept;
+
+    /**
+     * Runs jobs on the given worker until the counter is done.
+     */
+    void runUntil(Worker& worker, Counter const& counter) noexcept;
+
+    /**
+     * Checks if any worker has queued jobs.
+     */
+    [[nodiscard]] bool hasQueuedJobs() const noexcept;
+
+    /**
+     * Puts the calling worker to sleep until a job is submitted or the
+     * scheduler stops.
+     *
+     * @param has_work Called once the worker counts as sleeping, the worker
+     *                 does not sleep if it returns true
+     */
+    template <typename HasWork>
+    void sleep(HasWork&& has_work) noexcept {
+        sleeping_.fetch_add(1, std::memory_order_relaxed);
+
+        // Pairs with the fence in submit() so that either the submitting
+        // thread sees the sleeper or the sleeper sees the job
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        u64 epoch = 0;
+
+        {
+            std::lock_guard const lock{sleep_mutex_};
+            epoch = wake_epoch_;
+        }
+
+        // A job submitted before the fence is seen here, any later one
+        // changes the epoch
+        if (!has_work() && !stopping()) {
+            std::unique_lock lock{sleep_mutex_};
+            sleep_condition_.wait(lock, [this, epoch] {
+                return wake_epoch_ != epoch || stopping();
+            });
+        }
+
+        sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Wakes every worker and joins the threads of the workers.
+     */
+    void stop() noexcept;
+
+    [[nodiscard]] bool stopping() const noexcept {
+        return stopping_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    void wake() noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> stopping_{false};
+
+    // Sleeping workers wait for wake_epoch_ to change
+    alignas(Memory::cache_line_size) std::atomic<u32> sleeping_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_condition_;
+    u64 wake_epoch_ = 0;
+};
+
+}  // namespace Detail
+
+/**
+ * A work-stealing job system.
+ *
+ * The thread that constructs the system becomes worker 0 and the system
+ * starts one more thread for every other worker. Every worker owns a
+ * WorkStealingDeque of jobs: it pushes and pops its own jobs at the bottom
+ * and, when it runs out, steals the oldest job of a random other worker.
+ * Workers that find nothing to do spin briefly and then sleep until a new
+ * job is pushed.
+ *
+ * Fork/join is expressed with a Counter. Waiting on a counter never blocks,
+ * the waiting thread runs other jobs until the counter reaches zero, so jobs
+ * can wait on jobs they spawned.
+ *
+ * @note Only the workers of a system, including the thread that constructed
+ * it, may run jobs on it or wait on it.
+ *
+ * @note Jobs must not throw, an exception escaping a job calls
+ * std::terminate.
+ */
+class System {
+   public:
+    /**
+     * The default number of jobs a thread can have in flight before it has to
+     * help finish older jobs.
+     */
+    static constexpr std::size_t default_jobs_per_thread = 4096;
+
+    /**
+     * The index returned by workerIndex() for a thread that is not a worker
+     * of the system.
+     */
+    static constexpr std::size_t invalid_worker =
+        std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Starts a job system.
+     *
+     * @param thread_count      The number of workers including the calling
+     *                          thread, zero means one per core
+     * @param affinity          Whether the started threads are pinned to
+     *                          cores, the calling thread is never pinned
+     * @param jobs_per_thread   The number of jobs a thread can have in
+     *                          flight, rounded up to a power of two
+     */
+    explicit System(std::size_t thread_count = 0,
+                    Affinity affinity = Affinity::Pinned,
+                    std::size_t jobs_per_thread = default_jobs_per_thread);
+
+    System(System const&) = delete;
+    System(System&&) = delete;
+    System& operator=(System const&) = delete;
+    System& operator=(System&&) = delete;
+
+    /**
+     * Stops and joins the worker threads.
+     *
+     * @note Every counter must have been waited on before the system is
+     * destroyed.
+     */
+    ~System();
+
+    /**
+     * Runs a function object as a job.
+     *
+     * @note The function object is moved into the job so it must fit in
+     * Detail::job_payload_size bytes. Capture large state by reference.
+     *
+     * @param counter   The counter to report to once the job has finished
+     * @param function  The function object to run, called with no arguments
+     */
+    template <typename Function>
+    void run(Counter& counter, Function&& function) {
+        Detail::Worker& worker = current();
+        Detail::Job& job = scheduler_.allocate(worker);
+        Detail::emplaceJob(job, counter.value_,
+                           std::forward<Function>(function));
+        scheduler_.submit(worker, job);
+    }
+
+    /**
+     * Runs other jobs until every job reporting to the counter has finished.
+     *
+     * @param counter The counter to wait on
+     */
+    void wait(Counter const& counter) noexcept;
+
+    /**
+     * Returns the number of workers including the thread that constructed
+     * the system.
+     *
+     * @return The number of workers
+     */
+    [[nodiscard]] std::size_t threadCount() const noexcept {
+        return scheduler_.workerCount();
+    }
+
+    /**
+     * Returns the index of the calling thread in the system.
+     *
+     * @note The index is in the range [0, threadCount()), the thread that
+     * constructed the system is worker 0.
+     *
+     * @return The worker index or invalid_worker
+     */
+    [[nodiscard]] std::size_t workerIndex() const noexcept;
+
+   private:
+    Detail::Worker& current() const noexcept;
+    void workerMain(Detail::Worker& worker) noexcept;
+    void idle(Detail::Worker& worker) noexcept;
+
+    Detail::WorkStealingScheduler scheduler_;
+};
+
+namespace Detail {
+
+/**
+ * Shared state of a parallelFor() call.
+ */
+template <typename Scheduler, typename Function>
+struct ParallelFor {
+    Scheduler& system;
+    Counter& counter;
+    Function& function;
+    std::size_t grain;
+};
+
+/**
+ * Runs a range of a parallelFor(), splitting off the upper half as a new job
+ * until the range is no larger than the grain.
+ *
+ * Thieves take the oldest and therefore largest halves, so the range is only
+ * split as finely as the idle workers demand.
+ */
+template <typename Scheduler, typename Function>
+void parallelForRange(ParallelFor<Scheduler, Function> const& state,
+                      std::size_t begin, std::size_t end) {
+    while (end - begin > state.grain) {
+        std::size_t const middle = begin + (end - begin) / 2;
+
+        state.system.run(state.counter, [&state, middle, end] {
+            parallelForRange(state, middle, end);
+        });
+
+        end = middle;
+    }
+
+    state.function(begin, end);
+}
+
+}  // namespace Detail
+
+/**
+ * Calls a function for every subrange of [begin, end) in parallel and waits
+ * for all of them to finish.
+ *
+ * @param system    The System or FiberSystem to run on
+ * @param begin     The first index
+ * @param end       One past the last index
+ * @param grain     The largest subrange that is not split any further, zero
+ *                  picks one that gives every worker several subranges
+ * @param function  Called as function(first, last) for every subrange
+ */
+template <typename Scheduler, typename Function>
+void parallelFor(Scheduler& system, std::size_t begin, std::size_t end,
+                 std::size_t grain, Function&& function) {
+    if (begin >= end) {
+        return;
+    }
+
+    if (grain == 0) {
+        constexpr std::size_t ranges_per_worker = 8;
+
+        grain = (end - begin) / (system.threadCount() * ranges_per_worker);
+    }
+
+    Counter counter;
+    Detail::ParallelFor<Scheduler, std::remove_reference_t<Function>> const
+        state{system, counter, function, grain > 0 ? grain : 1};
+
+    Detail::parallelForRange(state, begin, end);
+    system.wait(counter);
+}
+
+/**
+ * Calls a function for every subrange of a contiguous range in parallel and
+ * waits for all of them to finish.
+ *
+ * @param system    The System or FiberSystem to run on
+ * @param range     A contiguous range, such as a std::vector of Vector3D
+ * @param grain     The largest number of elements that is not split any
+ *                  further, zero picks one automatically
+ * @param function  Called as function(first, last) with pointers to the
+ *                  elements of every subrange
+ */
+template <typename Scheduler, typename Range, typename Function,
+          typename = decltype(std::data(std::declval<Range&>()))>
+void parallelFor(Scheduler& system, Range&& range, std::size_t grain,
+                 Function&& function) {
+    auto* const data = std::data(range);
+
+    parallelFor(system, 0, std::size(range), grain,
+                [data, &function](std::size_t first, std::size_t last) {
+                    function(data + first, data + last);
+                });
+}
+
+}  // namespace Job
+
+}  // namespace Zeus
@@ -0,0 +1,251 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "zeus/core/bit.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file work_stealing_deque.hpp
+ */
+
+namespace Zeus {
+
+namespace Job {
+
+/**
+ * A Chase-Lev work-stealing deque.
+ *
+ * The owning thread pushes and pops items at the bottom of the deque like a
+ * stack while any other thread can steal items from the top. Pushing and
+ * popping only synchronize with thieves when the deque is almost empty, so
+ * the owner usually runs without contention.
+ *
+ * The deque grows when it is full. Buffers that were replaced are kept until
+ * the deque is destroyed since a thief may still be reading from them.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê,
+ * Pop, Cohen and Zappa Nardelli.
+ *
+ * @tparam T The type of the items, usually a pointer
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WorkStealingDeque items must be trivially copyable.");
+
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * The default number of items the deque can hold before it grows.
+     */
+    static constexpr size_type default_capacity = 1024;
+
+    /**
+     * Constructs an empty deque.
+     *
+     * @param capacity The initial capacity, rounded up to a power of two
+     */
+    explicit WorkStealingDeque(size_type capacity = default_capacity) {
+        auto const width =
+            bitWidth(static_cast<u64>(std::max<size_type>(capacity, 2) - 1));
+        auto buffer = std::make_unique<Buffer>(size_type{1} << width);
+        buffer_.store(buffer.get(), std::memory_order_relaxed);
+        buffers_.push_back(std::move(buffer));
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+    ~WorkStealingDeque() = default;
+
+    /**
+     * Pushes an item onto the bottom of the deque.
+     *
+     * @note Must only be called by the owning thread.
+     *
+     * @param item The item to push
+     */
+    void push(T item) {
+        i64 const bottom = bottom_.load(std::memory_order_relaxed);
+        i64 const top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<i64>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+
+        // A release store rather than the paper's release fence, which is as
+        // cheap and is understood by ThreadSanitizer
+        buffer->store(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * Pops the most recently pushed item from the bottom of the deque.
+     *
+     * @note Must only be called by the owning thread.
+     *
+     * @return The item or an empty optional if the deque is empty
+     */
+    [[nodiscard]] std::optional<T> pop() noexcept {
+        i64 const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+            return std::nullopt;
+        }
+
+        T const item = buffer->load(bottom);
+
+        if (top != bottom) {
+            return item;
+        }
+
+        // The last item, race the thieves for it
+        bool const won = top_.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst,
+            std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+        return won ? std::optional<T>{item} : std::nullopt;
+    }
+
+    /**
+     * Steals the oldest item from the top of the deque.
+     *
+     * @note May be called by any thread.
+     *
+     * @return The item or an empty optional if the deque is empty or another
+     * thread took the item first
+     */
+    [[nodiscard]] std::optional<T> steal() noexcept {
+        i64 top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 const bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+
+        T const item = buffer_.load(std::memory_order_acquire)->load(top);
+
+        if (!top_.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+
+        return item;
+    }
+
+    /**
+     * Returns an estimate of the number of items in the deque.
+     *
+     * @return The number of items, which may be stale by the time it is used
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        i64 const bottom = bottom_.load(std::memory_order_relaxed);
+        i64 const top = top_.load(std::memory_order_relaxed);
+
+        return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+
+    /**
+     * Returns whether the deque appears to be empty.
+     *
+     * @return True if the deque was empty when checked
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * Returns the number of items the deque can hold before it grows.
+     *
+     * @note Must only be called by the owning thread.
+     *
+     * @return The capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return buffer_.load(std::memory_order_relaxed)->mask + 1;
+    }
+
+   private:
+    /**
+     * A circular array of items indexed by the unbounded top and bottom.
+     */
+    struct Buffer {
+        explicit Buffer(size_type capacity)
+            : mask{capacity - 1},
+              items{std::make_unique<std::atomic<T>[]>(capacity)} {}
+
+        T load(i64 index) const noexcept {
+            return items[static_cast<size_type>(index) & mask].load(
+                std::memory_order_relaxed);
+        }
+
+        void store(i64 index, T item) noexcept {
+            items[static_cast<size_type>(index) & mask].store(
+                item, std::memory_order_relaxed);
+        }
+
+        size_type mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Buffer* grow(Buffer* old, i64 top, i64 bottom) {
+        auto buffer = std::make_unique<Buffer>((old->mask + 1) * 2);
+
+        for (i64 index = top; index < bottom; ++index) {
+            buffer->store(index, old->load(index));
+        }
+
+        Buffer* grown = buffer.get();
+        buffers_.push_back(std::move(buffer));
+        buffer_.store(grown, std::memory_order_release);
+
+        return grown;
+    }
+
+    alignas(Memory::cache_line_size) std::atomic<i64> top_{0};
+    alignas(Memory::cache_line_size) std::atomic<i64> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+
+    // Every buffer the deque has used, only touched by the owner
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}  // namespace Job
+
+}  // namespace Zeus
@@ -0,0 +1,164 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "zeus/core/types.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * @file matrix_3x4.hpp
+ */
+
+namespace Zeus {
+
+namespace Math {
+
+/**
+ * An affine 3D transform, the top three rows of a 4x4 matrix whose last row
+ * is (0, 0, 0, 1).
+ *
+ * The left 3x3 block rotates and scales, the last column translates. Points
+ * are column vectors, so (a * b) applies b first.
+ *
+ * @note Every row is aligned to four values so it can be loaded as one SIMD
+ * register.
+ *
+ * @tparam T The element type
+ */
+template <typename T>
+struct alignas(sizeof(T) * 4) BasicMatrix3x4 {
+    using value_type = T;
+
+    using this_type = BasicMatrix3x4<value_type>;
+
+    /**
+     * The elements, indexed by row and then column.
+     */
+    value_type m[3][4];
+
+    /**
+     * Returns a matrix that does not transform.
+     *
+     * @return The identity matrix
+     */
+    [[nodiscard]] static constexpr this_type identity() noexcept {
+        return this_type{{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}}};
+    }
+
+    /**
+     * Returns the translation of this matrix.
+     *
+     * @return Where the origin is moved to
+     */
+    [[nodiscard]] constexpr BasicVector3D<value_type> translation()
+        const noexcept {
+        return BasicVector3D<value_type>{m[0][3], m[1][3], m[2][3]};
+    }
+};
+
+/**
+ * Combines the two given transforms.
+ *
+ * @tparam T The element type for the two given matrices
+ *
+ * @param lhs The transform applied last
+ * @param rhs The transform applied first
+ *
+ * @return A new matrix that applies rhs and then lhs
+ */
+template <typename T>
+[[nodiscard]] constexpr BasicMatrix3x4<T> operator*(
+    BasicMatrix3x4<T> const& lhs, BasicMatrix3x4<T> const& rhs) noexcept {
+    BasicMatrix3x4<T> result{};
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.m[row][column] = lhs.m[row][0] * rhs.m[0][column] +
+                                    lhs.m[row][1] * rhs.m[1][column] +
+                                    lhs.m[row][2] * rhs.m[2][column];
+        }
+
+        result.m[row][3] += lhs.m[row][3];
+    }
+
+    return result;
+}
+
+/**
+ * Transforms the given point.
+ *
+ * @tparam T The element type for the given matrix and point
+ *
+ * @param matrix    The transform
+ * @param point     The point to transform
+ *
+ * @return The transformed point
+ */
+template <typename T>
+[[nodiscard]] constexpr BasicVector3D<T> transformPoint(
+    BasicMatrix3x4<T> const& matrix, BasicVector3D<T> const& point) noexcept {
+    auto const row = [&](int index) {
+        return matrix.m[index][0] * point.x + matrix.m[index][1] * point.y +
+               matrix.m[index][2] * point.z + matrix.m[index][3];
+    };
+
+    return BasicVector3D<T>{row(0), row(1), row(2)};
+}
+
+/**
+ * Returns the transform that scales, then rotates and then translates.
+ *
+ * @tparam T The element type
+ *
+ * @param position  The translation
+ * @param rotation  Euler angles in radians, applied in the order x, y, z
+ * @param scale     The scale along each axis
+ *
+ * @return The matrix of the transform
+ */
+template <typename T>
+[[nodiscard]] BasicMatrix3x4<T> fromTransform(
+    BasicVector3D<T> const& position, BasicVector3D<T> const& rotation,
+    BasicVector3D<T> const& scale) noexcept {
+    T const cx = std::cos(rotation.x);
+    T const sx = std::sin(rotation.x);
+    T const cy = std::cos(rotation.y);
+    T const sy = std::sin(rotation.y);
+    T const cz = std::cos(rotation.z);
+    T const sz = std::sin(rotation.z);
+
+    // The columns of Rz * Ry * Rx, each multiplied by its scale
+    return BasicMatrix3x4<T>{
+        {{cz * cy * scale.x, (cz * sy * sx - sz * cx) * scale.y,
+          (cz * sy * cx + sz * sx) * scale.z, position.x},
+         {sz * cy * scale.x, (sz * sy * sx + cz * cx) * scale.y,
+          (sz * sy * cx - cz * sx) * scale.z, position.y},
+         {-sy * scale.x, cy * sx * scale.y, cy * cx * scale.z, position.z}}};
+}
+
+/**
+ * An alias of a 32-bit affine matrix.
+ */
+using Matrix3x4 = BasicMatrix3x4<f32>;
+
+}  // namespace Math
+
+}  // namespace Zeus
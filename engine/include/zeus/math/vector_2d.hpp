@@ -22,6 +22,8 @@
 #include <stdexcept>
 
 #include "zeus/core/assert.hpp"
+#include "zeus/core/format.hpp"
+#include "zeus/core/hash.hpp"
 #include "zeus/core/types.hpp"
 #include "zeus/math/type_traits.hpp"
 
@@ -89,7 +91,7 @@ struct BasicVector2D {
      * @return A reference to the specified element
      */
     [[nodiscard]] constexpr reference operator[](size_type position) noexcept {
-        ZEUS_ASSERT(position <= 1 && position >= 0);
+        ZEUS_MODULE_ASSERT(MATH, DEBUG, position <= 1 && position >= 0);
 
         return (&(this->x))[position];
     }
@@ -105,7 +107,7 @@ struct BasicVector2D {
      */
     [[nodiscard]] constexpr const_reference operator[](
         size_type position) const noexcept {
-        ZEUS_ASSERT(position <= 1 && position >= 0);
+        ZEUS_MODULE_ASSERT(MATH, DEBUG, position <= 1 && position >= 0);
 
         return (&(this->x))[position];
     }
@@ -346,7 +348,7 @@ template <typename T>
                                                    T scalar) noexcept {
     T const scale = static_cast<T>(1.0f / scalar);
 
-    return BasicVector2D<T>{vec.x * scalar, vec.y * scalar};
+    return BasicVector2D<T>{vec.x * scale, vec.y * scale};
 }
 
 /**
@@ -389,7 +391,8 @@ template <typename T>
  * @return The normalization
  */
 template <typename T>
-[[nodiscard]] constexpr T normalize(BasicVector2D<T> const& vec) noexcept {
+[[nodiscard]] constexpr BasicVector2D<T> normalize(
+    BasicVector2D<T> const& vec) noexcept {
     // TODO: Replace with better version
     return vec / magnitude(vec);
 }
@@ -465,4 +468,45 @@ template <typename T>
     return vec[position];
 }
 
+/**
+ * Formats a 2D vector as "(x, y)".
+ */
+template <typename T>
+struct Formatter<Math::BasicVector2D<T>> {
+    static void format(FormatBuffer& out,
+                       Math::BasicVector2D<T> const& vec) noexcept {
+        out.push_back('(');
+        formatValue(out, vec.x);
+        out.append(", ");
+        formatValue(out, vec.y);
+        out.push_back(')');
+    }
+};
+
+/**
+ * Hashes a 2D vector by combining the hashes of its coordinates.
+ *
+ * @note Coordinates of 0.0 and -0.0 hash equally since they compare equal.
+ */
+template <typename T>
+struct Hash<Math::BasicVector2D<T>> {
+    std::size_t operator()(Math::BasicVector2D<T> const& vec) const noexcept {
+        u64 hash = Hash<T>{}(vec.x);
+        hash = hashCombine(hash, Hash<T>{}(vec.y));
+
+        return static_cast<std::size_t>(hash);
+    }
+};
+
 }  // namespace Zeus
+
+namespace std {
+
+/**
+ * Hashes 2D vectors with Zeus::Hash.
+ */
+template <typename T>
+struct hash<Zeus::Math::BasicVector2D<T>>
+    : Zeus::Hash<Zeus::Math::BasicVector2D<T>> {};
+
+}  // namespace std
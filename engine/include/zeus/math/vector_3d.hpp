@@ -22,6 +22,8 @@
 #include <stdexcept>
 
 #include "zeus/core/assert.hpp"
+#include "zeus/core/format.hpp"
+#include "zeus/core/hash.hpp"
 #include "zeus/core/types.hpp"
 #include "zeus/math/type_traits.hpp"
 
@@ -96,7 +98,7 @@ struct BasicVector3D {
      * @return A reference to the specified element
      */
     [[nodiscard]] constexpr reference operator[](size_type position) noexcept {
-        ZEUS_ASSERT(position <= 2 && position >= 0);
+        ZEUS_MODULE_ASSERT(MATH, DEBUG, position <= 2 && position >= 0);
 
         return (&(this->x))[position];
     }
@@ -112,7 +114,7 @@ struct BasicVector3D {
      */
     [[nodiscard]] constexpr const_reference operator[](
         size_type position) const noexcept {
-        ZEUS_ASSERT(position <= 2 && position >= 0);
+        ZEUS_MODULE_ASSERT(MATH, DEBUG, position <= 2 && position >= 0);
 
         return (&(this->x))[position];
     }
@@ -356,7 +358,7 @@ template <typename T>
                                                    T scalar) noexcept {
     T const scale = static_cast<T>(1.0f / scalar);
 
-    return BasicVector3D<T>{vec.x * scalar, vec.y * scalar, vec.z * scalar};
+    return BasicVector3D<T>{vec.x * scale, vec.y * scale, vec.z * scale};
 }
 
 /**
@@ -399,7 +401,8 @@ template <typename T>
  * @return The normalization
  */
 template <typename T>
-[[nodiscard]] constexpr T normalize(BasicVector3D<T> const& vec) noexcept {
+[[nodiscard]] constexpr BasicVector3D<T> normalize(
+    BasicVector3D<T> const& vec) noexcept {
     // TODO: Replace with better version
     return vec / magnitude(vec);
 }
@@ -475,4 +478,48 @@ template <typename T>
     return vec[position];
 }
 
+/**
+ * Formats a 3D vector as "(x, y, z)".
+ */
+template <typename T>
+struct Formatter<Math::BasicVector3D<T>> {
+    static void format(FormatBuffer& out,
+                       Math::BasicVector3D<T> const& vec) noexcept {
+        out.push_back('(');
+        formatValue(out, vec.x);
+        out.append(", ");
+        formatValue(out, vec.y);
+        out.append(", ");
+        formatValue(out, vec.z);
+        out.push_back(')');
+    }
+};
+
+/**
+ * Hashes a 3D vector by combining the hashes of its coordinates.
+ *
+ * @note Coordinates of 0.0 and -0.0 hash equally since they compare equal.
+ */
+template <typename T>
+struct Hash<Math::BasicVector3D<T>> {
+    std::size_t operator()(Math::BasicVector3D<T> const& vec) const noexcept {
+        u64 hash = Hash<T>{}(vec.x);
+        hash = hashCombine(hash, Hash<T>{}(vec.y));
+        hash = hashCombine(hash, Hash<T>{}(vec.z));
+
+        return static_cast<std::size_t>(hash);
+    }
+};
+
 }  // namespace Zeus
+
+namespace std {
+
+/**
+ * Hashes 3D vectors with Zeus::Hash.
+ */
+template <typename T>
+struct hash<Zeus::Math::BasicVector3D<T>>
+    : Zeus::Hash<Zeus::Math::BasicVector3D<T>> {};
+
+}  // namespace std
@@ -0,0 +1,42 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file cache_line.hpp
+ */
+
+namespace Zeus {
+
+namespace Memory {
+
+/**
+ * The assumed size of a cache line in bytes.
+ *
+ * @note std::hardware_destructive_interference_size is not used since its
+ * value is allowed to change between compiler versions and flags, which would
+ * silently change the layout of types that use it.
+ */
+inline constexpr std::size_t cache_line_size = 64;
+
+}  // namespace Memory
+
+}  // namespace Zeus
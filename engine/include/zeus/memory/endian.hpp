@@ -20,9 +20,11 @@
 #include <cstddef>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "zeus/core/compiler_macros.hpp"
+#include "zeus/core/format.hpp"
 #include "zeus/core/types.hpp"
 
 /**
@@ -247,6 +249,17 @@ template <typename T>
     return byteSwapIf(Endian::Type::Native, Endian::Type::Big, value);
 }
 
+/**
+ * Returns the name of the given Endian value.
+ *
+ * @param endian The endian value to name
+ *
+ * @return The name of the given Endian value
+ */
+[[nodiscard]] constexpr std::string_view name(Type endian) noexcept {
+    return (endian == Type::Little) ? "Little" : "Big";
+}
+
 }  // namespace Endian
 
 }  // namespace Memory
@@ -254,15 +267,24 @@ template <typename T>
 /**
  * Returns a string representation of the given Endian value.
  *
+ * @note Allocates, prefer Endian::name() or formatting the value.
+ *
  * @param endian The endian value to turn into a string representation
  *
  * @return The string representation of the given Endian value
  */
-[[nodiscard]] ZEUS_FORCE_INLINE inline std::string to_string(
-    Zeus::Memory::Endian::Type endian) noexcept {
-    return (endian == Zeus::Memory::Endian::Type::Little) ? "Little" : "Big";
+[[nodiscard]] inline std::string to_string(Zeus::Memory::Endian::Type endian) {
+    return std::string{Zeus::Memory::Endian::name(endian)};
 }
 
+template <>
+struct Formatter<Memory::Endian::Type> {
+    static void format(FormatBuffer& out,
+                       Memory::Endian::Type endian) noexcept {
+        out.append(Memory::Endian::name(endian));
+    }
+};
+
 }  // namespace Zeus
 
 /**
@@ -276,5 +298,5 @@ template <typename T>
  */
 inline std::ostream& operator<<(std::ostream& stream,
                                 Zeus::Memory::Endian::Type endian) noexcept {
-    return stream << Zeus::to_string(endian);
+    return stream << Zeus::Memory::Endian::name(endian);
 }
@@ -0,0 +1,424 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "zeus/core/thread_index.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+#include "zeus/memory/tracking.hpp"
+
+/**
+ * @file pool_allocator.hpp
+ */
+
+namespace Zeus {
+
+namespace Memory {
+
+/**
+ * A fixed-size object pool for objects of type T.
+ *
+ * Storage is carved out of cache-line aligned slabs and free cells are
+ * threaded into intrusive free lists. Every thread owns a small cache of free
+ * cells in front of a lock-free global free list, so allocations and frees
+ * only touch shared state once per batch. Frees from a thread other than the
+ * allocating one simply land in that thread's cache.
+ *
+ * The pool grows one slab at a time and never relocates existing objects.
+ * Memory is only returned to the system when the pool is destroyed.
+ *
+ * Slabs are charged to the memory tag that was current when the pool was
+ * constructed.
+ *
+ * @note The pool does not track live objects. Objects still alive when the
+ * pool is destroyed are not destructed.
+ *
+ * @tparam T The type of the objects in the pool
+ */
+template <typename T>
+class PoolAllocator {
+   public:
+    using value_type = T;
+    using pointer = value_type*;
+    using size_type = std::size_t;
+
+    /**
+     * The default number of cells in a single slab.
+     */
+    static constexpr size_type default_cells_per_slab = 1024;
+
+    /**
+     * The maximum number of slabs a pool can grow to.
+     */
+    static constexpr size_type max_slab_count = 1024;
+
+    /**
+     * The number of cells moved between a thread cache and the global free
+     * list at a time.
+     */
+    static constexpr u32 batch_size = 32;
+
+    /**
+     * Constructs an empty pool.
+     *
+     * @note The number of cells per slab is rounded up to a power of two and
+     * the total capacity, max_slab_count slabs of cells_per_slab cells, must
+     * fit in 32 bits.
+     *
+     * @param cells_per_slab The number of objects each slab can hold
+     */
+    explicit PoolAllocator(
+        size_type cells_per_slab = default_cells_per_slab) noexcept
+        : slab_shift_{shiftFor(cells_per_slab)} {}
+
+    PoolAllocator(PoolAllocator const&) = delete;
+    PoolAllocator(PoolAllocator&&) = delete;
+    PoolAllocator& operator=(PoolAllocator const&) = delete;
+    PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+    /**
+     * Releases every slab back to the system.
+     */
+    ~PoolAllocator() {
+        for (auto& slab : slabs_) {
+            Cell* cells = slab.load(std::memory_order_relaxed);
+
+            if (cells != nullptr) {
+                ::operator delete(cells, std::align_val_t{slab_alignment});
+                ZEUS_TRACK_DEALLOCATION(tag_, slabBytes());
+            }
+        }
+    }
+
+    /**
+     * Allocates uninitialized storage for a single object.
+     *
+     * @throws std::bad_alloc if the pool cannot grow any further
+     *
+     * @return A pointer to the storage
+     */
+    [[nodiscard]] pointer allocate() {
+        std::size_t const thread = threadIndex();
+
+        if (thread == invalid_thread_index) {
+            return storageOf(popGlobalOrGrow());
+        }
+
+        ThreadCache& cache = caches_[thread];
+
+        if (cache.count == 0) {
+            refill(cache);
+        }
+
+        Cell* cell = cellAt(cache.head);
+        cache.head = cell->next.load(std::memory_order_relaxed);
+        --cache.count;
+
+        return storageOf(cell);
+    }
+
+    /**
+     * Returns the given storage to the pool.
+     *
+     * @note The storage may be returned from any thread.
+     *
+     * @param ptr Storage previously returned by allocate()
+     */
+    void deallocate(pointer ptr) noexcept {
+        Cell* cell = cellOf(ptr);
+        std::size_t const thread = threadIndex();
+
+        if (thread == invalid_thread_index) {
+            pushGlobal(cell, cell);
+
+            return;
+        }
+
+        ThreadCache& cache = caches_[thread];
+
+        cell->next.store(cache.head, std::memory_order_relaxed);
+        cache.head = cell->index;
+        ++cache.count;
+
+        if (cache.count >= 2 * batch_size) {
+            drain(cache);
+        }
+    }
+
+    /**
+     * Allocates and constructs an object using the given arguments.
+     *
+     * @param args The arguments to construct the object with
+     *
+     * @return A pointer to the new object
+     */
+    template <typename... Args>
+    [[nodiscard]] pointer create(Args&&... args) {
+        pointer ptr = allocate();
+
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            return ::new (static_cast<void*>(ptr))
+                T(std::forward<Args>(args)...);
+        } else {
+            try {
+                return ::new (static_cast<void*>(ptr))
+                    T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(ptr);
+
+                throw;
+            }
+        }
+    }
+
+    /**
+     * Destructs the given object and returns its storage to the pool.
+     *
+     * @param ptr An object previously returned by create()
+     */
+    void destroy(pointer ptr) noexcept {
+        if (ptr != nullptr) {
+            std::destroy_at(ptr);
+            deallocate(ptr);
+        }
+    }
+
+    /**
+     * Returns the number of objects the pool can hold without growing.
+     *
+     * @return The capacity of the pool
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return slab_count_.load(std::memory_order_acquire) << slab_shift_;
+    }
+
+   private:
+    static constexpr u32 null_index = ~u32{0};
+
+    static constexpr std::size_t slab_alignment =
+        alignof(T) > cache_line_size ? alignof(T) : cache_line_size;
+
+    /**
+     * A single pool entry.
+     *
+     * @note The free list link sits next to the storage instead of on top of
+     * it. A thread that lost a race in the lock-free pop may still read the
+     * link of a cell that another thread has just handed out, and this keeps
+     * that read from racing with the constructor of the new object.
+     */
+    struct Cell {
+        alignas(T) std::array<std::byte, sizeof(T)> storage;
+        std::atomic<u32> next;
+        u32 index;
+    };
+
+    static_assert(std::is_standard_layout_v<Cell>,
+                  "The storage must be at the start of a pool cell.");
+
+    /**
+     * The free cells owned by a single thread.
+     */
+    struct alignas(cache_line_size) ThreadCache {
+        u32 head = null_index;
+        u32 count = 0;
+    };
+
+    static constexpr u8 shiftFor(size_type cells_per_slab) noexcept {
+        u8 shift = 0;
+
+        while ((size_type{1} << shift) < cells_per_slab) {
+            ++shift;
+        }
+
+        return shift;
+    }
+
+    static constexpr u64 pack(u32 index, u32 tag) noexcept {
+        return (static_cast<u64>(tag) << 32) | index;
+    }
+
+    static constexpr u32 indexOf(u64 head) noexcept {
+        return static_cast<u32>(head);
+    }
+
+    static constexpr u32 tagOf(u64 head) noexcept {
+        return static_cast<u32>(head >> 32);
+    }
+
+    size_type slabBytes() const noexcept {
+        return (size_type{1} << slab_shift_) * sizeof(Cell);
+    }
+
+    static pointer storageOf(Cell* cell) noexcept {
+        return std::launder(reinterpret_cast<pointer>(cell->storage.data()));
+    }
+
+    static Cell* cellOf(pointer ptr) noexcept {
+        return reinterpret_cast<Cell*>(ptr);
+    }
+
+    Cell* cellAt(u32 index) const noexcept {
+        Cell* slab =
+            slabs_[index >> slab_shift_].load(std::memory_order_acquire);
+
+        return slab + (index & ((u32{1} << slab_shift_) - 1));
+    }
+
+    /**
+     * Pushes the chain of cells from first to last onto the global free list.
+     */
+    void pushGlobal(Cell* first, Cell* last) noexcept {
+        u64 head = global_head_.load(std::memory_order_relaxed);
+
+        do {
+            last->next.store(indexOf(head), std::memory_order_relaxed);
+        } while (!global_head_.compare_exchange_weak(
+            head, pack(first->index, tagOf(head) + 1),
+            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * Pops a single cell from the global free list.
+     *
+     * @return The popped cell or nullptr if the list is empty
+     */
+    Cell* popGlobal() noexcept {
+        u64 head = global_head_.load(std::memory_order_acquire);
+
+        while (indexOf(head) != null_index) {
+            Cell* cell = cellAt(indexOf(head));
+            u32 const next = cell->next.load(std::memory_order_relaxed);
+
+            // The tag changes on every successful update which prevents ABA
+            if (global_head_.compare_exchange_weak(
+                    head, pack(next, tagOf(head) + 1),
+                    std::memory_order_acquire, std::memory_order_acquire)) {
+                return cell;
+            }
+        }
+
+        return nullptr;
+    }
+
+    Cell* popGlobalOrGrow() {
+        Cell* cell = popGlobal();
+
+        return (cell != nullptr) ? cell : grow();
+    }
+
+    /**
+     * Adds a new slab to the pool.
+     *
+     * @return The first cell of the new slab which is not on any free list
+     */
+    Cell* grow() {
+        std::lock_guard<std::mutex> const lock{grow_mutex_};
+
+        // Another thread may have grown the pool while waiting on the lock
+        if (Cell* cell = popGlobal(); cell != nullptr) {
+            return cell;
+        }
+
+        size_type const slab = slab_count_.load(std::memory_order_relaxed);
+
+        if (slab == max_slab_count) {
+            throw std::bad_alloc{};
+        }
+
+        size_type const count = size_type{1} << slab_shift_;
+        auto* cells = static_cast<Cell*>(
+            ::operator new(slabBytes(), std::align_val_t{slab_alignment}));
+        ZEUS_TRACK_ALLOCATION(tag_, slabBytes());
+        u32 const base = static_cast<u32>(slab << slab_shift_);
+
+        for (size_type i = 0; i < count; ++i) {
+            Cell* cell = ::new (static_cast<void*>(cells + i)) Cell;
+
+            cell->index = base + static_cast<u32>(i);
+            cell->next.store(base + static_cast<u32>(i) + 1,
+                             std::memory_order_relaxed);
+        }
+
+        slabs_[slab].store(cells, std::memory_order_release);
+        slab_count_.store(slab + 1, std::memory_order_release);
+
+        if (count > 1) {
+            pushGlobal(cells + 1, cells + count - 1);
+        }
+
+        return cells;
+    }
+
+    /**
+     * Moves up to a batch of cells from the global free list into the given
+     * thread cache, growing the pool if the global free list is empty.
+     */
+    void refill(ThreadCache& cache) {
+        Cell* cell = popGlobalOrGrow();
+
+        do {
+            cell->next.store(cache.head, std::memory_order_relaxed);
+            cache.head = cell->index;
+            ++cache.count;
+        } while (cache.count < batch_size && (cell = popGlobal()) != nullptr);
+    }
+
+    /**
+     * Moves a batch of cells from the given thread cache to the global free
+     * list.
+     */
+    void drain(ThreadCache& cache) noexcept {
+        Cell* first = cellAt(cache.head);
+        Cell* last = first;
+
+        for (u32 i = 1; i < batch_size; ++i) {
+            last = cellAt(last->next.load(std::memory_order_relaxed));
+        }
+
+        cache.head = last->next.load(std::memory_order_relaxed);
+        cache.count -= batch_size;
+
+        pushGlobal(first, last);
+    }
+
+    u8 const slab_shift_;
+    [[maybe_unused]] MemoryTag const tag_ = currentTag();
+
+    alignas(cache_line_size) std::atomic<u64> global_head_{
+        pack(null_index, 0)};
+
+    alignas(cache_line_size) std::atomic<size_type> slab_count_{0};
+    std::mutex grow_mutex_;
+    std::array<std::atomic<Cell*>, max_slab_count> slabs_{};
+
+    std::array<ThreadCache, max_thread_count> caches_{};
+};
+
+}  // namespace Memory
+
+}  // namespace Zeus
@@ -0,0 +1,475 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/macro_helpers.hpp"
+#include "zeus/core/thread_index.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+/**
+ * @file tracking.hpp
+ */
+
+namespace Zeus {
+
+namespace Memory {
+
+/**
+ * The subsystems that memory can be attributed to.
+ */
+enum class MemoryTag : u8 {
+    Unknown,
+    Core,
+    Containers,
+    Ecs,
+    Jobs,
+    Logging,
+    Scene,
+    Rendering,
+    Audio,
+    Physics,
+    Count
+};
+
+/**
+ * The number of memory tags.
+ */
+inline constexpr std::size_t memory_tag_count =
+    static_cast<std::size_t>(MemoryTag::Count);
+
+/**
+ * Returns the name of the given memory tag.
+ *
+ * @param tag The memory tag
+ *
+ * @return The name of the memory tag
+ */
+[[nodiscard]] constexpr std::string_view tagName(MemoryTag tag) noexcept {
+    constexpr std::array<std::string_view, memory_tag_count> names{
+        "Unknown", "Core",      "Containers", "Ecs",   "Jobs",
+        "Logging", "Scene",     "Rendering",  "Audio", "Physics"};
+
+    return (tag < MemoryTag::Count) ? names[static_cast<std::size_t>(tag)]
+                                    : "Invalid";
+}
+
+/**
+ * The memory statistics of a single tag.
+ */
+struct MemoryTagStats {
+    /**
+     * The number of bytes currently allocated.
+     */
+    i64 live_bytes = 0;
+
+    /**
+     * The largest number of bytes that were allocated at once.
+     */
+    i64 peak_bytes = 0;
+
+    /**
+     * The number of allocations made.
+     */
+    u64 allocation_count = 0;
+
+    /**
+     * The number of deallocations made.
+     */
+    u64 deallocation_count = 0;
+
+    /**
+     * The number of times the tag went over its budget.
+     */
+    u64 budget_alarm_count = 0;
+
+    /**
+     * Whether the tag is over its budget.
+     */
+    bool over_budget = false;
+};
+
+/**
+ * The memory statistics of every tag at a point in time.
+ */
+struct MemorySnapshot {
+    std::array<MemoryTagStats, memory_tag_count> tags{};
+
+    /**
+     * Returns the statistics of the given tag.
+     *
+     * @param tag The memory tag
+     *
+     * @return The statistics of the memory tag
+     */
+    [[nodiscard]] constexpr MemoryTagStats const& operator[](
+        MemoryTag tag) const noexcept {
+        return tags[static_cast<std::size_t>(tag)];
+    }
+
+    /**
+     * Returns the number of live bytes across every tag.
+     *
+     * @return The total number of live bytes
+     */
+    [[nodiscard]] constexpr i64 totalLiveBytes() const noexcept {
+        i64 total = 0;
+
+        for (auto const& stats : tags) {
+            total += stats.live_bytes;
+        }
+
+        return total;
+    }
+};
+
+namespace Detail {
+
+/**
+ * The number of bytes a thread accumulates before publishing them to the
+ * shared per-tag totals.
+ *
+ * @note Peak values and budget alarms are exact to within this many bytes per
+ * thread.
+ */
+inline constexpr i64 tracking_flush_threshold = i64{16} * 1024;
+
+/**
+ * Counters written only by the thread that owns them.
+ *
+ * @note Single writer counters are updated with a relaxed load and store
+ * instead of a read-modify-write so the hot path never locks the bus.
+ */
+struct alignas(cache_line_size) ThreadMemoryCounters {
+    std::array<std::atomic<i64>, memory_tag_count> pending_bytes{};
+    std::array<std::atomic<u64>, memory_tag_count> allocation_count{};
+    std::array<std::atomic<u64>, memory_tag_count> deallocation_count{};
+};
+
+/**
+ * Totals shared by every thread.
+ */
+struct alignas(cache_line_size) SharedMemoryCounters {
+    std::atomic<i64> live_bytes{0};
+    std::atomic<i64> peak_bytes{0};
+    std::atomic<i64> budget_bytes{0};
+    std::atomic<bool> over_budget{false};
+    std::atomic<u64> budget_alarm_count{0};
+
+    // Used by threads that could not get a thread index
+    std::atomic<u64> allocation_count{0};
+    std::atomic<u64> deallocation_count{0};
+};
+
+struct MemoryTrackingState {
+    std::array<ThreadMemoryCounters, max_thread_count> threads{};
+    std::array<SharedMemoryCounters, memory_tag_count> tags{};
+};
+
+[[nodiscard]] inline MemoryTrackingState& trackingState() noexcept {
+    static MemoryTrackingState state;
+
+    return state;
+}
+
+[[nodiscard]] inline MemoryTag& currentTagStorage() noexcept {
+    static thread_local MemoryTag tag = MemoryTag::Unknown;
+
+    return tag;
+}
+
+template <typename T>
+void increment(std::atomic<T>& counter, T amount) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+}
+
+/**
+ * Reports that the given tag went over its budget.
+ */
+inline void reportOverBudget([[maybe_unused]] MemoryTag tag,
+                             [[maybe_unused]] i64 live_bytes,
+                             [[maybe_unused]] i64 budget_bytes) noexcept {
+#ifdef ZEUS_ENABLE_LOGGING
+    std::array<char, 128> buffer{};
+    char* end = buffer.data() + buffer.size();
+
+    auto append = [&end](char* out, std::string_view text) {
+        for (char c : text) {
+            if (out != end) {
+                *out++ = c;
+            }
+        }
+
+        return out;
+    };
+
+    char* out = append(buffer.data(), "Memory budget exceeded for ");
+    out = append(out, tagName(tag));
+    out = append(out, ": ");
+    out = std::to_chars(out, end, live_bytes).ptr;
+    out = append(out, " of ");
+    out = std::to_chars(out, end, budget_bytes).ptr;
+    out = append(out, " bytes");
+
+    auto const size = static_cast<std::size_t>(out - buffer.data());
+
+    ZEUS_WARNING_LOG("Memory", std::string_view(buffer.data(), size));
+#endif
+}
+
+/**
+ * Publishes the given number of bytes to the shared totals of the given tag.
+ */
+inline void publish(MemoryTag tag, i64 bytes) noexcept {
+    SharedMemoryCounters& shared =
+        trackingState().tags[static_cast<std::size_t>(tag)];
+
+    i64 const live =
+        shared.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    i64 peak = shared.peak_bytes.load(std::memory_order_relaxed);
+
+    while (live > peak && !shared.peak_bytes.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed)) {
+    }
+
+    i64 const budget = shared.budget_bytes.load(std::memory_order_relaxed);
+
+    if (budget <= 0) {
+        return;
+    }
+
+    if (live > budget) {
+        if (!shared.over_budget.exchange(true, std::memory_order_relaxed)) {
+            shared.budget_alarm_count.fetch_add(1, std::memory_order_relaxed);
+            reportOverBudget(tag, live, budget);
+        }
+    } else if (shared.over_budget.load(std::memory_order_relaxed)) {
+        shared.over_budget.store(false, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Records the given change in bytes for the given tag.
+ */
+inline void record(MemoryTag tag, i64 bytes) noexcept {
+    std::size_t const thread = threadIndex();
+    auto const index = static_cast<std::size_t>(tag);
+
+    if (thread == invalid_thread_index) {
+        SharedMemoryCounters& shared = trackingState().tags[index];
+
+        (bytes >= 0 ? shared.allocation_count : shared.deallocation_count)
+            .fetch_add(1, std::memory_order_relaxed);
+        publish(tag, bytes);
+
+        return;
+    }
+
+    ThreadMemoryCounters& counters = trackingState().threads[thread];
+
+    increment(bytes >= 0 ? counters.allocation_count[index]
+                         : counters.deallocation_count[index],
+              u64{1});
+
+    i64 const pending =
+        counters.pending_bytes[index].load(std::memory_order_relaxed) + bytes;
+
+    if (pending >= tracking_flush_threshold ||
+        pending <= -tracking_flush_threshold) {
+        counters.pending_bytes[index].store(0, std::memory_order_relaxed);
+        publish(tag, pending);
+    } else {
+        counters.pending_bytes[index].store(pending,
+                                            std::memory_order_relaxed);
+    }
+}
+
+}  // namespace Detail
+
+/**
+ * Returns the memory tag at the top of the tag stack of the calling thread.
+ *
+ * @return The current memory tag
+ */
+[[nodiscard]] inline MemoryTag currentTag() noexcept {
+    return Detail::currentTagStorage();
+}
+
+/**
+ * Pushes a memory tag onto the tag stack of the calling thread for the
+ * lifetime of the object.
+ */
+class ScopedMemoryTag {
+   public:
+    /**
+     * Makes the given tag the current memory tag.
+     *
+     * @param tag The memory tag to push
+     */
+    explicit ScopedMemoryTag(MemoryTag tag) noexcept
+        : previous_{Detail::currentTagStorage()} {
+        Detail::currentTagStorage() = tag;
+    }
+
+    ScopedMemoryTag(ScopedMemoryTag const&) = delete;
+    ScopedMemoryTag(ScopedMemoryTag&&) = delete;
+    ScopedMemoryTag& operator=(ScopedMemoryTag const&) = delete;
+    ScopedMemoryTag& operator=(ScopedMemoryTag&&) = delete;
+
+    /**
+     * Restores the previous memory tag.
+     */
+    ~ScopedMemoryTag() {
+        Detail::currentTagStorage() = previous_;
+    }
+
+   private:
+    MemoryTag previous_;
+};
+
+/**
+ * Records an allocation of the given size for the given tag.
+ *
+ * @param tag   The memory tag that owns the allocation
+ * @param bytes The size of the allocation
+ */
+inline void recordAllocation(MemoryTag tag, std::size_t bytes) noexcept {
+    Detail::record(tag, static_cast<i64>(bytes));
+}
+
+/**
+ * Records a deallocation of the given size for the given tag.
+ *
+ * @param tag   The memory tag that owned the allocation
+ * @param bytes The size of the allocation
+ */
+inline void recordDeallocation(MemoryTag tag, std::size_t bytes) noexcept {
+    Detail::record(tag, -static_cast<i64>(bytes));
+}
+
+/**
+ * Records an allocation of the given size for the current memory tag.
+ *
+ * @param bytes The size of the allocation
+ */
+inline void recordAllocation(std::size_t bytes) noexcept {
+    recordAllocation(currentTag(), bytes);
+}
+
+/**
+ * Records a deallocation of the given size for the current memory tag.
+ *
+ * @note The deallocation has to happen under the same tag as the allocation.
+ * Allocators that outlive a tag scope keep the tag they were created under
+ * instead, see PoolAllocator and VirtualArray.
+ *
+ * @param bytes The size of the allocation
+ */
+inline void recordDeallocation(std::size_t bytes) noexcept {
+    recordDeallocation(currentTag(), bytes);
+}
+
+/**
+ * Sets the memory budget of the given tag.
+ *
+ * @note A warning is logged once every time the tag goes over its budget.
+ *
+ * @param tag   The memory tag
+ * @param bytes The budget in bytes or zero to disable the budget
+ */
+inline void setBudget(MemoryTag tag, std::size_t bytes) noexcept {
+    Detail::trackingState()
+        .tags[static_cast<std::size_t>(tag)]
+        .budget_bytes.store(static_cast<i64>(bytes), std::memory_order_relaxed);
+}
+
+/**
+ * Takes a snapshot of the memory statistics of every tag.
+ *
+ * @note The snapshot is not atomic with respect to threads that are
+ * allocating while it is taken.
+ *
+ * @return The memory snapshot
+ */
+[[nodiscard]] inline MemorySnapshot snapshot() noexcept {
+    MemorySnapshot result;
+    Detail::MemoryTrackingState const& state = Detail::trackingState();
+
+    for (std::size_t tag = 0; tag < memory_tag_count; ++tag) {
+        MemoryTagStats& stats = result.tags[tag];
+        Detail::SharedMemoryCounters const& shared = state.tags[tag];
+
+        stats.live_bytes = shared.live_bytes.load(std::memory_order_relaxed);
+        stats.allocation_count =
+            shared.allocation_count.load(std::memory_order_relaxed);
+        stats.deallocation_count =
+            shared.deallocation_count.load(std::memory_order_relaxed);
+
+        for (auto const& thread : state.threads) {
+            stats.live_bytes +=
+                thread.pending_bytes[tag].load(std::memory_order_relaxed);
+            stats.allocation_count +=
+                thread.allocation_count[tag].load(std::memory_order_relaxed);
+            stats.deallocation_count +=
+                thread.deallocation_count[tag].load(std::memory_order_relaxed);
+        }
+
+        stats.budget_alarm_count =
+            shared.budget_alarm_count.load(std::memory_order_relaxed);
+        stats.over_budget = shared.over_budget.load(std::memory_order_relaxed);
+        stats.peak_bytes = shared.peak_bytes.load(std::memory_order_relaxed);
+        stats.peak_bytes = (stats.live_bytes > stats.peak_bytes)
+                               ? stats.live_bytes
+                               : stats.peak_bytes;
+    }
+
+    return result;
+}
+
+}  // namespace Memory
+
+}  // namespace Zeus
+
+// Check if memory tracking is turned on
+#ifdef ZEUS_ENABLE_MEMORY_TRACKING
+
+#define ZEUS_MEMORY_TAG_SCOPE(TAG)                                       \
+    Zeus::Memory::ScopedMemoryTag const ZEUS_UNIQUE_NAME(zeus_memory_tag_) { \
+        TAG                                                                  \
+    }
+
+#define ZEUS_TRACK_ALLOCATION(TAG, BYTES) \
+    Zeus::Memory::recordAllocation(TAG, BYTES)
+
+#define ZEUS_TRACK_DEALLOCATION(TAG, BYTES) \
+    Zeus::Memory::recordDeallocation(TAG, BYTES)
+
+#else
+#define ZEUS_MEMORY_TAG_SCOPE(TAG)
+#define ZEUS_TRACK_ALLOCATION(TAG, BYTES)
+#define ZEUS_TRACK_DEALLOCATION(TAG, BYTES)
+#endif
@@ -0,0 +1,394 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/memory/tracking.hpp"
+#include "zeus/memory/virtual_memory.hpp"
+
+/**
+ * @file virtual_array.hpp
+ */
+
+namespace Zeus {
+
+namespace Memory {
+
+/**
+ * A growable array backed by a fixed virtual memory reservation.
+ *
+ * The whole address range for the maximum size is reserved up front and
+ * pages are committed as the array grows. Elements are never moved, so
+ * pointers and references stay valid for as long as the element exists, and
+ * growing never copies anything.
+ *
+ * When the array shrinks well below its committed size, the unused tail is
+ * decommitted and its physical memory is returned to the operating system.
+ * Committed memory is charged to the memory tag that was current when the
+ * array was constructed.
+ *
+ * @tparam T The type of the elements
+ */
+template <typename T>
+class VirtualArray {
+   public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using iterator = value_type*;
+    using const_iterator = value_type const*;
+
+    /**
+     * The smallest number of bytes committed at a time.
+     */
+    static constexpr size_type commit_granularity = size_type{64} * 1024;
+
+    /**
+     * Reserves address space for the given maximum number of elements.
+     *
+     * @note An array with a maximum size of zero reserves nothing and stays
+     * empty.
+     *
+     * @throws std::bad_alloc if the address space could not be reserved
+     *
+     * @param max_size The maximum number of elements the array can hold
+     */
+    explicit VirtualArray(size_type max_size) : max_size_{max_size} {
+        ZEUS_MODULE_ASSERT(MEMORY, ALWAYS,
+                           max_size <= SIZE_MAX / sizeof(T),
+                           "Maximum size of a virtual array is too large");
+
+        if (max_size == 0) {
+            return;
+        }
+
+        reserved_bytes_ = VirtualMemory::roundToPages(max_size * sizeof(T));
+        data_ = static_cast<T*>(VirtualMemory::reserve(reserved_bytes_));
+
+        if (data_ == nullptr) {
+            throw std::bad_alloc{};
+        }
+    }
+
+    VirtualArray(VirtualArray const&) = delete;
+    VirtualArray& operator=(VirtualArray const&) = delete;
+
+    VirtualArray(VirtualArray&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)},
+          max_size_{std::exchange(other.max_size_, 0)},
+          reserved_bytes_{std::exchange(other.reserved_bytes_, 0)},
+          committed_bytes_{std::exchange(other.committed_bytes_, 0)},
+          tag_{other.tag_} {}
+
+    VirtualArray& operator=(VirtualArray&& other) noexcept {
+        if (this != &other) {
+            destroy();
+
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            max_size_ = std::exchange(other.max_size_, 0);
+            reserved_bytes_ = std::exchange(other.reserved_bytes_, 0);
+            committed_bytes_ = std::exchange(other.committed_bytes_, 0);
+            tag_ = other.tag_;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Destructs every element and releases the reservation.
+     */
+    ~VirtualArray() {
+        destroy();
+    }
+
+    /**
+     * Constructs an element at the end of the array using the given
+     * arguments.
+     *
+     * @throws std::length_error if the array is full
+     * @throws std::bad_alloc if memory could not be committed
+     *
+     * @param args The arguments to construct the element with
+     *
+     * @return A reference to the new element
+     */
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        ensureCommitted(size_ + 1);
+
+        T* element = ::new (static_cast<void*>(data_ + size_))
+            T(std::forward<Args>(args)...);
+        ++size_;
+
+        return *element;
+    }
+
+    /**
+     * Appends the given value to the end of the array.
+     *
+     * @param value The value to append
+     */
+    void push_back(value_type const& value) {
+        emplace_back(value);
+    }
+
+    /**
+     * Appends the given value to the end of the array.
+     *
+     * @param value The value to append
+     */
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    /**
+     * Removes the last element of the array.
+     */
+    void pop_back() noexcept {
+        ZEUS_MODULE_ASSERT(MEMORY, DEBUG, size_ > 0,
+                           "pop_back() called on an empty array.");
+
+        --size_;
+        std::destroy_at(data_ + size_);
+
+        decommitUnused();
+    }
+
+    /**
+     * Resizes the array to the given number of elements, value initializing
+     * any new elements.
+     *
+     * @param count The new number of elements
+     */
+    void resize(size_type count) {
+        if (count < size_) {
+            std::destroy(data_ + count, data_ + size_);
+            size_ = count;
+
+            decommitUnused();
+
+            return;
+        }
+
+        ensureCommitted(count);
+
+        std::uninitialized_value_construct(data_ + size_, data_ + count);
+        size_ = count;
+    }
+
+    /**
+     * Commits memory for at least the given number of elements.
+     *
+     * @param count The number of elements to commit memory for
+     */
+    void reserve(size_type count) {
+        ensureCommitted(count);
+    }
+
+    /**
+     * Destructs every element and decommits every page.
+     */
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+
+        shrink_to_fit();
+    }
+
+    /**
+     * Decommits every page that is not used by an element.
+     */
+    void shrink_to_fit() noexcept {
+        size_type const needed = roundToCommit(size_ * sizeof(T));
+
+        if (needed < committed_bytes_) {
+            VirtualMemory::decommit(
+                reinterpret_cast<std::byte*>(data_) + needed,
+                committed_bytes_ - needed);
+            ZEUS_TRACK_DEALLOCATION(tag_, committed_bytes_ - needed);
+            committed_bytes_ = needed;
+        }
+    }
+
+    [[nodiscard]] reference operator[](size_type position) noexcept {
+        ZEUS_MODULE_ASSERT(MEMORY, DEBUG, position < size_,
+                           "Index out of bounds.");
+
+        return data_[position];
+    }
+
+    [[nodiscard]] const_reference operator[](
+        size_type position) const noexcept {
+        ZEUS_MODULE_ASSERT(MEMORY, DEBUG, position < size_,
+                           "Index out of bounds.");
+
+        return data_[position];
+    }
+
+    [[nodiscard]] reference back() noexcept {
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] const_reference back() const noexcept {
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /**
+     * Returns the number of elements that fit in the committed memory.
+     *
+     * @return The committed capacity
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return committed_bytes_ / sizeof(T);
+    }
+
+    /**
+     * Returns the maximum number of elements the array can hold.
+     *
+     * @return The maximum size
+     */
+    [[nodiscard]] size_type max_size() const noexcept {
+        return max_size_;
+    }
+
+    /**
+     * Returns the number of bytes of physical memory committed.
+     *
+     * @return The committed bytes
+     */
+    [[nodiscard]] size_type committedBytes() const noexcept {
+        return committed_bytes_;
+    }
+
+    [[nodiscard]] value_type* data() noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] value_type const* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+   private:
+    [[nodiscard]] static size_type roundToCommit(size_type bytes) noexcept {
+        size_type const granularity =
+            VirtualMemory::roundToPages(commit_granularity);
+
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    /**
+     * Commits pages until the given number of elements fit.
+     *
+     * @note Commits grow geometrically to keep the number of system calls
+     * logarithmic in the size of the array.
+     */
+    void ensureCommitted(size_type count) {
+        if (count > max_size_) {
+            throw std::length_error("VirtualArray reservation exhausted.");
+        }
+
+        if (count * sizeof(T) <= committed_bytes_) {
+            return;
+        }
+
+        size_type target = roundToCommit(count * sizeof(T));
+        size_type const doubled = roundToCommit(committed_bytes_ * 2);
+
+        target = (doubled > target) ? doubled : target;
+        target = (target > reserved_bytes_) ? reserved_bytes_ : target;
+
+        if (!VirtualMemory::commit(
+                reinterpret_cast<std::byte*>(data_) + committed_bytes_,
+                target - committed_bytes_)) {
+            throw std::bad_alloc{};
+        }
+
+        ZEUS_TRACK_ALLOCATION(tag_, target - committed_bytes_);
+        committed_bytes_ = target;
+    }
+
+    /**
+     * Decommits the unused tail once less than a quarter of the committed
+     * memory is in use so that oscillating around a boundary does not
+     * repeatedly commit and decommit the same pages.
+     */
+    void decommitUnused() noexcept {
+        size_type const used = size_ * sizeof(T);
+
+        if (used < committed_bytes_ / 4 &&
+            committed_bytes_ - used > roundToCommit(1)) {
+            shrink_to_fit();
+        }
+    }
+
+    void destroy() noexcept {
+        if (data_ != nullptr) {
+            std::destroy(data_, data_ + size_);
+            VirtualMemory::release(data_, reserved_bytes_);
+            ZEUS_TRACK_DEALLOCATION(tag_, committed_bytes_);
+            data_ = nullptr;
+            committed_bytes_ = 0;
+        }
+    }
+
+    T* data_ = nullptr;
+    size_type size_ = 0;
+    size_type max_size_ = 0;
+    size_type reserved_bytes_ = 0;
+    size_type committed_bytes_ = 0;
+    [[maybe_unused]] MemoryTag tag_ = currentTag();
+};
+
+}  // namespace Memory
+
+}  // namespace Zeus
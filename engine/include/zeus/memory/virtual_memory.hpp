@@ -0,0 +1,103 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file virtual_memory.hpp
+ */
+
+namespace Zeus {
+
+namespace Memory {
+
+/**
+ * Thin wrappers around the virtual memory facilities of the operating system.
+ *
+ * Address space is first reserved, which costs no physical memory, and pages
+ * inside the reservation are then committed and decommitted on demand.
+ */
+namespace VirtualMemory {
+
+/**
+ * Returns the size of a virtual memory page.
+ *
+ * @return The page size in bytes
+ */
+[[nodiscard]] std::size_t pageSize() noexcept;
+
+/**
+ * Rounds the given size up to a multiple of the page size.
+ *
+ * @param bytes The size to round up
+ *
+ * @return The rounded up size
+ */
+[[nodiscard]] inline std::size_t roundToPages(std::size_t bytes) noexcept {
+    std::size_t const page = pageSize();
+
+    return (bytes + page - 1) / page * page;
+}
+
+/**
+ * Reserves the given number of bytes of address space without backing it
+ * with physical memory.
+ *
+ * @param bytes The number of bytes to reserve, a multiple of the page size
+ *
+ * @return The start of the reservation or nullptr on failure
+ */
+[[nodiscard]] void* reserve(std::size_t bytes) noexcept;
+
+/**
+ * Makes the given pages of a reservation readable and writable.
+ *
+ * @note Committed pages are zero filled on first touch.
+ *
+ * @param address   The start of the pages, aligned to the page size
+ * @param bytes     The number of bytes to commit, a multiple of the page size
+ *
+ * @return True if the pages were committed, otherwise false
+ */
+[[nodiscard]] bool commit(void* address, std::size_t bytes) noexcept;
+
+/**
+ * Returns the physical memory of the given pages to the operating system and
+ * makes them inaccessible again.
+ *
+ * @param address   The start of the pages, aligned to the page size
+ * @param bytes     The number of bytes to decommit, a multiple of the page
+ * size
+ */
+void decommit(void* address, std::size_t bytes) noexcept;
+
+/**
+ * Releases a reservation.
+ *
+ * @param address   The start of the reservation
+ * @param bytes     The size of the reservation
+ */
+void release(void* address, std::size_t bytes) noexcept;
+
+}  // namespace VirtualMemory
+
+}  // namespace Memory
+
+}  // namespace Zeus
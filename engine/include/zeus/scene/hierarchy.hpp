@@ -0,0 +1,299 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/handle.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/matrix_3x4.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * @file hierarchy.hpp
+ */
+
+namespace Zeus {
+
+namespace Scene {
+
+struct NodeTag;
+
+/**
+ * A node of a Hierarchy.
+ */
+using Node = Handle64<NodeTag>;
+
+/**
+ * A tree of transforms that computes world matrices incrementally.
+ *
+ * Nodes are stored breadth first in contiguous arrays of local positions,
+ * rotations, scales and matrices and of world matrices, so the nodes of each
+ * depth form one range and every parent comes before its children. Changing
+ * a local transform marks its node dirty. update() walks the levels from the
+ * first dirty node down. It recomputes a local matrix only if the node
+ * changed and a world matrix only if the node or its parent changed, so
+ * static parts of the scene cost a flag check each and nothing at all in a
+ * frame where nothing moved.
+ *
+ * The nodes of a level are roots of disjoint subtrees whose parents are
+ * already up to date, so a level can be split across workers.
+ *
+ * @note Creating, destroying and reparenting nodes reorders the arrays at the
+ * next update() or destroy(), which is linear in the number of nodes.
+ */
+class Hierarchy {
+   public:
+    /**
+     * Constructs an empty hierarchy.
+     */
+    Hierarchy();
+
+    /**
+     * Creates a node with an identity local transform.
+     *
+     * @param parent The parent node, null for a root
+     *
+     * @return The new node
+     */
+    Node create(Node parent = {});
+
+    /**
+     * Destroys a node and all of its descendants, does nothing if it is not
+     * alive.
+     *
+     * @param node The node to destroy
+     */
+    void destroy(Node node);
+
+    /**
+     * Moves a node, together with its descendants, under another parent.
+     *
+     * @param node      A live node
+     * @param parent    The new parent, which must not be a descendant of the
+     *                  node, or null to make the node a root
+     */
+    void setParent(Node node, Node parent);
+
+    /**
+     * Returns whether a node has been created and not destroyed.
+     */
+    [[nodiscard]] bool isAlive(Node node) const noexcept {
+        return node.index() < records_.size() &&
+               records_[node.index()].generation == node.generation() &&
+               records_[node.index()].index != null_index;
+    }
+
+    /**
+     * Returns the parent of a live node, or null for a root.
+     */
+    [[nodiscard]] Node parent(Node node) const noexcept {
+        u32 const parent = parents_[indexOf(node)];
+
+        return parent == null_index ? Node{} : nodes_[parent];
+    }
+
+    /**
+     * Returns the local position of a live node.
+     */
+    [[nodiscard]] Math::Vector3D const& position(Node node) const noexcept {
+        return positions_[indexOf(node)];
+    }
+
+    /**
+     * Returns the local rotation of a live node, as Euler angles in radians
+     * applied in the order x, y, z.
+     */
+    [[nodiscard]] Math::Vector3D const& rotation(Node node) const noexcept {
+        return rotations_[indexOf(node)];
+    }
+
+    /**
+     * Returns the local scale of a live node.
+     */
+    [[nodiscard]] Math::Vector3D const& scale(Node node) const noexcept {
+        return scales_[indexOf(node)];
+    }
+
+    /**
+     * Sets the local position of a live node.
+     */
+    void setPosition(Node node, Math::Vector3D const& position) noexcept {
+        u32 const index = indexOf(node);
+        positions_[index] = position;
+        markDirty(index);
+    }
+
+    /**
+     * Sets the local rotation of a live node.
+     */
+    void setRotation(Node node, Math::Vector3D const& rotation) noexcept {
+        u32 const index = indexOf(node);
+        rotations_[index] = rotation;
+        markDirty(index);
+    }
+
+    /**
+     * Sets the local scale of a live node.
+     */
+    void setScale(Node node, Math::Vector3D const& scale) noexcept {
+        u32 const index = indexOf(node);
+        scales_[index] = scale;
+        markDirty(index);
+    }
+
+    /**
+     * Returns the world matrix of a live node as of the last update().
+     */
+    [[nodiscard]] Math::Matrix3x4 const& world(Node node) const noexcept {
+        return worlds_[indexOf(node)];
+    }
+
+    /**
+     * Recomputes the world matrices of the dirty nodes and their
+     * descendants.
+     */
+    void update();
+
+    /**
+     * Recomputes the world matrices of the dirty nodes and their descendants,
+     * splitting every level across the workers of a job system.
+     *
+     * @param system    The System or FiberSystem to run on
+     * @param grain     The largest number of nodes of a level that is not
+     *                  split any further
+     */
+    template <typename Scheduler>
+    void update(Scheduler& system, std::size_t grain = default_grain) {
+        std::size_t level = beginUpdate();
+
+        for (; level + 1 < level_begins_.size(); ++level) {
+            std::atomic<std::size_t> updated{0};
+
+            Job::parallelFor(
+                system, level_begins_[level], level_begins_[level + 1], grain,
+                [this, &updated](std::size_t first, std::size_t last) {
+                    updated.fetch_add(updateRange(first, last),
+                                      std::memory_order_relaxed);
+                });
+
+            updated_count_ += updated.load(std::memory_order_relaxed);
+        }
+
+        endUpdate();
+    }
+
+    /**
+     * Returns the number of world matrices the last update() recomputed.
+     */
+    [[nodiscard]] std::size_t updatedCount() const noexcept {
+        return updated_count_;
+    }
+
+    /**
+     * Returns the number of live nodes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return nodes_.size(); }
+
+    /**
+     * Returns the number of levels, i.e. the depth of the deepest node plus
+     * one, as of the last update().
+     */
+    [[nodiscard]] std::size_t levelCount() const noexcept {
+        return level_begins_.size() - 1;
+    }
+
+    /**
+     * Returns the node at a position of the breadth first order, as of the
+     * last update().
+     */
+    [[nodiscard]] Node at(std::size_t index) const noexcept {
+        return nodes_[index];
+    }
+
+    /**
+     * The default number of nodes below which a level is not split.
+     */
+    static constexpr std::size_t default_grain = 1024;
+
+   private:
+    /**
+     * Where the data of a node is stored.
+     */
+    struct Record {
+        // null_index while the handle index is free
+        u32 index = 0;
+        u32 generation = 0;
+    };
+
+    static constexpr u32 null_index = std::numeric_limits<u32>::max();
+
+    u32 indexOf(Node node) const noexcept {
+        ZEUS_MODULE_ASSERT(SCENE, DEBUG, isAlive(node),
+                           "The node is not alive.");
+
+        return records_[node.index()].index;
+    }
+
+    void markDirty(u32 index) noexcept {
+        dirty_[index] = 1;
+
+        if (index < first_dirty_) {
+            first_dirty_ = index;
+        }
+    }
+
+    void sort();
+    std::size_t beginUpdate();
+    std::size_t updateRange(std::size_t first, std::size_t last) noexcept;
+    void endUpdate() noexcept;
+
+    // The breadth first arrays, indexed alike
+    std::vector<Node> nodes_;
+    std::vector<u32> parents_;
+    std::vector<Math::Vector3D> positions_;
+    std::vector<Math::Vector3D> rotations_;
+    std::vector<Math::Vector3D> scales_;
+    std::vector<Math::Matrix3x4> locals_;
+    std::vector<Math::Matrix3x4> worlds_;
+    std::vector<u8> dirty_;
+
+    // The epoch in which a node's world matrix was last recomputed
+    std::vector<u32> updated_in_;
+
+    // Where each level starts, followed by the number of nodes
+    std::vector<u32> level_begins_;
+
+    std::vector<Record> records_;
+    std::vector<u32> free_records_;
+
+    u32 first_dirty_ = null_index;
+    u32 epoch_ = 0;
+    std::size_t updated_count_ = 0;
+    bool unsorted_ = false;
+};
+
+}  // namespace Scene
+
+}  // namespace Zeus
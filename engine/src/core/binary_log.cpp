@@ -0,0 +1,504 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/binary_log.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/thread_exit.hpp"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Zeus {
+
+namespace BinaryLog {
+
+namespace {
+
+/**
+ * A registered call site.
+ */
+struct SiteRecord {
+    SiteHeader header;
+    std::vector<ArgumentType> types;
+    std::string name;
+    std::string format;
+    std::string file;
+};
+
+void writeAll(int file_descriptor, void const* data,
+              std::size_t size) noexcept {
+    auto const* bytes = static_cast<char const*>(data);
+
+    while (size > 0) {
+#if defined(_WIN32)
+        int const written =
+            _write(file_descriptor, bytes, static_cast<unsigned>(size));
+#else
+        ssize_t const written = ::write(file_descriptor, bytes, size);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+
+        if (written <= 0) {
+            return;
+        }
+
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+/**
+ * The largest number of thread buffers that may exist at once, including
+ * full buffers waiting for the writer thread and spare buffers.
+ */
+constexpr std::size_t max_buffer_count = 64;
+
+void closeFile(int file_descriptor) noexcept {
+#if defined(_WIN32)
+    _close(file_descriptor);
+#else
+    ::close(file_descriptor);
+#endif
+}
+
+/**
+ * Owns the call site table, the output of the binary log and the writer
+ * thread that writes full thread buffers.
+ */
+class Sink {
+   public:
+    /**
+     * Returns the sink.
+     *
+     * @note The sink is intentionally never destroyed since threads flush
+     * their buffers while the program exits. The writer thread runs for the
+     * lifetime of the program for the same reason.
+     */
+    static Sink& instance() noexcept {
+        static Sink* const sink = new Sink;
+
+        return *sink;
+    }
+
+    u32 registerSite(Site& site, std::string_view format,
+                     ArgumentType const* types, std::size_t count) {
+        std::lock_guard<std::mutex> const lock{output_mutex_};
+
+        // Another thread could have registered the site in the meantime
+        if (u32 const id = site.id.load(std::memory_order_relaxed); id != 0) {
+            return id;
+        }
+
+        SiteRecord record{};
+        record.types.assign(types, types + count);
+        record.name =
+            std::string_view{site.name}.substr(0, max_string_size);
+        record.format = format.substr(0, max_string_size);
+        record.file = std::string_view{site.file}.substr(0, max_string_size);
+
+        record.header.id = static_cast<u32>(sites_.size() + 1);
+        record.header.line = site.line;
+        record.header.level = static_cast<u8>(site.level);
+        record.header.argument_count = static_cast<u8>(count);
+        record.header.name_size = static_cast<u16>(record.name.size());
+        record.header.format_size = static_cast<u16>(record.format.size());
+        record.header.file_size = static_cast<u16>(record.file.size());
+
+        sites_.push_back(std::move(record));
+
+        if (output_ >= 0) {
+            writeSite(sites_.back());
+        }
+
+        u32 const id = sites_.back().header.id;
+        site.id.store(id, std::memory_order_release);
+
+        return id;
+    }
+
+    /**
+     * Writes the stream header and every known call site to the given file
+     * descriptor and makes it the output.
+     */
+    void setOutput(int file_descriptor, bool owned) noexcept {
+        f64 const ticks_per_second = Tsc::ticksPerSecond();
+
+        // Events logged before the switch belong to the previous output
+        waitUntilWritten();
+
+        std::lock_guard<std::mutex> const lock{output_mutex_};
+
+        closeLocked();
+
+        output_ = file_descriptor;
+        owned_ = owned;
+
+        StreamHeader header{};
+        header.magic = stream_magic;
+        header.version = stream_version;
+        header.start_ticks = Detail::ticks();
+        header.ticks_per_second = ticks_per_second;
+
+        writeAll(output_, &header, sizeof(header));
+
+        for (auto const& site : sites_) {
+            writeSite(site);
+        }
+    }
+
+    void close() noexcept {
+        waitUntilWritten();
+
+        std::lock_guard<std::mutex> const lock{output_mutex_};
+
+        closeLocked();
+    }
+
+    /**
+     * Hands the given full buffer to the writer thread and returns an empty
+     * buffer in its place.
+     *
+     * @note Never waits for the output, the caller only takes the queue lock
+     * long enough to swap buffers.
+     *
+     * @return An empty buffer or nullptr if too many buffers are waiting to
+     * be written, in which case the full buffer is kept by the caller
+     */
+    Detail::ThreadBuffer* exchange(Detail::ThreadBuffer* full) noexcept {
+        Detail::ThreadBuffer* empty = nullptr;
+
+        {
+            std::lock_guard<std::mutex> const lock{queue_mutex_};
+
+            if (!spare_.empty()) {
+                empty = spare_.back();
+                spare_.pop_back();
+            } else if (buffer_count_ < max_buffer_count) {
+                empty = new (std::nothrow) Detail::ThreadBuffer;
+                buffer_count_ += (empty != nullptr) ? 1 : 0;
+            }
+
+            if (empty == nullptr) {
+                return nullptr;
+            }
+
+            full_.push_back(full);
+        }
+
+        wake_.notify_one();
+
+        return empty;
+    }
+
+    /**
+     * Returns a new buffer for a thread that logs for the first time.
+     *
+     * @return An empty buffer or nullptr if there are too many buffers
+     */
+    Detail::ThreadBuffer* acquire() noexcept {
+        std::lock_guard<std::mutex> const lock{queue_mutex_};
+
+        if (!spare_.empty()) {
+            Detail::ThreadBuffer* buffer = spare_.back();
+            spare_.pop_back();
+
+            return buffer;
+        }
+
+        if (buffer_count_ == max_buffer_count) {
+            return nullptr;
+        }
+
+        auto* buffer = new (std::nothrow) Detail::ThreadBuffer;
+        buffer_count_ += (buffer != nullptr) ? 1 : 0;
+
+        return buffer;
+    }
+
+    /**
+     * Gives back the buffer of an exiting thread.
+     */
+    void release(Detail::ThreadBuffer* buffer) noexcept {
+        std::lock_guard<std::mutex> const lock{queue_mutex_};
+
+        spare_.push_back(buffer);
+    }
+
+    /**
+     * Writes the events of the given buffer after every buffer queued
+     * before it and empties the buffer.
+     */
+    void write(Detail::ThreadBuffer& buffer) noexcept {
+        waitUntilWritten();
+
+        if (buffer.size == 0) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> const lock{output_mutex_};
+
+            writeEvents(buffer);
+        }
+
+        buffer.size = 0;
+    }
+
+    void drop() noexcept { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] u64 droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    Sink() {
+        writer_ = std::thread{[this] { run(); }};
+        writer_.detach();
+    }
+
+    /**
+     * Writes the full buffers in the order they were queued and recycles
+     * them as spare buffers.
+     */
+    void run() noexcept {
+        std::unique_lock<std::mutex> lock{queue_mutex_};
+
+        while (true) {
+            wake_.wait(lock, [this] { return !full_.empty(); });
+
+            Detail::ThreadBuffer* buffer = full_.front();
+            full_.pop_front();
+            writing_ = true;
+
+            lock.unlock();
+
+            {
+                std::lock_guard<std::mutex> const output_lock{output_mutex_};
+
+                writeEvents(*buffer);
+            }
+
+            buffer->size = 0;
+
+            lock.lock();
+
+            spare_.push_back(buffer);
+            writing_ = false;
+
+            if (full_.empty()) {
+                written_.notify_all();
+            }
+        }
+    }
+
+    /**
+     * Waits until the writer thread has written every queued buffer.
+     */
+    void waitUntilWritten() noexcept {
+        std::unique_lock<std::mutex> lock{queue_mutex_};
+
+        written_.wait(lock, [this] { return full_.empty() && !writing_; });
+    }
+
+    void writeEvents(Detail::ThreadBuffer const& buffer) noexcept {
+        if (output_ >= 0 && buffer.size > 0) {
+            BlockHeader const header{BlockType::Events,
+                                     static_cast<u32>(buffer.size)};
+
+            writeAll(output_, &header, sizeof(header));
+            writeAll(output_, buffer.data.data(), buffer.size);
+        }
+    }
+
+    void writeSite(SiteRecord const& site) noexcept {
+        BlockHeader const header{
+            BlockType::Site,
+            static_cast<u32>(sizeof(SiteHeader) + site.types.size() +
+                             site.name.size() + site.format.size() +
+                             site.file.size())};
+
+        writeAll(output_, &header, sizeof(header));
+        writeAll(output_, &site.header, sizeof(site.header));
+        writeAll(output_, site.types.data(), site.types.size());
+        writeAll(output_, site.name.data(), site.name.size());
+        writeAll(output_, site.format.data(), site.format.size());
+        writeAll(output_, site.file.data(), site.file.size());
+    }
+
+    void closeLocked() noexcept {
+        if (output_ >= 0 && owned_) {
+            closeFile(output_);
+        }
+
+        output_ = -1;
+        owned_ = false;
+    }
+
+    // Guards the call sites and every write to the output
+    std::mutex output_mutex_;
+    std::vector<SiteRecord> sites_;
+    int output_ = -1;
+    bool owned_ = false;
+
+    // Guards the buffers handed between the logging threads and the writer
+    std::mutex queue_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable written_;
+    std::deque<Detail::ThreadBuffer*> full_;
+    std::vector<Detail::ThreadBuffer*> spare_;
+    std::size_t buffer_count_ = 0;
+    bool writing_ = false;
+
+    std::atomic<u64> dropped_{0};
+    std::thread writer_;
+};
+
+/**
+ * Set once the buffer of the calling thread has been released.
+ */
+thread_local bool thread_exited = false;
+
+/**
+ * Writes and frees the buffer of the calling thread.
+ */
+void releaseThreadBuffer() noexcept {
+    if (Detail::thread_buffer != nullptr) {
+        Sink::instance().write(*Detail::thread_buffer);
+        Sink::instance().release(Detail::thread_buffer);
+
+        Detail::thread_buffer = nullptr;
+    }
+
+    thread_exited = true;
+}
+
+}  // namespace
+
+namespace Detail {
+
+u32 registerSite(Site& site, std::string_view format, ArgumentType const* types,
+                 std::size_t count) noexcept {
+    Sink& sink = Sink::instance();
+
+    try {
+        return sink.registerSite(site, format, types, count);
+    } catch (...) {
+        // Out of memory, the next message from the site tries again
+        sink.drop();
+
+        return 0;
+    }
+}
+
+ThreadBuffer* reserve(std::size_t size) noexcept {
+    Sink& sink = Sink::instance();
+
+    if (size > buffer_size || thread_exited) {
+        sink.drop();
+
+        return nullptr;
+    }
+
+    if (thread_buffer != nullptr) {
+        ThreadBuffer* empty = sink.exchange(thread_buffer);
+
+        if (empty == nullptr) {
+            sink.drop();
+
+            return nullptr;
+        }
+
+        thread_buffer = empty;
+
+        return thread_buffer;
+    }
+
+    thread_buffer = sink.acquire();
+
+    if (thread_buffer == nullptr) {
+        sink.drop();
+
+        return nullptr;
+    }
+
+    atThreadExit<&releaseThreadBuffer>();
+
+    return thread_buffer;
+}
+
+}  // namespace Detail
+
+bool open(std::string const& path) noexcept {
+#if defined(_WIN32)
+    int const file_descriptor =
+        _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+              _S_IREAD | _S_IWRITE);
+#else
+    int const file_descriptor =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+
+    if (file_descriptor < 0) {
+        return false;
+    }
+
+    Sink::instance().setOutput(file_descriptor, true);
+
+    return true;
+}
+
+void setOutput(int file_descriptor) noexcept {
+    Sink::instance().setOutput(file_descriptor, false);
+}
+
+void close() noexcept {
+    flush();
+
+    Sink::instance().close();
+}
+
+void flush() noexcept {
+    if (Detail::thread_buffer != nullptr) {
+        Sink::instance().write(*Detail::thread_buffer);
+    }
+}
+
+std::uint64_t droppedCount() noexcept {
+    return Sink::instance().droppedCount();
+}
+
+}  // namespace BinaryLog
+
+}  // namespace Zeus
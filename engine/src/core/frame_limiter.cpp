@@ -0,0 +1,71 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/frame_limiter.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "zeus/core/compiler_macros.hpp"
+
+namespace Zeus {
+
+namespace {
+
+/**
+ * The number of samples after which the sleep estimate starts over, so that
+ * it follows changes in system load.
+ */
+constexpr u64 max_samples = 1000;
+
+}  // namespace
+
+void FrameLimiter::waitUntil(TscClock::time_point deadline) noexcept {
+    auto now = TscClock::now();
+
+    while (static_cast<f64>((deadline - now).count()) > estimate_) {
+        auto const start = now;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        now = TscClock::now();
+
+        learn(static_cast<f64>((now - start).count()));
+    }
+
+    while (TscClock::now() < deadline) {
+        ZEUS_CPU_PAUSE();
+    }
+}
+
+void FrameLimiter::learn(f64 sleep) noexcept {
+    if (samples_ == max_samples) {
+        samples_ = 1;
+        mean_ = estimate_;
+        m2_ = 0.0;
+    }
+
+    ++samples_;
+
+    f64 const delta = sleep - mean_;
+    mean_ += delta / static_cast<f64>(samples_);
+    m2_ += delta * (sleep - mean_);
+
+    estimate_ = mean_ + std::sqrt(m2_ / static_cast<f64>(samples_ - 1));
+}
+
+}  // namespace Zeus
@@ -0,0 +1,155 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/game_loop.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "zeus/core/format.hpp"
+#include "zeus/core/log.hpp"
+
+namespace Zeus {
+
+namespace {
+
+/**
+ * Converts seconds to the duration of the clock, 0 for negative seconds.
+ */
+TscClock::duration durationOf(f64 seconds) noexcept {
+    if (seconds <= 0.0) {
+        return TscClock::duration{0};
+    }
+
+    return TscClock::duration{std::llround(seconds * 1e9)};
+}
+
+/**
+ * Converts a rate in Hz to its period, 0 for a rate of 0.
+ */
+TscClock::duration periodOf(f64 rate) noexcept {
+    return rate > 0.0 ? durationOf(1.0 / rate) : TscClock::duration{0};
+}
+
+}  // namespace
+
+GameLoop::GameLoop(Settings const& settings) noexcept
+    : settings_{settings},
+      step_{std::max(periodOf(settings.update_rate), TscClock::duration{1})},
+      frame_period_{periodOf(settings.frame_rate_limit)},
+      report_period_{durationOf(settings.report_interval)},
+      step_seconds_{toSeconds(step_)} {}
+
+void GameLoop::report(char const* label, Histogram const& frame_times) {
+    if (frame_times.count() == 0) {
+        return;
+    }
+
+    auto const microseconds = [](u64 nanoseconds) {
+        return (nanoseconds + 500) / 1000;
+    };
+
+    ZEUS_INFO_LOG(
+        "Loop",
+        ZEUS_FORMAT(256,
+                    "{}: {} frames at {} fps, frame time p50 {} us, "
+                    "p99 {} us, max {} us",
+                    label, frame_times.count(),
+                    std::llround(1e9 / frame_times.mean()),
+                    microseconds(frame_times.percentile(50.0)),
+                    microseconds(frame_times.percentile(99.0)),
+                    microseconds(frame_times.max())));
+}
+
+void GameLoop::begin() noexcept {
+    frame_start_ = Clock::now();
+    next_frame_ = frame_start_;
+    next_report_ = frame_start_ + report_period_;
+    accumulator_ = Clock::duration{0};
+    frames_ = 0;
+    updates_ = 0;
+    frame_times_.reset();
+    report_times_.reset();
+}
+
+bool GameLoop::isDone() const noexcept {
+    return stop_.load(std::memory_order_relaxed) ||
+           (settings_.frame_count != 0 && frames_ >= settings_.frame_count);
+}
+
+u32 GameLoop::beginFrame() noexcept {
+    auto const now = Clock::now();
+
+    if (frames_ > 0) {
+        auto const elapsed = now - frame_start_;
+        auto const nanoseconds = static_cast<u64>(elapsed.count());
+
+        frame_times_.record(nanoseconds);
+        report_times_.record(nanoseconds);
+        frame_time_metric_.record(nanoseconds);
+        accumulator_ += elapsed;
+    }
+
+    frame_start_ = now;
+
+    if (settings_.headless) {
+        accumulator_ = Clock::duration{0};
+        ++updates_;
+        update_metric_.add();
+
+        return 1;
+    }
+
+    // Drop the time that does not fit into the allowed number of steps
+    accumulator_ =
+        std::min(accumulator_, step_ * settings_.max_updates_per_frame);
+
+    auto const updates = static_cast<u32>(accumulator_ / step_);
+    accumulator_ -= step_ * updates;
+    updates_ += updates;
+    update_metric_.add(updates);
+
+    return updates;
+}
+
+void GameLoop::endFrame() {
+    ++frames_;
+    frame_metric_.add();
+
+    if (frame_period_.count() > 0) {
+        next_frame_ += frame_period_;
+
+        // Start over from now instead of rushing frames to catch up
+        if (next_frame_ < Clock::now()) {
+            next_frame_ = Clock::now();
+        } else {
+            ZEUS_PROFILE_SCOPE("Frame Limiter");
+            limiter_.waitUntil(next_frame_);
+        }
+    }
+
+    if (report_period_.count() > 0 && Clock::now() >= next_report_) {
+        report("Last interval", report_times_);
+        report_times_.reset();
+        next_report_ = Clock::now() + report_period_;
+    }
+}
+
+void GameLoop::end() { report("Total", frame_times_); }
+
+}  // namespace Zeus
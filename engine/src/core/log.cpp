@@ -0,0 +1,1044 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "zeus/core/log_limit.hpp"
+#include "zeus/core/log_ring.hpp"
+#include "zeus/core/thread_index.hpp"
+#include "zeus/core/types.hpp"
+#include "zeus/memory/cache_line.hpp"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Zeus {
+
+namespace {
+
+#if defined(_WIN32)
+struct iovec {
+    void* iov_base;
+    std::size_t iov_len;
+};
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The size of the log buffer of a single thread, a power of two.
+ */
+constexpr std::size_t buffer_size = std::size_t{64} * 1024;
+
+/**
+ * Records are padded to this alignment so headers can be read in place.
+ */
+constexpr std::size_t record_alignment = 8;
+
+/**
+ * Longer messages are truncated so a single record can never fill a buffer.
+ */
+constexpr std::size_t max_message_size = buffer_size / 4;
+
+constexpr std::size_t max_name_size = 64;
+
+/**
+ * The number of I/O slices written by a single writev call.
+ */
+constexpr std::size_t max_batch_slices = 1020;
+
+constexpr std::size_t slices_per_record = 5;
+
+constexpr std::size_t max_prefix_size = 48;
+
+constexpr auto writer_idle_timeout = std::chrono::milliseconds{5};
+
+constexpr auto consumer_lock_timeout = std::chrono::seconds{1};
+
+/**
+ * Precedes every message in a log buffer.
+ */
+struct RecordHeader {
+    // The size of the record including the header and padding
+    u32 size;
+    u32 message_size;
+    u16 name_size;
+    u8 level;
+
+    // Set on filler records that skip to the start of the buffer
+    u8 is_padding;
+    i64 timestamp;
+};
+
+static_assert(sizeof(RecordHeader) % record_alignment == 0,
+              "Record headers must keep records aligned.");
+
+/**
+ * A single-producer single-consumer ring buffer of log records.
+ *
+ * @note Positions increase monotonically and are masked into the buffer.
+ */
+struct alignas(Memory::cache_line_size) ThreadBuffer {
+    // Written by the producing thread
+    alignas(Memory::cache_line_size) std::atomic<u64> head{0};
+    u64 cached_tail = 0;
+
+    // Written by the consumer
+    alignas(Memory::cache_line_size) std::atomic<u64> tail{0};
+
+    alignas(Memory::cache_line_size) std::array<std::byte, buffer_size> data;
+};
+
+constexpr std::size_t alignRecord(std::size_t size) noexcept {
+    return (size + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+constexpr std::string_view levelName(Log::Level level) noexcept {
+    switch (level) {
+        case Log::Level::Error:
+            return "ERROR";
+        case Log::Level::Warning:
+            return "WARNING";
+        case Log::Level::Info:
+            return "INFO";
+        case Log::Level::Config:
+            return "CONFIG";
+        case Log::Level::Debug:
+            return "DEBUG";
+    }
+
+    return "UNKNOWN";
+}
+
+Clock::time_point startTime() noexcept {
+    static Clock::time_point const start = Clock::now();
+
+    return start;
+}
+
+/**
+ * Writes the given slices completely, retrying on partial writes.
+ */
+void writeAll(int file_descriptor, iovec* slices, std::size_t count) noexcept {
+#if defined(_WIN32)
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const* bytes = static_cast<char const*>(slices[i].iov_base);
+        std::size_t remaining = slices[i].iov_len;
+
+        while (remaining > 0) {
+            int const written = _write(file_descriptor, bytes,
+                                       static_cast<unsigned>(remaining));
+
+            if (written <= 0) {
+                return;
+            }
+
+            bytes += written;
+            remaining -= static_cast<std::size_t>(written);
+        }
+    }
+#else
+    while (count > 0) {
+        ssize_t written =
+            ::writev(file_descriptor, slices, static_cast<int>(count));
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        // Skip past the slices that were written completely
+        while (count > 0 &&
+               static_cast<std::size_t>(written) >= slices->iov_len) {
+            written -= static_cast<ssize_t>(slices->iov_len);
+            ++slices;
+            --count;
+        }
+
+        if (count > 0) {
+            slices->iov_base = static_cast<char*>(slices->iov_base) + written;
+            slices->iov_len -= static_cast<std::size_t>(written);
+        }
+    }
+#endif
+}
+
+/**
+ * Formats the timestamp, level and opening bracket of the logger name.
+ *
+ * @return The number of characters written
+ */
+std::size_t formatPrefix(std::array<char, max_prefix_size>& prefix,
+                         i64 timestamp, Log::Level level) noexcept {
+    char* out = prefix.data();
+    char* const end = prefix.data() + prefix.size();
+
+    auto append = [&out, end](std::string_view text) {
+        std::size_t const count =
+            std::min(text.size(), static_cast<std::size_t>(end - out));
+        std::memcpy(out, text.data(), count);
+        out += count;
+    };
+
+    i64 const micros = timestamp / 1000;
+    std::array<char, 8> fraction{};
+    auto const fraction_end =
+        std::to_chars(fraction.data(), fraction.data() + fraction.size(),
+                      micros % 1000000)
+            .ptr;
+    auto const fraction_size =
+        static_cast<std::size_t>(fraction_end - fraction.data());
+
+    append("[");
+    out = std::to_chars(out, end, micros / 1000000).ptr;
+    append(".");
+    append(std::string_view{"000000"}.substr(fraction_size));
+    append(std::string_view{fraction.data(), fraction_size});
+    append("] [");
+    append(levelName(level));
+    append("] [");
+
+    return static_cast<std::size_t>(out - prefix.data());
+}
+
+/**
+ * Writes a single message straight to the given file descriptor.
+ *
+ * @note Used when the calling thread has no log buffer or the writer thread
+ * is gone.
+ */
+void writeDirect(int file_descriptor, std::string_view name,
+                 std::string_view message, Log::Level level) noexcept {
+    std::array<char, max_prefix_size> prefix{};
+    i64 const timestamp =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             startTime())
+            .count();
+    std::size_t const prefix_size = formatPrefix(prefix, timestamp, level);
+
+    std::array<iovec, slices_per_record> slices{
+        iovec{prefix.data(), prefix_size},
+        iovec{const_cast<char*>(name.data()), name.size()},
+        iovec{const_cast<char*>("] "), 2},
+        iovec{const_cast<char*>(message.data()), message.size()},
+        iovec{const_cast<char*>("\n"), 1}};
+
+    writeAll(file_descriptor, slices.data(), slices.size());
+}
+
+/**
+ * Owns the thread buffers and the writer thread.
+ */
+class Backend {
+   public:
+    Backend() {
+        startTime();
+
+        previous_terminate_ = std::set_terminate(onTerminate);
+        writer_ = std::thread{[this] { run(); }};
+    }
+
+    Backend(Backend const&) = delete;
+    Backend(Backend&&) = delete;
+    Backend& operator=(Backend const&) = delete;
+    Backend& operator=(Backend&&) = delete;
+
+    /**
+     * Stops the writer thread and writes the remaining messages.
+     *
+     * @note The thread buffers are intentionally not freed since a detached
+     * thread could still be logging while the program exits.
+     */
+    ~Backend() {
+        {
+            std::lock_guard<std::mutex> const lock{wake_mutex_};
+            running_ = false;
+        }
+
+        wake_.notify_one();
+        writer_.join();
+
+        // Messages logged from now on are written directly
+        destroyed().store(true, std::memory_order_release);
+
+        drain();
+    }
+
+    /**
+     * Returns the backend, creating it on first use.
+     *
+     * @return The backend or nullptr once it has been destroyed
+     */
+    static Backend* instance() noexcept {
+        if (destroyed().load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        static Backend backend;
+
+        return &backend;
+    }
+
+    /**
+     * Returns the file descriptor messages are written to.
+     */
+    static std::atomic<int>& output() noexcept {
+        static std::atomic<int> output{2};
+
+        return output;
+    }
+
+    void push(std::string_view name, std::string_view message,
+              Log::Level level) noexcept {
+        std::size_t const thread = threadIndex();
+
+        if (thread == invalid_thread_index) {
+            writeDirect(output().load(std::memory_order_relaxed), name,
+                        message, level);
+
+            return;
+        }
+
+        ThreadBuffer* buffer = bufferFor(thread);
+
+        if (buffer == nullptr) {
+            writeDirect(output().load(std::memory_order_relaxed), name,
+                        message, level);
+
+            return;
+        }
+
+        name = name.substr(0, max_name_size);
+        message = message.substr(0, max_message_size);
+
+        std::size_t const size = alignRecord(sizeof(RecordHeader) +
+                                             name.size() + message.size());
+
+        u64 head = buffer->head.load(std::memory_order_relaxed);
+        std::size_t offset = head & (buffer_size - 1);
+        std::size_t const contiguous = buffer_size - offset;
+        std::size_t const needed =
+            size + ((size > contiguous) ? contiguous : 0);
+
+        if (!reserve(*buffer, head, needed)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            return;
+        }
+
+        // Records never wrap, skip to the start of the buffer instead
+        if (size > contiguous) {
+            if (contiguous >= sizeof(RecordHeader)) {
+                RecordHeader padding{};
+                padding.size = static_cast<u32>(contiguous);
+                padding.is_padding = 1;
+
+                std::memcpy(buffer->data.data() + offset, &padding,
+                            sizeof(padding));
+            }
+
+            head += contiguous;
+            offset = 0;
+        }
+
+        RecordHeader header{};
+        header.size = static_cast<u32>(size);
+        header.message_size = static_cast<u32>(message.size());
+        header.name_size = static_cast<u16>(name.size());
+        header.level = static_cast<u8>(level);
+        header.timestamp =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - startTime())
+                .count();
+
+        std::byte* record = buffer->data.data() + offset;
+
+        std::memcpy(record, &header, sizeof(header));
+        std::memcpy(record + sizeof(header), name.data(), name.size());
+        std::memcpy(record + sizeof(header) + name.size(), message.data(),
+                    message.size());
+
+        buffer->head.store(head + size, std::memory_order_release);
+
+        if (writer_sleeping_.load(std::memory_order_relaxed) ||
+            level == Log::Level::Error) {
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * Writes every pending message from the calling thread.
+     */
+    void flush() noexcept {
+        if (lockConsumer()) {
+            drainLocked();
+            consume_mutex_.unlock();
+        }
+    }
+
+    /**
+     * Writes every pending message and switches to the given file
+     * descriptor.
+     */
+    void setOutput(int file_descriptor) noexcept {
+        if (lockConsumer()) {
+            drainLocked();
+            output().store(file_descriptor, std::memory_order_relaxed);
+            consume_mutex_.unlock();
+        } else {
+            output().store(file_descriptor, std::memory_order_relaxed);
+        }
+    }
+
+    void setPolicy(Log::OverflowPolicy policy) noexcept {
+        policy_.store(policy, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] u64 droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    /**
+     * Takes the consumer lock from a thread other than the writer thread.
+     *
+     * @note The lock could be held by a writer thread that is stuck, for
+     * example after a crash in another thread, so do not wait forever.
+     *
+     * @return True if the lock was taken, otherwise false
+     */
+    bool lockConsumer() noexcept {
+        auto const deadline = Clock::now() + consumer_lock_timeout;
+
+        while (!consume_mutex_.try_lock()) {
+            if (Clock::now() > deadline) {
+                return false;
+            }
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    static std::atomic<bool>& destroyed() noexcept {
+        static std::atomic<bool> destroyed{false};
+
+        return destroyed;
+    }
+
+    [[noreturn]] static void onTerminate() noexcept {
+        if (Backend* backend = instance(); backend != nullptr) {
+            backend->flush();
+
+            if (backend->previous_terminate_ != nullptr) {
+                backend->previous_terminate_();
+            }
+        }
+
+        std::abort();
+    }
+
+    /**
+     * Returns the buffer of the given thread index, allocating it on first
+     * use.
+     *
+     * @note A buffer is inherited by the next thread that receives the same
+     * index, which keeps every buffer single producer.
+     */
+    ThreadBuffer* bufferFor(std::size_t thread) noexcept {
+        ThreadBuffer* buffer =
+            buffers_[thread].load(std::memory_order_acquire);
+
+        if (buffer == nullptr) {
+            buffer = new (std::nothrow) ThreadBuffer;
+
+            buffers_[thread].store(buffer, std::memory_order_release);
+        }
+
+        return buffer;
+    }
+
+    /**
+     * Waits for or gives up on the given number of free bytes.
+     *
+     * @return True if there is room, false if the message should be dropped
+     */
+    bool reserve(ThreadBuffer& buffer, u64 head, std::size_t needed) noexcept {
+        while (head + needed - buffer.cached_tail > buffer_size) {
+            buffer.cached_tail = buffer.tail.load(std::memory_order_acquire);
+
+            if (head + needed - buffer.cached_tail <= buffer_size) {
+                break;
+            }
+
+            if (policy_.load(std::memory_order_relaxed) ==
+                Log::OverflowPolicy::Drop) {
+                return false;
+            }
+
+            wake_.notify_one();
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    void run() noexcept {
+        std::unique_lock<std::mutex> lock{wake_mutex_};
+
+        while (running_) {
+            lock.unlock();
+
+            // Reported before draining so the reports never wait on the
+            // buffer of the writer itself
+            Detail::reportSuppressedLogs();
+
+            bool const wrote = drain();
+            lock.lock();
+
+            if (!wrote && running_) {
+                writer_sleeping_.store(true, std::memory_order_relaxed);
+                wake_.wait_for(lock, writer_idle_timeout);
+                writer_sleeping_.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool drain() noexcept {
+        std::lock_guard<std::mutex> const lock{consume_mutex_};
+
+        return drainLocked();
+    }
+
+    /**
+     * Writes every pending record of every thread buffer.
+     *
+     * @note The records are written straight out of the thread buffers and
+     * the buffers are only released once the write has completed.
+     *
+     * @return True if anything was written, otherwise false
+     */
+    bool drainLocked() noexcept {
+        int const file_descriptor = output().load(std::memory_order_relaxed);
+        bool wrote = false;
+
+        for (auto& slot : buffers_) {
+            ThreadBuffer* buffer = slot.load(std::memory_order_acquire);
+
+            if (buffer == nullptr) {
+                continue;
+            }
+
+            u64 tail = buffer->tail.load(std::memory_order_relaxed);
+            u64 const head = buffer->head.load(std::memory_order_acquire);
+
+            while (tail != head) {
+                std::size_t slice_count = 0;
+                std::size_t record_count = 0;
+
+                while (tail != head &&
+                       slice_count + slices_per_record <= max_batch_slices) {
+                    std::size_t const offset = tail & (buffer_size - 1);
+
+                    if (buffer_size - offset < sizeof(RecordHeader)) {
+                        tail += buffer_size - offset;
+
+                        continue;
+                    }
+
+                    std::byte* record = buffer->data.data() + offset;
+                    RecordHeader header{};
+                    std::memcpy(&header, record, sizeof(header));
+
+                    tail += header.size;
+
+                    if (header.is_padding != 0) {
+                        continue;
+                    }
+
+                    auto& prefix = prefixes_[record_count++];
+                    auto* name = reinterpret_cast<char*>(record) +
+                                 sizeof(RecordHeader);
+
+                    slices_[slice_count++] = iovec{
+                        prefix.data(),
+                        formatPrefix(prefix, header.timestamp,
+                                     static_cast<Log::Level>(header.level))};
+                    slices_[slice_count++] = iovec{name, header.name_size};
+                    slices_[slice_count++] = iovec{const_cast<char*>("] "), 2};
+                    slices_[slice_count++] =
+                        iovec{name + header.name_size, header.message_size};
+                    slices_[slice_count++] = iovec{const_cast<char*>("\n"), 1};
+                }
+
+                if (slice_count > 0) {
+                    writeAll(file_descriptor, slices_.data(), slice_count);
+                    wrote = true;
+                }
+
+                buffer->tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        reportDropped(file_descriptor);
+
+        return wrote;
+    }
+
+    void reportDropped(int file_descriptor) noexcept {
+        u64 const dropped = dropped_.load(std::memory_order_relaxed);
+
+        if (dropped == reported_dropped_) {
+            return;
+        }
+
+        std::array<char, 64> message{};
+        char* out = std::to_chars(message.data(),
+                                  message.data() + message.size(),
+                                  dropped - reported_dropped_)
+                        .ptr;
+        std::string_view const suffix = " log messages dropped";
+
+        std::memcpy(out, suffix.data(), suffix.size());
+        out += suffix.size();
+
+        reported_dropped_ = dropped;
+
+        writeDirect(file_descriptor, Log::default_logger_name,
+                    std::string_view{message.data(), static_cast<std::size_t>(
+                                                         out - message.data())},
+                    Log::Level::Warning);
+    }
+
+    std::array<std::atomic<ThreadBuffer*>, max_thread_count> buffers_{};
+
+    std::atomic<Log::OverflowPolicy> policy_{Log::OverflowPolicy::Block};
+    std::atomic<u64> dropped_{0};
+    u64 reported_dropped_ = 0;
+
+    // Only one thread may consume the thread buffers at a time
+    std::mutex consume_mutex_;
+    std::array<iovec, max_batch_slices> slices_{};
+    std::array<std::array<char, max_prefix_size>,
+               max_batch_slices / slices_per_record>
+        prefixes_{};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> writer_sleeping_{false};
+    bool running_ = true;
+
+    std::terminate_handler previous_terminate_ = nullptr;
+    std::thread writer_;
+};
+
+/**
+ * The layout of LogRing::RingHeader with an atomic cursor.
+ */
+struct MappedRingHeader {
+    u32 magic;
+    u16 version;
+    u16 header_size;
+    u64 capacity;
+    std::atomic<u64> cursor;
+};
+
+static_assert(sizeof(MappedRingHeader) == sizeof(LogRing::RingHeader) &&
+                  std::atomic<u64>::is_always_lock_free,
+              "The mapped header must match the file format.");
+
+/**
+ * Copies every message into a memory mapped file used as a ring.
+ *
+ * @note Messages are copied by the logging threads and the mapping is shared
+ * with the file, so the newest messages survive the process being killed
+ * without the log ever calling fsync.
+ */
+class CrashRing {
+   public:
+    /**
+     * Creates the given file and maps it.
+     *
+     * @return The ring or nullptr if the file could not be mapped
+     */
+    static CrashRing* open(std::string const& path,
+                           std::size_t capacity) noexcept {
+        capacity = std::max(capacity, LogRing::min_capacity);
+
+        // Round up to a power of two so positions can be masked
+        std::size_t rounded = LogRing::min_capacity;
+
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+
+        std::size_t const file_size = sizeof(MappedRingHeader) + rounded;
+        void* memory = mapFile(path, file_size);
+
+        if (memory == nullptr) {
+            return nullptr;
+        }
+
+        auto* header = new (memory) MappedRingHeader{};
+        header->magic = LogRing::file_magic;
+        header->version = LogRing::file_version;
+        header->header_size = static_cast<u16>(sizeof(MappedRingHeader));
+        header->capacity = rounded;
+
+        return new (std::nothrow) CrashRing{
+            header, static_cast<std::byte*>(memory) + sizeof(MappedRingHeader),
+            rounded};
+    }
+
+    void write(std::string_view name, std::string_view message,
+               Log::Level level, i64 timestamp) noexcept {
+        name = name.substr(0, max_name_size);
+        message = message.substr(0, std::min(max_message_size, capacity_ / 4));
+
+        std::size_t const size =
+            (sizeof(LogRing::RecordHeader) + name.size() + message.size() +
+             LogRing::record_alignment - 1) /
+            LogRing::record_alignment * LogRing::record_alignment;
+
+        u64 const position =
+            header_->cursor.fetch_add(size, std::memory_order_relaxed);
+
+        LogRing::RecordHeader record{};
+        record.magic = LogRing::record_magic;
+        record.size = static_cast<u32>(size);
+        record.position = position;
+        record.timestamp = timestamp;
+        record.message_size = static_cast<u32>(message.size());
+        record.name_size = static_cast<u16>(name.size());
+        record.level = static_cast<u8>(level);
+
+        record.checksum =
+            LogRing::Detail::recordChecksum(record, name, message);
+
+        copy(position, &record, sizeof(record));
+        copy(position + sizeof(record), name.data(), name.size());
+        copy(position + sizeof(record) + name.size(), message.data(),
+             message.size());
+    }
+
+    /**
+     * Returns the ring messages are copied into.
+     */
+    static std::atomic<CrashRing*>& active() noexcept {
+        static std::atomic<CrashRing*> active{nullptr};
+
+        return active;
+    }
+
+   private:
+    CrashRing(MappedRingHeader* header, std::byte* ring,
+              std::size_t capacity) noexcept
+        : header_{header}, ring_{ring}, capacity_{capacity} {}
+
+    static void* mapFile(std::string const& path,
+                         std::size_t file_size) noexcept {
+#if defined(_WIN32)
+        HANDLE const file =
+            CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                        FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+
+        auto const size = static_cast<u64>(file_size);
+        HANDLE const mapping = CreateFileMappingA(
+            file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32U),
+            static_cast<DWORD>(size & 0xFFFFFFFFU), nullptr);
+        void* memory = nullptr;
+
+        if (mapping != nullptr) {
+            memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0,
+                                   file_size);
+            CloseHandle(mapping);
+        }
+
+        CloseHandle(file);
+
+        return memory;
+#else
+        int const file_descriptor =
+            ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        if (file_descriptor < 0) {
+            return nullptr;
+        }
+
+        void* memory = nullptr;
+
+        if (::ftruncate(file_descriptor, static_cast<off_t>(file_size)) == 0) {
+            memory = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, file_descriptor, 0);
+        }
+
+        ::close(file_descriptor);
+
+        return (memory == MAP_FAILED) ? nullptr : memory;
+#endif
+    }
+
+    /**
+     * Copies bytes into the ring, wrapping around its end.
+     */
+    void copy(u64 position, void const* data, std::size_t size) noexcept {
+        std::size_t const offset = position & (capacity_ - 1);
+        std::size_t const first = std::min(size, capacity_ - offset);
+
+        std::memcpy(ring_ + offset, data, first);
+        std::memcpy(ring_, static_cast<std::byte const*>(data) + first,
+                    size - first);
+    }
+
+    MappedRingHeader* header_;
+    std::byte* ring_;
+    std::size_t capacity_;
+};
+
+/**
+ * Remembers the runtime log levels and keeps the level table in sync.
+ */
+class LevelRegistry {
+   public:
+    static LevelRegistry& instance() noexcept {
+        static LevelRegistry registry;
+
+        return registry;
+    }
+
+    void set(Log::LoggerId id, Log::Level level) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        levels_[id] = level;
+        updateSlot(Log::levelSlot(id));
+    }
+
+    void reset(Log::LoggerId id) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        if (levels_.erase(id) != 0) {
+            updateSlot(Log::levelSlot(id));
+        }
+    }
+
+    void setDefault(Log::Level level) noexcept {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        default_level_ = level;
+
+        for (std::size_t slot = 0; slot < Detail::logger_level_slots; ++slot) {
+            Detail::logger_levels[slot].store(static_cast<u8>(level),
+                                              std::memory_order_relaxed);
+        }
+
+        for (auto const& [id, logger_level] : levels_) {
+            updateSlot(Log::levelSlot(id));
+        }
+    }
+
+   private:
+    /**
+     * Stores the lowest level of the loggers that share the given slot, or
+     * the default level if none of them has its own level.
+     */
+    void updateSlot(std::size_t slot) noexcept {
+        bool found = false;
+        auto lowest = static_cast<u8>(Log::Level::Error);
+
+        for (auto const& [id, level] : levels_) {
+            if (Log::levelSlot(id) == slot) {
+                lowest = std::min(lowest, static_cast<u8>(level));
+                found = true;
+            }
+        }
+
+        Detail::logger_levels[slot].store(
+            found ? lowest : static_cast<u8>(default_level_),
+            std::memory_order_relaxed);
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<Log::LoggerId, Log::Level> levels_;
+    Log::Level default_level_ = Log::Level::Debug;
+};
+
+}  // namespace
+
+void Log::msg(std::string_view name, std::string_view message,
+              Log::Level level) {
+    if (!isEnabled(loggerId(name), level)) {
+        return;
+    }
+
+    if (CrashRing* ring = CrashRing::active().load(std::memory_order_acquire);
+        ring != nullptr) {
+        ring->write(name, message, level,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - startTime())
+                        .count());
+    }
+
+    if (Backend* backend = Backend::instance(); backend != nullptr) {
+        backend->push(name, message, level);
+    } else {
+        writeDirect(Backend::output().load(std::memory_order_relaxed), name,
+                    message, level);
+    }
+}
+
+void Log::msg(std::string_view message, Log::Level level) {
+    Log::msg(Log::default_logger_name, message, level);
+}
+
+void Log::error(std::string_view name, std::string_view message) {
+    Log::msg(name, message, Log::Level::Error);
+}
+
+void Log::error(std::string_view message) {
+    Log::msg(message, Log::Level::Error);
+}
+
+void Log::warning(std::string_view name, std::string_view message) {
+    Log::msg(name, message, Log::Level::Warning);
+}
+
+void Log::warning(std::string_view message) {
+    Log::msg(message, Log::Level::Warning);
+}
+
+void Log::info(std::string_view name, std::string_view message) {
+    Log::msg(name, message, Log::Level::Info);
+}
+
+void Log::info(std::string_view message) {
+    Log::msg(message, Log::Level::Info);
+}
+
+void Log::config(std::string_view name, std::string_view message) {
+    Log::msg(name, message, Log::Level::Config);
+}
+
+void Log::config(std::string_view message) {
+    Log::msg(message, Log::Level::Config);
+}
+
+void Log::debug(std::string_view name, std::string_view message) {
+    Log::msg(name, message, Log::Level::Debug);
+}
+
+void Log::debug(std::string_view message) {
+    Log::msg(message, Log::Level::Debug);
+}
+
+void Log::setLevel(std::string_view name, Log::Level level) {
+    LevelRegistry::instance().set(loggerId(name), level);
+}
+
+void Log::resetLevel(std::string_view name) {
+    LevelRegistry::instance().reset(loggerId(name));
+}
+
+void Log::setDefaultLevel(Log::Level level) noexcept {
+    LevelRegistry::instance().setDefault(level);
+}
+
+bool Log::openCrashLog(std::string const& path, std::size_t size) noexcept {
+    CrashRing* ring = CrashRing::open(path, size);
+
+    if (ring == nullptr) {
+        return false;
+    }
+
+    // The previous ring is not unmapped since threads could still be writing
+    // to it
+    CrashRing::active().store(ring, std::memory_order_release);
+
+    return true;
+}
+
+void Log::closeCrashLog() noexcept {
+    CrashRing::active().store(nullptr, std::memory_order_release);
+}
+
+void Log::setOverflowPolicy(Log::OverflowPolicy policy) noexcept {
+    if (Backend* backend = Backend::instance(); backend != nullptr) {
+        backend->setPolicy(policy);
+    }
+}
+
+void Log::setOutput(int file_descriptor) noexcept {
+    if (Backend* backend = Backend::instance(); backend != nullptr) {
+        backend->setOutput(file_descriptor);
+    } else {
+        Backend::output().store(file_descriptor, std::memory_order_relaxed);
+    }
+}
+
+void Log::flush() noexcept {
+    if (Backend* backend = Backend::instance(); backend != nullptr) {
+        backend->flush();
+    }
+}
+
+std::uint64_t Log::droppedCount() noexcept {
+    Backend const* backend = Backend::instance();
+
+    return (backend != nullptr) ? backend->droppedCount() : 0;
+}
+
+std::string to_string(Log::Level level) noexcept {
+    return std::string{levelName(level)};
+}
+
+}  // namespace Zeus
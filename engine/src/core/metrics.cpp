@@ -0,0 +1,662 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+#include "zeus/core/json.hpp"
+#include "zeus/core/thread_exit.hpp"
+
+namespace Zeus {
+
+namespace Metrics {
+
+namespace {
+
+/**
+ * The percentiles written for histograms and their names.
+ */
+struct Percentile {
+    char const* name;
+    f64 value;
+};
+
+constexpr Percentile percentiles[] = {
+    {"p50", 50.0}, {"p90", 90.0}, {"p99", 99.0}, {"p999", 99.9}};
+
+u64 toBits(f64 value) noexcept {
+    u64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+f64 fromBits(u64 bits) noexcept {
+    f64 value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+/**
+ * Adds the values a thread recorded into a histogram to another histogram.
+ */
+void mergeInto(Zeus::Histogram& histogram,
+               Detail::ThreadHistogram const& recorded) noexcept {
+    histogram.merge(
+        [&recorded](std::size_t bucket) {
+            return recorded.buckets[bucket].load(std::memory_order_relaxed);
+        },
+        static_cast<f64>(recorded.sum.load(std::memory_order_relaxed)),
+        recorded.min.load(std::memory_order_relaxed),
+        recorded.max.load(std::memory_order_relaxed));
+}
+
+/**
+ * Owns the names of the metrics, the slots of every thread and the values
+ * recorded by threads that have exited.
+ */
+class Registry {
+   public:
+    static Registry& instance() noexcept {
+        // Never destroyed so threads that exit late can still use it
+        static Registry* const registry = new Registry;
+
+        return *registry;
+    }
+
+    u32 addCounter(std::string_view name) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        return add(counter_names_, name, max_counters);
+    }
+
+    u32 addGauge(std::string_view name) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        return add(gauge_names_, name, max_gauges);
+    }
+
+    u32 addHistogram(std::string_view name) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        u32 const id = add(histogram_names_, name, max_histograms);
+
+        if (id != invalid_id && id == retired_histograms_.size()) {
+            retired_histograms_.emplace_back();
+        }
+
+        return id;
+    }
+
+    std::atomic<u64>& gauge(u32 id) noexcept { return gauges_[id]; }
+
+    Detail::ThreadSlots* addThread() noexcept {
+        auto* slots = new (std::nothrow) Detail::ThreadSlots;
+
+        if (slots == nullptr) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> const lock{mutex_};
+        threads_.push_back(slots);
+
+        return slots;
+    }
+
+    /**
+     * Keeps the values of an exiting thread and frees its slots.
+     */
+    void retire(Detail::ThreadSlots* slots) noexcept {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        for (u32 id = 0; id < max_counters; ++id) {
+            retired_counters_[id] +=
+                slots->counters[id].load(std::memory_order_relaxed);
+        }
+
+        for (u32 id = 0; id < retired_histograms_.size(); ++id) {
+            if (auto* histogram =
+                    slots->histograms[id].load(std::memory_order_relaxed)) {
+                mergeInto(retired_histograms_[id], *histogram);
+                delete histogram;
+            }
+        }
+
+        threads_.erase(std::find(threads_.begin(), threads_.end(), slots));
+        delete slots;
+    }
+
+    u64 counterValue(u32 id) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        return sumCounter(id);
+    }
+
+    Zeus::Histogram histogramValues(u32 id) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        return mergeHistogram(id);
+    }
+
+    Snapshot snapshot() {
+        Snapshot result;
+        result.timestamp_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch())
+                .count();
+
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        for (u32 id = 0; id < counter_names_.size(); ++id) {
+            result.counters.push_back({counter_names_[id], sumCounter(id)});
+        }
+
+        for (u32 id = 0; id < gauge_names_.size(); ++id) {
+            result.gauges.push_back(
+                {gauge_names_[id],
+                 fromBits(gauges_[id].load(std::memory_order_relaxed))});
+        }
+
+        for (u32 id = 0; id < histogram_names_.size(); ++id) {
+            result.histograms.push_back(
+                {histogram_names_[id], mergeHistogram(id)});
+        }
+
+        auto const byName = [](auto const& lhs, auto const& rhs) {
+            return lhs.name < rhs.name;
+        };
+
+        std::sort(result.counters.begin(), result.counters.end(), byName);
+        std::sort(result.gauges.begin(), result.gauges.end(), byName);
+        std::sort(result.histograms.begin(), result.histograms.end(),
+                  byName);
+
+        return result;
+    }
+
+   private:
+    Registry() = default;
+
+    /**
+     * Returns the id of the given name, registering it if it is new.
+     */
+    static u32 add(std::vector<std::string>& names, std::string_view name,
+                   u32 max) {
+        auto const it = std::find(names.begin(), names.end(), name);
+
+        if (it != names.end()) {
+            return static_cast<u32>(it - names.begin());
+        }
+
+        if (names.size() == max) {
+            return invalid_id;
+        }
+
+        names.emplace_back(name);
+
+        return static_cast<u32>(names.size() - 1);
+    }
+
+    u64 sumCounter(u32 id) const noexcept {
+        u64 sum = retired_counters_[id];
+
+        for (auto const* slots : threads_) {
+            sum += slots->counters[id].load(std::memory_order_relaxed);
+        }
+
+        return sum;
+    }
+
+    Zeus::Histogram mergeHistogram(u32 id) const {
+        Zeus::Histogram histogram;
+        histogram.merge(retired_histograms_[id]);
+
+        for (auto const* slots : threads_) {
+            // Acquire pairs with the release in addHistogram() so that the
+            // buckets are seen initialized
+            if (auto const* recorded =
+                    slots->histograms[id].load(std::memory_order_acquire)) {
+                mergeInto(histogram, *recorded);
+            }
+        }
+
+        return histogram;
+    }
+
+    std::mutex mutex_;
+    std::vector<std::string> counter_names_;
+    std::vector<std::string> gauge_names_;
+    std::vector<std::string> histogram_names_;
+    std::vector<Detail::ThreadSlots*> threads_;
+
+    u64 retired_counters_[max_counters] = {};
+    std::vector<Zeus::Histogram> retired_histograms_;
+    std::atomic<u64> gauges_[max_gauges] = {};
+};
+
+/**
+ * Hands the slots of the calling thread back to the registry.
+ */
+void retireThreadSlots() noexcept {
+    if (Detail::thread_slots != nullptr) {
+        Registry::instance().retire(Detail::thread_slots);
+        Detail::thread_slots = nullptr;
+    }
+}
+
+/**
+ * Writes a number as JSON, which has no NaN or infinity.
+ */
+void writeJsonNumber(std::ostream& out, f64 value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+/**
+ * Writes a CSV field, quoted if it contains a separator, quote or newline.
+ */
+void writeCsvField(std::ostream& out, std::string_view text) {
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out << text;
+
+        return;
+    }
+
+    out << '"';
+
+    for (char const c : text) {
+        if (c == '"') {
+            out << '"';
+        }
+
+        out << c;
+    }
+
+    out << '"';
+}
+
+void writeCsvRow(std::ostream& out, i64 timestamp_ms, char const* kind,
+                 std::string_view name, char const* statistic, f64 value) {
+    out << timestamp_ms << ',' << kind << ',';
+    writeCsvField(out, name);
+    out << ',' << statistic << ',' << value << '\n';
+}
+
+bool startsWith(std::string_view text, std::string_view prefix) noexcept {
+    return text.substr(0, prefix.size()) == prefix;
+}
+
+/**
+ * Appends snapshots to a file from a background thread.
+ */
+class Dumper {
+   public:
+    static Dumper& instance() noexcept {
+        // Destroyed at exit, which stops the thread
+        static Dumper dumper;
+
+        return dumper;
+    }
+
+    Dumper(Dumper const&) = delete;
+    Dumper(Dumper&&) = delete;
+    Dumper& operator=(Dumper const&) = delete;
+    Dumper& operator=(Dumper&&) = delete;
+
+    ~Dumper() { stop(); }
+
+    bool start(std::string const& path, Format format, f64 interval) {
+        stop();
+
+        if (!std::ofstream{path, std::ios::app}) {
+            return false;
+        }
+
+        auto const period = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<f64>{std::max(interval, 0.001)});
+
+        std::lock_guard<std::mutex> const lock{mutex_};
+        stopping_ = false;
+        thread_ = std::thread{[this, path, format, period] {
+            run(path, format, period);
+        }};
+
+        return true;
+    }
+
+    void stop() {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        stopping_ = true;
+        std::thread thread = std::move(thread_);
+        lock.unlock();
+
+        wake_.notify_one();
+        thread.join();
+    }
+
+   private:
+    Dumper() = default;
+
+    void run(std::string const& path, Format format,
+             std::chrono::steady_clock::duration period) {
+        auto next = std::chrono::steady_clock::now() + period;
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        while (!wake_.wait_until(lock, next, [this] { return stopping_; })) {
+            lock.unlock();
+            dump(path, format);
+            lock.lock();
+
+            next += period;
+        }
+
+        lock.unlock();
+        dump(path, format);
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+    bool stopping_ = false;
+};
+
+}  // namespace
+
+namespace Detail {
+
+ThreadSlots* registerThread() noexcept {
+    thread_slots = Registry::instance().addThread();
+    atThreadExit<&retireThreadSlots>();
+
+    return thread_slots;
+}
+
+ThreadHistogram* addHistogram(ThreadSlots& slots, u32 id) noexcept {
+    auto* histogram = new (std::nothrow) ThreadHistogram;
+
+    if (histogram != nullptr) {
+        slots.histograms[id].store(histogram, std::memory_order_release);
+    }
+
+    return histogram;
+}
+
+}  // namespace Detail
+
+Counter::Counter(std::string_view name)
+    : id_{Registry::instance().addCounter(name)} {}
+
+u64 Counter::value() const {
+    return id_ == invalid_id ? 0 : Registry::instance().counterValue(id_);
+}
+
+Gauge::Gauge(std::string_view name) : value_{nullptr} {
+    u32 const id = Registry::instance().addGauge(name);
+
+    if (id != invalid_id) {
+        value_ = &Registry::instance().gauge(id);
+    }
+}
+
+void Gauge::set(f64 value) noexcept {
+    if (value_ != nullptr) {
+        value_->store(toBits(value), std::memory_order_relaxed);
+    }
+}
+
+void Gauge::add(f64 delta) noexcept {
+    if (value_ == nullptr) {
+        return;
+    }
+
+    u64 bits = value_->load(std::memory_order_relaxed);
+
+    while (!value_->compare_exchange_weak(bits, toBits(fromBits(bits) + delta),
+                                          std::memory_order_relaxed)) {
+    }
+}
+
+f64 Gauge::value() const noexcept {
+    return value_ == nullptr
+               ? 0.0
+               : fromBits(value_->load(std::memory_order_relaxed));
+}
+
+Histogram::Histogram(std::string_view name)
+    : id_{Registry::instance().addHistogram(name)} {}
+
+Zeus::Histogram Histogram::values() const {
+    return id_ == invalid_id ? Zeus::Histogram{}
+                             : Registry::instance().histogramValues(id_);
+}
+
+Snapshot snapshot() { return Registry::instance().snapshot(); }
+
+void writeJson(std::ostream& out, Snapshot const& snapshot) {
+    std::ios_base::fmtflags const flags = out.flags();
+    std::streamsize const precision = out.precision();
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(15);
+
+    out << "{\"timestamp_ms\":" << snapshot.timestamp_ms << ",\"counters\":{";
+
+    for (std::size_t i = 0; i < snapshot.counters.size(); ++i) {
+        out << (i == 0 ? "" : ",");
+        Json::writeString(out, snapshot.counters[i].name);
+        out << ':' << snapshot.counters[i].value;
+    }
+
+    out << "},\"gauges\":{";
+
+    for (std::size_t i = 0; i < snapshot.gauges.size(); ++i) {
+        out << (i == 0 ? "" : ",");
+        Json::writeString(out, snapshot.gauges[i].name);
+        out << ':';
+        writeJsonNumber(out, snapshot.gauges[i].value);
+    }
+
+    out << "},\"histograms\":{";
+
+    for (std::size_t i = 0; i < snapshot.histograms.size(); ++i) {
+        Zeus::Histogram const& values = snapshot.histograms[i].values;
+
+        out << (i == 0 ? "" : ",");
+        Json::writeString(out, snapshot.histograms[i].name);
+        out << ":{\"count\":" << values.count() << ",\"mean\":" << values.mean()
+            << ",\"min\":" << values.min();
+
+        for (auto const& percentile : percentiles) {
+            out << ",\"" << percentile.name
+                << "\":" << values.percentile(percentile.value);
+        }
+
+        out << ",\"max\":" << values.max() << '}';
+    }
+
+    out << "}}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void writeCsv(std::ostream& out, Snapshot const& snapshot, bool with_header) {
+    std::ios_base::fmtflags const flags = out.flags();
+    std::streamsize const precision = out.precision();
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(15);
+
+    if (with_header) {
+        out << "timestamp_ms,kind,name,statistic,value\n";
+    }
+
+    i64 const time = snapshot.timestamp_ms;
+
+    for (auto const& counter : snapshot.counters) {
+        writeCsvRow(out, time, "counter", counter.name, "value",
+                    static_cast<f64>(counter.value));
+    }
+
+    for (auto const& gauge : snapshot.gauges) {
+        writeCsvRow(out, time, "gauge", gauge.name, "value", gauge.value);
+    }
+
+    for (auto const& histogram : snapshot.histograms) {
+        Zeus::Histogram const& values = histogram.values;
+
+        writeCsvRow(out, time, "histogram", histogram.name, "count",
+                    static_cast<f64>(values.count()));
+        writeCsvRow(out, time, "histogram", histogram.name, "mean",
+                    values.mean());
+        writeCsvRow(out, time, "histogram", histogram.name, "min",
+                    static_cast<f64>(values.min()));
+
+        for (auto const& percentile : percentiles) {
+            writeCsvRow(out, time, "histogram", histogram.name,
+                        percentile.name,
+                        static_cast<f64>(values.percentile(percentile.value)));
+        }
+
+        writeCsvRow(out, time, "histogram", histogram.name, "max",
+                    static_cast<f64>(values.max()));
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void writeText(std::ostream& out, Snapshot const& snapshot,
+               std::string_view prefix) {
+    std::ios_base::fmtflags const flags = out.flags();
+    std::streamsize const precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << std::left << std::setw(40) << "Counter" << std::right
+        << std::setw(16) << "Value" << '\n';
+
+    for (auto const& counter : snapshot.counters) {
+        if (startsWith(counter.name, prefix)) {
+            out << std::left << std::setw(40) << counter.name << std::right
+                << std::setw(16) << counter.value << '\n';
+        }
+    }
+
+    out << '\n'
+        << std::left << std::setw(40) << "Gauge" << std::right
+        << std::setw(16) << "Value" << '\n';
+
+    for (auto const& gauge : snapshot.gauges) {
+        if (startsWith(gauge.name, prefix)) {
+            out << std::left << std::setw(40) << gauge.name << std::right
+                << std::setw(16) << gauge.value << '\n';
+        }
+    }
+
+    out << '\n'
+        << std::left << std::setw(40) << "Histogram" << std::right
+        << std::setw(12) << "Count" << std::setw(14) << "Mean"
+        << std::setw(12) << "Min";
+
+    for (auto const& percentile : percentiles) {
+        out << std::setw(12) << percentile.name;
+    }
+
+    out << std::setw(12) << "Max" << '\n';
+
+    for (auto const& histogram : snapshot.histograms) {
+        if (!startsWith(histogram.name, prefix)) {
+            continue;
+        }
+
+        Zeus::Histogram const& values = histogram.values;
+
+        out << std::left << std::setw(40) << histogram.name << std::right
+            << std::setw(12) << values.count() << std::setw(14)
+            << values.mean() << std::setw(12) << values.min();
+
+        for (auto const& percentile : percentiles) {
+            out << std::setw(12) << values.percentile(percentile.value);
+        }
+
+        out << std::setw(12) << values.max() << '\n';
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+std::string query(std::string_view prefix) {
+    std::ostringstream out;
+    writeText(out, snapshot(), prefix);
+
+    return out.str();
+}
+
+bool dump(std::string const& path, Format format) {
+    bool is_new = true;
+
+    if (std::ifstream existing{path, std::ios::binary | std::ios::ate}) {
+        is_new = existing.tellg() == 0;
+    }
+
+    std::ofstream file{path, std::ios::app};
+
+    if (!file) {
+        return false;
+    }
+
+    if (format == Format::Json) {
+        writeJson(file, snapshot());
+    } else {
+        writeCsv(file, snapshot(), is_new);
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool startDumping(std::string const& path, Format format, f64 interval) {
+    return Dumper::instance().start(path, format, interval);
+}
+
+void stopDumping() { Dumper::instance().stop(); }
+
+}  // namespace Metrics
+
+}  // namespace Zeus
@@ -0,0 +1,192 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/perf_counters.hpp"
+
+#include <cstdio>
+
+#include "zeus/core/tsc.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Zeus {
+
+namespace Perf {
+
+namespace {
+
+#if defined(__linux__)
+
+constexpr std::array<u64, event_count> event_configs{
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+/**
+ * The layout read from a group leader with PERF_FORMAT_GROUP,
+ * PERF_FORMAT_ID and both time formats.
+ */
+struct GroupReading {
+    u64 count;
+    u64 time_enabled;
+    u64 time_running;
+
+    struct {
+        u64 value;
+        u64 id;
+    } values[event_count];
+};
+
+int openEvent(u64 config, int group) noexcept {
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = config;
+    attributes.disabled = group < 0 ? 1 : 0;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                             PERF_FORMAT_TOTAL_TIME_ENABLED |
+                             PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // The calling thread on any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1,
+                                    group, PERF_FLAG_FD_CLOEXEC));
+}
+
+#endif
+
+}  // namespace
+
+CounterGroup::CounterGroup() noexcept {
+#if defined(__linux__)
+    for (std::size_t index = 0; index < event_count; ++index) {
+        int const descriptor = openEvent(event_configs[index], leader_);
+
+        if (descriptor < 0) {
+            if (error_[0] == '\0') {
+                int const error = errno;
+                std::string_view const event =
+                    name(static_cast<Event>(index));
+                char const* hint = "";
+
+                if (error == EACCES || error == EPERM) {
+                    hint = " (see kernel.perf_event_paranoid)";
+                } else if (error == ENOENT || error == EOPNOTSUPP) {
+                    hint = " (no hardware PMU, e.g. in a virtual machine)";
+                }
+
+                std::snprintf(error_.data(), error_.size(),
+                              "%.*s: perf_event_open failed: %s%s",
+                              static_cast<int>(event.size()), event.data(),
+                              std::strerror(error), hint);
+            }
+
+            continue;
+        }
+
+        if (ioctl(descriptor, PERF_EVENT_IOC_ID, &ids_[index]) != 0) {
+            close(descriptor);
+            continue;
+        }
+
+        descriptors_[index] = descriptor;
+
+        // The first event that opens leads the group
+        if (leader_ < 0) {
+            leader_ = descriptor;
+        }
+    }
+#else
+    std::snprintf(error_.data(), error_.size(),
+                  "Hardware counters are only supported on Linux");
+#endif
+}
+
+CounterGroup::~CounterGroup() {
+#if defined(__linux__)
+    for (int const descriptor : descriptors_) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+    }
+#endif
+}
+
+void CounterGroup::start() noexcept {
+#if defined(__linux__)
+    if (leader_ >= 0) {
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    start_ticks_ = Tsc::now();
+}
+
+Counts CounterGroup::stop(u64 elements) noexcept {
+    u64 const end_ticks = Tsc::now();
+
+    Counts counts;
+    counts.elements = elements;
+    counts.seconds = Tsc::toSeconds(end_ticks - start_ticks_);
+
+#if defined(__linux__)
+    if (leader_ < 0) {
+        return counts;
+    }
+
+    ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    GroupReading reading{};
+
+    if (read(leader_, &reading, sizeof(reading)) <= 0 ||
+        reading.time_running == 0) {
+        return counts;
+    }
+
+    // Counters only run part of the time when the PMU is shared
+    f64 const scale = static_cast<f64>(reading.time_enabled) /
+                      static_cast<f64>(reading.time_running);
+
+    for (u64 value = 0; value < reading.count && value < event_count;
+         ++value) {
+        for (std::size_t index = 0; index < event_count; ++index) {
+            if (descriptors_[index] >= 0 &&
+                ids_[index] == reading.values[value].id) {
+                counts.values[index] = static_cast<u64>(
+                    static_cast<f64>(reading.values[value].value) * scale);
+                counts.available[index] = true;
+            }
+        }
+    }
+#endif
+
+    return counts;
+}
+
+}  // namespace Perf
+
+}  // namespace Zeus
@@ -0,0 +1,548 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+#include "zeus/core/json.hpp"
+#include "zeus/core/thread_exit.hpp"
+
+namespace Zeus {
+
+namespace Profiler {
+
+namespace {
+
+/**
+ * The most chunks that are allocated on top of the first chunk of every
+ * thread, 64 MiB of events.
+ */
+constexpr u64 max_chunk_count = 2048;
+
+/**
+ * A copy of the events recorded by a thread.
+ */
+struct ThreadEvents {
+    u32 id;
+    std::string name;
+    std::vector<Detail::Event> events;
+};
+
+/**
+ * Owns the buffers of every thread that has recorded an event.
+ */
+class Registry {
+   public:
+    static Registry& instance() noexcept {
+        // Never destroyed so threads that exit late can still use it
+        static Registry* const registry = new Registry;
+
+        return *registry;
+    }
+
+    Detail::ThreadBuffer* add() noexcept {
+        auto* buffer = new (std::nothrow) Detail::ThreadBuffer;
+
+        if (buffer == nullptr) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        buffer->tail = &buffer->head;
+
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        u32 const id = next_id_++;
+        threads_.push_back({std::unique_ptr<Detail::ThreadBuffer>{buffer}, id,
+                            "Thread " + std::to_string(id), false});
+
+        return buffer;
+    }
+
+    /**
+     * Keeps the events of an exited thread until the next reset.
+     */
+    void retire(Detail::ThreadBuffer* buffer) noexcept {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        if (Entry* entry = find(buffer)) {
+            entry->exited = true;
+        }
+    }
+
+    Site const& intern(std::string_view name, char const* file, u32 line) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        auto found = sites_.find(name);
+
+        if (found == sites_.end()) {
+            auto site = std::make_unique<InternedSite>();
+            site->name = name;
+            site->site = {site->name.c_str(), file, line};
+
+            found = sites_.emplace(site->name, std::move(site)).first;
+        }
+
+        return found->second->site;
+    }
+
+    void setName(Detail::ThreadBuffer* buffer, std::string_view name) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        if (Entry* entry = find(buffer)) {
+            entry->name = name;
+        }
+    }
+
+    Detail::Chunk* grow(Detail::ThreadBuffer& buffer) noexcept {
+        if (chunk_count_.fetch_add(1, std::memory_order_relaxed) >=
+            max_chunk_count) {
+            chunk_count_.fetch_sub(1, std::memory_order_relaxed);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        auto* chunk = new (std::nothrow) Detail::Chunk;
+
+        if (chunk == nullptr) {
+            chunk_count_.fetch_sub(1, std::memory_order_relaxed);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        buffer.tail->next.store(chunk, std::memory_order_release);
+        buffer.tail = chunk;
+
+        return chunk;
+    }
+
+    void start() noexcept {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        if (origin_ == 0) {
+            origin_ = Tsc::now();
+        }
+
+        Detail::active.store(true, std::memory_order_release);
+    }
+
+    void reset() noexcept {
+        std::lock_guard<std::mutex> const lock{mutex_};
+
+        // Free the chunks of every thread, including exited ones, before
+        // their entries are dropped
+        for (auto& entry : threads_) {
+            Detail::ThreadBuffer& buffer = *entry.buffer;
+            Detail::Chunk* chunk =
+                buffer.head.next.load(std::memory_order_relaxed);
+
+            while (chunk != nullptr) {
+                delete std::exchange(
+                    chunk, chunk->next.load(std::memory_order_relaxed));
+            }
+
+            buffer.head.count.store(0, std::memory_order_relaxed);
+            buffer.head.next.store(nullptr, std::memory_order_relaxed);
+            buffer.tail = &buffer.head;
+        }
+
+        threads_.erase(
+            std::remove_if(threads_.begin(), threads_.end(),
+                           [](Entry const& entry) { return entry.exited; }),
+            threads_.end());
+
+        chunk_count_.store(0, std::memory_order_relaxed);
+        dropped_.store(0, std::memory_order_relaxed);
+        origin_ = 0;
+    }
+
+    /**
+     * Copies the events that have been published so far.
+     */
+    std::vector<ThreadEvents> snapshot(u64& origin) {
+        std::lock_guard<std::mutex> const lock{mutex_};
+        std::vector<ThreadEvents> threads;
+
+        origin = origin_;
+
+        for (auto const& entry : threads_) {
+            ThreadEvents thread{entry.id, entry.name, {}};
+            Detail::Chunk const* chunk = &entry.buffer->head;
+
+            while (chunk != nullptr) {
+                u32 const count = chunk->count.load(std::memory_order_acquire);
+                thread.events.insert(thread.events.end(), chunk->events,
+                                     chunk->events + count);
+                chunk = chunk->next.load(std::memory_order_acquire);
+            }
+
+            if (!thread.events.empty()) {
+                threads.push_back(std::move(thread));
+            }
+        }
+
+        return threads;
+    }
+
+    [[nodiscard]] u64 droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    struct Entry {
+        std::unique_ptr<Detail::ThreadBuffer> buffer;
+        u32 id;
+        std::string name;
+        bool exited;
+    };
+
+    // A site named at runtime, the site points into the name
+    struct InternedSite {
+        std::string name;
+        Site site;
+    };
+
+    Registry() = default;
+
+    Entry* find(Detail::ThreadBuffer const* buffer) noexcept {
+        for (auto& entry : threads_) {
+            if (entry.buffer.get() == buffer) {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::mutex mutex_;
+    std::vector<Entry> threads_;
+    std::unordered_map<std::string_view, std::unique_ptr<InternedSite>>
+        sites_;
+    u32 next_id_ = 1;
+    u64 origin_ = 0;
+
+    std::atomic<u64> chunk_count_{0};
+    std::atomic<u64> dropped_{0};
+};
+
+/**
+ * Hands the buffer of the calling thread back to the registry.
+ */
+void retireThreadBuffer() noexcept {
+    if (Detail::thread_buffer != nullptr) {
+        Registry::instance().retire(Detail::thread_buffer);
+        Detail::thread_buffer = nullptr;
+    }
+}
+
+f64 toMilliseconds(u64 ticks) noexcept { return Tsc::toSeconds(ticks) * 1e3; }
+
+/**
+ * Converts a timestamp to microseconds since the start of the capture.
+ */
+f64 toTraceTime(u64 ticks, u64 origin) noexcept {
+    auto const delta = static_cast<f64>(static_cast<i64>(ticks - origin));
+
+    return delta / Tsc::ticksPerSecond() * 1e6;
+}
+
+}  // namespace
+
+namespace Detail {
+
+ThreadBuffer* registerThread() noexcept {
+    thread_buffer = Registry::instance().add();
+    atThreadExit<&retireThreadBuffer>();
+
+    return thread_buffer;
+}
+
+Chunk* grow(ThreadBuffer& buffer) noexcept {
+    return Registry::instance().grow(buffer);
+}
+
+}  // namespace Detail
+
+void markFrame(Site const& site) noexcept {
+    if (!Detail::active.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (Detail::ThreadBuffer* buffer = Detail::threadBuffer()) {
+        u64 const now = Tsc::now();
+        Detail::record(*buffer,
+                       {now, now, &site, 0, Detail::EventType::Frame});
+    }
+}
+
+void recordCounter(Site const& site, f64 value) noexcept {
+    if (!Detail::active.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (Detail::ThreadBuffer* buffer = Detail::threadBuffer()) {
+        u64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        Detail::record(*buffer, {Tsc::now(), bits, &site, 0,
+                                 Detail::EventType::Counter});
+    }
+}
+
+void start() noexcept { Registry::instance().start(); }
+
+void stop() noexcept {
+    Detail::active.store(false, std::memory_order_release);
+}
+
+bool isActive() noexcept {
+    return Detail::active.load(std::memory_order_relaxed);
+}
+
+void reset() noexcept { Registry::instance().reset(); }
+
+void setThreadName(std::string_view name) {
+    if (Detail::ThreadBuffer* buffer = Detail::threadBuffer()) {
+        Registry::instance().setName(buffer, name);
+    }
+}
+
+Site const& internSite(std::string_view name, char const* file, u32 line) {
+    return Registry::instance().intern(name, file, line);
+}
+
+u64 droppedCount() noexcept { return Registry::instance().droppedCount(); }
+
+void writeChromeTrace(std::ostream& out) {
+    u64 origin = 0;
+    auto const threads = Registry::instance().snapshot(origin);
+
+    std::ios_base::fmtflags const flags = out.flags();
+    std::streamsize const precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto const separate = [&out, &first] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (auto const& thread : threads) {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread.id << ",\"args\":{\"name\":";
+        Json::writeString(out, thread.name);
+        out << "}}";
+
+        for (auto const& event : thread.events) {
+            separate();
+            out << "{\"name\":";
+            Json::writeString(out, event.site->name);
+            out << ",\"ts\":" << toTraceTime(event.begin, origin)
+                << ",\"pid\":1,\"tid\":" << thread.id;
+
+            switch (event.type) {
+                case Detail::EventType::Zone:
+                    out << ",\"cat\":\"zone\",\"ph\":\"X\",\"dur\":"
+                        << Tsc::toSeconds(event.end - event.begin) * 1e6
+                        << ",\"args\":{\"depth\":" << event.depth << "}}";
+                    break;
+                case Detail::EventType::Frame:
+                    out << ",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\"}";
+                    break;
+                case Detail::EventType::Counter: {
+                    f64 value;
+                    std::memcpy(&value, &event.end, sizeof(value));
+                    out << ",\"ph\":\"C\",\"args\":{\"value\":" << value
+                        << "}}";
+                    break;
+                }
+            }
+        }
+    }
+
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool writeChromeTrace(std::string const& path) {
+    std::ofstream file{path};
+
+    if (!file) {
+        return false;
+    }
+
+    writeChromeTrace(file);
+
+    return static_cast<bool>(file);
+}
+
+std::vector<ZoneStatistics> zoneStatistics() {
+    struct Totals {
+        u64 count = 0;
+        u64 total = 0;
+        u64 self = 0;
+        u64 min = ~u64{0};
+        u64 max = 0;
+    };
+
+    u64 origin = 0;
+    auto const threads = Registry::instance().snapshot(origin);
+    std::unordered_map<std::string_view, Totals> totals;
+
+    for (auto const& thread : threads) {
+        // The time spent in closed children of the open zone at each depth.
+        // Children close before their parent, so a parent finds the sum of
+        // its children one level below its own depth.
+        std::vector<u64> child_ticks;
+
+        for (auto const& event : thread.events) {
+            if (event.type != Detail::EventType::Zone) {
+                continue;
+            }
+
+            if (child_ticks.size() < event.depth + 2) {
+                child_ticks.resize(event.depth + 2, 0);
+            }
+
+            u64 const duration = event.end - event.begin;
+            u64 const children =
+                std::min(std::exchange(child_ticks[event.depth + 1], 0),
+                         duration);
+            child_ticks[event.depth] += duration;
+
+            Totals& zone = totals[event.site->name];
+            ++zone.count;
+            zone.total += duration;
+            zone.self += duration - children;
+            zone.min = std::min(zone.min, duration);
+            zone.max = std::max(zone.max, duration);
+        }
+    }
+
+    std::vector<ZoneStatistics> statistics;
+    statistics.reserve(totals.size());
+
+    for (auto const& [name, zone] : totals) {
+        statistics.push_back({std::string{name}, zone.count,
+                              toMilliseconds(zone.total),
+                              toMilliseconds(zone.self),
+                              toMilliseconds(zone.min),
+                              toMilliseconds(zone.max)});
+    }
+
+    std::sort(statistics.begin(), statistics.end(),
+              [](ZoneStatistics const& lhs, ZoneStatistics const& rhs) {
+                  return lhs.total_ms > rhs.total_ms;
+              });
+
+    return statistics;
+}
+
+FrameStatistics frameStatistics() {
+    u64 origin = 0;
+    auto const threads = Registry::instance().snapshot(origin);
+
+    u64 count = 0;
+    u64 total = 0;
+    u64 min = ~u64{0};
+    u64 max = 0;
+
+    for (auto const& thread : threads) {
+        bool started = false;
+        u64 previous = 0;
+
+        for (auto const& event : thread.events) {
+            if (event.type != Detail::EventType::Frame) {
+                continue;
+            }
+
+            if (started) {
+                u64 const duration = event.begin - previous;
+                ++count;
+                total += duration;
+                min = std::min(min, duration);
+                max = std::max(max, duration);
+            }
+
+            started = true;
+            previous = event.begin;
+        }
+    }
+
+    if (count == 0) {
+        return {};
+    }
+
+    return {count, toMilliseconds(total) / static_cast<f64>(count),
+            toMilliseconds(min), toMilliseconds(max)};
+}
+
+void writeStatistics(std::ostream& out) {
+    FrameStatistics const frames = frameStatistics();
+    std::vector<ZoneStatistics> const zones = zoneStatistics();
+
+    std::ios_base::fmtflags const flags = out.flags();
+    std::streamsize const precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "Frames: " << frames.count << ", mean " << frames.mean_ms
+        << " ms, min " << frames.min_ms << " ms, max " << frames.max_ms
+        << " ms\n\n";
+
+    out << std::left << std::setw(32) << "Zone" << std::right << std::setw(10)
+        << "Count" << std::setw(12) << "Total ms" << std::setw(12)
+        << "Self ms" << std::setw(12) << "Mean ms" << std::setw(12)
+        << "Min ms" << std::setw(12) << "Max ms" << '\n';
+
+    for (auto const& zone : zones) {
+        out << std::left << std::setw(32) << zone.name << std::right
+            << std::setw(10) << zone.count << std::setw(12) << zone.total_ms
+            << std::setw(12) << zone.self_ms << std::setw(12)
+            << zone.total_ms / static_cast<f64>(zone.count) << std::setw(12)
+            << zone.min_ms << std::setw(12) << zone.max_ms << '\n';
+    }
+
+    if (u64 const dropped = droppedCount(); dropped > 0) {
+        out << "\nDropped " << dropped << " events\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}  // namespace Profiler
+
+}  // namespace Zeus
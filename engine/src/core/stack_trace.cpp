@@ -0,0 +1,50 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/core/stack_trace.hpp"
+
+#if defined(_WIN32)
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+namespace Zeus {
+
+namespace StackTrace {
+
+namespace Detail {
+
+ZEUS_NOINLINE std::size_t captureWindows(void** frames,
+                                         std::size_t capacity) noexcept {
+    // Skips this function so frame 0 is the caller, like backtrace()
+    return static_cast<std::size_t>(CaptureStackBackTrace(
+        1, static_cast<DWORD>(capacity), frames, nullptr));
+}
+
+}  // namespace Detail
+
+}  // namespace StackTrace
+
+}  // namespace Zeus
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/ecs/archetype.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "zeus/memory/cache_line.hpp"
+
+namespace Zeus {
+
+namespace Ecs {
+
+namespace {
+
+constexpr std::size_t column_alignment = Memory::cache_line_size;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+Archetype::Archetype(ComponentMask mask) : mask_{mask} {
+    column_of_.fill(no_column);
+
+    std::size_t row_size = sizeof(Entity);
+
+    for (ComponentId id = 0; id < max_components; ++id) {
+        if ((mask & (ComponentMask{1} << id)) != 0) {
+            ComponentInfo const& info = componentInfo(id);
+
+            ZEUS_MODULE_ASSERT(ECS, ALWAYS, info.alignment <= column_alignment,
+                               "Components can be aligned to a cache line at "
+                               "most.");
+
+            column_of_[id] = static_cast<u8>(columns_.size());
+            columns_.push_back({id, &info, 0});
+            row_size += info.size;
+        }
+    }
+
+    // Every array can need up to a cache line of padding
+    std::size_t const padding = (columns_.size() + 1) * column_alignment;
+
+    capacity_ = static_cast<u32>(
+        chunk_size > padding ? (chunk_size - padding) / row_size : 0);
+
+    // Rows larger than a chunk get chunks of a single row
+    capacity_ = std::max<u32>(capacity_, 1);
+
+    std::size_t offset = alignUp(capacity_ * sizeof(Entity), column_alignment);
+
+    for (Column& column : columns_) {
+        column.offset = offset;
+        offset = alignUp(offset + capacity_ * column.info->size,
+                         column_alignment);
+    }
+
+    chunk_bytes_ = std::max(chunk_size, offset);
+}
+
+Archetype::~Archetype() {
+    for (u32 row = 0; row < size_; ++row) {
+        destroyRow(row);
+    }
+
+    for (Chunk const& chunk : chunks_) {
+        ::operator delete(chunk.data, std::align_val_t{column_alignment});
+    }
+}
+
+u32 Archetype::allocate(Entity entity) {
+    std::size_t const chunk = size_ / capacity_;
+
+    if (chunk == chunks_.size()) {
+        auto* const data = static_cast<std::byte*>(::operator new(
+            chunk_bytes_, std::align_val_t{column_alignment}));
+
+        chunks_.push_back({data, 0});
+    }
+
+    Chunk& last = chunks_[chunk];
+    entities(chunk)[last.count] = entity;
+    ++last.count;
+
+    return size_++;
+}
+
+Entity Archetype::remove(u32 row, bool destroy) noexcept {
+    if (destroy) {
+        destroyRow(row);
+    }
+
+    u32 const last = size_ - 1;
+    Entity moved;
+
+    if (row != last) {
+        moved = entity(last);
+        entities(row / capacity_)[row % capacity_] = moved;
+
+        for (Column const& column : columns_) {
+            void* const to = component(column.id, row);
+            void* const from = component(column.id, last);
+
+            if (column.info->relocate != nullptr) {
+                column.info->relocate(to, from);
+            } else {
+                std::memcpy(to, from, column.info->size);
+            }
+        }
+    }
+
+    --size_;
+
+    Chunk& chunk = chunks_[last / capacity_];
+    --chunk.count;
+
+    // Keep one empty chunk so that an entity moving back and forth at a
+    // chunk boundary does not allocate every time
+    if (chunks_.size() >= 2 && chunks_.back().count == 0 &&
+        chunks_[chunks_.size() - 2].count == 0) {
+        ::operator delete(chunks_.back().data,
+                          std::align_val_t{column_alignment});
+        chunks_.pop_back();
+    }
+
+    return moved;
+}
+
+void Archetype::destroyRow(u32 row) noexcept {
+    for (Column const& column : columns_) {
+        if (column.info->destroy != nullptr) {
+            column.info->destroy(component(column.id, row));
+        }
+    }
+}
+
+}  // namespace Ecs
+
+}  // namespace Zeus
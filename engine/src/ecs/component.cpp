@@ -0,0 +1,59 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/ecs/component.hpp"
+
+#include <array>
+#include <atomic>
+
+#include "zeus/core/assert.hpp"
+
+namespace Zeus {
+
+namespace Ecs {
+
+namespace {
+
+std::array<ComponentInfo, max_components> infos;
+std::atomic<ComponentId> next_id{0};
+
+}  // namespace
+
+namespace Detail {
+
+ComponentId registerComponent(ComponentInfo const& info) noexcept {
+    ComponentId const id = next_id.fetch_add(1, std::memory_order_relaxed);
+
+    ZEUS_MODULE_ASSERT(ECS, ALWAYS, id < max_components,
+                       "Too many component types, a ComponentMask holds at "
+                       "most max_components.");
+
+    infos[id] = info;
+
+    return id;
+}
+
+}  // namespace Detail
+
+ComponentInfo const& componentInfo(ComponentId id) noexcept {
+    return infos[id];
+}
+
+}  // namespace Ecs
+
+}  // namespace Zeus
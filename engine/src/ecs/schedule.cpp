@@ -0,0 +1,76 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/ecs/schedule.hpp"
+
+#include <algorithm>
+
+namespace Zeus {
+
+namespace Ecs {
+
+namespace {
+
+/**
+ * Returns whether two systems must not run at the same time.
+ */
+bool conflicts(ComponentMask lhs_reads, ComponentMask lhs_writes,
+               ComponentMask rhs_reads, ComponentMask rhs_writes) noexcept {
+    return (lhs_writes & (rhs_reads | rhs_writes)) != 0 ||
+           (rhs_writes & lhs_reads) != 0;
+}
+
+}  // namespace
+
+void Schedule::run() {
+    for (auto const& stage : stages_) {
+        for (std::size_t const index : stage) {
+            runSystem(systems_[index]);
+        }
+    }
+}
+
+void Schedule::addSystem(std::string name, ComponentMask reads,
+                         ComponentMask writes,
+                         std::function<void()> function) {
+    std::size_t stage = 0;
+
+    for (System const& earlier : systems_) {
+        if (conflicts(reads, writes, earlier.reads, earlier.writes)) {
+            stage = std::max(stage, earlier.stage + 1);
+        }
+    }
+
+    if (stage == stages_.size()) {
+        stages_.emplace_back();
+    }
+
+    Profiler::Site const* site = nullptr;
+
+#ifdef ZEUS_ENABLE_PROFILING
+    site = &Profiler::internSite(name, __FILE__, __LINE__);
+#endif
+
+    stages_[stage].push_back(systems_.size());
+    systems_.push_back(
+        {std::move(name), reads, writes, stage, std::move(function), site});
+}
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,181 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/ecs/world.hpp"
+
+#include <cstring>
+
+namespace Zeus {
+
+namespace Ecs {
+
+World::World() : empty_{&archetypeFor(0)} {}
+
+World::~World() = default;
+
+Entity World::create() {
+    Entity const entity = allocateEntity();
+
+    place(entity, *empty_, empty_->allocate(entity));
+
+    return entity;
+}
+
+void World::destroy(Entity entity) noexcept {
+    if (!isAlive(entity)) {
+        return;
+    }
+
+    Record& record = records_[entity.index()];
+    Entity const moved = record.archetype->remove(record.row, true);
+
+    if (moved) {
+        records_[moved.index()].row = record.row;
+    }
+
+    record.archetype = nullptr;
+
+    // Generation zero is reserved for null entities
+    if (++record.generation > Entity::max_generation) {
+        record.generation = 1;
+    }
+
+    free_indices_.push_back(static_cast<u32>(entity.index()));
+    --entity_count_;
+}
+
+u32 World::bitCount(ComponentMask mask) noexcept {
+    u32 count = 0;
+
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+
+    return count;
+}
+
+Entity World::allocateEntity() {
+    u32 index;
+
+    if (!free_indices_.empty()) {
+        index = free_indices_.back();
+        free_indices_.pop_back();
+    } else {
+        ZEUS_MODULE_ASSERT(ECS, ALWAYS, records_.size() <= Entity::max_index,
+                           "Too many entities.");
+
+        index = static_cast<u32>(records_.size());
+        records_.push_back({nullptr, 0, 1});
+    }
+
+    ++entity_count_;
+
+    return {index, records_[index].generation};
+}
+
+void World::place(Entity entity, Archetype& archetype, u32 row) noexcept {
+    Record& record = records_[entity.index()];
+    record.archetype = &archetype;
+    record.row = row;
+}
+
+Archetype& World::archetypeFor(ComponentMask mask) {
+    auto const found = archetype_of_mask_.find(mask);
+
+    if (found != archetype_of_mask_.end()) {
+        return *found->second;
+    }
+
+    archetypes_.push_back(std::make_unique<Archetype>(mask));
+    Archetype* const archetype = archetypes_.back().get();
+    archetype_of_mask_.try_emplace(mask, archetype);
+
+    return *archetype;
+}
+
+Archetype& World::withComponent(Archetype& from, ComponentId id) {
+    if (Archetype* const cached = from.addEdge(id)) {
+        return *cached;
+    }
+
+    Archetype& to = archetypeFor(from.mask() | (ComponentMask{1} << id));
+    from.setAddEdge(id, &to);
+    to.setRemoveEdge(id, &from);
+
+    return to;
+}
+
+Archetype& World::withoutComponent(Archetype& from, ComponentId id) {
+    if (Archetype* const cached = from.removeEdge(id)) {
+        return *cached;
+    }
+
+    Archetype& to = archetypeFor(from.mask() & ~(ComponentMask{1} << id));
+    from.setRemoveEdge(id, &to);
+    to.setAddEdge(id, &from);
+
+    return to;
+}
+
+u32 World::move(Entity entity, Archetype& to) {
+    Record& record = records_[entity.index()];
+    Archetype& from = *record.archetype;
+    u32 const row = to.allocate(entity);
+
+    // Move the components both archetypes have and destroy the others
+    from.forEachComponent([&](ComponentId id) {
+        ComponentInfo const& info = componentInfo(id);
+        void* const source = from.component(id, record.row);
+
+        if (to.has(id)) {
+            void* const destination = to.component(id, row);
+
+            if (info.relocate != nullptr) {
+                info.relocate(destination, source);
+            } else {
+                std::memcpy(destination, source, info.size);
+            }
+        } else if (info.destroy != nullptr) {
+            info.destroy(source);
+        }
+    });
+
+    Entity const moved = from.remove(record.row, false);
+
+    if (moved) {
+        records_[moved.index()].row = record.row;
+    }
+
+    place(entity, to, row);
+
+    return row;
+}
+
+bool World::removeComponent(Entity entity, ComponentId id) {
+    if (!isAlive(entity) || !records_[entity.index()].archetype->has(id)) {
+        return false;
+    }
+
+    move(entity, withoutComponent(*records_[entity.index()].archetype, id));
+
+    return true;
+}
+
+}  // namespace Ecs
+
+}  // namespace Zeus
@@ -0,0 +1,168 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/job/fiber.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+#if !ZEUS_FIBER_USE_UCONTEXT
+
+// Saves the callee-saved registers and the floating point control words of
+// the running context on its stack, stores the stack pointer in *from and
+// restores the target context from the stack pointer to.
+//
+// void zeus_fiber_switch(void** from, void* to)
+asm(R"(
+    .text
+    .p2align 4
+    .type zeus_fiber_switch, @function
+zeus_fiber_switch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size zeus_fiber_switch, .-zeus_fiber_switch
+
+    .p2align 4
+    .type zeus_fiber_start, @function
+zeus_fiber_start:
+    movq %r13, %rdi
+    callq *%r12
+    ud2
+    .size zeus_fiber_start, .-zeus_fiber_start
+)");
+
+extern "C" {
+void zeus_fiber_switch(void** from, void* to) noexcept;
+void zeus_fiber_start() noexcept;
+}
+
+#endif
+
+namespace Zeus {
+
+namespace Job {
+
+#if ZEUS_FIBER_USE_UCONTEXT
+
+namespace {
+
+void startFiber(unsigned int entry_high, unsigned int entry_low,
+                unsigned int argument_high,
+                unsigned int argument_low) noexcept {
+    // makecontext only passes int arguments, so pointers arrive in halves
+    auto const join = [](unsigned int high, unsigned int low) {
+        return (static_cast<std::uintptr_t>(high) << 32U) |
+               static_cast<std::uintptr_t>(low);
+    };
+
+    auto const entry = reinterpret_cast<Fiber::Entry>(
+        join(entry_high, entry_low));
+    entry(reinterpret_cast<void*>(join(argument_high, argument_low)));
+
+    // Entry functions must switch away instead of returning
+    std::abort();
+}
+
+}  // namespace
+
+Fiber::Fiber(void* stack, std::size_t stack_size, Entry entry,
+             void* argument) noexcept {
+    auto const entry_bits = reinterpret_cast<std::uintptr_t>(entry);
+    auto const argument_bits = reinterpret_cast<std::uintptr_t>(argument);
+
+    getcontext(&context_);
+    context_.uc_stack.ss_sp = stack;
+    context_.uc_stack.ss_size = stack_size;
+    context_.uc_link = nullptr;
+
+    makecontext(&context_, reinterpret_cast<void (*)()>(&startFiber), 4,
+                static_cast<unsigned int>(entry_bits >> 32U),
+                static_cast<unsigned int>(entry_bits),
+                static_cast<unsigned int>(argument_bits >> 32U),
+                static_cast<unsigned int>(argument_bits));
+}
+
+void Fiber::switchTo(Fiber& target) noexcept {
+    swapcontext(&context_, &target.context_);
+}
+
+#else
+
+Fiber::Fiber(void* stack, std::size_t stack_size, Entry entry,
+             void* argument) noexcept {
+    // The initial frame is popped by zeus_fiber_switch, the entry and its
+    // argument travel in r12 and r13
+    struct InitialFrame {
+        std::uint32_t mxcsr;
+        std::uint32_t fpu_control;
+        void* r15;
+        void* r14;
+        void* r13;
+        void* r12;
+        void* rbx;
+        void* rbp;
+        void* return_address;
+    };
+
+    std::uintptr_t top = reinterpret_cast<std::uintptr_t>(stack) + stack_size;
+    top &= ~std::uintptr_t{15};
+
+    // zeus_fiber_start is entered with a 16 byte aligned stack pointer, as
+    // expected right before a call
+    auto* frame = reinterpret_cast<InitialFrame*>(top - 80);
+    frame->mxcsr = 0x1F80;
+    frame->fpu_control = 0x037F;
+    frame->r15 = nullptr;
+    frame->r14 = nullptr;
+    frame->r13 = argument;
+    frame->r12 = reinterpret_cast<void*>(entry);
+    frame->rbx = nullptr;
+    frame->rbp = nullptr;
+    frame->return_address = reinterpret_cast<void*>(&zeus_fiber_start);
+
+    stack_pointer_ = frame;
+}
+
+void Fiber::switchTo(Fiber& target) noexcept {
+    zeus_fiber_switch(&stack_pointer_, target.stack_pointer_);
+}
+
+#endif
+
+}  // namespace Job
+
+}  // namespace Zeus
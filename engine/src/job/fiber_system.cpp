@@ -0,0 +1,377 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/job/fiber_system.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/bit.hpp"
+#include "zeus/core/compiler_macros.hpp"
+#include "zeus/job/work_stealing_deque.hpp"
+#include "zeus/memory/virtual_memory.hpp"
+
+namespace Zeus {
+
+namespace Job {
+
+namespace Detail {
+
+struct AfterSwitch {
+    enum class Action {
+        /**
+         * Nothing to do.
+         */
+        None,
+
+        /**
+         * Return the fiber to the pool.
+         */
+        Release,
+
+        /**
+         * Add the fiber to the waiting fibers.
+         */
+        Park
+    };
+
+    Action action = Action::None;
+    Fiber* fiber = nullptr;
+    Counter const* counter = nullptr;
+    std::size_t owner = FiberSystem::invalid_worker;
+};
+
+struct FiberWorker : Worker {
+    using Worker::Worker;
+
+    // The context of the thread itself and the fiber running on it
+    Fiber thread_fiber;
+    Fiber* fiber = &thread_fiber;
+
+    // Left by the fiber that switched away for the fiber switched to
+    AfterSwitch after_switch;
+};
+
+}  // namespace Detail
+
+namespace {
+
+thread_local Detail::FiberWorker* current_worker = nullptr;
+
+/**
+ * Returns the worker of the calling thread.
+ *
+ * @note Kept out of line so the compiler cannot reuse the address of the
+ * thread_local across a fiber switch, after which the fiber may run on
+ * another thread.
+ */
+ZEUS_NOINLINE Detail::FiberWorker* currentWorker() noexcept {
+    return current_worker;
+}
+
+ZEUS_NOINLINE void setCurrentWorker(Detail::FiberWorker* worker) noexcept {
+    current_worker = worker;
+}
+
+}  // namespace
+
+FiberSystem::FiberSystem(std::size_t thread_count, Affinity affinity,
+                         std::size_t fiber_count, std::size_t stack_size) {
+    ZEUS_MODULE_ASSERT(JOB, ALWAYS, currentWorker() == nullptr,
+                       "The thread already belongs to a fiber system.");
+
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    // Every started thread needs a fiber to run on, worker 0 needs one to
+    // wait
+    fiber_count_ = std::max(fiber_count, thread_count);
+
+    std::size_t const page = Memory::VirtualMemory::pageSize();
+    std::size_t const stack_bytes = Memory::VirtualMemory::roundToPages(
+        std::max(stack_size, page));
+    stack_stride_ = stack_bytes + page;
+
+    stacks_ = Memory::VirtualMemory::reserve(stack_stride_ * fiber_count_);
+    ZEUS_MODULE_ASSERT(JOB, ALWAYS, stacks_ != nullptr,
+                       "Failed to reserve the fiber stacks.");
+
+    fibers_.reserve(fiber_count_);
+    free_fibers_.reserve(fiber_count_);
+    waiting_.reserve(fiber_count_ + thread_count);
+
+    for (std::size_t index = 0; index < fiber_count_; ++index) {
+        // The lowest page of every stride stays inaccessible, stacks grow
+        // down towards it
+        auto* const stack =
+            static_cast<std::byte*>(stacks_) + index * stack_stride_ + page;
+
+        bool const committed =
+            Memory::VirtualMemory::commit(stack, stack_bytes);
+        ZEUS_MODULE_ASSERT(JOB, ALWAYS, committed,
+                           "Failed to commit a fiber stack.");
+
+        fibers_.push_back(
+            std::make_unique<Fiber>(stack, stack_bytes, &fiberMain, this));
+        free_fibers_.push_back(fibers_.back().get());
+    }
+
+    std::size_t const job_count = System::default_jobs_per_thread;
+
+    for (std::size_t index = 0; index < thread_count; ++index) {
+        scheduler_.addWorker(std::make_unique<Detail::FiberWorker>(
+            scheduler_, index, job_count));
+    }
+
+    setCurrentWorker(&fiberWorker(0));
+
+    for (std::size_t index = 1; index < thread_count; ++index) {
+        Detail::FiberWorker& worker = fiberWorker(index);
+        Fiber* const fiber = acquireFiber();
+
+        worker.thread = std::thread{
+            [this, &worker, fiber] { threadMain(worker, *fiber); }};
+        Detail::configureWorkerThread(worker.thread, index, affinity);
+    }
+}
+
+FiberSystem::~FiberSystem() {
+    scheduler_.stop();
+
+    setCurrentWorker(nullptr);
+
+    ZEUS_MODULE_ASSERT(JOB, DEBUG, waiting_.empty(),
+                       "A fiber is still waiting on a counter.");
+
+    Memory::VirtualMemory::release(stacks_, stack_stride_ * fiber_count_);
+}
+
+void FiberSystem::wait(Counter const& counter) noexcept {
+    if (counter.done()) {
+        return;
+    }
+
+    Detail::FiberWorker& worker = current();
+
+    if (Fiber* const next = acquireFiber()) {
+        // The thread's own context may only continue on the same thread
+        std::size_t const owner = worker.fiber == &worker.thread_fiber
+                                      ? worker.index
+                                      : invalid_worker;
+
+        switchTo(*next, {Detail::AfterSwitch::Action::Park, nullptr,
+                         &counter, owner});
+
+        return;
+    }
+
+    // Every fiber is taken, run other jobs on top of this one
+    scheduler_.runUntil(worker, counter);
+}
+
+std::size_t FiberSystem::workerIndex() const noexcept {
+    Detail::FiberWorker const* worker = currentWorker();
+
+    if (worker == nullptr || worker->scheduler != &scheduler_) {
+        return invalid_worker;
+    }
+
+    return worker->index;
+}
+
+void FiberSystem::fiberMain(void* system) noexcept {
+    static_cast<FiberSystem*>(system)->schedule();
+}
+
+Detail::FiberWorker& FiberSystem::current() const noexcept {
+    Detail::FiberWorker* worker = currentWorker();
+
+    ZEUS_MODULE_ASSERT(JOB, ALWAYS,
+                       worker != nullptr &&
+                           worker->scheduler == &scheduler_,
+                       "Jobs can only be used from a worker of the system.");
+
+    return *worker;
+}
+
+Detail::FiberWorker& FiberSystem::fiberWorker(std::size_t index) noexcept {
+    return static_cast<Detail::FiberWorker&>(scheduler_.worker(index));
+}
+
+Detail::Job& FiberSystem::allocate() noexcept {
+    return scheduler_.allocate(current());
+}
+
+void FiberSystem::submit(Detail::Job& job) {
+    // Allocating may have run a job that waited, after which this fiber can
+    // continue on another worker
+    scheduler_.submit(current(), job);
+}
+
+Fiber* FiberSystem::acquireFiber() noexcept {
+    std::lock_guard const lock{free_mutex_};
+
+    if (free_fibers_.empty()) {
+        return nullptr;
+    }
+
+    Fiber* const fiber = free_fibers_.back();
+    free_fibers_.pop_back();
+
+    return fiber;
+}
+
+Fiber* FiberSystem::takeReady(Detail::FiberWorker& worker) noexcept {
+    if (waiting_count_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard const lock{waiting_mutex_};
+
+    auto const ready = std::find_if(
+        waiting_.begin(), waiting_.end(), [&worker](Waiting const& waiting) {
+            return (waiting.owner == invalid_worker ||
+                    waiting.owner == worker.index) &&
+                   waiting.counter->done();
+        });
+
+    if (ready == waiting_.end()) {
+        return nullptr;
+    }
+
+    Fiber* const fiber = ready->fiber;
+    *ready = waiting_.back();
+    waiting_.pop_back();
+    waiting_count_.fetch_sub(1, std::memory_order_relaxed);
+
+    return fiber;
+}
+
+bool FiberSystem::hasWork(Detail::FiberWorker& worker) noexcept {
+    if (scheduler_.hasQueuedJobs()) {
+        return true;
+    }
+
+    if (waiting_count_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::lock_guard const lock{waiting_mutex_};
+
+    return std::any_of(
+        waiting_.begin(), waiting_.end(), [&worker](Waiting const& waiting) {
+            return (waiting.owner == invalid_worker ||
+                    waiting.owner == worker.index) &&
+                   waiting.counter->done();
+        });
+}
+
+void FiberSystem::switchTo(Fiber& target,
+                           Detail::AfterSwitch const& after) noexcept {
+    Detail::FiberWorker& worker = current();
+    Fiber& from = *worker.fiber;
+
+    worker.after_switch = after;
+    worker.after_switch.fiber = &from;
+    worker.fiber = &target;
+
+    from.switchTo(target);
+
+    // Resumed, possibly on another thread
+    afterSwitch();
+}
+
+void FiberSystem::afterSwitch() noexcept {
+    Detail::FiberWorker& worker = current();
+    Detail::AfterSwitch const after =
+        std::exchange(worker.after_switch, Detail::AfterSwitch{});
+
+    switch (after.action) {
+        case Detail::AfterSwitch::Action::None:
+            break;
+
+        case Detail::AfterSwitch::Action::Release: {
+            std::lock_guard const lock{free_mutex_};
+            free_fibers_.push_back(after.fiber);
+            break;
+        }
+
+        case Detail::AfterSwitch::Action::Park: {
+            std::lock_guard const lock{waiting_mutex_};
+            waiting_.push_back({after.fiber, after.counter, after.owner});
+            waiting_count_.fetch_add(1, std::memory_order_release);
+            break;
+        }
+    }
+}
+
+void FiberSystem::schedule() noexcept {
+    afterSwitch();
+
+    for (;;) {
+        Detail::FiberWorker& worker = current();
+
+        if (Fiber* const ready = takeReady(worker)) {
+            switchTo(*ready, {Detail::AfterSwitch::Action::Release});
+        } else if (worker.index != 0 && scheduler_.stopping()) {
+            switchTo(worker.thread_fiber,
+                     {Detail::AfterSwitch::Action::Release});
+        } else if (Detail::Job* job = scheduler_.find(worker)) {
+            Detail::executeJob(*job);
+        } else {
+            idle(worker);
+        }
+    }
+}
+
+void FiberSystem::threadMain(Detail::FiberWorker& worker,
+                             Fiber& fiber) noexcept {
+    setCurrentWorker(&worker);
+
+    // Run the scheduler on a fiber until the system stops
+    switchTo(fiber, {});
+
+    setCurrentWorker(nullptr);
+}
+
+void FiberSystem::idle(Detail::FiberWorker& worker) noexcept {
+    for (int spin = 0; spin < Detail::WorkStealingScheduler::spin_count;
+         ++spin) {
+        if (hasWork(worker)) {
+            return;
+        }
+
+        ZEUS_CPU_PAUSE();
+    }
+
+    // Worker 0 keeps polling, the context of its thread waits for a counter
+    // that nobody signals
+    if (worker.index == 0) {
+        std::this_thread::yield();
+
+        return;
+    }
+
+    scheduler_.sleep([this, &worker] { return hasWork(worker); });
+}
+
+}  // namespace Job
+
+}  // namespace Zeus
@@ -0,0 +1,301 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/job/job_system.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/bit.hpp"
+#include "zeus/core/compiler_macros.hpp"
+#include "zeus/job/work_stealing_deque.hpp"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Zeus {
+
+namespace Job {
+
+namespace {
+
+thread_local Detail::Worker* current_worker = nullptr;
+
+u64 nextRandom(u64& state) noexcept {
+    // xorshift64
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+
+    return state;
+}
+
+}  // namespace
+
+void Detail::configureWorkerThread(
+    [[maybe_unused]] std::thread& thread, [[maybe_unused]] std::size_t index,
+    [[maybe_unused]] Affinity affinity) noexcept {
+    [[maybe_unused]] std::size_t const cores =
+        std::max(std::thread::hardware_concurrency(), 1U);
+
+#if defined(_WIN32)
+    if (affinity == Affinity::Pinned && index % cores < 64) {
+        SetThreadAffinityMask(thread.native_handle(),
+                              DWORD_PTR{1} << (index % cores));
+    }
+#elif defined(__linux__)
+    std::string const name = "zeus-worker-" + std::to_string(index);
+    pthread_setname_np(thread.native_handle(), name.substr(0, 15).c_str());
+
+    if (affinity == Affinity::Pinned) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % cores, &cpus);
+
+        // Pinning is only a hint, the worker still runs if it fails
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+    }
+#endif
+}
+
+Detail::Worker::Worker(WorkStealingScheduler& owner,
+                       std::size_t worker_index, std::size_t job_count)
+    : scheduler{&owner},
+      index{worker_index},
+      jobs{std::make_unique<Job[]>(job_count)},
+      job_mask{job_count - 1},
+      random{0x9E3779B97F4A7C15ULL * (worker_index + 1)} {}
+
+Detail::Worker::~Worker() = default;
+
+void Detail::WorkStealingScheduler::addWorker(std::unique_ptr<Worker> worker) {
+    ZEUS_MODULE_ASSERT(JOB, DEBUG,
+                       worker->scheduler == this &&
+                           worker->index == workers_.size(),
+                       "The worker was created for another slot.");
+
+    workers_.push_back(std::move(worker));
+}
+
+Detail::Job& Detail::WorkStealingScheduler::allocate(Worker& worker) noexcept {
+    Job& job = worker.jobs[worker.next_job++ & worker.job_mask];
+
+    // Every slot is in flight, help until the oldest one is free again
+    while (job.function.load(std::memory_order_acquire) != nullptr) {
+        if (Job* other = find(worker)) {
+            executeJob(*other);
+        } else {
+            ZEUS_CPU_PAUSE();
+        }
+    }
+
+    return job;
+}
+
+void Detail::WorkStealingScheduler::submit(Worker& worker, Job& job) {
+    worker.deque.push(&job);
+
+    // Pairs with the fence in sleep() so that either this thread sees the
+    // sleeper or the sleeper sees the job
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (sleeping_.load(std::memory_order_relaxed) > 0) {
+        wake();
+    }
+}
+
+Detail::Job* Detail::WorkStealingScheduler::find(Worker& worker) noexcept {
+    if (auto job = worker.deque.pop()) {
+        return *job;
+    }
+
+    std::size_t const count = workers_.size();
+    std::size_t const start = nextRandom(worker.random) % count;
+
+    for (std::size_t offset = 0; offset < count; ++offset) {
+        Worker& victim = *workers_[(start + offset) % count];
+
+        if (&victim == &worker) {
+            continue;
+        }
+
+        if (auto job = victim.deque.steal()) {
+            return *job;
+        }
+    }
+
+    return nullptr;
+}
+
+void Detail::WorkStealingScheduler::runUntil(Worker& worker,
+                                             Counter const& counter) noexcept {
+    int failures = 0;
+
+    while (!counter.done()) {
+        if (Job* job = find(worker)) {
+            executeJob(*job);
+            failures = 0;
+        } else if (++failures < yield_after) {
+            ZEUS_CPU_PAUSE();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool Detail::WorkStealingScheduler::hasQueuedJobs() const noexcept {
+    return std::any_of(
+        workers_.begin(), workers_.end(),
+        [](auto const& worker) { return !worker->deque.empty(); });
+}
+
+void Detail::WorkStealingScheduler::stop() noexcept {
+    stopping_.store(true, std::memory_order_relaxed);
+
+    {
+        std::lock_guard const lock{sleep_mutex_};
+        ++wake_epoch_;
+    }
+
+    sleep_condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void Detail::WorkStealingScheduler::wake() noexcept {
+    {
+        std::lock_guard const lock{sleep_mutex_};
+        ++wake_epoch_;
+    }
+
+    sleep_condition_.notify_one();
+}
+
+System::System(std::size_t thread_count, Affinity affinity,
+               std::size_t jobs_per_thread) {
+    ZEUS_MODULE_ASSERT(JOB, ALWAYS, current_worker == nullptr,
+                       "The thread already belongs to a job system.");
+
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    std::size_t const job_count =
+        u64{1} << bitWidth(
+            static_cast<u64>(std::max<std::size_t>(jobs_per_thread, 2) - 1));
+
+    for (std::size_t index = 0; index < thread_count; ++index) {
+        scheduler_.addWorker(
+            std::make_unique<Detail::Worker>(scheduler_, index, job_count));
+    }
+
+    current_worker = &scheduler_.worker(0);
+
+    for (std::size_t index = 1; index < thread_count; ++index) {
+        Detail::Worker& worker = scheduler_.worker(index);
+
+        worker.thread = std::thread{[this, &worker] { workerMain(worker); }};
+        Detail::configureWorkerThread(worker.thread, index, affinity);
+    }
+}
+
+System::~System() {
+    scheduler_.stop();
+
+    current_worker = nullptr;
+}
+
+void System::wait(Counter const& counter) noexcept {
+    scheduler_.runUntil(current(), counter);
+}
+
+std::size_t System::workerIndex() const noexcept {
+    if (current_worker == nullptr || current_worker->scheduler != &scheduler_) {
+        return invalid_worker;
+    }
+
+    return current_worker->index;
+}
+
+Detail::Worker& System::current() const noexcept {
+    ZEUS_MODULE_ASSERT(JOB, ALWAYS,
+                       current_worker != nullptr &&
+                           current_worker->scheduler == &scheduler_,
+                       "Jobs can only be used from a worker of the system.");
+
+    return *current_worker;
+}
+
+void System::workerMain(Detail::Worker& worker) noexcept {
+    current_worker = &worker;
+
+    while (!scheduler_.stopping()) {
+        if (Detail::Job* job = scheduler_.find(worker)) {
+            Detail::executeJob(*job);
+        } else {
+            idle(worker);
+        }
+    }
+
+    current_worker = nullptr;
+}
+
+void System::idle(Detail::Worker& worker) noexcept {
+    for (int spin = 0; spin < Detail::WorkStealingScheduler::spin_count;
+         ++spin) {
+        if (Detail::Job* job = scheduler_.find(worker)) {
+            Detail::executeJob(*job);
+
+            return;
+        }
+
+        ZEUS_CPU_PAUSE();
+    }
+
+    Detail::Job* job = nullptr;
+
+    scheduler_.sleep([&] {
+        job = scheduler_.find(worker);
+
+        return job != nullptr;
+    });
+
+    if (job != nullptr) {
+        Detail::executeJob(*job);
+    }
+}
+
+}  // namespace Job
+
+}  // namespace Zeus
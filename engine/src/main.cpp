@@ -16,13 +16,224 @@
  * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
+#include <csignal>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "zeus/config.hpp"
+#include "zeus/core/format.hpp"
+#include "zeus/core/game_loop.hpp"
+#include "zeus/core/log.hpp"
+#include "zeus/core/metrics.hpp"
+#include "zeus/core/profiler.hpp"
+#include "zeus/core/stack_trace.hpp"
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/vector_3d.hpp"
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
-    std::cout << "Zeus Version: " << ZEUS_VERSION_MAJOR << '.'
-              << ZEUS_VERSION_MINOR << '.' << ZEUS_VERSION_PATCH << '\n';
+namespace {
+
+using Zeus::Math::Vector3D;
+
+constexpr std::size_t particle_count = std::size_t{1} << 16U;
+
+/**
+ * A point mass integrated by the simulation. The previous position is kept
+ * for interpolating between simulation steps.
+ */
+struct Particle {
+    Vector3D previous;
+    Vector3D position;
+    Vector3D velocity;
+};
+
+/**
+ * The options given on the command line.
+ */
+struct Options {
+    Zeus::GameLoop::Settings loop;
+    std::string trace_path;
+    std::string metrics_path;
+};
+
+/**
+ * The loop that SIGINT and SIGTERM stop.
+ */
+Zeus::GameLoop* running_loop = nullptr;
+
+void requestStop([[maybe_unused]] int signal) {
+    if (running_loop != nullptr) {
+        running_loop->stop();
+    }
+}
+
+void printUsage(char const* program) {
+    std::printf(
+        "Usage: %s [--frames N] [--fps N] [--trace FILE] [--metrics FILE]\n"
+        "\n"
+        "  --frames N    Run N frames headless, one simulation step each, as\n"
+        "                fast as possible and exit\n"
+        "  --fps N       Limit the frame rate, 0 for no limit (default 60,\n"
+        "                or no limit with --frames)\n"
+        "  --trace FILE  Profile the run and write a Chrome trace to FILE\n"
+        "  --metrics FILE\n"
+        "                Append the runtime metrics to FILE every second, as\n"
+        "                JSON lines if it ends in .json and as CSV otherwise\n",
+        program);
+}
+
+/**
+ * Parses the command line.
+ *
+ * @return False if the command line is invalid
+ */
+bool parseOptions(int argc, char* argv[], Options& options) {
+    bool has_fps = false;
+
+    for (int i = 1; i < argc; ++i) {
+        bool const has_value = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            options.loop.frame_count = std::strtoull(argv[++i], nullptr, 10);
+            options.loop.headless = options.loop.frame_count > 0;
+        } else if (std::strcmp(argv[i], "--fps") == 0 && has_value) {
+            options.loop.frame_rate_limit = std::strtod(argv[++i], nullptr);
+            has_fps = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && has_value) {
+            options.trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--metrics") == 0 && has_value) {
+            options.metrics_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    if (!has_fps) {
+        options.loop.frame_rate_limit = options.loop.headless ? 0.0 : 60.0;
+    }
+
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Zeus::StackTrace::installCrashHandlers();
+
+    Options options;
+
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    auto const version =
+        ZEUS_FORMAT(64, "Zeus Version: {}.{}.{}\n", ZEUS_VERSION_MAJOR,
+                    ZEUS_VERSION_MINOR, ZEUS_VERSION_PATCH);
+    std::fputs(version.c_str(), stdout);
+
+    // One worker per core, this thread is worker 0
+    Zeus::Job::System jobs;
+
+    auto const workers =
+        ZEUS_FORMAT(64, "Job System: {} workers\n", jobs.threadCount());
+    std::fputs(workers.c_str(), stdout);
+
+    std::vector<Particle> particles(particle_count);
+
+    for (std::size_t i = 0; i < particle_count; ++i) {
+        auto const offset = static_cast<float>(i % 256);
+        auto& particle = particles[i];
+
+        particle.position = {offset, 10.0F + offset * 0.1F, 0.0F};
+        particle.previous = particle.position;
+        particle.velocity = {1.0F, 0.0F, offset * 0.01F};
+    }
+
+    Zeus::GameLoop loop{options.loop};
+    running_loop = &loop;
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    if (!options.trace_path.empty()) {
+        Zeus::Profiler::setThreadName("Main");
+        Zeus::Profiler::start();
+    }
+
+    if (!options.metrics_path.empty()) {
+        std::string_view const path = options.metrics_path;
+        bool const json =
+            path.size() >= 5 && path.substr(path.size() - 5) == ".json";
+
+        if (!Zeus::Metrics::startDumping(
+                options.metrics_path,
+                json ? Zeus::Metrics::Format::Json : Zeus::Metrics::Format::Csv,
+                1.0)) {
+            ZEUS_ERROR_LOG("Loop", "Could not open the metrics file");
+        }
+    }
+
+    Zeus::Metrics::Histogram update_time{"simulation.update_ns"};
+    Zeus::Metrics::Gauge dropped_messages{"log.dropped_messages"};
+    Vector3D interpolated;
+
+    loop.run(
+        [&jobs, &particles, &update_time](Zeus::f64 step) {
+            Zeus::Metrics::ScopedTimer const timer{update_time};
+            auto const dt = static_cast<float>(step);
+            Vector3D const gravity{0.0F, -9.81F * dt, 0.0F};
+
+            Zeus::Job::parallelFor(
+                jobs, particles, 0, [dt, gravity](Particle* first,
+                                                  Particle* last) {
+                    for (; first != last; ++first) {
+                        first->previous = first->position;
+                        first->velocity += gravity;
+                        first->position += first->velocity * dt;
+
+                        // Bounce off the ground
+                        if (first->position.y < 0.0F) {
+                            first->position.y = -first->position.y;
+                            first->velocity.y = -first->velocity.y;
+                        }
+                    }
+                });
+        },
+        [&particles, &interpolated, &dropped_messages](Zeus::f64 alpha) {
+            // Nothing is drawn yet, interpolate one particle like a renderer
+            // would interpolate every visible one
+            auto const t = static_cast<float>(alpha);
+            Particle const& particle = particles.front();
+
+            interpolated = particle.previous * (1.0F - t) +
+                           particle.position * t;
+
+            dropped_messages.set(
+                static_cast<Zeus::f64>(Zeus::Log::droppedCount()));
+        });
+
+    running_loop = nullptr;
+
+    ZEUS_INFO_LOG("Loop",
+                  ZEUS_FORMAT(128, "Ran {} frames and {} simulation steps",
+                              loop.frameCount(), loop.updateCount()));
+
+    if (!options.metrics_path.empty()) {
+        Zeus::Metrics::stopDumping();
+    }
+
+    if (!options.trace_path.empty()) {
+        Zeus::Profiler::stop();
+
+        if (!Zeus::Profiler::writeChromeTrace(options.trace_path)) {
+            ZEUS_ERROR_LOG("Loop", "Could not write the profiler trace");
+        }
+    }
 
     return EXIT_SUCCESS;
 }
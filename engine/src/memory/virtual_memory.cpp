@@ -0,0 +1,96 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/memory/virtual_memory.hpp"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Zeus {
+
+namespace Memory {
+
+namespace VirtualMemory {
+
+std::size_t pageSize() noexcept {
+    static std::size_t const size = [] {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        // Reservations are made at allocation granularity on Windows
+        return static_cast<std::size_t>(info.dwAllocationGranularity);
+#else
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+
+    return size;
+}
+
+void* reserve(std::size_t bytes) noexcept {
+#if defined(_WIN32)
+    return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* address = mmap(nullptr, bytes, PROT_NONE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    return (address == MAP_FAILED) ? nullptr : address;
+#endif
+}
+
+bool commit(void* address, std::size_t bytes) noexcept {
+#if defined(_WIN32)
+    return VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(address, bytes, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void decommit(void* address, std::size_t bytes) noexcept {
+#if defined(_WIN32)
+    VirtualFree(address, bytes, MEM_DECOMMIT);
+#else
+    madvise(address, bytes, MADV_DONTNEED);
+    mprotect(address, bytes, PROT_NONE);
+#endif
+}
+
+void release(void* address, [[maybe_unused]] std::size_t bytes) noexcept {
+#if defined(_WIN32)
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, bytes);
+#endif
+}
+
+}  // namespace VirtualMemory
+
+}  // namespace Memory
+
+}  // namespace Zeus
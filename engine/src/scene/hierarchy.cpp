@@ -0,0 +1,398 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "zeus/scene/hierarchy.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "zeus/core/compiler_macros.hpp"
+
+#if ZEUS_HAS_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Zeus {
+
+namespace Scene {
+
+namespace {
+
+/**
+ * Writes parent * local to out, one SIMD register per row.
+ */
+void compose(Math::Matrix3x4 const& parent, Math::Matrix3x4 const& local,
+             Math::Matrix3x4& out) noexcept {
+#if ZEUS_HAS_SSE
+    __m128 const local0 = _mm_load_ps(local.m[0]);
+    __m128 const local1 = _mm_load_ps(local.m[1]);
+    __m128 const local2 = _mm_load_ps(local.m[2]);
+
+    // The implicit last row (0, 0, 0, 1)
+    __m128 const local3 = _mm_set_ps(1.0F, 0.0F, 0.0F, 0.0F);
+
+    for (int row = 0; row < 3; ++row) {
+        __m128 const lhs = _mm_load_ps(parent.m[row]);
+
+        __m128 result =
+            _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, 0x00), local0);
+        result = _mm_add_ps(
+            result, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, 0x55), local1));
+        result = _mm_add_ps(
+            result, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, 0xAA), local2));
+        result = _mm_add_ps(
+            result, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, 0xFF), local3));
+
+        _mm_store_ps(out.m[row], result);
+    }
+#else
+    out = parent * local;
+#endif
+}
+
+}  // namespace
+
+Hierarchy::Hierarchy() : level_begins_{0} {}
+
+Node Hierarchy::create(Node parent) {
+    u32 const parent_index = parent ? indexOf(parent) : null_index;
+
+    u32 record;
+
+    if (!free_records_.empty()) {
+        record = free_records_.back();
+        free_records_.pop_back();
+    } else {
+        ZEUS_MODULE_ASSERT(SCENE, ALWAYS, records_.size() <= Node::max_index,
+                           "Too many nodes.");
+
+        record = static_cast<u32>(records_.size());
+        records_.push_back({null_index, 1});
+    }
+
+    auto const index = static_cast<u32>(nodes_.size());
+    Node const node{record, records_[record].generation};
+
+    records_[record].index = index;
+
+    nodes_.push_back(node);
+    parents_.push_back(parent_index);
+    positions_.emplace_back(0.0F, 0.0F, 0.0F);
+    rotations_.emplace_back(0.0F, 0.0F, 0.0F);
+    scales_.emplace_back(1.0F, 1.0F, 1.0F);
+    locals_.push_back(Math::Matrix3x4::identity());
+    worlds_.push_back(Math::Matrix3x4::identity());
+    dirty_.push_back(0);
+    updated_in_.push_back(0);
+
+    markDirty(index);
+    unsorted_ = true;
+
+    return node;
+}
+
+void Hierarchy::destroy(Node node) {
+    if (!isAlive(node)) {
+        return;
+    }
+
+    // Descendants have to come after their ancestors
+    if (unsorted_) {
+        sort();
+    }
+
+    u32 const root = indexOf(node);
+    auto const count = static_cast<u32>(nodes_.size());
+
+    // Compacts the arrays in place, which keeps them breadth first
+    std::vector<u32> new_index(count);
+    u32 kept = root;
+    std::size_t level = 0;
+
+    for (u32 index = 0; index < root; ++index) {
+        new_index[index] = index;
+    }
+
+    for (; level_begins_[level] <= root; ++level) {
+    }
+
+    for (u32 index = root; index < count; ++index) {
+        for (; level + 1 < level_begins_.size() &&
+               level_begins_[level] == index;
+             ++level) {
+            level_begins_[level] = kept;
+        }
+
+        u32 const parent = parents_[index];
+
+        if (index == root ||
+            (parent != null_index && new_index[parent] == null_index)) {
+            Record& record = records_[nodes_[index].index()];
+            record.index = null_index;
+
+            // Generation zero is reserved for null nodes
+            if (++record.generation > Node::max_generation) {
+                record.generation = 1;
+            }
+
+            free_records_.push_back(static_cast<u32>(nodes_[index].index()));
+            new_index[index] = null_index;
+
+            continue;
+        }
+
+        new_index[index] = kept;
+
+        nodes_[kept] = nodes_[index];
+        parents_[kept] = parent == null_index ? null_index : new_index[parent];
+        positions_[kept] = positions_[index];
+        rotations_[kept] = rotations_[index];
+        scales_[kept] = scales_[index];
+        locals_[kept] = locals_[index];
+        worlds_[kept] = worlds_[index];
+        dirty_[kept] = dirty_[index];
+        updated_in_[kept] = updated_in_[index];
+        records_[nodes_[kept].index()].index = kept;
+
+        ++kept;
+    }
+
+    nodes_.resize(kept);
+    parents_.resize(kept);
+    positions_.resize(kept);
+    rotations_.resize(kept);
+    scales_.resize(kept);
+    locals_.resize(kept);
+    worlds_.resize(kept);
+    dirty_.resize(kept);
+    updated_in_.resize(kept);
+
+    // Levels below the subtree can only have emptied from the bottom up
+    level_begins_.back() = kept;
+
+    while (level_begins_.size() > 1 &&
+           level_begins_[level_begins_.size() - 2] == kept) {
+        level_begins_.pop_back();
+    }
+
+    if (first_dirty_ >= root) {
+        auto const dirty = std::find(dirty_.begin() + root, dirty_.end(), 1);
+
+        first_dirty_ = dirty == dirty_.end()
+                           ? null_index
+                           : static_cast<u32>(dirty - dirty_.begin());
+    }
+}
+
+void Hierarchy::setParent(Node node, Node parent) {
+    u32 const index = indexOf(node);
+    u32 const parent_index = parent ? indexOf(parent) : null_index;
+
+    for (u32 ancestor = parent_index; ancestor != null_index;
+         ancestor = parents_[ancestor]) {
+        ZEUS_MODULE_ASSERT(SCENE, ALWAYS, ancestor != index,
+                           "A node cannot be moved below itself.");
+    }
+
+    parents_[index] = parent_index;
+    markDirty(index);
+    unsorted_ = true;
+}
+
+void Hierarchy::update() {
+    std::size_t level = beginUpdate();
+
+    for (; level + 1 < level_begins_.size(); ++level) {
+        updated_count_ +=
+            updateRange(level_begins_[level], level_begins_[level + 1]);
+    }
+
+    endUpdate();
+}
+
+void Hierarchy::sort() {
+    auto const count = static_cast<u32>(nodes_.size());
+
+    // The children of every node, in their current order
+    std::vector<u32> child_begins(count + 1, 0);
+    std::vector<u32> children(count);
+
+    for (u32 const parent : parents_) {
+        if (parent != null_index) {
+            ++child_begins[parent + 1];
+        }
+    }
+
+    for (u32 index = 0; index < count; ++index) {
+        child_begins[index + 1] += child_begins[index];
+    }
+
+    std::vector<u32> cursors(child_begins.begin(), child_begins.end() - 1);
+    std::vector<u32> order;
+    order.reserve(count);
+
+    for (u32 index = 0; index < count; ++index) {
+        if (parents_[index] == null_index) {
+            order.push_back(index);
+        } else {
+            children[cursors[parents_[index]]++] = index;
+        }
+    }
+
+    // Appends the children of one level to get the next one
+    level_begins_.clear();
+
+    for (std::size_t begin = 0; begin < order.size();) {
+        std::size_t const end = order.size();
+        level_begins_.push_back(static_cast<u32>(begin));
+
+        for (std::size_t position = begin; position < end; ++position) {
+            u32 const node = order[position];
+
+            order.insert(order.end(), children.begin() + child_begins[node],
+                         children.begin() + child_begins[node + 1]);
+        }
+
+        begin = end;
+    }
+
+    level_begins_.push_back(count);
+
+    ZEUS_MODULE_ASSERT(SCENE, ALWAYS, order.size() == count,
+                       "Every node has to be reachable from a root.");
+
+    std::vector<u32> new_index(count);
+
+    for (u32 index = 0; index < count; ++index) {
+        new_index[order[index]] = index;
+    }
+
+    auto const permute = [&order](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted;
+        sorted.reserve(values.size());
+
+        for (u32 const index : order) {
+            sorted.push_back(values[index]);
+        }
+
+        values.swap(sorted);
+    };
+
+    permute(nodes_);
+    permute(parents_);
+    permute(positions_);
+    permute(rotations_);
+    permute(scales_);
+    permute(locals_);
+    permute(worlds_);
+    permute(dirty_);
+    permute(updated_in_);
+
+    first_dirty_ = null_index;
+
+    for (u32 index = 0; index < count; ++index) {
+        if (parents_[index] != null_index) {
+            parents_[index] = new_index[parents_[index]];
+        }
+
+        records_[nodes_[index].index()].index = index;
+
+        if (dirty_[index] != 0 && first_dirty_ == null_index) {
+            first_dirty_ = index;
+        }
+    }
+
+    unsorted_ = false;
+}
+
+std::size_t Hierarchy::beginUpdate() {
+    if (unsorted_) {
+        sort();
+    }
+
+    updated_count_ = 0;
+
+    if (first_dirty_ == null_index) {
+        return levelCount();
+    }
+
+    ++epoch_;
+
+    // The last level that starts at or before the first dirty node
+    return static_cast<std::size_t>(
+        std::upper_bound(level_begins_.begin(), level_begins_.end(),
+                         first_dirty_) -
+        level_begins_.begin() - 1);
+}
+
+std::size_t Hierarchy::updateRange(std::size_t first,
+                                   std::size_t last) noexcept {
+    // Finding the changed nodes is kept apart from computing their matrices
+    // so the latter runs as a tight loop without unpredictable branches
+    constexpr std::size_t batch_size = 64;
+
+    u32 batch[batch_size];
+    std::size_t updated = 0;
+
+    while (first < last) {
+        std::size_t count = 0;
+
+        for (; first < last && count < batch_size; ++first) {
+            u32 const parent = parents_[first];
+
+            if (dirty_[first] != 0 ||
+                (parent != null_index && updated_in_[parent] == epoch_)) {
+                batch[count++] = static_cast<u32>(first);
+            }
+        }
+
+        // Nodes that only moved with their parent keep their local matrix
+        for (std::size_t node = 0; node < count; ++node) {
+            u32 const index = batch[node];
+
+            if (dirty_[index] != 0) {
+                locals_[index] = Math::fromTransform(
+                    positions_[index], rotations_[index], scales_[index]);
+                dirty_[index] = 0;
+            }
+        }
+
+        for (std::size_t node = 0; node < count; ++node) {
+            u32 const index = batch[node];
+            u32 const parent = parents_[index];
+
+            if (parent == null_index) {
+                worlds_[index] = locals_[index];
+            } else {
+                compose(worlds_[parent], locals_[index], worlds_[index]);
+            }
+
+            updated_in_[index] = epoch_;
+        }
+
+        updated += count;
+    }
+
+    return updated;
+}
+
+void Hierarchy::endUpdate() noexcept { first_dirty_ = null_index; }
+
+}  // namespace Scene
+
+}  // namespace Zeus
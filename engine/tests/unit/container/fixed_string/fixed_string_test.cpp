@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "zeus/container/fixed_string.hpp"
+
+/**
+ * Tests for fixed_string.hpp
+ */
+namespace {
+
+TEST(fixed_string_test, constexpr) {
+    constexpr Zeus::FixedString name{"Zeus"};
+
+    static_assert(name.capacity() == 4);
+    static_assert(name == std::string_view{"Zeus"});
+    static_assert(name.c_str()[4] == '\0');
+}
+
+TEST(fixed_string_test, append) {
+    Zeus::FixedString<16> string{"Hello"};
+
+    string += ", ";
+    string += "World";
+    string += '!';
+
+    EXPECT_EQ(string, "Hello, World!");
+    EXPECT_EQ(string.size(), 13U);
+}
+
+TEST(fixed_string_test, truncates) {
+    Zeus::FixedString<4> string{"abcdef"};
+
+    EXPECT_EQ(string, "abcd");
+    EXPECT_TRUE(string.full());
+
+    string += 'x';
+
+    EXPECT_EQ(string, "abcd");
+    EXPECT_EQ(string.c_str()[4], '\0');
+}
+
+TEST(fixed_string_test, resize_and_clear) {
+    Zeus::FixedString<8> string{"abcdef"};
+
+    string.resize(3);
+
+    EXPECT_EQ(string, "abc");
+
+    string.clear();
+
+    EXPECT_TRUE(string.empty());
+}
+
+TEST(fixed_string_test, resize_and_overwrite) {
+    Zeus::FixedString<8> string{"ab"};
+
+    string.resize_and_overwrite(16, [](char* data, std::size_t count) {
+        EXPECT_EQ(count, 8U);
+
+        data[2] = 'c';
+
+        return 3;
+    });
+
+    EXPECT_EQ(string, "abc");
+    EXPECT_EQ(string.c_str()[3], '\0');
+
+    string.resize_and_overwrite(2, [](char*, std::size_t) { return 5; });
+
+    EXPECT_EQ(string, "ab");
+}
+
+TEST(fixed_string_test, ostream) {
+    std::ostringstream stream;
+
+    stream << Zeus::FixedString<8>{"stream"};
+
+    EXPECT_EQ(stream.str(), "stream");
+}
+
+}  // namespace
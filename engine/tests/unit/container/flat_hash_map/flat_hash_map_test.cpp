@@ -0,0 +1,256 @@
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "zeus/container/flat_hash_map.hpp"
+#include "zeus/core/string_id.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Tests for flat_hash_map.hpp
+ */
+namespace {
+
+/**
+ * Counts the live bytes allocated through it.
+ */
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(std::size_t* bytes) noexcept : bytes_{bytes} {}
+
+    template <typename U>
+    CountingAllocator(CountingAllocator<U> const& other) noexcept
+        : bytes_{other.bytes_} {}
+
+    T* allocate(std::size_t count) {
+        *bytes_ += count * sizeof(T);
+
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        *bytes_ -= count * sizeof(T);
+        std::allocator<T>{}.deallocate(pointer, count);
+    }
+
+    template <typename U>
+    bool operator==(CountingAllocator<U> const& other) const noexcept {
+        return bytes_ == other.bytes_;
+    }
+
+    template <typename U>
+    bool operator!=(CountingAllocator<U> const& other) const noexcept {
+        return !(*this == other);
+    }
+
+    std::size_t* bytes_;
+};
+
+TEST(flat_hash_map_test, insert_find_erase) {
+    Zeus::FlatHashMap<int, int> map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+
+    EXPECT_TRUE(map.insert({1, 10}).second);
+    EXPECT_FALSE(map.insert({1, 20}).second);
+    EXPECT_TRUE(map.emplace(2, 20).second);
+
+    ASSERT_EQ(map.size(), 2U);
+    EXPECT_EQ(map.find(1)->second, 10);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.count(3), 0U);
+
+    EXPECT_EQ(map.erase(1), 1U);
+    EXPECT_EQ(map.erase(1), 0U);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(flat_hash_map_test, subscript_and_at) {
+    Zeus::FlatHashMap<std::string, int> map;
+
+    map["a"] = 1;
+    ++map["a"];
+    ++map["b"];
+
+    EXPECT_EQ(map.at("a"), 2);
+    EXPECT_EQ(map.at("b"), 1);
+    EXPECT_THROW((void)map.at("c"), std::out_of_range);
+}
+
+TEST(flat_hash_map_test, try_emplace_and_insert_or_assign) {
+    Zeus::FlatHashMap<int, std::unique_ptr<int>> map;
+
+    EXPECT_TRUE(map.try_emplace(1, std::make_unique<int>(1)).second);
+    EXPECT_FALSE(map.try_emplace(1, std::make_unique<int>(2)).second);
+    EXPECT_EQ(*map.at(1), 1);
+
+    EXPECT_FALSE(map.insert_or_assign(1, std::make_unique<int>(3)).second);
+    EXPECT_EQ(*map.at(1), 3);
+}
+
+TEST(flat_hash_map_test, heterogeneous_lookup) {
+    Zeus::FlatHashMap<std::string, int> map{{"alpha", 1}, {"beta", 2}};
+
+    std::string_view const key{"beta"};
+
+    EXPECT_EQ(map.find(key)->second, 2);
+    EXPECT_TRUE(map.contains("alpha"));
+    EXPECT_EQ(map.erase(std::string_view{"alpha"}), 1U);
+    EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(flat_hash_map_test, string_id_and_vector_keys) {
+    using namespace Zeus::Literals;
+
+    Zeus::FlatHashMap<Zeus::StringId, int> ids;
+    ids["player"_sid] = 1;
+
+    EXPECT_EQ(ids.at(Zeus::StringId{std::string{"player"}}), 1);
+
+    Zeus::FlatHashMap<Zeus::Math::Vector3D, int> cells;
+    cells[{1.0F, 2.0F, 3.0F}] = 7;
+
+    EXPECT_EQ(cells.at({1.0F, 2.0F, 3.0F}), 7);
+    EXPECT_FALSE(cells.contains({3.0F, 2.0F, 1.0F}));
+}
+
+TEST(flat_hash_map_test, matches_unordered_map) {
+    Zeus::FlatHashMap<int, int> map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> keys{0, 2000};
+
+    // Churn through inserts and erases so deleted slots get reused
+    for (int i = 0; i < 100000; ++i) {
+        int const key = keys(random);
+
+        if (random() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), reference.erase(key));
+        } else {
+            EXPECT_EQ(map.insert({key, i}).second,
+                      reference.insert({key, i}).second);
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+
+    for (auto const& [key, value] : reference) {
+        auto const position = map.find(key);
+
+        ASSERT_NE(position, map.end());
+        EXPECT_EQ(position->second, value);
+    }
+
+    std::size_t visited = 0;
+
+    for (auto const& [key, value] : map) {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(flat_hash_map_test, erase_while_iterating) {
+    Zeus::FlatHashMap<int, int> map;
+
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->first % 2 == 0) {
+            map.erase(it);
+        }
+    }
+
+    EXPECT_EQ(map.size(), 500U);
+
+    for (auto const& [key, value] : map) {
+        EXPECT_EQ(key % 2, 1);
+    }
+}
+
+TEST(flat_hash_map_test, reserve_and_rehash) {
+    Zeus::FlatHashMap<int, int> map;
+    map.reserve(1000);
+
+    std::size_t const capacity = map.capacity();
+    EXPECT_GE(capacity * 7 / 8, 1000U);
+
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+
+    for (int i = 10; i < 1000; ++i) {
+        map.erase(i);
+    }
+
+    map.rehash(0);
+
+    EXPECT_EQ(map.capacity(), 15U);
+    EXPECT_EQ(map.size(), 10U);
+    EXPECT_EQ(map.at(9), 9);
+
+    map.clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(flat_hash_map_test, copy_move_and_compare) {
+    Zeus::FlatHashMap<int, std::string> map{{1, "one"}, {2, "two"}};
+    Zeus::FlatHashMap<int, std::string> copy{map};
+
+    EXPECT_EQ(copy, map);
+
+    copy[3] = "three";
+
+    EXPECT_NE(copy, map);
+
+    Zeus::FlatHashMap<int, std::string> moved{std::move(copy)};
+
+    EXPECT_EQ(moved.size(), 3U);
+    EXPECT_TRUE(copy.empty());  // NOLINT(bugprone-use-after-move)
+
+    copy = moved;
+    moved = std::move(map);
+
+    EXPECT_EQ(copy.size(), 3U);
+    EXPECT_EQ(moved.at(2), "two");
+}
+
+TEST(flat_hash_map_test, custom_allocator) {
+    std::size_t bytes = 0;
+
+    {
+        using Allocator = CountingAllocator<std::pair<int, int>>;
+        Zeus::FlatHashMap<int, int, Zeus::Hash<int>, std::equal_to<>,
+                          Allocator>
+            map{0, Zeus::Hash<int>{}, std::equal_to<>{}, Allocator{&bytes}};
+
+        for (int i = 0; i < 100; ++i) {
+            map[i] = i;
+        }
+
+        EXPECT_GT(bytes, 100 * sizeof(std::pair<int, int>));
+    }
+
+    EXPECT_EQ(bytes, 0U);
+}
+
+}  // namespace
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "zeus/container/flat_hash_set.hpp"
+
+/**
+ * Tests for flat_hash_set.hpp
+ */
+namespace {
+
+TEST(flat_hash_set_test, insert_find_erase) {
+    Zeus::FlatHashSet<int> set{1, 2, 3};
+
+    EXPECT_EQ(set.size(), 3U);
+    EXPECT_FALSE(set.insert(2).second);
+    EXPECT_TRUE(set.emplace(4).second);
+    EXPECT_TRUE(set.contains(4));
+    EXPECT_EQ(set.erase(1), 1U);
+    EXPECT_FALSE(set.contains(1));
+    EXPECT_EQ(*set.find(3), 3);
+}
+
+TEST(flat_hash_set_test, heterogeneous_lookup) {
+    Zeus::FlatHashSet<std::string> set{"red", "green"};
+
+    EXPECT_TRUE(set.contains(std::string_view{"red"}));
+    EXPECT_TRUE(set.contains("green"));
+    EXPECT_FALSE(set.contains("blue"));
+}
+
+TEST(flat_hash_set_test, matches_unordered_set) {
+    Zeus::FlatHashSet<unsigned> set;
+    std::unordered_set<unsigned> reference;
+    std::mt19937 random{7};
+
+    for (int i = 0; i < 50000; ++i) {
+        unsigned const value = random() % 5000;
+
+        if (i % 4 == 0) {
+            EXPECT_EQ(set.erase(value), reference.erase(value));
+        } else {
+            EXPECT_EQ(set.insert(value).second,
+                      reference.insert(value).second);
+        }
+    }
+
+    ASSERT_EQ(set.size(), reference.size());
+
+    for (unsigned const value : set) {
+        EXPECT_EQ(reference.count(value), 1U);
+    }
+}
+
+TEST(flat_hash_set_test, swap) {
+    Zeus::FlatHashSet<int> lhs{1};
+    Zeus::FlatHashSet<int> rhs{2, 3};
+
+    swap(lhs, rhs);
+
+    EXPECT_EQ(lhs.size(), 2U);
+    EXPECT_TRUE(rhs.contains(1));
+}
+
+}  // namespace
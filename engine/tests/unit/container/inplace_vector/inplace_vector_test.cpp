@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+#include "zeus/container/inplace_vector.hpp"
+
+/**
+ * Tests for inplace_vector.hpp
+ */
+namespace {
+
+constexpr Zeus::InplaceVector<int, 4> makeSquares() {
+    Zeus::InplaceVector<int, 4> squares;
+
+    for (int i = 1; i <= 4; ++i) {
+        squares.push_back(i * i);
+    }
+
+    return squares;
+}
+
+TEST(inplace_vector_test, constexpr) {
+    constexpr auto squares = makeSquares();
+
+    static_assert(squares.size() == 4);
+    static_assert(squares[3] == 16);
+    static_assert(squares.full());
+}
+
+TEST(inplace_vector_test, non_trivial_elements) {
+    Zeus::InplaceVector<std::string, 4> strings{"a", "b"};
+
+    strings.emplace_back(3, 'c');
+
+    Zeus::InplaceVector<std::string, 4> copy{strings};
+    Zeus::InplaceVector<std::string, 4> moved{std::move(strings)};
+
+    EXPECT_EQ(copy, moved);
+    EXPECT_EQ(moved[2], "ccc");
+}
+
+TEST(inplace_vector_test, try_emplace_back) {
+    Zeus::InplaceVector<int, 2> vector;
+
+    EXPECT_NE(vector.tryEmplaceBack(1), nullptr);
+    EXPECT_NE(vector.tryEmplaceBack(2), nullptr);
+    EXPECT_EQ(vector.tryEmplaceBack(3), nullptr);
+    EXPECT_EQ(vector.size(), 2U);
+}
+
+TEST(inplace_vector_test, destructs_elements) {
+    auto counter = std::make_shared<int>(0);
+
+    {
+        Zeus::InplaceVector<std::shared_ptr<int>, 4> vector;
+
+        vector.push_back(counter);
+        vector.push_back(counter);
+        vector.push_back(counter);
+
+        vector.erase(vector.begin());
+
+        EXPECT_EQ(counter.use_count(), 3);
+
+        vector.pop_back();
+
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+}  // namespace
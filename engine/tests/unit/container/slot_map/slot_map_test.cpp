@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <numeric>
+#include <string>
+
+#include "zeus/container/slot_map.hpp"
+
+/**
+ * Tests for slot_map.hpp
+ */
+namespace {
+
+TEST(slot_map_test, insert_and_get) {
+    Zeus::SlotMap<std::string> map;
+
+    auto const first = map.insert("first");
+    auto const second = map.emplace(3, 'x');
+
+    ASSERT_EQ(map.size(), 2U);
+    EXPECT_EQ(map[first], "first");
+    EXPECT_EQ(map[second], "xxx");
+    EXPECT_NE(first, second);
+}
+
+TEST(slot_map_test, stale_handle_is_rejected) {
+    Zeus::SlotMap<int> map;
+
+    auto const handle = map.insert(1);
+
+    EXPECT_TRUE(map.erase(handle));
+    EXPECT_FALSE(map.contains(handle));
+    EXPECT_EQ(map.get(handle), nullptr);
+    EXPECT_FALSE(map.erase(handle));
+
+    // The slot is reused with a new generation
+    auto const reused = map.insert(2);
+
+    EXPECT_EQ(reused.index(), handle.index());
+    EXPECT_NE(reused.generation(), handle.generation());
+    EXPECT_EQ(map.get(handle), nullptr);
+    EXPECT_EQ(*map.get(reused), 2);
+}
+
+TEST(slot_map_test, null_handle_is_rejected) {
+    Zeus::SlotMap<int> map;
+
+    map.insert(1);
+
+    EXPECT_FALSE(map.contains(Zeus::SlotMap<int>::handle_type{}));
+}
+
+TEST(slot_map_test, erase_keeps_values_dense) {
+    Zeus::SlotMap<int> map;
+
+    std::vector<Zeus::SlotMap<int>::handle_type> handles;
+
+    for (int i = 0; i < 10; ++i) {
+        handles.push_back(map.insert(i));
+    }
+
+    for (int i = 0; i < 10; i += 2) {
+        map.erase(handles[i]);
+    }
+
+    ASSERT_EQ(map.size(), 5U);
+    EXPECT_EQ(std::accumulate(map.begin(), map.end(), 0), 1 + 3 + 5 + 7 + 9);
+
+    for (int i = 1; i < 10; i += 2) {
+        EXPECT_EQ(map[handles[i]], i);
+    }
+
+    for (std::size_t i = 0; i < map.size(); ++i) {
+        EXPECT_EQ(map[map.handleAt(i)], map.data()[i]);
+    }
+}
+
+TEST(slot_map_test, generation_exhaustion_retires_slot) {
+    using Map = Zeus::SlotMap<int>;
+
+    Map map;
+
+    auto handle = map.insert(0);
+    auto const first_index = handle.index();
+
+    while (handle.generation() < Map::handle_type::max_generation) {
+        map.erase(handle);
+        handle = map.insert(0);
+
+        ASSERT_EQ(handle.index(), first_index);
+    }
+
+    map.erase(handle);
+
+    EXPECT_NE(map.insert(0).index(), first_index);
+}
+
+TEST(slot_map_test, clear) {
+    Zeus::SlotMap<std::unique_ptr<int>> map;
+
+    auto const handle = map.insert(std::make_unique<int>(5));
+
+    map.clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(handle));
+}
+
+}  // namespace
@@ -0,0 +1,207 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "zeus/container/fixed_string.hpp"
+#include "zeus/container/inplace_vector.hpp"
+#include "zeus/container/small_vector.hpp"
+
+/**
+ * Tests for small_vector.hpp
+ */
+namespace {
+
+std::atomic<std::size_t> allocation_count{0};
+
+/**
+ * Counts the heap allocations made by the calling scope.
+ */
+class AllocationCounter {
+   public:
+    AllocationCounter() noexcept
+        : start_{allocation_count.load(std::memory_order_relaxed)} {}
+
+    [[nodiscard]] std::size_t count() const noexcept {
+        return allocation_count.load(std::memory_order_relaxed) - start_;
+    }
+
+   private:
+    std::size_t start_;
+};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+TEST(small_vector_test, stays_inline) {
+    AllocationCounter const counter;
+
+    Zeus::SmallVector<int, 8> vector;
+
+    for (int i = 0; i < 8; ++i) {
+        vector.push_back(i);
+    }
+
+    Zeus::SmallVector<int, 8> copy{vector};
+    Zeus::SmallVector<int, 8> moved{std::move(copy)};
+
+    EXPECT_TRUE(vector.isInline());
+    EXPECT_TRUE(moved.isInline());
+    EXPECT_EQ(moved[7], 7);
+    EXPECT_EQ(counter.count(), 0U);
+}
+
+TEST(small_vector_test, spills_to_heap) {
+    Zeus::SmallVector<std::string, 2> vector{"a", "b"};
+
+    EXPECT_TRUE(vector.isInline());
+
+    vector.emplace_back("c");
+
+    EXPECT_FALSE(vector.isInline());
+    EXPECT_GE(vector.capacity(), 3U);
+    EXPECT_EQ(vector[0], "a");
+    EXPECT_EQ(vector[2], "c");
+}
+
+TEST(small_vector_test, move_steals_heap_buffer) {
+    Zeus::SmallVector<int, 2> vector{1, 2, 3, 4};
+
+    int const* data = vector.data();
+
+    AllocationCounter const counter;
+    Zeus::SmallVector<int, 2> moved{std::move(vector)};
+
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(vector.isInline());
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(counter.count(), 0U);
+}
+
+TEST(small_vector_test, emplace_self_reference) {
+    Zeus::SmallVector<std::string, 1> vector{"self"};
+
+    vector.push_back(vector[0]);
+
+    EXPECT_EQ(vector[1], "self");
+}
+
+TEST(small_vector_test, erase_and_resize) {
+    Zeus::SmallVector<std::unique_ptr<int>, 4> vector;
+
+    for (int i = 0; i < 4; ++i) {
+        vector.push_back(std::make_unique<int>(i));
+    }
+
+    vector.erase(vector.begin() + 1);
+
+    ASSERT_EQ(vector.size(), 3U);
+    EXPECT_EQ(*vector[1], 2);
+
+    vector.resize(5);
+
+    EXPECT_EQ(vector[4], nullptr);
+
+    vector.resize(1);
+
+    EXPECT_EQ(*vector.back(), 0);
+}
+
+/**
+ * Throws from its copy constructor once copies_left runs out.
+ */
+struct ThrowingCopy {
+    static inline int copies_left = 0;
+
+    explicit ThrowingCopy(int number) : value{number} {}
+
+    ThrowingCopy(ThrowingCopy const& other) : value{other.value} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error{"copy failed"};
+        }
+    }
+
+    // Not noexcept, so growing has to copy
+    ThrowingCopy(ThrowingCopy&& other) : value{other.value} {
+        other.value = -1;
+    }
+
+    ThrowingCopy& operator=(ThrowingCopy const&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) = default;
+    ~ThrowingCopy() = default;
+
+    int value;
+};
+
+TEST(small_vector_test, growing_keeps_elements_on_throw) {
+    Zeus::SmallVector<ThrowingCopy, 2> vector;
+
+    vector.emplace_back(0);
+    vector.emplace_back(1);
+
+    // The second copy into the new buffer throws
+    ThrowingCopy::copies_left = 1;
+
+    EXPECT_THROW(vector.emplace_back(2), std::runtime_error);
+
+    ASSERT_EQ(vector.size(), 2U);
+    EXPECT_TRUE(vector.isInline());
+    EXPECT_EQ(vector[0].value, 0);
+    EXPECT_EQ(vector[1].value, 1);
+
+    ThrowingCopy::copies_left = 0;
+
+    EXPECT_THROW(vector.reserve(8), std::runtime_error);
+
+    EXPECT_EQ(vector.capacity(), 2U);
+    EXPECT_EQ(vector[0].value, 0);
+    EXPECT_EQ(vector[1].value, 1);
+
+    ThrowingCopy::copies_left = 2;
+    vector.emplace_back(2);
+
+    ASSERT_EQ(vector.size(), 3U);
+    EXPECT_EQ(vector[0].value, 0);
+    EXPECT_EQ(vector[2].value, 2);
+}
+
+TEST(small_vector_test, common_cases_do_not_allocate) {
+    AllocationCounter const counter;
+
+    Zeus::InplaceVector<std::pair<int, float>, 16> results;
+    results.emplace_back(1, 2.0F);
+
+    Zeus::FixedString<64> name{"Renderer"};
+    name += "::Vulkan";
+
+    Zeus::SmallVector<Zeus::FixedString<32>, 4> names;
+    names.emplace_back(name.view());
+
+    EXPECT_EQ(names[0], "Renderer::Vulkan");
+    EXPECT_EQ(counter.count(), 0U);
+}
+
+}  // namespace
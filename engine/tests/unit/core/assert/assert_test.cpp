@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include "zeus/core/assert.hpp"
+
+/**
+ * Tests for assert.hpp
+ */
+namespace {
+
+constexpr int checkedHalf(int value) {
+    ZEUS_ASSERT(value % 2 == 0, "Value must be even.");
+
+    return value / 2;
+}
+
+TEST(assert_test, passing_assertions_continue) {
+    int evaluations = 0;
+
+    ZEUS_ASSERT_ALWAYS(++evaluations == 1);
+    ZEUS_ASSERT(++evaluations == 2, "Debug assertion.");
+    ZEUS_ASSERT_PARANOID(++evaluations == 3);
+    ZEUS_MODULE_ASSERT(CONTAINER, DEBUG, ++evaluations == 4);
+
+    EXPECT_EQ(evaluations, 4);
+}
+
+TEST(assert_test, disabled_module_does_not_evaluate) {
+    int evaluations = 0;
+
+    ZEUS_MODULE_ASSERT(MATH, ALWAYS, ++evaluations == 1);
+    ZEUS_MODULE_ASSERT(MATH, DEBUG, ++evaluations < 0);
+    ZEUS_MODULE_ASSERT(MATH, PARANOID, ++evaluations < 0);
+
+    EXPECT_EQ(evaluations, 1);
+}
+
+TEST(assert_test, usable_in_constexpr) {
+    static_assert(checkedHalf(4) == 2);
+
+    EXPECT_EQ(checkedHalf(8), 4);
+}
+
+TEST(assert_death_test, failing_assertion_terminates) {
+    EXPECT_DEATH(ZEUS_ASSERT_ALWAYS(1 + 1 == 3),
+                 "Assertion \\(1 \\+ 1 == 3\\) failed!");
+    EXPECT_DEATH(checkedHalf(3), "Message: Value must be even\\.");
+    EXPECT_DEATH(ZEUS_ASSERT_PARANOID(false, "Paranoid."), "Paranoid\\.");
+    EXPECT_DEATH(ZEUS_MODULE_ASSERT(MEMORY, DEBUG, false), "assert_test");
+}
+
+TEST(assert_death_test, assert_condition_terminates) {
+    EXPECT_DEATH(Zeus::assert_condition(false, "condition", "Legacy.",
+                                        "file.cpp", 42),
+                 "Line: 42\nMessage: Legacy\\.");
+}
+
+}  // namespace
@@ -0,0 +1,250 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "zeus/core/binary_log.hpp"
+#include "zeus/core/binary_log_decoder.hpp"
+#include "zeus/math/vector_2d.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Tests for binary_log.hpp and binary_log_decoder.hpp
+ */
+namespace {
+
+/**
+ * Writes the binary log to a temporary file for the lifetime of the object.
+ */
+class CapturedBinaryLog {
+   public:
+    CapturedBinaryLog() {
+        std::array<char, 32> name{"/tmp/zeus_binary_log_XXXXXX"};
+
+        int const file_descriptor = mkstemp(name.data());
+        close(file_descriptor);
+        path_ = name.data();
+
+        Zeus::BinaryLog::open(path_);
+    }
+
+    CapturedBinaryLog(CapturedBinaryLog const&) = delete;
+    CapturedBinaryLog& operator=(CapturedBinaryLog const&) = delete;
+
+    ~CapturedBinaryLog() {
+        Zeus::BinaryLog::close();
+
+        std::remove(path_.c_str());
+    }
+
+    [[nodiscard]] std::string bytes() const {
+        std::ifstream file{path_, std::ios::binary};
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        return stream.str();
+    }
+
+    [[nodiscard]] std::string decoded() const {
+        Zeus::BinaryLog::flush();
+
+        std::istringstream input{bytes()};
+        std::ostringstream output;
+
+        EXPECT_TRUE(Zeus::BinaryLog::decode(input, output));
+
+        return output.str();
+    }
+
+   private:
+    std::string path_;
+};
+
+std::vector<std::string> lines(std::string const& text) {
+    std::vector<std::string> result;
+    std::istringstream stream{text};
+
+    for (std::string line; std::getline(stream, line);) {
+        result.push_back(line);
+    }
+
+    return result;
+}
+
+/**
+ * Removes the timestamp of a decoded line.
+ */
+std::string withoutTimestamp(std::string const& line) {
+    return line.substr(line.find("] ") + 2);
+}
+
+enum class Mode : Zeus::u8 { Forward = 3 };
+
+TEST(binary_log_test, decode_arguments) {
+    CapturedBinaryLog const log;
+
+    std::string const name = "player";
+    std::string_view const view = "checkpoint";
+
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "Started");
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Warning, "Physics",
+                    "Entity {} of {} at {} moving {}", -42, 7U,
+                    Zeus::Math::Vector3D{1.0F, 2.5F, -3.0F},
+                    Zeus::Math::Vector2D{0.5F, 4.0F});
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Debug, "Game", "{} reached {} ({})",
+                    name, view, "literal");
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Error, "Game", "{} {} {} {} {}", true,
+                    'x', 0.25, 1.5F, Mode::Forward);
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), 4U);
+    EXPECT_EQ(withoutTimestamp(result[0]), "[INFO] [Game] Started");
+    EXPECT_EQ(withoutTimestamp(result[1]),
+              "[WARNING] [Physics] Entity -42 of 7 at (1, 2.5, -3) moving "
+              "(0.5, 4)");
+    EXPECT_EQ(withoutTimestamp(result[2]),
+              "[DEBUG] [Game] player reached checkpoint (literal)");
+    EXPECT_EQ(withoutTimestamp(result[3]), "[ERROR] [Game] true x 0.25 1.5 3");
+}
+
+TEST(binary_log_test, call_site_registered_once) {
+    CapturedBinaryLog const log;
+
+    for (int i = 0; i < 3; ++i) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "Frame {}", i);
+    }
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), 3U);
+    EXPECT_EQ(withoutTimestamp(result[2]), "[INFO] [Game] Frame 2");
+
+    // The format string is stored once no matter how often the site logs
+    std::string const bytes = log.bytes();
+    EXPECT_EQ(bytes.find("Frame {}"), bytes.rfind("Frame {}"));
+}
+
+TEST(binary_log_test, timestamps_increase) {
+    CapturedBinaryLog const log;
+
+    for (int i = 0; i < 100; ++i) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "Tick {}", i);
+    }
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), 100U);
+
+    for (std::size_t i = 1; i < result.size(); ++i) {
+        EXPECT_LE(std::stod(result[i - 1].substr(1)),
+                  std::stod(result[i].substr(1)));
+    }
+}
+
+TEST(binary_log_test, buffer_fills_up) {
+    CapturedBinaryLog const log;
+
+    std::string const payload(200, 'a');
+    std::size_t const count = 2 * Zeus::BinaryLog::buffer_size / 200;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "{} {}", i, payload);
+    }
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), count);
+    EXPECT_EQ(withoutTimestamp(result.back()),
+              "[INFO] [Game] " + std::to_string(count - 1) + " " + payload);
+}
+
+TEST(binary_log_test, long_strings_truncated) {
+    CapturedBinaryLog const log;
+
+    std::string const payload(2 * Zeus::BinaryLog::max_string_size, 'b');
+
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "{}", payload);
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), 1U);
+    EXPECT_EQ(withoutTimestamp(result[0]),
+              "[INFO] [Game] " +
+                  std::string(Zeus::BinaryLog::max_string_size, 'b'));
+}
+
+TEST(binary_log_test, threads_flushed_on_exit) {
+    CapturedBinaryLog const log;
+
+    constexpr int thread_count = 4;
+    constexpr int messages_per_thread = 1000;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < messages_per_thread; ++i) {
+                ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Worker",
+                                "Thread {} message {}", t, i);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const result = lines(log.decoded());
+
+    EXPECT_EQ(result.size(),
+              static_cast<std::size_t>(thread_count * messages_per_thread));
+}
+
+TEST(binary_log_test, runtime_levels) {
+    CapturedBinaryLog const log;
+
+    int evaluated = 0;
+    auto value = [&evaluated] { return ++evaluated; };
+
+    Zeus::Log::setLevel("Muted", Zeus::Log::Level::Error);
+
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Muted", "Value {}", value());
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Error, "Muted", "Value {}", value());
+
+    Zeus::Log::resetLevel("Muted");
+
+    auto const result = lines(log.decoded());
+
+    EXPECT_EQ(evaluated, 1);
+    ASSERT_EQ(result.size(), 1U);
+    EXPECT_EQ(withoutTimestamp(result[0]), "[ERROR] [Muted] Value 1");
+}
+
+TEST(binary_log_test, truncated_stream) {
+    CapturedBinaryLog const log;
+
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "Value {}", 1);
+    ZEUS_BINARY_LOG(Zeus::Log::Level::Info, "Game", "Value {}", 2);
+    Zeus::BinaryLog::flush();
+
+    std::string const bytes = log.bytes();
+    std::istringstream input{bytes.substr(0, bytes.size() - 3)};
+    std::ostringstream output;
+
+    EXPECT_FALSE(Zeus::BinaryLog::decode(input, output));
+
+    std::istringstream garbage{"not a binary log"};
+
+    EXPECT_FALSE(Zeus::BinaryLog::decode(garbage, output));
+}
+
+}  // namespace
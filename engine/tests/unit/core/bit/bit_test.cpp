@@ -0,0 +1,39 @@
+#include "gtest/gtest.h"
+
+#include "zeus/core/bit.hpp"
+
+/**
+ * Tests for bit.hpp
+ */
+namespace {
+
+TEST(bit_test, count_trailing_zeros) {
+    EXPECT_EQ(Zeus::countTrailingZeros(Zeus::u32{1}), 0);
+    EXPECT_EQ(Zeus::countTrailingZeros(Zeus::u32{0x80000000}), 31);
+    EXPECT_EQ(Zeus::countTrailingZeros(Zeus::u32{0}), 32);
+    EXPECT_EQ(Zeus::countTrailingZeros(Zeus::u64{1} << 40), 40);
+    EXPECT_EQ(Zeus::countTrailingZeros(Zeus::u64{0}), 64);
+}
+
+TEST(bit_test, count_leading_zeros) {
+    EXPECT_EQ(Zeus::countLeadingZeros(Zeus::u32{1}), 31);
+    EXPECT_EQ(Zeus::countLeadingZeros(Zeus::u32{0}), 32);
+    EXPECT_EQ(Zeus::countLeadingZeros(Zeus::u64{1} << 40), 23);
+    EXPECT_EQ(Zeus::countLeadingZeros(~Zeus::u64{0}), 0);
+}
+
+TEST(bit_test, bit_width) {
+    EXPECT_EQ(Zeus::bitWidth(Zeus::u32{0}), 0);
+    EXPECT_EQ(Zeus::bitWidth(Zeus::u32{1}), 1);
+    EXPECT_EQ(Zeus::bitWidth(Zeus::u64{255}), 8);
+    EXPECT_EQ(Zeus::bitWidth(Zeus::u64{256}), 9);
+}
+
+TEST(bit_test, is_power_of_two) {
+    static_assert(Zeus::isPowerOfTwo(1U));
+    static_assert(Zeus::isPowerOfTwo(std::size_t{4096}));
+    static_assert(!Zeus::isPowerOfTwo(0U));
+    static_assert(!Zeus::isPowerOfTwo(12U));
+}
+
+}  // namespace
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/blocking_queue.hpp"
+#include "zeus/core/mpmc_queue.hpp"
+#include "zeus/core/spsc_queue.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for blocking_queue.hpp
+ */
+namespace {
+
+TEST(blocking_queue_test, try_operations) {
+    Zeus::BlockingQueue<Zeus::SpscQueue<int>> queue{2};
+
+    EXPECT_EQ(queue.capacity(), 2U);
+    EXPECT_FALSE(queue.tryPop().has_value());
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+    EXPECT_EQ(queue.size(), 2U);
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.tryPop(), 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(blocking_queue_test, pop_waits_for_push) {
+    Zeus::BlockingQueue<Zeus::SpscQueue<std::unique_ptr<int>>> queue{4};
+
+    std::thread consumer{[&queue] { EXPECT_EQ(*queue.pop(), 42); }};
+
+    // Give the consumer a chance to block first
+    std::this_thread::yield();
+    queue.push(std::make_unique<int>(42));
+    consumer.join();
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(blocking_queue_test, push_waits_for_pop) {
+    Zeus::BlockingQueue<Zeus::MpmcQueue<int>> queue{2};
+
+    queue.push(1);
+    queue.push(2);
+
+    std::thread producer{[&queue] { queue.push(3); }};
+
+    std::this_thread::yield();
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+}
+
+TEST(blocking_queue_test, spsc_stress) {
+    constexpr Zeus::u64 count = 100'000;
+
+    // A tiny queue makes both sides block often
+    Zeus::BlockingQueue<Zeus::SpscQueue<Zeus::u64>> queue{4};
+
+    std::thread producer{[&queue] {
+        for (Zeus::u64 value = 0; value < count; ++value) {
+            queue.push(value);
+        }
+    }};
+
+    for (Zeus::u64 expected = 0; expected < count; ++expected) {
+        ASSERT_EQ(queue.pop(), expected);
+    }
+
+    producer.join();
+}
+
+TEST(blocking_queue_test, mpmc_stress) {
+    constexpr int thread_count = 4;
+    constexpr Zeus::u64 per_producer = 20'000;
+    Zeus::BlockingQueue<Zeus::MpmcQueue<Zeus::u64>> queue{8};
+
+    std::atomic<Zeus::u64> sum{0};
+    std::vector<std::thread> threads;
+
+    for (int producer = 0; producer < thread_count; ++producer) {
+        threads.emplace_back([&queue] {
+            for (Zeus::u64 value = 1; value <= per_producer; ++value) {
+                queue.push(value);
+            }
+        });
+    }
+
+    // Each consumer pops exactly as many values as one producer pushes, so
+    // every pop is eventually matched and nobody blocks forever
+    for (int consumer = 0; consumer < thread_count; ++consumer) {
+        threads.emplace_back([&queue, &sum] {
+            Zeus::u64 local_sum = 0;
+
+            for (Zeus::u64 index = 0; index < per_producer; ++index) {
+                local_sum += queue.pop();
+            }
+
+            sum.fetch_add(local_sum);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(sum.load(),
+              thread_count * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "zeus/core/clock.hpp"
+
+/**
+ * Tests for clock.hpp
+ */
+namespace {
+
+using Zeus::TscClock;
+
+TEST(clock_test, never_goes_backwards) {
+    TscClock::time_point previous = TscClock::now();
+
+    for (int i = 0; i < 1000; ++i) {
+        TscClock::time_point const current = TscClock::now();
+
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+}
+
+TEST(clock_test, agrees_with_steady_clock) {
+    auto const tsc_start = TscClock::now();
+    auto const steady_start = std::chrono::steady_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+    auto const tsc_elapsed = TscClock::now() - tsc_start;
+    auto const steady_elapsed = std::chrono::steady_clock::now() - steady_start;
+
+    // Generous bounds, the two reads of each clock are not simultaneous
+    EXPECT_NEAR(Zeus::toSeconds(tsc_elapsed), Zeus::toSeconds(steady_elapsed),
+                0.005);
+}
+
+TEST(clock_test, to_seconds) {
+    EXPECT_DOUBLE_EQ(Zeus::toSeconds(std::chrono::milliseconds{1500}), 1.5);
+    EXPECT_DOUBLE_EQ(Zeus::toSeconds(TscClock::duration{250}), 250e-9);
+}
+
+}  // namespace
@@ -0,0 +1,228 @@
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "zeus/core/event_bus.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * Tests for event_bus.hpp
+ */
+namespace {
+
+using Zeus::EventBus;
+
+struct Collision {
+    int first;
+    int second;
+};
+
+struct Damage {
+    int target;
+    float amount;
+};
+
+TEST(event_bus_test, dispatch_in_batches) {
+    EventBus bus;
+    std::vector<int> calls;
+    std::vector<int> seconds;
+
+    bus.subscribe<Collision>(
+        [&](Collision const* events, std::size_t count) {
+            calls.push_back(static_cast<int>(count));
+
+            for (std::size_t i = 0; i < count; ++i) {
+                seconds.push_back(events[i].second);
+            }
+        });
+
+    bus.publish(Collision{1, 10});
+    bus.publish(Collision{2, 20});
+    bus.publish(Collision{3, 30});
+
+    EXPECT_EQ(bus.pending<Collision>(), 3U);
+    EXPECT_TRUE(calls.empty());
+
+    bus.dispatch();
+
+    EXPECT_EQ(calls, std::vector<int>{3});
+    EXPECT_EQ(seconds, (std::vector<int>{10, 20, 30}));
+    EXPECT_EQ(bus.pending<Collision>(), 0U);
+
+    // Nothing published, nothing dispatched
+    bus.dispatch();
+
+    EXPECT_EQ(calls.size(), 1U);
+}
+
+TEST(event_bus_test, types_and_subscribers) {
+    EventBus bus;
+    std::vector<char> order;
+    float damage = 0.0F;
+
+    bus.subscribe<Damage>([&](Damage const* events, std::size_t count) {
+        order.push_back('d');
+
+        for (std::size_t i = 0; i < count; ++i) {
+            damage += events[i].amount;
+        }
+    });
+    bus.subscribe<Collision>(
+        [&](Collision const*, std::size_t) { order.push_back('a'); });
+    bus.subscribe<Collision>(
+        [&](Collision const*, std::size_t) { order.push_back('b'); });
+
+    EXPECT_EQ(bus.typeCount(), 2U);
+
+    Damage const hits[] = {{1, 1.5F}, {2, 2.5F}, {1, 4.0F}};
+    bus.publish(hits, 3);
+    bus.publish(Collision{1, 2});
+    bus.dispatch();
+
+    EXPECT_EQ(order, (std::vector<char>{'d', 'a', 'b'}));
+    EXPECT_FLOAT_EQ(damage, 8.0F);
+}
+
+TEST(event_bus_test, events_without_subscribers) {
+    EventBus bus;
+
+    bus.publish(Collision{1, 2});
+
+    EXPECT_EQ(bus.pending<Collision>(), 0U);
+    EXPECT_EQ(bus.typeCount(), 0U);
+
+    bus.dispatch();
+}
+
+TEST(event_bus_test, publish_during_dispatch) {
+    EventBus bus;
+    int collisions = 0;
+    int damages = 0;
+
+    bus.subscribe<Collision>(
+        [&](Collision const* events, std::size_t count) {
+            collisions += static_cast<int>(count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                bus.publish(Damage{events[i].first, 1.0F});
+                bus.publish(Collision{events[i].second, events[i].first});
+            }
+        });
+    bus.subscribe<Damage>([&](Damage const*, std::size_t count) {
+        damages += static_cast<int>(count);
+    });
+
+    bus.publish(Collision{1, 2});
+    bus.dispatch();
+
+    // The damage type comes later in this dispatch, the collision does not
+    EXPECT_EQ(collisions, 1);
+    EXPECT_EQ(damages, 1);
+    EXPECT_EQ(bus.pending<Collision>(), 1U);
+
+    bus.dispatch();
+
+    EXPECT_EQ(collisions, 2);
+    EXPECT_EQ(damages, 2);
+}
+
+TEST(event_bus_test, clear) {
+    EventBus bus;
+    int calls = 0;
+
+    bus.subscribe<Collision>(
+        [&](Collision const*, std::size_t) { ++calls; });
+
+    bus.publish(Collision{1, 2});
+    bus.clear();
+    bus.dispatch();
+
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(event_bus_test, buses_keep_their_own_events) {
+    int first_calls = 0;
+
+    {
+        EventBus first;
+        first.subscribe<Damage>(
+            [&first_calls](Damage const*, std::size_t) { ++first_calls; });
+        first.publish(Damage{1, 1.0F});
+        first.dispatch();
+    }
+
+    // A new bus may get the address of the destroyed one
+    for (int round = 0; round < 3; ++round) {
+        EventBus bus;
+        EventBus other;
+        std::size_t received = 0;
+
+        bus.subscribe<Damage>([&received](Damage const*, std::size_t count) {
+            received += count;
+        });
+        other.subscribe<Damage>([](Damage const*, std::size_t) {});
+
+        bus.publish(Damage{2, 1.0F});
+        other.publish(Damage{3, 1.0F});
+        bus.publish(Damage{4, 1.0F});
+
+        EXPECT_EQ(bus.pending<Damage>(), 2U);
+        EXPECT_EQ(other.pending<Damage>(), 1U);
+
+        bus.dispatch();
+
+        EXPECT_EQ(received, 2U);
+    }
+
+    EXPECT_EQ(first_calls, 1);
+}
+
+TEST(event_bus_test, type_indices_are_unique) {
+    struct Local {
+        int value;
+    };
+
+    std::size_t const collision = Zeus::Detail::eventTypeIndex<Collision>();
+
+    EXPECT_EQ(Zeus::Detail::eventTypeIndex<Collision>(), collision);
+    EXPECT_NE(Zeus::Detail::eventTypeIndex<Damage>(), collision);
+    EXPECT_NE(Zeus::Detail::eventTypeIndex<Local>(),
+              Zeus::Detail::eventTypeIndex<Damage>());
+    EXPECT_NE(Zeus::Detail::eventTypeIndex<Local>(), collision);
+}
+
+TEST(event_bus_test, parallel_publish) {
+    constexpr int event_count = 20000;
+
+    Zeus::Job::System system{4, Zeus::Job::Affinity::Unpinned};
+    EventBus bus;
+    std::vector<int> seen(event_count, 0);
+
+    bus.subscribe<Collision>(
+        [&](Collision const* events, std::size_t count) {
+            ASSERT_EQ(count, static_cast<std::size_t>(event_count));
+
+            for (std::size_t i = 0; i < count; ++i) {
+                ++seen[static_cast<std::size_t>(events[i].first)];
+            }
+        });
+
+    for (int frame = 0; frame < 3; ++frame) {
+        Zeus::Job::parallelFor(system, 0, event_count, 100,
+                               [&bus](std::size_t first, std::size_t last) {
+                                   for (; first != last; ++first) {
+                                       bus.publish(Collision{
+                                           static_cast<int>(first), 0});
+                                   }
+                               });
+
+        bus.dispatch();
+    }
+
+    for (int count : seen) {
+        ASSERT_EQ(count, 3);
+    }
+}
+
+}  // namespace
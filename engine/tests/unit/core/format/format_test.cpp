@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "zeus/core/format.hpp"
+
+/**
+ * Tests for format.hpp
+ */
+namespace {
+
+struct Point {
+    int x;
+    int y;
+};
+
+}  // namespace
+
+template <>
+struct Zeus::Formatter<Point> {
+    static void format(FormatBuffer& out, Point const& point) noexcept {
+        ZEUS_FORMAT_TO(out, "<{} {}>", point.x, point.y);
+    }
+};
+
+namespace {
+
+TEST(format_test, integers) {
+    EXPECT_EQ(ZEUS_FORMAT(64, "{} {} {}", 0, -42, 42U), "0 -42 42");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", std::numeric_limits<std::int64_t>::min()),
+              "-9223372036854775808");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", std::numeric_limits<std::uint64_t>::max()),
+              "18446744073709551615");
+}
+
+TEST(format_test, floating_point_round_trips) {
+    EXPECT_EQ(ZEUS_FORMAT(64, "{} {}", 0.1F, 0.1), "0.1 0.1");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", 1.5e300), "1.5e+300");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", -2.0F), "-2");
+}
+
+TEST(format_test, text) {
+    std::string const owned{"owned"};
+    char const* const missing = nullptr;
+
+    EXPECT_EQ(ZEUS_FORMAT(64, "{} {} {} {} {}", "literal",
+                          std::string_view{"view"}, owned, 'c', missing),
+              "literal view owned c (null)");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{} {}", true, false), "true false");
+}
+
+TEST(format_test, pointers) {
+    auto const* const pointer = reinterpret_cast<int const*>(0xABC0);
+
+    EXPECT_EQ(ZEUS_FORMAT(64, "{} {}", pointer, nullptr), "0xabc0 nullptr");
+}
+
+TEST(format_test, escaped_braces) {
+    EXPECT_EQ(ZEUS_FORMAT(64, "{{}} {{{}}}", 1), "{} {1}");
+}
+
+TEST(format_test, custom_formatter) {
+    EXPECT_EQ(ZEUS_FORMAT(64, "point {}", Point{1, 2}), "point <1 2>");
+}
+
+TEST(format_test, truncates_to_capacity) {
+    auto const text = ZEUS_FORMAT(8, "{} {}", "abcdef", 123456);
+
+    EXPECT_EQ(text, "abcdef 1");
+    EXPECT_TRUE(text.full());
+
+    std::array<char, 4> data{};
+    Zeus::FormatBuffer buffer{data.data(), data.size()};
+    ZEUS_FORMAT_TO(buffer, "{}", 1234567);
+
+    EXPECT_EQ(buffer.view(), "1234");
+    EXPECT_TRUE(buffer.truncated());
+}
+
+TEST(format_test, appends_to_fixed_string) {
+    Zeus::FixedString<32> text{"a"};
+
+    ZEUS_FORMAT_TO(text, "{}", 1);
+    ZEUS_FORMAT_TO(text, "-{}", 2);
+
+    EXPECT_EQ(text, "a1-2");
+}
+
+TEST(format_test, runtime_format_strings) {
+    std::string_view const format{"{} and {}"};
+
+    EXPECT_EQ(Zeus::format<32>(format, 1), "1 and {}");
+    EXPECT_EQ(Zeus::format<32>(format, 1, 2, 3), "1 and 2");
+}
+
+TEST(format_test, placeholders_are_counted_at_compile_time) {
+    using Zeus::Detail::placeholderCount;
+
+    static_assert(placeholderCount("none") == 0);
+    static_assert(placeholderCount("{} {}") == 2);
+    static_assert(placeholderCount("{{}} {}") == 1);
+    static_assert(placeholderCount("{") == Zeus::Detail::invalid_format);
+    static_assert(placeholderCount("} {}") == Zeus::Detail::invalid_format);
+    static_assert(placeholderCount("{x}") == Zeus::Detail::invalid_format);
+
+    static_assert(Zeus::is_formattable_v<int>);
+    static_assert(Zeus::is_formattable_v<char[4]>);
+    static_assert(!Zeus::is_formattable_v<std::array<int, 2>>);
+}
+
+}  // namespace
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+#include "zeus/core/clock.hpp"
+#include "zeus/core/frame_limiter.hpp"
+
+/**
+ * Tests for frame_limiter.hpp
+ */
+namespace {
+
+using Zeus::FrameLimiter;
+using Zeus::TscClock;
+
+TEST(frame_limiter_test, never_returns_early) {
+    FrameLimiter limiter;
+
+    for (int i = 0; i < 20; ++i) {
+        auto const deadline = TscClock::now() + std::chrono::microseconds{
+                                                    (i % 5) * 1000 + 300};
+
+        limiter.waitUntil(deadline);
+
+        EXPECT_GE(TscClock::now(), deadline);
+    }
+}
+
+TEST(frame_limiter_test, past_deadlines_return_at_once) {
+    FrameLimiter limiter;
+    auto const start = TscClock::now();
+
+    limiter.waitUntil(start - std::chrono::milliseconds{10});
+
+    EXPECT_LT(TscClock::now() - start, std::chrono::milliseconds{1});
+}
+
+TEST(frame_limiter_test, learns_the_sleep_time) {
+    FrameLimiter limiter;
+
+    for (int i = 0; i < 10; ++i) {
+        limiter.waitUntil(TscClock::now() + std::chrono::milliseconds{5});
+    }
+
+    // A 1 ms sleep takes at least 1 ms
+    EXPECT_GE(limiter.expectedSleep(), 1e6);
+}
+
+}  // namespace
@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+
+#include "zeus/core/futex.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for futex.hpp
+ */
+namespace {
+
+TEST(futex_test, wait_returns_if_value_differs) {
+    std::atomic<Zeus::u32> word{1};
+
+    // Would block forever if the value were not compared
+    Zeus::Futex::wait(word, 0);
+
+    EXPECT_EQ(word.load(), 1U);
+}
+
+TEST(futex_test, wake_without_waiters) {
+    std::atomic<Zeus::u32> word{0};
+
+    Zeus::Futex::wakeOne(word);
+    Zeus::Futex::wakeAll(word);
+
+    EXPECT_EQ(word.load(), 0U);
+}
+
+TEST(futex_test, wake_one_releases_waiter) {
+    std::atomic<Zeus::u32> word{0};
+
+    std::thread waiter{[&word] {
+        while (word.load(std::memory_order_acquire) == 0) {
+            Zeus::Futex::wait(word, 0);
+        }
+    }};
+
+    word.store(1, std::memory_order_release);
+    Zeus::Futex::wakeOne(word);
+    waiter.join();
+
+    EXPECT_EQ(word.load(), 1U);
+}
+
+TEST(futex_test, wake_all_releases_every_waiter) {
+    std::atomic<Zeus::u32> word{0};
+    std::atomic<int> released{0};
+    std::thread waiters[4];
+
+    for (auto& waiter : waiters) {
+        waiter = std::thread{[&word, &released] {
+            while (word.load(std::memory_order_acquire) == 0) {
+                Zeus::Futex::wait(word, 0);
+            }
+
+            released.fetch_add(1);
+        }};
+    }
+
+    word.store(1, std::memory_order_release);
+    Zeus::Futex::wakeAll(word);
+
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    EXPECT_EQ(released.load(), 4);
+}
+
+TEST(futex_test, ping_pong) {
+    constexpr Zeus::u32 round_trips = 1000;
+    std::atomic<Zeus::u32> word{0};
+
+    // Even values are the main thread's turn, odd values the other thread's
+    std::thread partner{[&word] {
+        for (Zeus::u32 turn = 1; turn < 2 * round_trips; turn += 2) {
+            Zeus::u32 value;
+
+            while ((value = word.load(std::memory_order_acquire)) != turn) {
+                Zeus::Futex::wait(word, value);
+            }
+
+            word.store(turn + 1, std::memory_order_release);
+            Zeus::Futex::wakeOne(word);
+        }
+    }};
+
+    for (Zeus::u32 turn = 0; turn < 2 * round_trips; turn += 2) {
+        Zeus::u32 value;
+
+        while ((value = word.load(std::memory_order_acquire)) != turn) {
+            Zeus::Futex::wait(word, value);
+        }
+
+        word.store(turn + 1, std::memory_order_release);
+        Zeus::Futex::wakeOne(word);
+    }
+
+    partner.join();
+
+    EXPECT_EQ(word.load(), 2 * round_trips);
+}
+
+}  // namespace
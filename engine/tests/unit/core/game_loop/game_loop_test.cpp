@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "zeus/core/clock.hpp"
+#include "zeus/core/game_loop.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for game_loop.hpp
+ */
+namespace {
+
+using Zeus::f64;
+using Zeus::GameLoop;
+using Zeus::TscClock;
+using Zeus::u64;
+
+GameLoop::Settings settingsFor(u64 frames) {
+    GameLoop::Settings settings;
+    settings.frame_count = frames;
+    settings.report_interval = 0.0;
+
+    return settings;
+}
+
+TEST(game_loop_test, runs_the_frame_count) {
+    GameLoop loop{settingsFor(10)};
+    u64 renders = 0;
+
+    loop.run([](f64) {}, [&renders](f64) { ++renders; });
+
+    EXPECT_EQ(loop.frameCount(), 10);
+    EXPECT_EQ(renders, 10);
+
+    // The first frame has no previous frame to measure against
+    EXPECT_EQ(loop.frameTimes().count(), 9);
+}
+
+TEST(game_loop_test, steps_follow_real_time) {
+    GameLoop::Settings settings = settingsFor(11);
+    settings.update_rate = 1000.0;
+    settings.max_updates_per_frame = 100;
+
+    GameLoop loop{settings};
+    u64 updates = 0;
+    f64 step = 0.0;
+
+    loop.run(
+        [&updates, &step](f64 dt) {
+            ++updates;
+            step = dt;
+        },
+        [](f64) { std::this_thread::sleep_for(std::chrono::milliseconds{5}); });
+
+    // 10 measured frames of at least 5 ms at 1 ms steps
+    EXPECT_EQ(loop.updateCount(), updates);
+    EXPECT_GE(updates, 50);
+    EXPECT_DOUBLE_EQ(step, 0.001);
+}
+
+TEST(game_loop_test, slow_frames_drop_time) {
+    GameLoop::Settings settings = settingsFor(3);
+    settings.update_rate = 1000.0;
+    settings.max_updates_per_frame = 2;
+
+    GameLoop loop{settings};
+
+    loop.run([](f64) {},
+             [](f64) {
+                 std::this_thread::sleep_for(std::chrono::milliseconds{10});
+             });
+
+    EXPECT_LE(loop.updateCount(), 4);
+}
+
+TEST(game_loop_test, interpolation_is_a_fraction_of_a_step) {
+    GameLoop::Settings settings = settingsFor(200);
+    settings.update_rate = 10'000.0;
+
+    GameLoop loop{settings};
+
+    loop.run([](f64) {},
+             [](f64 alpha) {
+                 EXPECT_GE(alpha, 0.0);
+                 EXPECT_LT(alpha, 1.0);
+             });
+}
+
+TEST(game_loop_test, headless_runs_one_step_per_frame) {
+    GameLoop::Settings settings = settingsFor(100);
+    settings.headless = true;
+
+    GameLoop loop{settings};
+    u64 updates = 0;
+
+    loop.run([&updates](f64) { ++updates; },
+             [](f64 alpha) { EXPECT_EQ(alpha, 0.0); });
+
+    EXPECT_EQ(updates, 100);
+    EXPECT_EQ(loop.updateCount(), 100);
+}
+
+TEST(game_loop_test, frame_rate_limit) {
+    GameLoop::Settings settings = settingsFor(21);
+    settings.frame_rate_limit = 200.0;
+
+    GameLoop loop{settings};
+    auto const start = TscClock::now();
+
+    loop.run([](f64) {}, [](f64) {});
+
+    // 20 frame periods of 5 ms, the limiter never returns early. A single
+    // frame can be shorter when the one before it woke up late, frames stay
+    // on the 5 ms grid instead of drifting.
+    EXPECT_GE(TscClock::now() - start, std::chrono::milliseconds{100});
+    EXPECT_GE(loop.frameTimes().mean(), 4'900'000.0);
+}
+
+TEST(game_loop_test, stop) {
+    GameLoop loop{settingsFor(0)};
+
+    loop.run([](f64) {},
+             [&loop](f64) {
+                 if (loop.frameCount() == 4) {
+                     loop.stop();
+                 }
+             });
+
+    EXPECT_EQ(loop.frameCount(), 5);
+}
+
+}  // namespace
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include <type_traits>
+#include <unordered_set>
+
+#include "zeus/core/macros.hpp"
+
+/**
+ * Tests for handle.hpp
+ */
+namespace {
+
+ZEUS_DEFINE_GENERATIONAL_HANDLE(TextureHandle);
+ZEUS_DEFINE_GENERATIONAL_HANDLE(MeshHandle);
+ZEUS_DEFINE_GENERATIONAL_HANDLE_64(BufferHandle);
+
+TEST(handle_test, sizes) {
+    static_assert(sizeof(TextureHandle) == 4);
+    static_assert(sizeof(BufferHandle) == 8);
+    static_assert(!std::is_convertible_v<TextureHandle, MeshHandle>);
+}
+
+TEST(handle_test, null) {
+    constexpr TextureHandle handle;
+
+    static_assert(handle.isNull());
+    EXPECT_FALSE(handle);
+}
+
+TEST(handle_test, index_and_generation) {
+    constexpr TextureHandle handle{1234, 56};
+
+    static_assert(handle.index() == 1234);
+    static_assert(handle.generation() == 56);
+    EXPECT_TRUE(handle);
+
+    constexpr BufferHandle wide{TextureHandle::max_index + 1, 7};
+
+    static_assert(wide.index() == TextureHandle::max_index + 1);
+    static_assert(wide.generation() == 7);
+}
+
+TEST(handle_test, round_trip) {
+    constexpr TextureHandle handle{42, 3};
+
+    EXPECT_EQ(TextureHandle::fromValue(handle.value()), handle);
+    EXPECT_NE(handle, (TextureHandle{42, 4}));
+}
+
+TEST(handle_test, hash) {
+    std::unordered_set<TextureHandle> handles;
+
+    handles.insert(TextureHandle{1, 1});
+    handles.insert(TextureHandle{1, 2});
+    handles.insert(TextureHandle{1, 1});
+
+    EXPECT_EQ(handles.size(), 2U);
+}
+
+}  // namespace
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "zeus/core/hash.hpp"
+#include "zeus/math/vector_2d.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Tests for hash.hpp
+ */
+namespace {
+
+TEST(hash_test, mix_spreads_small_values) {
+    std::unordered_set<Zeus::u64> high_bits;
+
+    // Consecutive integers must differ in their top bits after mixing
+    for (Zeus::u64 i = 0; i < 256; ++i) {
+        high_bits.insert(Zeus::hashMix(i) >> 56);
+    }
+
+    EXPECT_GT(high_bits.size(), 128U);
+}
+
+TEST(hash_test, floats_hash_signed_zero_alike) {
+    EXPECT_EQ(Zeus::hashFloat(0.0F), Zeus::hashFloat(-0.0F));
+    EXPECT_EQ(Zeus::hashFloat(0.0), Zeus::hashFloat(-0.0));
+    EXPECT_NE(Zeus::hashFloat(1.0F), Zeus::hashFloat(-1.0F));
+}
+
+TEST(hash_test, strings_are_transparent) {
+    Zeus::Hash<std::string> const hash;
+
+    EXPECT_EQ(hash(std::string{"zeus"}), hash(std::string_view{"zeus"}));
+    EXPECT_EQ(hash(std::string{"zeus"}), hash("zeus"));
+}
+
+TEST(hash_test, vectors) {
+    Zeus::Hash<Zeus::Math::Vector3D> const hash;
+
+    EXPECT_EQ(hash({0.0F, 1.0F, 2.0F}), hash({-0.0F, 1.0F, 2.0F}));
+    EXPECT_NE(hash({1.0F, 2.0F, 3.0F}), hash({3.0F, 2.0F, 1.0F}));
+    EXPECT_EQ(std::hash<Zeus::Math::Vector2D>{}({1.0F, 2.0F}),
+              Zeus::Hash<Zeus::Math::Vector2D>{}({1.0F, 2.0F}));
+
+    // A grid of positions should not collide
+    std::unordered_set<std::size_t> hashes;
+
+    for (int x = 0; x < 32; ++x) {
+        for (int y = 0; y < 32; ++y) {
+            for (int z = 0; z < 32; ++z) {
+                hashes.insert(hash({static_cast<float>(x),
+                                    static_cast<float>(y),
+                                    static_cast<float>(z)}));
+            }
+        }
+    }
+
+    EXPECT_EQ(hashes.size(), 32U * 32U * 32U);
+}
+
+}  // namespace
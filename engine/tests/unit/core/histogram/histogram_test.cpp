@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <limits>
+
+#include "zeus/core/histogram.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for histogram.hpp
+ */
+namespace {
+
+using Zeus::Histogram;
+using Zeus::u64;
+
+TEST(histogram_test, small_values_are_exact) {
+    for (u64 value = 0; value < Histogram::linear_count; ++value) {
+        EXPECT_EQ(Histogram::bucketOf(value), value);
+        EXPECT_EQ(Histogram::lowestOf(value), value);
+        EXPECT_EQ(Histogram::highestOf(value), value);
+    }
+}
+
+TEST(histogram_test, buckets_cover_every_value) {
+    // Consecutive buckets are adjacent and every value maps back into the
+    // bucket it came from
+    for (std::size_t bucket = 0; bucket + 1 < Histogram::bucket_count;
+         ++bucket) {
+        u64 const lowest = Histogram::lowestOf(bucket);
+        u64 const highest = Histogram::highestOf(bucket);
+
+        EXPECT_EQ(Histogram::lowestOf(bucket + 1), highest + 1);
+        EXPECT_EQ(Histogram::bucketOf(lowest), bucket);
+        EXPECT_EQ(Histogram::bucketOf(highest), bucket);
+    }
+
+    u64 const max = std::numeric_limits<u64>::max();
+
+    EXPECT_EQ(Histogram::bucketOf(max), Histogram::bucket_count - 1);
+    EXPECT_EQ(Histogram::highestOf(Histogram::bucket_count - 1), max);
+}
+
+TEST(histogram_test, relative_error_is_bounded) {
+    for (std::size_t bucket = Histogram::linear_count;
+         bucket < Histogram::bucket_count; ++bucket) {
+        u64 const lowest = Histogram::lowestOf(bucket);
+        u64 const width = Histogram::highestOf(bucket) - lowest + 1;
+
+        EXPECT_LE(width, lowest / 64);
+    }
+}
+
+TEST(histogram_test, empty) {
+    Histogram const histogram;
+
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.mean(), 0.0);
+    EXPECT_EQ(histogram.percentile(50.0), 0);
+}
+
+TEST(histogram_test, percentiles) {
+    Histogram histogram;
+
+    for (u64 value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.count(), 100);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 100);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+    EXPECT_EQ(histogram.percentile(0.0), 1);
+    EXPECT_EQ(histogram.percentile(50.0), 50);
+    EXPECT_EQ(histogram.percentile(99.0), 99);
+    EXPECT_EQ(histogram.percentile(100.0), 100);
+}
+
+TEST(histogram_test, large_percentiles_are_within_a_bucket) {
+    Histogram histogram;
+
+    histogram.record(1'000'000, 99);
+    histogram.record(50'000'000);
+
+    u64 const median = histogram.percentile(50.0);
+
+    EXPECT_GE(median, 1'000'000);
+    EXPECT_LE(median, 1'000'000 + 1'000'000 / 64);
+    EXPECT_EQ(histogram.percentile(100.0), 50'000'000);
+}
+
+TEST(histogram_test, record_counts) {
+    Histogram histogram;
+
+    histogram.record(10, 3);
+    histogram.record(20);
+
+    EXPECT_EQ(histogram.count(), 4);
+    EXPECT_EQ(histogram.bucketCount(Histogram::bucketOf(10)), 3);
+    EXPECT_EQ(histogram.percentile(75.0), 10);
+    EXPECT_EQ(histogram.percentile(76.0), 20);
+}
+
+TEST(histogram_test, merge) {
+    Histogram first;
+    Histogram second;
+
+    first.record(5);
+    second.record(500);
+    second.record(7);
+    first.merge(second);
+
+    EXPECT_EQ(first.count(), 3);
+    EXPECT_EQ(first.min(), 5);
+    EXPECT_EQ(first.max(), 500);
+    EXPECT_DOUBLE_EQ(first.mean(), 512.0 / 3.0);
+    EXPECT_EQ(first.percentile(50.0), 7);
+
+    // Merging an empty histogram changes nothing
+    first.merge(Histogram{});
+
+    EXPECT_EQ(first.count(), 3);
+    EXPECT_EQ(first.min(), 5);
+}
+
+TEST(histogram_test, reset) {
+    Histogram histogram;
+
+    histogram.record(42);
+    histogram.reset();
+
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.bucketCount(42), 0);
+    EXPECT_EQ(histogram.max(), 0);
+
+    histogram.record(3);
+
+    EXPECT_EQ(histogram.min(), 3);
+}
+
+}  // namespace
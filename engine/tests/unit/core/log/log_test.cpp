@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "zeus/core/log.hpp"
+
+/**
+ * Tests for log.hpp
+ */
+namespace {
+
+/**
+ * Redirects the log to a temporary file for the lifetime of the object.
+ */
+class CapturedLog {
+   public:
+    CapturedLog() {
+        std::array<char, 32> name{"/tmp/zeus_log_XXXXXX"};
+
+        file_descriptor_ = mkstemp(name.data());
+        path_ = name.data();
+
+        Zeus::Log::setOutput(file_descriptor_);
+    }
+
+    CapturedLog(CapturedLog const&) = delete;
+    CapturedLog& operator=(CapturedLog const&) = delete;
+
+    ~CapturedLog() {
+        Zeus::Log::setOutput(2);
+
+        close(file_descriptor_);
+        std::remove(path_.c_str());
+    }
+
+    [[nodiscard]] std::string contents() const {
+        Zeus::Log::flush();
+
+        std::ifstream file{path_};
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        return stream.str();
+    }
+
+   private:
+    int file_descriptor_;
+    std::string path_;
+};
+
+std::size_t countOccurrences(std::string const& text,
+                             std::string const& pattern) {
+    std::size_t count = 0;
+
+    for (auto position = text.find(pattern); position != std::string::npos;
+         position = text.find(pattern, position + pattern.size())) {
+        ++count;
+    }
+
+    return count;
+}
+
+TEST(log_test, to_string) {
+    EXPECT_EQ(Zeus::to_string(Zeus::Log::Level::Error), "ERROR");
+    EXPECT_EQ(Zeus::to_string(Zeus::Log::Level::Debug), "DEBUG");
+}
+
+TEST(log_test, format) {
+    CapturedLog const log;
+
+    Zeus::Log::info("Renderer", "Swapchain created");
+    Zeus::Log::warning("Default logger");
+
+    std::string const contents = log.contents();
+
+    EXPECT_NE(contents.find("] [INFO] [Renderer] Swapchain created\n"),
+              std::string::npos);
+    EXPECT_NE(contents.find("] [WARNING] [Zeus] Default logger\n"),
+              std::string::npos);
+}
+
+TEST(log_test, many_threads) {
+    constexpr int thread_count = 8;
+    constexpr int message_count = 5000;
+
+    CapturedLog const log;
+
+    Zeus::Log::setOverflowPolicy(Zeus::Log::OverflowPolicy::Block);
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < message_count; ++i) {
+                Zeus::Log::debug("Worker", "message from a worker thread");
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(countOccurrences(log.contents(), "message from a worker thread\n"),
+              std::size_t{thread_count * message_count});
+}
+
+TEST(log_test, drop_policy) {
+    CapturedLog const log;
+
+    Zeus::Log::setOverflowPolicy(Zeus::Log::OverflowPolicy::Drop);
+
+    std::string const message(4000, 'x');
+    std::uint64_t const dropped = Zeus::Log::droppedCount();
+
+    for (int i = 0; i < 10000; ++i) {
+        Zeus::Log::info(message);
+    }
+
+    Zeus::Log::setOverflowPolicy(Zeus::Log::OverflowPolicy::Block);
+
+    std::uint64_t const newly_dropped = Zeus::Log::droppedCount() - dropped;
+    std::string const contents = log.contents();
+
+    EXPECT_EQ(countOccurrences(contents, message + "\n") + newly_dropped,
+              10000U);
+
+    if (newly_dropped > 0) {
+        EXPECT_NE(contents.find("log messages dropped"), std::string::npos);
+    }
+}
+
+TEST(log_test, long_messages_are_truncated) {
+    CapturedLog const log;
+
+    Zeus::Log::info(std::string(1 << 20, 'y'));
+
+    std::string const contents = log.contents();
+
+    EXPECT_GT(countOccurrences(contents, "y"), 0U);
+    EXPECT_LT(countOccurrences(contents, "y"), std::size_t{1} << 20);
+}
+
+TEST(log_test, logger_id) {
+    static_assert(Zeus::Log::loggerId("") == 2166136261U);
+    static_assert(Zeus::Log::loggerId("a") == 0xE40C292CU);
+    static_assert(Zeus::Log::loggerId("Physics") !=
+                  Zeus::Log::loggerId("Renderer"));
+
+    EXPECT_NE(Zeus::Log::levelSlot(Zeus::Log::loggerId("Physics")),
+              Zeus::Log::levelSlot(Zeus::Log::loggerId("Renderer")));
+}
+
+TEST(log_test, runtime_levels) {
+    CapturedLog const log;
+
+    Zeus::Log::setLevel("Physics", Zeus::Log::Level::Warning);
+
+    EXPECT_FALSE(Zeus::Log::isEnabled(Zeus::Log::loggerId("Physics"),
+                                      Zeus::Log::Level::Info));
+    EXPECT_TRUE(Zeus::Log::isEnabled(Zeus::Log::loggerId("Physics"),
+                                     Zeus::Log::Level::Error));
+    EXPECT_TRUE(Zeus::Log::isEnabled(Zeus::Log::loggerId("Renderer"),
+                                     Zeus::Log::Level::Debug));
+
+    ZEUS_DEBUG_LOG("Physics", "hidden physics message");
+    ZEUS_WARNING_LOG("Physics", "shown physics message");
+    ZEUS_DEBUG_LOG("Renderer", "shown renderer message");
+    Zeus::Log::info("Physics", "hidden direct message");
+
+    Zeus::Log::resetLevel("Physics");
+
+    ZEUS_DEBUG_LOG("Physics", "message after reset");
+
+    std::string const contents = log.contents();
+
+    EXPECT_EQ(contents.find("hidden"), std::string::npos);
+    EXPECT_NE(contents.find("shown physics message"), std::string::npos);
+    EXPECT_NE(contents.find("shown renderer message"), std::string::npos);
+    EXPECT_NE(contents.find("message after reset"), std::string::npos);
+}
+
+TEST(log_test, default_level) {
+    CapturedLog const log;
+
+    Zeus::Log::setDefaultLevel(Zeus::Log::Level::Error);
+    Zeus::Log::setLevel("Audio", Zeus::Log::Level::Debug);
+
+    ZEUS_INFO_LOG("hidden default message");
+    ZEUS_INFO_LOG("Renderer", "hidden renderer message");
+    ZEUS_DEBUG_LOG("Audio", "shown audio message");
+    ZEUS_ERROR_LOG("shown error message");
+
+    Zeus::Log::setDefaultLevel(Zeus::Log::Level::Debug);
+    Zeus::Log::resetLevel("Audio");
+
+    std::string const contents = log.contents();
+
+    EXPECT_EQ(contents.find("hidden"), std::string::npos);
+    EXPECT_NE(contents.find("shown audio message"), std::string::npos);
+    EXPECT_NE(contents.find("shown error message"), std::string::npos);
+}
+
+TEST(log_test, disabled_arguments_not_evaluated) {
+    CapturedLog const log;
+
+    int evaluated = 0;
+    auto message = [&evaluated] {
+        ++evaluated;
+
+        return std::string{"evaluated message"};
+    };
+
+    Zeus::Log::setLevel("Physics", Zeus::Log::Level::Error);
+
+    ZEUS_DEBUG_LOG("Physics", message());
+    ZEUS_INFO_LOG("Physics", message());
+
+    EXPECT_EQ(evaluated, 0);
+
+    ZEUS_ERROR_LOG("Physics", message());
+
+    EXPECT_EQ(evaluated, 1);
+
+    Zeus::Log::resetLevel("Physics");
+}
+
+TEST(log_test, terminate_flushes) {
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+    EXPECT_DEATH(
+        {
+            Zeus::Log::error("Assert", "last words before terminate");
+            std::terminate();
+        },
+        "last words before terminate");
+}
+
+}  // namespace
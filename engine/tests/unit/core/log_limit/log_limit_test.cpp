@@ -0,0 +1,323 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "zeus/core/log_limit.hpp"
+
+/**
+ * Tests for log_limit.hpp
+ */
+namespace {
+
+/**
+ * Redirects the log to a temporary file for the lifetime of the object.
+ */
+class CapturedLog {
+   public:
+    CapturedLog() {
+        std::array<char, 32> name{"/tmp/zeus_log_XXXXXX"};
+
+        file_descriptor_ = mkstemp(name.data());
+        path_ = name.data();
+
+        Zeus::Log::setOutput(file_descriptor_);
+    }
+
+    CapturedLog(CapturedLog const&) = delete;
+    CapturedLog& operator=(CapturedLog const&) = delete;
+
+    ~CapturedLog() {
+        Zeus::Log::setOutput(2);
+
+        close(file_descriptor_);
+        std::remove(path_.c_str());
+    }
+
+    [[nodiscard]] std::string contents() const {
+        Zeus::Log::flush();
+
+        std::ifstream file{path_};
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        return stream.str();
+    }
+
+   private:
+    int file_descriptor_;
+    std::string path_;
+};
+
+std::size_t countOccurrences(std::string const& text,
+                             std::string const& pattern) {
+    std::size_t count = 0;
+
+    for (auto position = text.find(pattern); position != std::string::npos;
+         position = text.find(pattern, position + pattern.size())) {
+        ++count;
+    }
+
+    return count;
+}
+
+/**
+ * Returns the given duration in the nanoseconds of logLimitNow().
+ */
+Zeus::i64 nanoseconds(std::chrono::nanoseconds duration) {
+    return duration.count();
+}
+
+/**
+ * Waits until the log contains the pattern, for at most a few seconds.
+ */
+std::string waitForLog(CapturedLog const& log, std::string const& pattern) {
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    std::string contents = log.contents();
+
+    while (contents.find(pattern) == std::string::npos &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        contents = log.contents();
+    }
+
+    return contents;
+}
+
+TEST(log_limit_test, every_n) {
+    CapturedLog const log;
+
+    for (int i = 0; i < 10; ++i) {
+        ZEUS_LOG_EVERY_N(Zeus::Log::Level::Warning, 4, "Physics",
+                         "body left the world");
+    }
+
+    std::string const contents = log.contents();
+
+    // Messages 1, 5 and 9 are logged
+    EXPECT_EQ(countOccurrences(contents, "body left the world"), 3U);
+    EXPECT_EQ(countOccurrences(contents, "[3 similar messages suppressed]"),
+              2U);
+    EXPECT_NE(contents.find("[WARNING] [Physics] body left the world\n"),
+              std::string::npos);
+}
+
+TEST(log_limit_test, every_n_threads) {
+    CapturedLog const log;
+
+    constexpr int thread_count = 4;
+    constexpr int message_count = 1000;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < message_count; ++i) {
+                ZEUS_LOG_EVERY_N(Zeus::Log::Level::Info, 100, "storm message");
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(countOccurrences(log.contents(), "storm message"),
+              std::size_t{thread_count * message_count / 100});
+}
+
+TEST(log_limit_test, first_n) {
+    CapturedLog const log;
+
+    for (int i = 0; i < 100; ++i) {
+        ZEUS_LOG_FIRST_N(Zeus::Log::Level::Error, 3, "Audio", "device lost");
+    }
+
+    std::string const contents = log.contents();
+
+    EXPECT_EQ(countOccurrences(contents, "device lost"), 3U);
+    EXPECT_EQ(contents.find("suppressed"), std::string::npos);
+}
+
+TEST(log_limit_test, every_t) {
+    Zeus::Detail::EveryTLimiter limiter{std::chrono::milliseconds{100}};
+    std::vector<Zeus::u64> reports;
+
+    // One call per millisecond for 250 milliseconds
+    for (int i = 0; i < 250; ++i) {
+        Zeus::u64 suppressed = 0;
+
+        if (limiter.allow(suppressed, nullptr,
+                          nanoseconds(std::chrono::milliseconds{i}))) {
+            reports.push_back(suppressed);
+        }
+    }
+
+    // Logged at 0, 100 and 200 milliseconds
+    EXPECT_EQ(reports, (std::vector<Zeus::u64>{0, 99, 99}));
+}
+
+TEST(log_limit_test, every_t_logs_its_own_report) {
+    Zeus::Detail::EveryTLimiter limiter{std::chrono::milliseconds{100}};
+    Zeus::u64 suppressed = 0;
+
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr, 0));
+
+    for (int i = 1; i <= 3; ++i) {
+        EXPECT_FALSE(limiter.allow(suppressed, nullptr,
+                                   nanoseconds(std::chrono::milliseconds{i})));
+    }
+
+    // The token is back but the site was not quiet for a full interval, so
+    // the report is left to the next message
+    EXPECT_FALSE(limiter.takeQuietSuppressed(
+        suppressed, nanoseconds(std::chrono::milliseconds{150})));
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr,
+                              nanoseconds(std::chrono::milliseconds{150})));
+    EXPECT_EQ(suppressed, 3U);
+
+    EXPECT_FALSE(limiter.allow(suppressed, nullptr,
+                               nanoseconds(std::chrono::milliseconds{160})));
+
+    // Quiet for a full interval since the token came back at 250
+    EXPECT_FALSE(limiter.takeQuietSuppressed(
+        suppressed, nanoseconds(std::chrono::milliseconds{349})));
+    EXPECT_TRUE(limiter.takeQuietSuppressed(
+        suppressed, nanoseconds(std::chrono::milliseconds{350})));
+    EXPECT_EQ(suppressed, 1U);
+
+    // Reporting left the token for the next message
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr,
+                              nanoseconds(std::chrono::milliseconds{350})));
+    EXPECT_EQ(suppressed, 0U);
+}
+
+TEST(log_limit_test, every_t_limiter) {
+    Zeus::Detail::EveryTLimiter limiter{std::chrono::hours{1}};
+    Zeus::u64 suppressed = 0;
+
+    EXPECT_TRUE(limiter.allow(suppressed));
+    EXPECT_EQ(suppressed, 0U);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(limiter.allow(suppressed));
+    }
+}
+
+TEST(log_limit_test, first_n_reports_suppressed) {
+    Zeus::Detail::FirstNLimiter limiter{2, std::chrono::milliseconds{20}};
+    Zeus::u64 suppressed = 0;
+
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr, 0));
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr, 0));
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(limiter.allow(suppressed, nullptr, 0));
+    }
+
+    Zeus::i64 const later = nanoseconds(std::chrono::milliseconds{25});
+
+    EXPECT_TRUE(limiter.allow(suppressed, nullptr, later));
+    EXPECT_EQ(suppressed, 5U);
+    EXPECT_FALSE(limiter.allow(suppressed, nullptr, later));
+}
+
+TEST(log_limit_test, every_t_reports_after_silence) {
+    CapturedLog const log;
+
+    for (int i = 0; i < 10; ++i) {
+        ZEUS_LOG_EVERY_T(Zeus::Log::Level::Warning,
+                         std::chrono::milliseconds{50}, "Input",
+                         "controller disconnected");
+    }
+
+    // The call site goes quiet, so the log writer has to report the burst
+    std::string const contents =
+        waitForLog(log, "similar messages suppressed at ");
+
+    EXPECT_EQ(countOccurrences(contents, "controller disconnected"), 1U);
+    EXPECT_NE(contents.find("[WARNING] [Input] [9 similar messages "
+                            "suppressed at "),
+              std::string::npos)
+        << contents;
+    EXPECT_NE(contents.find("log_limit_test.cpp:"), std::string::npos);
+}
+
+TEST(log_limit_test, first_n_reports_after_silence) {
+    CapturedLog const log;
+
+    static constexpr Zeus::Detail::LimitedLogSite site{
+        "Audio", Zeus::Log::Level::Error, "mixer.cpp", 42};
+    // Registered limiters are visited by the log writer, so keep it alive.
+    // The interval is long enough that the writer never reports it itself.
+    static Zeus::Detail::FirstNLimiter limiter{1, std::chrono::hours{1}};
+    Zeus::i64 const now = Zeus::Detail::logLimitNow();
+    Zeus::i64 const interval = nanoseconds(std::chrono::hours{1});
+    Zeus::u64 suppressed = 0;
+
+    EXPECT_TRUE(limiter.allow(suppressed, &site, now));
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(limiter.allow(suppressed, &site, now));
+    }
+
+    // Not quiet for a full interval yet
+    Zeus::Detail::reportSuppressedLogs(now + interval);
+
+    EXPECT_EQ(log.contents().find("mixer.cpp:42"), std::string::npos);
+
+    Zeus::Detail::reportSuppressedLogs(now + 2 * interval);
+
+    EXPECT_NE(log.contents().find(
+                  "[3 similar messages suppressed at mixer.cpp:42]"),
+              std::string::npos);
+
+    // Reported once, so the next message starts a new count
+    Zeus::Detail::reportSuppressedLogs(now + 2 * interval);
+
+    EXPECT_EQ(countOccurrences(log.contents(), "mixer.cpp:42"), 1U);
+}
+
+TEST(log_limit_test, long_message_keeps_report) {
+    CapturedLog const log;
+
+    std::string const message(2 * Zeus::Detail::max_suppressed_log_size, 'x');
+
+    Zeus::Detail::logSuppressed("Long", message, Zeus::Log::Level::Info, 7);
+
+    EXPECT_NE(log.contents().find("xxx [7 similar messages suppressed]\n"),
+              std::string::npos);
+}
+
+TEST(log_limit_test, disabled_logger) {
+    CapturedLog const log;
+
+    int evaluated = 0;
+    auto message = [&evaluated] {
+        ++evaluated;
+
+        return std::string{"muted message"};
+    };
+
+    Zeus::Log::setLevel("Muted", Zeus::Log::Level::Error);
+
+    for (int i = 0; i < 10; ++i) {
+        ZEUS_LOG_EVERY_N(Zeus::Log::Level::Info, 2, "Muted", message());
+    }
+
+    Zeus::Log::resetLevel("Muted");
+
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_EQ(log.contents().find("muted message"), std::string::npos);
+}
+
+}  // namespace
@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "zeus/core/log.hpp"
+#include "zeus/core/log_ring.hpp"
+
+/**
+ * Tests for log_ring.hpp
+ */
+namespace {
+
+/**
+ * Copies the log into a crash log in a temporary file for the lifetime of
+ * the object.
+ */
+class CrashLog {
+   public:
+    explicit CrashLog(std::size_t size) {
+        std::array<char, 32> name{"/tmp/zeus_ring_XXXXXX"};
+
+        int const file_descriptor = mkstemp(name.data());
+        close(file_descriptor);
+        path_ = name.data();
+
+        // Keep the text log out of the test output
+        null_device_ = open("/dev/null", O_WRONLY);
+        Zeus::Log::setOutput(null_device_);
+
+        EXPECT_TRUE(Zeus::Log::openCrashLog(path_, size));
+    }
+
+    CrashLog(CrashLog const&) = delete;
+    CrashLog& operator=(CrashLog const&) = delete;
+
+    ~CrashLog() {
+        Zeus::Log::closeCrashLog();
+        Zeus::Log::setOutput(2);
+
+        close(null_device_);
+        std::remove(path_.c_str());
+    }
+
+    [[nodiscard]] std::string decoded() const {
+        std::ifstream file{path_, std::ios::binary};
+        std::stringstream contents;
+        contents << file.rdbuf();
+
+        std::ostringstream output;
+
+        EXPECT_TRUE(Zeus::LogRing::decode(contents.str(), output));
+
+        return output.str();
+    }
+
+   private:
+    std::string path_;
+    int null_device_;
+};
+
+std::vector<std::string> lines(std::string const& text) {
+    std::vector<std::string> result;
+    std::istringstream stream{text};
+
+    for (std::string line; std::getline(stream, line);) {
+        result.push_back(line);
+    }
+
+    return result;
+}
+
+TEST(log_ring_test, decode) {
+    CrashLog const log{Zeus::LogRing::min_capacity};
+
+    Zeus::Log::info("Renderer", "Swapchain created");
+    Zeus::Log::error("Device lost");
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_EQ(result.size(), 2U);
+    EXPECT_NE(result[0].find("] [INFO] [Renderer] Swapchain created"),
+              std::string::npos);
+    EXPECT_NE(result[1].find("] [ERROR] [Zeus] Device lost"),
+              std::string::npos);
+}
+
+TEST(log_ring_test, keeps_newest_messages) {
+    CrashLog const log{Zeus::LogRing::min_capacity};
+
+    constexpr int message_count = 10000;
+
+    for (int i = 0; i < message_count; ++i) {
+        Zeus::Log::info("Frame", "frame " + std::to_string(i));
+    }
+
+    auto const result = lines(log.decoded());
+
+    ASSERT_FALSE(result.empty());
+    EXPECT_LT(result.size(), static_cast<std::size_t>(message_count));
+    EXPECT_NE(result.back().find(
+                  "[Frame] frame " + std::to_string(message_count - 1)),
+              std::string::npos);
+
+    // The surviving tail is contiguous and in order
+    int const first = std::stoi(result.front().substr(
+        result.front().rfind(' ') + 1));
+
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_NE(result[i].find("frame " +
+                                 std::to_string(first + static_cast<int>(i))),
+                  std::string::npos);
+    }
+}
+
+TEST(log_ring_test, many_threads) {
+    CrashLog const log{std::size_t{1} << 20};
+
+    constexpr int thread_count = 4;
+    constexpr int message_count = 1000;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < message_count; ++i) {
+                Zeus::Log::debug("Worker", "message from a worker thread");
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(lines(log.decoded()).size(),
+              static_cast<std::size_t>(thread_count * message_count));
+}
+
+TEST(log_ring_test, survives_kill) {
+    CrashLog const log{Zeus::LogRing::min_capacity};
+
+    // The child has to share the crash log of this process
+    testing::FLAGS_gtest_death_test_style = "fast";
+
+    EXPECT_EXIT(
+        {
+            Zeus::Log::error("Crash", "last words before the kill");
+            std::raise(SIGKILL);
+        },
+        testing::KilledBySignal(SIGKILL), "");
+
+    EXPECT_NE(log.decoded().find("last words before the kill"),
+              std::string::npos);
+}
+
+TEST(log_ring_test, not_a_crash_log) {
+    std::ostringstream output;
+
+    EXPECT_FALSE(Zeus::LogRing::decode("not a crash log", output));
+    EXPECT_FALSE(Zeus::LogRing::decode(
+        std::string(Zeus::LogRing::min_capacity * 2, '\0'), output));
+}
+
+}  // namespace
@@ -0,0 +1,292 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/metrics.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for metrics.hpp
+ */
+namespace {
+
+namespace Metrics = Zeus::Metrics;
+using Zeus::u64;
+
+/**
+ * Returns the contents of a file.
+ */
+std::string readFile(std::string const& path) {
+    std::ifstream file{path};
+
+    return {std::istreambuf_iterator<char>{file},
+            std::istreambuf_iterator<char>{}};
+}
+
+u64 countOf(std::string const& text, std::string const& needle) {
+    u64 count = 0;
+
+    for (auto at = text.find(needle); at != std::string::npos;
+         at = text.find(needle, at + 1)) {
+        ++count;
+    }
+
+    return count;
+}
+
+TEST(metrics_test, counter_sums_threads) {
+    Metrics::Counter counter{"test.counter_sums_threads"};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < 10'000; ++j) {
+                counter.add();
+            }
+        });
+    }
+
+    counter.add(5);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The exited threads still count
+    EXPECT_EQ(counter.value(), 40'005);
+}
+
+TEST(metrics_test, counter_read_while_recording) {
+    Metrics::Counter counter{"test.counter_read_while_recording"};
+    std::thread recorder{[&counter] {
+        for (int i = 0; i < 100'000; ++i) {
+            counter.add();
+        }
+    }};
+
+    u64 previous = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        u64 const current = counter.value();
+
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+
+    recorder.join();
+
+    EXPECT_EQ(counter.value(), 100'000);
+}
+
+TEST(metrics_test, same_name_is_same_metric) {
+    Metrics::Counter first{"test.same_name"};
+    Metrics::Counter second{"test.same_name"};
+
+    first.add(2);
+    second.add(3);
+
+    EXPECT_EQ(first.value(), 5);
+    EXPECT_EQ(second.value(), 5);
+
+    // Different kinds do not share names
+    Metrics::Gauge gauge{"test.same_name"};
+
+    EXPECT_EQ(gauge.value(), 0.0);
+}
+
+TEST(metrics_test, gauge) {
+    Metrics::Gauge gauge{"test.gauge"};
+
+    gauge.set(2.5);
+
+    EXPECT_EQ(gauge.value(), 2.5);
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&gauge] {
+            for (int j = 0; j < 1000; ++j) {
+                gauge.add(1.0);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(gauge.value(), 4002.5);
+
+    gauge.add(-4000.0);
+
+    EXPECT_EQ(gauge.value(), 2.5);
+}
+
+TEST(metrics_test, histogram_merges_threads) {
+    Metrics::Histogram histogram{"test.histogram_merges_threads"};
+    std::vector<std::thread> threads;
+
+    for (u64 i = 0; i < 4; ++i) {
+        threads.emplace_back([&histogram, i] {
+            for (u64 value = 1; value <= 25; ++value) {
+                histogram.record(i * 25 + value);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Zeus::Histogram const values = histogram.values();
+
+    EXPECT_EQ(values.count(), 100);
+    EXPECT_EQ(values.min(), 1);
+    EXPECT_EQ(values.max(), 100);
+    EXPECT_DOUBLE_EQ(values.mean(), 50.5);
+    EXPECT_EQ(values.percentile(50.0), 50);
+}
+
+TEST(metrics_test, scoped_timer) {
+    Metrics::Histogram histogram{"test.scoped_timer"};
+
+    {
+        Metrics::ScopedTimer const timer{histogram};
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+
+    Zeus::Histogram const values = histogram.values();
+
+    EXPECT_EQ(values.count(), 1);
+    EXPECT_GE(values.min(), 2'000'000);
+}
+
+TEST(metrics_test, snapshot_is_sorted) {
+    Metrics::Counter b{"test.snapshot.b"};
+    Metrics::Counter a{"test.snapshot.a"};
+
+    a.add(1);
+    b.add(2);
+
+    Metrics::Snapshot const snapshot = Metrics::snapshot();
+
+    EXPECT_GT(snapshot.timestamp_ms, 0);
+    EXPECT_TRUE(std::is_sorted(
+        snapshot.counters.begin(), snapshot.counters.end(),
+        [](auto const& lhs, auto const& rhs) { return lhs.name < rhs.name; }));
+
+    auto const a_value = std::find_if(
+        snapshot.counters.begin(), snapshot.counters.end(),
+        [](auto const& counter) { return counter.name == "test.snapshot.a"; });
+
+    ASSERT_NE(a_value, snapshot.counters.end());
+    EXPECT_EQ(a_value->value, 1);
+}
+
+TEST(metrics_test, json) {
+    Metrics::Snapshot snapshot;
+    snapshot.timestamp_ms = 1234;
+    snapshot.counters.push_back({"frames", 7});
+    snapshot.gauges.push_back({"queue \"depth\"", 1.5});
+    snapshot.histograms.push_back({"frame_ns", Zeus::Histogram{}});
+    snapshot.histograms.back().values.record(10);
+
+    std::ostringstream out;
+    Metrics::writeJson(out, snapshot);
+
+    EXPECT_EQ(out.str(),
+              "{\"timestamp_ms\":1234,\"counters\":{\"frames\":7},"
+              "\"gauges\":{\"queue \\\"depth\\\"\":1.5},\"histograms\":{"
+              "\"frame_ns\":{\"count\":1,\"mean\":10,\"min\":10,\"p50\":10,"
+              "\"p90\":10,\"p99\":10,\"p999\":10,\"max\":10}}}\n");
+}
+
+TEST(metrics_test, csv) {
+    Metrics::Snapshot snapshot;
+    snapshot.timestamp_ms = 1234;
+    snapshot.counters.push_back({"a,b", 7});
+    snapshot.gauges.push_back({"level", 0.25});
+
+    std::ostringstream out;
+    Metrics::writeCsv(out, snapshot);
+
+    EXPECT_EQ(out.str(),
+              "timestamp_ms,kind,name,statistic,value\n"
+              "1234,counter,\"a,b\",value,7\n"
+              "1234,gauge,level,value,0.25\n");
+
+    std::ostringstream rows;
+    Metrics::writeCsv(rows, snapshot, false);
+
+    EXPECT_EQ(countOf(rows.str(), "timestamp_ms"), 0);
+}
+
+TEST(metrics_test, query_filters_by_prefix) {
+    Metrics::Counter selected{"test.query.selected"};
+    Metrics::Counter other{"test.other"};
+
+    selected.add(42);
+
+    std::string const table = Metrics::query("test.query.");
+
+    EXPECT_NE(table.find("test.query.selected"), std::string::npos);
+    EXPECT_NE(table.find("42"), std::string::npos);
+    EXPECT_EQ(table.find("test.other"), std::string::npos);
+}
+
+TEST(metrics_test, dump_appends) {
+    std::string const path = "metrics_test_dump.csv";
+    std::remove(path.c_str());
+
+    Metrics::Counter counter{"test.dump"};
+    counter.add();
+
+    ASSERT_TRUE(Metrics::dump(path, Metrics::Format::Csv));
+    ASSERT_TRUE(Metrics::dump(path, Metrics::Format::Csv));
+
+    std::string const contents = readFile(path);
+
+    // The header is only written to the new file
+    EXPECT_EQ(countOf(contents, "timestamp_ms"), 1);
+    EXPECT_EQ(countOf(contents, ",counter,test.dump,value,1\n"), 2);
+
+    std::remove(path.c_str());
+}
+
+TEST(metrics_test, dumping) {
+    std::string const path = "metrics_test_dumping.json";
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(Metrics::startDumping(path, Metrics::Format::Json, 0.01));
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    Metrics::stopDumping();
+
+    // At least one periodic snapshot and the final one
+    u64 const lines = countOf(readFile(path), "\n");
+
+    EXPECT_GE(lines, 2);
+
+    // Nothing is appended after stopping
+    std::this_thread::sleep_for(std::chrono::milliseconds{30});
+
+    EXPECT_EQ(countOf(readFile(path), "\n"), lines);
+
+    std::remove(path.c_str());
+}
+
+TEST(metrics_test, dumping_to_a_bad_path) {
+    EXPECT_FALSE(Metrics::startDumping("/nonexistent/metrics.json",
+                                       Metrics::Format::Json, 1.0));
+    EXPECT_FALSE(Metrics::dump("/nonexistent/metrics.csv",
+                               Metrics::Format::Csv));
+}
+
+}  // namespace
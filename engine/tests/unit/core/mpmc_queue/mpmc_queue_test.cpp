@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/mpmc_queue.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for mpmc_queue.hpp
+ */
+namespace {
+
+TEST(mpmc_queue_test, capacity_is_power_of_two) {
+    EXPECT_EQ(Zeus::MpmcQueue<int>{1}.capacity(), 2U);
+    EXPECT_EQ(Zeus::MpmcQueue<int>{5}.capacity(), 8U);
+    EXPECT_EQ(Zeus::MpmcQueue<int>{64}.capacity(), 64U);
+}
+
+TEST(mpmc_queue_test, fifo_order) {
+    Zeus::MpmcQueue<int> queue{4};
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryPop().has_value());
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryEmplace(3));
+
+    EXPECT_EQ(queue.size(), 3U);
+    EXPECT_EQ(queue.tryPop(), 1);
+    EXPECT_EQ(queue.tryPop(), 2);
+    EXPECT_EQ(queue.tryPop(), 3);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(mpmc_queue_test, full_queue_rejects_push) {
+    Zeus::MpmcQueue<int> queue{4};
+
+    for (int value = 0; value < 4; ++value) {
+        EXPECT_TRUE(queue.tryPush(value));
+    }
+
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(queue.tryPop(), 0);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    for (int value = 1; value < 5; ++value) {
+        EXPECT_EQ(queue.tryPop(), value);
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpmc_queue_test, non_trivial_elements) {
+    auto shared = std::make_shared<int>(7);
+
+    {
+        Zeus::MpmcQueue<std::shared_ptr<int>> queue{8};
+
+        // Wrap around a few times so the destructor starts mid-buffer
+        for (int lap = 0; lap < 5; ++lap) {
+            EXPECT_TRUE(queue.tryPush(shared));
+            EXPECT_TRUE(queue.tryPush(shared));
+            EXPECT_TRUE(queue.tryPop().has_value());
+        }
+
+        EXPECT_EQ(shared.use_count(), 6);
+    }
+
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(mpmc_queue_test, stress) {
+    constexpr int producer_count = 4;
+    constexpr int consumer_count = 4;
+    constexpr Zeus::u64 per_producer = 25'000;
+    Zeus::MpmcQueue<Zeus::u64> queue{128};
+
+    std::atomic<Zeus::u64> popped{0};
+    std::atomic<Zeus::u64> sum{0};
+    std::vector<std::thread> threads;
+
+    for (int producer = 0; producer < producer_count; ++producer) {
+        threads.emplace_back([&queue, producer] {
+            // Tag each value with its producer so ordering can be checked
+            Zeus::u64 const tag = static_cast<Zeus::u64>(producer) << 32;
+
+            for (Zeus::u64 value = 0; value < per_producer;) {
+                if (queue.tryPush(tag | value)) {
+                    ++value;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::atomic<bool> in_order{true};
+
+    for (int consumer = 0; consumer < consumer_count; ++consumer) {
+        threads.emplace_back([&] {
+            std::vector<Zeus::u64> next(producer_count, 0);
+            Zeus::u64 local_sum = 0;
+
+            while (popped.load(std::memory_order_relaxed) <
+                   producer_count * per_producer) {
+                auto value = queue.tryPop();
+
+                if (!value) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                popped.fetch_add(1, std::memory_order_relaxed);
+
+                // Values from one producer arrive in order at each consumer
+                Zeus::u64 const producer = *value >> 32;
+                Zeus::u64 const sequence = *value & 0xFFFF'FFFF;
+
+                if (sequence < next[producer]) {
+                    in_order.store(false);
+                }
+
+                next[producer] = sequence + 1;
+                local_sum += sequence;
+            }
+
+            sum.fetch_add(local_sum);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(in_order.load());
+    EXPECT_EQ(popped.load(), producer_count * per_producer);
+    EXPECT_EQ(sum.load(),
+              producer_count * per_producer * (per_producer - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
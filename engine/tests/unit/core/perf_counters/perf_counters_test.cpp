@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "zeus/core/perf_counters.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for perf_counters.hpp
+ *
+ * The counters are not permitted on every machine, so the tests only check
+ * the values that were actually counted.
+ */
+namespace {
+
+using Zeus::Perf::Event;
+
+Zeus::u64 sumOf(std::vector<Zeus::u64> const& values) {
+    Zeus::u64 sum = 0;
+
+    for (Zeus::u64 const value : values) {
+        sum += value;
+    }
+
+    return sum;
+}
+
+TEST(perf_counters_test, event_names) {
+    EXPECT_EQ(Zeus::Perf::name(Event::Cycles), "cycles");
+    EXPECT_EQ(Zeus::Perf::name(Event::Instructions), "instructions");
+    EXPECT_EQ(Zeus::Perf::name(Event::CacheMisses), "cache-misses");
+    EXPECT_EQ(Zeus::Perf::name(Event::BranchMisses), "branch-misses");
+}
+
+TEST(perf_counters_test, ratios) {
+    Zeus::Perf::Counts counts;
+
+    EXPECT_EQ(counts.ipc(), 0.0);
+    EXPECT_EQ(counts.perElement(Event::CacheMisses), 0.0);
+
+    counts.values = {1000, 2500, 40, 8};
+    counts.available = {true, true, true, false};
+    counts.elements = 10;
+    counts.seconds = 1e-6;
+
+    EXPECT_DOUBLE_EQ(counts.ipc(), 2.5);
+    EXPECT_DOUBLE_EQ(counts.perElement(Event::CacheMisses), 4.0);
+    EXPECT_EQ(counts.perElement(Event::BranchMisses), 0.0);
+    EXPECT_DOUBLE_EQ(counts.nanosecondsPerElement(), 100.0);
+}
+
+TEST(perf_counters_test, availability_is_consistent) {
+    Zeus::Perf::CounterGroup const group;
+    bool any = false;
+
+    for (auto const event : {Event::Cycles, Event::Instructions,
+                             Event::CacheMisses, Event::BranchMisses}) {
+        any = any || group.isAvailable(event);
+    }
+
+    EXPECT_EQ(group.isAvailable(), any);
+
+    if (!group.isAvailable()) {
+        EXPECT_STRNE(group.error(), "");
+    }
+}
+
+TEST(perf_counters_test, scope_counts_work) {
+    Zeus::Perf::CounterGroup group;
+    std::vector<Zeus::u64> values(100'000, 3);
+    Zeus::Perf::Counts counts;
+
+    {
+        Zeus::Perf::Scope const scope{group, counts, values.size()};
+        EXPECT_EQ(sumOf(values), 300'000U);
+    }
+
+    EXPECT_EQ(counts.elements, values.size());
+    EXPECT_GT(counts.seconds, 0.0);
+
+    for (auto const event : {Event::Cycles, Event::Instructions,
+                             Event::CacheMisses, Event::BranchMisses}) {
+        EXPECT_EQ(counts.has(event), group.isAvailable(event));
+    }
+
+    // Summing 100000 values takes at least one instruction per value
+    if (counts.has(Event::Instructions)) {
+        EXPECT_GE(counts.perElement(Event::Instructions), 1.0);
+    }
+
+    if (counts.has(Event::Cycles)) {
+        EXPECT_GT(counts[Event::Cycles], 0U);
+    }
+}
+
+TEST(perf_counters_test, restart_resets) {
+    Zeus::Perf::CounterGroup group;
+    std::vector<Zeus::u64> values(100'000, 1);
+
+    group.start();
+    EXPECT_EQ(sumOf(values), 100'000U);
+    auto const large = group.stop(values.size());
+
+    group.start();
+    auto const empty = group.stop();
+
+    if (large.has(Event::Instructions)) {
+        EXPECT_LT(empty[Event::Instructions], large[Event::Instructions]);
+    }
+}
+
+}  // namespace
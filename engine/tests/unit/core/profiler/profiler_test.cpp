@@ -0,0 +1,241 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/profiler.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for profiler.hpp
+ */
+namespace {
+
+/**
+ * Starts every test with an empty, stopped profiler.
+ */
+class profiler_test : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        Zeus::Profiler::stop();
+        Zeus::Profiler::reset();
+    }
+
+    void TearDown() override {
+        Zeus::Profiler::stop();
+        Zeus::Profiler::reset();
+    }
+};
+
+Zeus::Profiler::ZoneStatistics const* findZone(
+    std::vector<Zeus::Profiler::ZoneStatistics> const& zones,
+    std::string const& name) {
+    auto const zone =
+        std::find_if(zones.begin(), zones.end(),
+                     [&name](auto const& zone) { return zone.name == name; });
+
+    return zone != zones.end() ? &*zone : nullptr;
+}
+
+std::string chromeTrace() {
+    std::ostringstream out;
+    Zeus::Profiler::writeChromeTrace(out);
+
+    return out.str();
+}
+
+void busyWait(Zeus::u64 ticks) {
+    Zeus::u64 const start = Zeus::Tsc::now();
+
+    while (Zeus::Tsc::now() - start < ticks) {
+    }
+}
+
+void profiledFunction() { ZEUS_PROFILE_FUNCTION(); }
+
+TEST_F(profiler_test, records_nothing_when_stopped) {
+    EXPECT_FALSE(Zeus::Profiler::isActive());
+
+    {
+        ZEUS_PROFILE_SCOPE("Stopped");
+    }
+
+    ZEUS_PROFILE_FRAME();
+    ZEUS_PROFILE_COUNTER("Counter", 1);
+
+    EXPECT_TRUE(Zeus::Profiler::zoneStatistics().empty());
+    EXPECT_EQ(Zeus::Profiler::frameStatistics().count, 0U);
+    EXPECT_EQ(chromeTrace().find("Stopped"), std::string::npos);
+}
+
+TEST_F(profiler_test, nested_zones) {
+    Zeus::Profiler::start();
+    EXPECT_TRUE(Zeus::Profiler::isActive());
+
+    for (int i = 0; i < 3; ++i) {
+        ZEUS_PROFILE_SCOPE("Outer");
+        busyWait(10'000);
+
+        {
+            ZEUS_PROFILE_SCOPE("Inner");
+            busyWait(10'000);
+        }
+
+        profiledFunction();
+    }
+
+    Zeus::Profiler::stop();
+
+    auto const zones = Zeus::Profiler::zoneStatistics();
+    auto const* outer = findZone(zones, "Outer");
+    auto const* inner = findZone(zones, "Inner");
+    auto const* function = findZone(zones, "profiledFunction");
+
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    ASSERT_NE(function, nullptr);
+
+    EXPECT_EQ(outer->count, 3U);
+    EXPECT_EQ(inner->count, 3U);
+    EXPECT_EQ(function->count, 3U);
+
+    // The outer zone contains the others, so it comes first
+    EXPECT_EQ(zones.front().name, "Outer");
+    EXPECT_GT(outer->total_ms, inner->total_ms);
+    EXPECT_NEAR(outer->self_ms,
+                outer->total_ms - inner->total_ms - function->total_ms, 1e-9);
+    EXPECT_DOUBLE_EQ(inner->self_ms, inner->total_ms);
+    EXPECT_LE(inner->min_ms, inner->max_ms);
+}
+
+TEST_F(profiler_test, zones_open_at_stop_are_recorded) {
+    Zeus::Profiler::start();
+
+    {
+        ZEUS_PROFILE_SCOPE("Open");
+        Zeus::Profiler::stop();
+
+        ZEUS_PROFILE_SCOPE("After stop");
+    }
+
+    auto const zones = Zeus::Profiler::zoneStatistics();
+
+    ASSERT_EQ(zones.size(), 1U);
+    EXPECT_EQ(zones.front().name, "Open");
+}
+
+TEST_F(profiler_test, frames) {
+    Zeus::Profiler::start();
+
+    for (int i = 0; i < 5; ++i) {
+        ZEUS_PROFILE_FRAME();
+        busyWait(10'000);
+    }
+
+    Zeus::Profiler::stop();
+
+    auto const frames = Zeus::Profiler::frameStatistics();
+
+    EXPECT_EQ(frames.count, 4U);
+    EXPECT_GT(frames.mean_ms, 0.0);
+    EXPECT_LE(frames.min_ms, frames.mean_ms);
+    EXPECT_GE(frames.max_ms, frames.mean_ms);
+}
+
+TEST_F(profiler_test, many_zones_span_chunks) {
+    constexpr Zeus::u64 zone_count = 5000;
+
+    Zeus::Profiler::start();
+
+    for (Zeus::u64 i = 0; i < zone_count; ++i) {
+        ZEUS_PROFILE_SCOPE("Small");
+    }
+
+    Zeus::Profiler::stop();
+
+    auto const zones = Zeus::Profiler::zoneStatistics();
+
+    ASSERT_EQ(zones.size(), 1U);
+    EXPECT_EQ(zones.front().count, zone_count);
+    EXPECT_EQ(Zeus::Profiler::droppedCount(), 0U);
+
+    Zeus::Profiler::reset();
+
+    EXPECT_TRUE(Zeus::Profiler::zoneStatistics().empty());
+}
+
+TEST_F(profiler_test, chrome_trace) {
+    Zeus::Profiler::setThreadName("Main \"thread\"");
+    Zeus::Profiler::start();
+
+    {
+        ZEUS_PROFILE_SCOPE("Update");
+        ZEUS_PROFILE_COUNTER("Entities", 42);
+    }
+
+    ZEUS_PROFILE_FRAME();
+    Zeus::Profiler::stop();
+
+    std::string const trace = chromeTrace();
+
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0),
+              0U);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"Main \\\"thread\\\"\"}"),
+              std::string::npos);
+    EXPECT_NE(trace.find("{\"name\":\"Update\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"C\",\"args\":{\"value\":42.000}"),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"i\""), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+    std::ostringstream statistics;
+    Zeus::Profiler::writeStatistics(statistics);
+
+    EXPECT_NE(statistics.str().find("Update"), std::string::npos);
+}
+
+TEST_F(profiler_test, threads_record_separately) {
+    constexpr int thread_count = 4;
+    constexpr Zeus::u64 zones_per_thread = 2000;
+
+    Zeus::Profiler::start();
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([t] {
+            Zeus::Profiler::setThreadName("Worker " + std::to_string(t));
+
+            for (Zeus::u64 i = 0; i < zones_per_thread; ++i) {
+                ZEUS_PROFILE_SCOPE("Work");
+            }
+        });
+    }
+
+    // Export while the workers are still recording
+    static_cast<void>(chromeTrace());
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Zeus::Profiler::stop();
+
+    auto const zones = Zeus::Profiler::zoneStatistics();
+    std::string const trace = chromeTrace();
+
+    ASSERT_EQ(zones.size(), 1U);
+    EXPECT_EQ(zones.front().count, thread_count * zones_per_thread);
+    EXPECT_NE(trace.find("Worker 3"), std::string::npos);
+
+    // Buffers of exited threads are released by the next reset
+    Zeus::Profiler::reset();
+
+    EXPECT_TRUE(Zeus::Profiler::zoneStatistics().empty());
+}
+
+}  // namespace
@@ -0,0 +1,169 @@
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zeus/core/spsc_queue.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for spsc_queue.hpp
+ */
+namespace {
+
+TEST(spsc_queue_test, capacity_is_power_of_two) {
+    EXPECT_EQ(Zeus::SpscQueue<int>{0}.capacity(), 2U);
+    EXPECT_EQ(Zeus::SpscQueue<int>{2}.capacity(), 2U);
+    EXPECT_EQ(Zeus::SpscQueue<int>{3}.capacity(), 4U);
+    EXPECT_EQ(Zeus::SpscQueue<int>{1000}.capacity(), 1024U);
+}
+
+TEST(spsc_queue_test, fifo_order) {
+    Zeus::SpscQueue<int> queue{4};
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryPop().has_value());
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryEmplace(3));
+
+    EXPECT_EQ(queue.size(), 3U);
+    EXPECT_EQ(queue.tryPop(), 1);
+    EXPECT_EQ(queue.tryPop(), 2);
+    EXPECT_EQ(queue.tryPop(), 3);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(spsc_queue_test, full_queue_rejects_push) {
+    Zeus::SpscQueue<int> queue{4};
+
+    for (int value = 0; value < 4; ++value) {
+        EXPECT_TRUE(queue.tryPush(value));
+    }
+
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(queue.tryPop(), 0);
+    EXPECT_TRUE(queue.tryPush(4));
+    EXPECT_EQ(queue.size(), 4U);
+}
+
+TEST(spsc_queue_test, wraps_around) {
+    Zeus::SpscQueue<int> queue{4};
+
+    for (int value = 0; value < 100; ++value) {
+        EXPECT_TRUE(queue.tryPush(value));
+        EXPECT_TRUE(queue.tryPush(value + 1000));
+        EXPECT_EQ(queue.tryPop(), value);
+        EXPECT_EQ(queue.tryPop(), value + 1000);
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue_test, pop_batch) {
+    Zeus::SpscQueue<int> queue{8};
+
+    for (int value = 0; value < 6; ++value) {
+        EXPECT_TRUE(queue.tryPush(value));
+    }
+
+    std::vector<int> out(8, -1);
+
+    EXPECT_EQ(queue.popBatch(out.begin(), 4), 4U);
+    EXPECT_EQ(queue.popBatch(out.begin() + 4, 4), 2U);
+    EXPECT_EQ(queue.popBatch(out.begin(), 4), 0U);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4, 5, -1, -1}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue_test, non_trivial_elements) {
+    auto shared = std::make_shared<int>(7);
+
+    {
+        Zeus::SpscQueue<std::shared_ptr<int>> queue{4};
+
+        EXPECT_TRUE(queue.tryPush(shared));
+        EXPECT_TRUE(queue.tryPush(shared));
+        EXPECT_TRUE(queue.tryPush(shared));
+        EXPECT_EQ(shared.use_count(), 4);
+
+        EXPECT_EQ(*queue.tryPop().value(), 7);
+        EXPECT_EQ(shared.use_count(), 3);
+    }
+
+    // The queue destroys the elements it still holds
+    EXPECT_EQ(shared.use_count(), 1);
+
+    Zeus::SpscQueue<std::string> strings{2};
+    std::string const text(100, 'x');
+
+    EXPECT_TRUE(strings.tryPush(text));
+    EXPECT_EQ(strings.tryPop(), text);
+}
+
+TEST(spsc_queue_test, stress) {
+    constexpr Zeus::u64 count = 200'000;
+    Zeus::SpscQueue<Zeus::u64> queue{64};
+
+    std::thread producer{[&queue] {
+        for (Zeus::u64 value = 0; value < count;) {
+            if (queue.tryPush(value)) {
+                ++value;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    Zeus::u64 expected = 0;
+    Zeus::u64 buffer[16];
+
+    while (expected < count) {
+        std::size_t const popped = queue.popBatch(buffer, 16);
+
+        if (popped == 0) {
+            std::this_thread::yield();
+        }
+
+        for (std::size_t index = 0; index < popped; ++index) {
+            ASSERT_EQ(buffer[index], expected);
+            ++expected;
+        }
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue_test, stress_non_trivial) {
+    constexpr int count = 20'000;
+    Zeus::SpscQueue<std::unique_ptr<int>> queue{16};
+
+    std::thread producer{[&queue] {
+        for (int value = 0; value < count;) {
+            if (queue.tryEmplace(std::make_unique<int>(value))) {
+                ++value;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    for (int expected = 0; expected < count;) {
+        if (auto value = queue.tryPop()) {
+            ASSERT_EQ(**value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+}
+
+}  // namespace
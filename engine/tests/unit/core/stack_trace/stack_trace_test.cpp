@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "zeus/core/assert.hpp"
+#include "zeus/core/stack_trace.hpp"
+
+/**
+ * Tests for stack_trace.hpp
+ */
+
+// Outside of the anonymous namespace so the functions are exported by name
+ZEUS_NOINLINE std::string zeusStackTraceInner() {
+    return Zeus::StackTrace::current();
+}
+
+ZEUS_NOINLINE std::string zeusStackTraceOuter() {
+    std::string trace = zeusStackTraceInner();
+
+    // Keeps this frame from becoming a tail call
+    trace += ' ';
+
+    return trace;
+}
+
+namespace {
+
+TEST(stack_trace_test, capture_records_frames) {
+    std::array<void*, Zeus::StackTrace::max_frames> frames{};
+
+    std::size_t const size =
+        Zeus::StackTrace::capture(frames.data(), frames.size());
+    std::size_t const skipped =
+        Zeus::StackTrace::capture(frames.data(), frames.size(), 1);
+
+    EXPECT_GT(size, 1U);
+    EXPECT_EQ(skipped + 1, size);
+}
+
+TEST(stack_trace_test, symbolize_names_callers) {
+    std::string const trace = zeusStackTraceOuter();
+
+    std::size_t const inner = trace.find("zeusStackTraceInner");
+    std::size_t const outer = trace.find("zeusStackTraceOuter");
+
+    ASSERT_NE(inner, std::string::npos) << trace;
+    ASSERT_NE(outer, std::string::npos) << trace;
+    EXPECT_LT(inner, outer);
+    EXPECT_EQ(trace.rfind("#0 0x", 0), 0U);
+}
+
+TEST(stack_trace_test, raw_trace_has_offsets_and_build_ids) {
+    std::array<char, 32> name{"/tmp/zeus_trace_XXXXXX"};
+    int const file_descriptor = mkstemp(name.data());
+
+    std::array<void*, Zeus::StackTrace::max_frames> frames{};
+    std::size_t const size =
+        Zeus::StackTrace::capture(frames.data(), frames.size());
+
+    Zeus::StackTrace::prepare();
+    Zeus::StackTrace::writeRaw(file_descriptor, frames.data(), size);
+    close(file_descriptor);
+
+    std::ifstream file{name.data()};
+    std::stringstream stream;
+    stream << file.rdbuf();
+    std::remove(name.data());
+
+    std::string const trace = stream.str();
+
+    EXPECT_NE(trace.find("#0 0x"), std::string::npos) << trace;
+    EXPECT_NE(trace.find("stack_trace_test+0x"), std::string::npos) << trace;
+    EXPECT_NE(trace.find("build-id "), std::string::npos) << trace;
+}
+
+TEST(stack_trace_death_test, fatal_signal_reports_trace) {
+    EXPECT_DEATH(
+        {
+            Zeus::StackTrace::installCrashHandlers();
+            std::raise(SIGSEGV);
+        },
+        "Signal: SIGSEGV \\(11\\)\n(.|\n)*Stack trace:\n#0 0x");
+}
+
+TEST(stack_trace_death_test, assertion_reports_trace_once) {
+    EXPECT_DEATH(
+        {
+            Zeus::StackTrace::installCrashHandlers();
+            ZEUS_ASSERT_ALWAYS(false);
+        },
+        "Stack trace:\n#0 0x(.|\n)*Signal: SIGABRT \\(6\\)\n=+\n$");
+}
+
+}  // namespace
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "zeus/core/string_id.hpp"
+
+/**
+ * Tests for string_id.hpp
+ */
+namespace {
+
+using namespace Zeus::Literals;
+
+TEST(string_id_test, hash_is_fnv1a) {
+    static_assert(Zeus::StringId::hash("") == 0xcbf29ce484222325U);
+    static_assert(Zeus::StringId::hash("a") == 0xaf63dc4c8601ec8cU);
+    static_assert("player"_sid.value() == 0x4580fab03b7eb9c0U);
+
+    static_assert(!Zeus::StringId{});
+    static_assert(Zeus::StringId{""});
+}
+
+TEST(string_id_test, literal_and_runtime_ids_match) {
+    std::string const runtime{"player"};
+
+    EXPECT_EQ(Zeus::StringId{runtime}, "player"_sid);
+    EXPECT_EQ(Zeus::StringId::intern(runtime), "player"_sid);
+    EXPECT_EQ(ZEUS_SID("player"), "player"_sid);
+    EXPECT_NE("enemy"_sid, "player"_sid);
+}
+
+TEST(string_id_test, interned_names_round_trip) {
+    std::string text{"interned name"};
+    Zeus::StringId const id = Zeus::StringId::intern(text);
+
+    // The table keeps its own copy
+    text.assign("something else!");
+
+    EXPECT_EQ(id.name(), "interned name");
+    EXPECT_EQ("never interned"_sid.name(), "");
+}
+
+TEST(string_id_test, sid_is_a_constant_expression) {
+    constexpr Zeus::StringId id = ZEUS_SID("constant");
+
+    static_assert(id == "constant"_sid);
+    static_assert(std::integral_constant<Zeus::StringId::value_type,
+                                         ZEUS_SID("template").value()>::value ==
+                  "template"_sid.value());
+
+    switch ("constant"_sid.value()) {
+        case ZEUS_SID("constant").value():
+            SUCCEED();
+            break;
+        default:
+            FAIL();
+    }
+}
+
+TEST(string_id_test, debug_literals_are_reversible) {
+    // Registered before main() even when only used at compile time
+    constexpr Zeus::StringId id = ZEUS_SID("compile time literal");
+
+#ifdef ZEUS_DEBUG
+    EXPECT_EQ(ZEUS_SID("debug literal").name(), "debug literal");
+    EXPECT_EQ(id.name(), "compile time literal");
+#else
+    EXPECT_EQ(ZEUS_SID("release literal").name(), "");
+    EXPECT_EQ(id.name(), "");
+#endif
+}
+
+TEST(string_id_test, concurrent_interning) {
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                std::string const name = "thread name " + std::to_string(i);
+                EXPECT_EQ(Zeus::StringId::intern(name).name(), name);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(Zeus::StringId{"thread name 999"}.name(), "thread name 999");
+}
+
+TEST(string_id_test, long_strings) {
+    std::string const text(100000, 'x');
+
+    EXPECT_EQ(Zeus::StringId::intern(text).name(), text);
+}
+
+TEST(string_id_test, hash_map_keys) {
+    std::unordered_map<Zeus::StringId, int> values;
+    values["a"_sid] = 1;
+    values["b"_sid] = 2;
+
+    EXPECT_EQ(values.at(Zeus::StringId{std::string{"b"}}), 2);
+}
+
+TEST(string_id_test, format) {
+    Zeus::StringId const id = Zeus::StringId::intern("formatted");
+
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", id), "formatted");
+    EXPECT_EQ(ZEUS_FORMAT(64, "{}", Zeus::StringId::fromValue(42)), "#42");
+}
+
+}  // namespace
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+#include "zeus/core/tsc.hpp"
+#include "zeus/core/types.hpp"
+
+/**
+ * Tests for tsc.hpp
+ */
+namespace {
+
+TEST(tsc_test, never_goes_backwards) {
+    Zeus::u64 previous = Zeus::Tsc::now();
+
+    for (int i = 0; i < 1000; ++i) {
+        Zeus::u64 const current = Zeus::Tsc::now();
+
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+}
+
+TEST(tsc_test, measures_sleeps) {
+    EXPECT_GT(Zeus::Tsc::ticksPerSecond(), 0.0);
+
+    Zeus::u64 const start = Zeus::Tsc::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    Zeus::f64 const elapsed = Zeus::Tsc::toSeconds(Zeus::Tsc::now() - start);
+
+    // Sleeps can overshoot by a lot on a busy machine but never undershoot
+    EXPECT_GE(elapsed, 0.019);
+    EXPECT_LT(elapsed, 1.0);
+}
+
+}  // namespace
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "zeus/ecs/archetype.hpp"
+#include "zeus/ecs/component.hpp"
+#include "zeus/ecs/entity.hpp"
+#include "zeus/ecs/transform.hpp"
+
+/**
+ * Tests for archetype.hpp
+ */
+namespace {
+
+using Zeus::u32;
+using Zeus::Ecs::Archetype;
+using Zeus::Ecs::Entity;
+using Zeus::Ecs::Transform;
+
+struct Health {
+    int value;
+};
+
+/**
+ * A component with a destructor, counting the live instances.
+ */
+struct Tracked {
+    static inline int live = 0;
+
+    explicit Tracked(int value) : value{std::make_unique<int>(value)} {
+        ++live;
+    }
+
+    Tracked(Tracked&& other) noexcept : value{std::move(other.value)} {
+        ++live;
+    }
+
+    Tracked& operator=(Tracked&&) = delete;
+
+    ~Tracked() { --live; }
+
+    std::unique_ptr<int> value;
+};
+
+TEST(archetype_test, layout) {
+    Archetype const archetype{
+        Zeus::Ecs::componentMask<Transform, Health>()};
+
+    EXPECT_TRUE(archetype.has(Zeus::Ecs::componentId<Transform>()));
+    EXPECT_TRUE(archetype.has(Zeus::Ecs::componentId<Health>()));
+    EXPECT_FALSE(archetype.has(Zeus::Ecs::componentId<Tracked>()));
+    EXPECT_EQ(archetype.size(), 0);
+    EXPECT_EQ(archetype.chunkCount(), 0);
+
+    // 8 byte entities, 36 byte transforms and 4 byte healths fill most of a
+    // 16 KiB chunk
+    EXPECT_GE(archetype.capacity(), 320);
+    EXPECT_LE(archetype.capacity(), 16 * 1024 / 48);
+}
+
+TEST(archetype_test, columns_are_cache_line_aligned) {
+    Archetype archetype{Zeus::Ecs::componentMask<Transform, Health>()};
+    archetype.allocate(Entity{0, 1});
+
+    auto const address = [](void const* pointer) {
+        return reinterpret_cast<std::uintptr_t>(pointer);
+    };
+
+    EXPECT_EQ(address(archetype.entities(0)) % 64, 0);
+    EXPECT_EQ(address(archetype.column<Transform>(0)) % 64, 0);
+    EXPECT_EQ(address(archetype.column<Health>(0)) % 64, 0);
+
+    archetype.remove(0, false);
+}
+
+TEST(archetype_test, chunks_fill_up) {
+    Archetype archetype{Zeus::Ecs::componentMask<Health>()};
+    u32 const capacity = archetype.capacity();
+
+    for (u32 i = 0; i <= capacity; ++i) {
+        u32 const row = archetype.allocate(Entity{i, 1});
+        ::new (archetype.component(Zeus::Ecs::componentId<Health>(), row))
+            Health{static_cast<int>(i)};
+
+        EXPECT_EQ(row, i);
+    }
+
+    EXPECT_EQ(archetype.chunkCount(), 2);
+    EXPECT_EQ(archetype.chunk(0).count, capacity);
+    EXPECT_EQ(archetype.chunk(1).count, 1);
+    EXPECT_EQ(archetype.column<Health>(1)[0].value,
+              static_cast<int>(capacity));
+    EXPECT_EQ(archetype.entity(capacity), (Entity{capacity, 1}));
+}
+
+TEST(archetype_test, remove_moves_the_last_row) {
+    Archetype archetype{Zeus::Ecs::componentMask<Health>()};
+
+    for (u32 i = 0; i < 3; ++i) {
+        u32 const row = archetype.allocate(Entity{i, 1});
+        ::new (archetype.component(Zeus::Ecs::componentId<Health>(), row))
+            Health{static_cast<int>(i * 10)};
+    }
+
+    EXPECT_EQ(archetype.remove(0, true), (Entity{2, 1}));
+    EXPECT_EQ(archetype.size(), 2);
+    EXPECT_EQ(archetype.entity(0), (Entity{2, 1}));
+    EXPECT_EQ(archetype.column<Health>(0)[0].value, 20);
+
+    // Removing the last row moves nothing
+    EXPECT_FALSE(archetype.remove(1, true));
+    EXPECT_EQ(archetype.size(), 1);
+}
+
+TEST(archetype_test, destroys_components) {
+    {
+        Archetype archetype{Zeus::Ecs::componentMask<Tracked>()};
+
+        for (u32 i = 0; i < 4; ++i) {
+            u32 const row = archetype.allocate(Entity{i, 1});
+            ::new (archetype.component(Zeus::Ecs::componentId<Tracked>(), row))
+                Tracked{static_cast<int>(i)};
+        }
+
+        EXPECT_EQ(Tracked::live, 4);
+
+        archetype.remove(1, true);
+
+        EXPECT_EQ(Tracked::live, 3);
+        EXPECT_EQ(*archetype.column<Tracked>(0)[1].value, 3);
+    }
+
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(archetype_test, empty_chunks_are_freed) {
+    Archetype archetype{Zeus::Ecs::componentMask<Health>()};
+    u32 const count = archetype.capacity() * 3;
+
+    for (u32 i = 0; i < count; ++i) {
+        archetype.allocate(Entity{i, 1});
+    }
+
+    EXPECT_EQ(archetype.chunkCount(), 3);
+
+    while (archetype.size() > 0) {
+        archetype.remove(archetype.size() - 1, false);
+    }
+
+    // One empty chunk is kept for reuse
+    EXPECT_EQ(archetype.chunkCount(), 1);
+}
+
+}  // namespace
@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+#include "zeus/ecs/entity.hpp"
+#include "zeus/ecs/query.hpp"
+#include "zeus/ecs/transform.hpp"
+#include "zeus/ecs/world.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * Tests for query.hpp
+ */
+namespace {
+
+using Zeus::u32;
+using Zeus::Ecs::Entity;
+using Zeus::Ecs::Query;
+using Zeus::Ecs::Transform;
+using Zeus::Ecs::World;
+using Zeus::Math::Vector3D;
+
+struct Velocity {
+    Vector3D value;
+};
+
+struct Frozen {};
+
+TEST(query_test, matches_supersets) {
+    World world;
+
+    world.create(Transform{});
+    world.create(Transform{}, Velocity{});
+    world.create(Velocity{});
+    world.create(Frozen{}, Velocity{}, Transform{});
+
+    Query<Transform, Velocity const> query{world};
+
+    EXPECT_EQ(query.count(), 2);
+}
+
+TEST(query_test, sees_new_archetypes) {
+    World world;
+    Query<Velocity> query{world};
+
+    EXPECT_EQ(query.count(), 0);
+
+    world.create(Velocity{});
+    Entity const entity = world.create(Transform{});
+    world.add<Velocity>(entity);
+
+    EXPECT_EQ(query.count(), 2);
+}
+
+TEST(query_test, each) {
+    World world;
+
+    for (int i = 0; i < 1000; ++i) {
+        world.create(Transform{},
+                     Velocity{{static_cast<float>(i), 0.0F, 0.0F}});
+    }
+
+    Query<Transform, Velocity const> query{world};
+
+    query.each([](Transform& transform, Velocity const& velocity) {
+        transform.position += velocity.value;
+    });
+
+    float sum = 0.0F;
+
+    query.each([&sum](Transform const& transform, Velocity const&) {
+        sum += transform.position.x;
+    });
+
+    EXPECT_EQ(sum, 999.0F * 1000.0F / 2.0F);
+}
+
+TEST(query_test, each_with_entity) {
+    World world;
+    Entity const entity = world.create(Velocity{});
+
+    Query<Velocity> query{world};
+    std::vector<Entity> seen;
+
+    query.each([&seen](Entity current, Velocity&) { seen.push_back(current); });
+
+    ASSERT_EQ(seen.size(), 1);
+    EXPECT_EQ(seen.front(), entity);
+}
+
+TEST(query_test, each_chunk) {
+    World world;
+
+    for (int i = 0; i < 2000; ++i) {
+        world.create(Velocity{});
+    }
+
+    Query<Velocity> query{world};
+    u32 total = 0;
+    u32 chunks = 0;
+
+    query.eachChunk([&](u32 count, Entity const* entities, Velocity* values) {
+        EXPECT_NE(entities, nullptr);
+        EXPECT_NE(values, nullptr);
+        total += count;
+        ++chunks;
+    });
+
+    EXPECT_EQ(total, 2000);
+    EXPECT_GT(chunks, 1);
+}
+
+TEST(query_test, parallel_each) {
+    Zeus::Job::System jobs{4, Zeus::Job::Affinity::Unpinned};
+    World world;
+
+    for (int i = 0; i < 10'000; ++i) {
+        world.create(Transform{}, Velocity{{1.0F, 2.0F, 3.0F}});
+    }
+
+    Query<Transform, Velocity const> query{world};
+    std::atomic<u32> visited{0};
+
+    query.parallelEach(jobs, [&visited](Transform& transform,
+                                        Velocity const& velocity) {
+        transform.position += velocity.value;
+        visited.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    EXPECT_EQ(visited.load(), 10'000);
+
+    query.each([](Transform const& transform, Velocity const&) {
+        EXPECT_EQ(transform.position.z, 3.0F);
+    });
+}
+
+TEST(query_test, access) {
+    using Move = Query<Transform, Velocity const>;
+
+    EXPECT_EQ(Move::writes(), Zeus::Ecs::componentMask<Transform>());
+    EXPECT_EQ(Move::reads(), Zeus::Ecs::componentMask<Velocity>());
+}
+
+}  // namespace
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "zeus/core/profiler.hpp"
+#include "zeus/ecs/query.hpp"
+#include "zeus/ecs/schedule.hpp"
+#include "zeus/ecs/transform.hpp"
+#include "zeus/ecs/world.hpp"
+#include "zeus/job/job_system.hpp"
+
+/**
+ * Tests for schedule.hpp
+ */
+namespace {
+
+using Zeus::Ecs::Query;
+using Zeus::Ecs::Schedule;
+using Zeus::Ecs::Transform;
+using Zeus::Ecs::World;
+using Zeus::Math::Vector3D;
+
+struct Velocity {
+    Vector3D value;
+};
+
+struct Health {
+    int value;
+};
+
+TEST(schedule_test, stages_follow_access) {
+    World world;
+    Schedule schedule{world};
+
+    auto const nothing = [](auto&) {};
+
+    // Reads velocities and writes transforms
+    schedule.add<Transform, Velocity const>("Move", nothing);
+
+    // Only reads transforms, conflicts with Move
+    schedule.add<Transform const>("Render", nothing);
+
+    // Touches neither, runs next to Move
+    schedule.add<Health>("Regenerate", nothing);
+
+    // Reads what Move reads, runs next to Move
+    schedule.add<Velocity const>("Audio", nothing);
+
+    // Writes what Audio reads, after it
+    schedule.add<Velocity>("Damp", nothing);
+
+    EXPECT_EQ(schedule.systemCount(), 5);
+    EXPECT_EQ(schedule.stageOf(0), 0);
+    EXPECT_EQ(schedule.stageOf(1), 1);
+    EXPECT_EQ(schedule.stageOf(2), 0);
+    EXPECT_EQ(schedule.stageOf(3), 0);
+    EXPECT_EQ(schedule.stageOf(4), 1);
+    EXPECT_EQ(schedule.stageCount(), 2);
+    EXPECT_EQ(schedule.name(4), "Damp");
+}
+
+TEST(schedule_test, exclusive_systems_run_alone) {
+    World world;
+    Schedule schedule{world};
+
+    auto const nothing = [](auto&) {};
+
+    schedule.add<Health>("Before", nothing);
+    schedule.addExclusive("Spawn", nothing);
+    schedule.add<Velocity const>("After", nothing);
+
+    EXPECT_EQ(schedule.stageOf(0), 0);
+    EXPECT_EQ(schedule.stageOf(1), 1);
+    EXPECT_EQ(schedule.stageOf(2), 2);
+}
+
+TEST(schedule_test, run) {
+    Zeus::Job::System jobs{4, Zeus::Job::Affinity::Unpinned};
+    World world;
+    Schedule schedule{world};
+
+    for (int i = 0; i < 1000; ++i) {
+        world.create(Transform{}, Velocity{{1.0F, 0.0F, 0.0F}}, Health{0});
+    }
+
+    std::atomic<int> spawned{0};
+
+    schedule.addExclusive("Spawn", [&spawned](World& current) {
+        current.create(Transform{}, Velocity{{1.0F, 0.0F, 0.0F}}, Health{0});
+        spawned.fetch_add(1);
+    });
+
+    schedule.add<Transform, Velocity const>(
+        "Move", [&jobs](Query<Transform, Velocity const>& query) {
+            query.parallelEach(jobs, [](Transform& transform,
+                                        Velocity const& velocity) {
+                transform.position += velocity.value;
+            });
+        });
+
+    schedule.add<Health>("Regenerate", [](Query<Health>& query) {
+        query.each([](Health& health) { ++health.value; });
+    });
+
+    for (int frame = 0; frame < 3; ++frame) {
+        schedule.run(jobs);
+    }
+
+    schedule.run();
+
+    EXPECT_EQ(spawned.load(), 4);
+    EXPECT_EQ(world.entityCount(), 1004);
+
+    // Spawned entities miss the runs before they were created, but every
+    // entity moved and regenerated the same number of times
+    Query<Transform const, Health const> check{world};
+    int regenerated = 0;
+
+    check.each([&](Transform const& transform, Health const& health) {
+        EXPECT_EQ(transform.position.x, static_cast<float>(health.value));
+        regenerated += health.value;
+    });
+
+    EXPECT_EQ(regenerated, 1000 * 4 + 4 + 3 + 2 + 1);
+}
+
+TEST(schedule_test, systems_profile_under_their_names) {
+    World world;
+    Schedule schedule{world};
+
+    auto const nothing = [](auto&) {};
+
+    schedule.add<Transform>("Move", nothing);
+    schedule.add<Health>("Regenerate", nothing);
+
+    Zeus::Profiler::reset();
+    Zeus::Profiler::start();
+    schedule.run();
+    Zeus::Profiler::stop();
+
+    auto const zones = Zeus::Profiler::zoneStatistics();
+    Zeus::Profiler::reset();
+
+    auto const has_zone = [&zones](std::string const& name) {
+        return std::any_of(zones.begin(), zones.end(),
+                           [&name](auto const& zone) {
+                               return zone.name == name && zone.count == 1;
+                           });
+    };
+
+    EXPECT_EQ(zones.size(), 2U);
+    EXPECT_TRUE(has_zone("Move"));
+    EXPECT_TRUE(has_zone("Regenerate"));
+}
+
+}  // namespace
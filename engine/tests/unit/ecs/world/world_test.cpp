@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "zeus/ecs/entity.hpp"
+#include "zeus/ecs/transform.hpp"
+#include "zeus/ecs/world.hpp"
+
+/**
+ * Tests for world.hpp
+ */
+namespace {
+
+using Zeus::Ecs::Entity;
+using Zeus::Ecs::Transform;
+using Zeus::Ecs::World;
+using Zeus::Math::Vector3D;
+
+struct Velocity {
+    Vector3D value;
+};
+
+struct Health {
+    int value;
+};
+
+struct Name {
+    std::unique_ptr<char const*> text;
+};
+
+struct Throwing {
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("fail");
+        }
+    }
+};
+
+TEST(world_test, create_and_destroy) {
+    World world;
+
+    Entity const first = world.create();
+    Entity const second = world.create(Health{10});
+
+    EXPECT_TRUE(first);
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(world.isAlive(first));
+    EXPECT_TRUE(world.isAlive(second));
+    EXPECT_EQ(world.entityCount(), 2);
+
+    world.destroy(first);
+
+    EXPECT_FALSE(world.isAlive(first));
+    EXPECT_TRUE(world.isAlive(second));
+    EXPECT_EQ(world.entityCount(), 1);
+
+    // Destroying twice does nothing
+    world.destroy(first);
+
+    EXPECT_EQ(world.entityCount(), 1);
+    EXPECT_FALSE(world.isAlive(Entity{}));
+}
+
+TEST(world_test, reused_indices_get_a_new_generation) {
+    World world;
+
+    Entity const old = world.create(Health{1});
+    world.destroy(old);
+    Entity const reused = world.create(Health{2});
+
+    EXPECT_EQ(reused.index(), old.index());
+    EXPECT_NE(reused.generation(), old.generation());
+    EXPECT_FALSE(world.isAlive(old));
+    EXPECT_EQ(world.get<Health>(old), nullptr);
+    EXPECT_EQ(world.get<Health>(reused)->value, 2);
+}
+
+TEST(world_test, components) {
+    World world;
+
+    Entity const entity = world.create(
+        Transform{{1.0F, 2.0F, 3.0F}, {}, {1.0F, 1.0F, 1.0F}}, Health{5});
+
+    ASSERT_NE(world.get<Transform>(entity), nullptr);
+    EXPECT_EQ(world.get<Transform>(entity)->position.y, 2.0F);
+    EXPECT_EQ(world.get<Health>(entity)->value, 5);
+    EXPECT_TRUE(world.has<Health>(entity));
+    EXPECT_FALSE(world.has<Velocity>(entity));
+    EXPECT_EQ(world.get<Velocity>(entity), nullptr);
+
+    world.get<Health>(entity)->value = 6;
+
+    EXPECT_EQ(world.get<Health>(entity)->value, 6);
+}
+
+TEST(world_test, add_and_remove_components) {
+    World world;
+
+    Entity const entity = world.create(Health{5});
+    Velocity& velocity = world.add<Velocity>(entity, Vector3D{1, 0, 0});
+
+    EXPECT_EQ(velocity.value.x, 1.0F);
+    EXPECT_TRUE(world.has<Velocity>(entity));
+
+    // Moving to another archetype keeps the other components
+    EXPECT_EQ(world.get<Health>(entity)->value, 5);
+
+    // Adding an existing component replaces it
+    world.add<Health>(entity, 7);
+
+    EXPECT_EQ(world.get<Health>(entity)->value, 7);
+
+    EXPECT_TRUE(world.remove<Health>(entity));
+    EXPECT_FALSE(world.has<Health>(entity));
+    EXPECT_EQ(world.get<Velocity>(entity)->value.x, 1.0F);
+    EXPECT_FALSE(world.remove<Health>(entity));
+}
+
+TEST(world_test, archetypes_are_shared) {
+    World world;
+
+    world.create(Health{1}, Velocity{});
+    world.create(Velocity{}, Health{2});
+
+    std::size_t const count = world.archetypeCount();
+
+    Entity const entity = world.create(Health{3});
+    world.add<Velocity>(entity);
+
+    // The empty archetype, {Health, Velocity} and {Health}
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(world.archetypeCount(), 3);
+}
+
+TEST(world_test, removal_keeps_other_entities) {
+    World world;
+    std::vector<Entity> entities;
+
+    for (int i = 0; i < 1000; ++i) {
+        entities.push_back(world.create(Health{i}));
+    }
+
+    for (int i = 0; i < 1000; i += 3) {
+        world.destroy(entities[i]);
+    }
+
+    for (int i = 1; i < 1000; i += 3) {
+        world.add<Velocity>(entities[i]);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_FALSE(world.isAlive(entities[i]));
+        } else {
+            ASSERT_NE(world.get<Health>(entities[i]), nullptr);
+            EXPECT_EQ(world.get<Health>(entities[i])->value, i);
+            EXPECT_EQ(world.has<Velocity>(entities[i]), i % 3 == 1);
+        }
+    }
+}
+
+TEST(world_test, non_trivial_components) {
+    World world;
+
+    Entity const first = world.create(Name{std::make_unique<char const*>("a")});
+    Entity const second =
+        world.create(Name{std::make_unique<char const*>("b")});
+
+    world.add<Health>(first, 1);
+    world.destroy(second);
+
+    EXPECT_STREQ(*world.get<Name>(first)->text, "a");
+
+    world.remove<Health>(first);
+
+    EXPECT_STREQ(*world.get<Name>(first)->text, "a");
+}
+
+TEST(world_test, throwing_add_keeps_the_entity) {
+    World world;
+
+    Entity const entity = world.create(Health{5});
+
+    EXPECT_THROW(world.add<Throwing>(entity, true), std::runtime_error);
+    EXPECT_TRUE(world.isAlive(entity));
+    EXPECT_FALSE(world.has<Throwing>(entity));
+    ASSERT_TRUE(world.has<Health>(entity));
+    EXPECT_EQ(world.get<Health>(entity)->value, 5);
+
+    world.add<Throwing>(entity, false);
+
+    EXPECT_TRUE(world.has<Throwing>(entity));
+    EXPECT_EQ(world.get<Health>(entity)->value, 5);
+}
+
+}  // namespace
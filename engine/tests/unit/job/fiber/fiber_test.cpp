@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "zeus/job/fiber.hpp"
+
+/**
+ * Tests for fiber.hpp
+ */
+namespace {
+
+using Zeus::Job::Fiber;
+
+constexpr std::size_t stack_size = 64 * 1024;
+
+struct PingPong {
+    Fiber main;
+    Fiber* worker = nullptr;
+    std::vector<int> steps;
+};
+
+[[noreturn]] void pingPong(void* argument) noexcept {
+    auto& state = *static_cast<PingPong*>(argument);
+
+    for (int step = 0;; ++step) {
+        state.steps.push_back(step);
+        state.worker->switchTo(state.main);
+    }
+}
+
+TEST(fiber_test, switches_back_and_forth) {
+    std::vector<std::byte> stack(stack_size);
+    PingPong state;
+    Fiber worker{stack.data(), stack.size(), &pingPong, &state};
+    state.worker = &worker;
+
+    for (int i = 0; i < 3; ++i) {
+        state.main.switchTo(worker);
+    }
+
+    EXPECT_EQ(state.steps, (std::vector<int>{0, 1, 2}));
+}
+
+struct Chain {
+    Fiber main;
+    std::vector<Fiber*> fibers;
+    std::vector<std::size_t> order;
+    double sum = 0.0;
+};
+
+[[noreturn]] void chainLink(void* argument) noexcept {
+    auto& chain = *static_cast<Chain*>(argument);
+    std::size_t const index = chain.order.size();
+
+    // Floating point state must survive the switches
+    double const value = std::sqrt(static_cast<double>(index + 1));
+    chain.order.push_back(index);
+
+    Fiber& next = index + 1 < chain.fibers.size() ? *chain.fibers[index + 1]
+                                                   : chain.main;
+    chain.fibers[index]->switchTo(next);
+
+    chain.sum += value;
+    chain.fibers[index]->switchTo(chain.main);
+
+    for (;;) {
+        chain.fibers[index]->switchTo(chain.main);
+    }
+}
+
+TEST(fiber_test, preserves_state_across_fibers) {
+    constexpr std::size_t fiber_count = 4;
+
+    std::vector<std::vector<std::byte>> stacks(
+        fiber_count, std::vector<std::byte>(stack_size));
+    std::vector<std::unique_ptr<Fiber>> fibers;
+    Chain chain;
+
+    for (auto& stack : stacks) {
+        fibers.push_back(std::make_unique<Fiber>(stack.data(), stack.size(),
+                                                 &chainLink, &chain));
+        chain.fibers.push_back(fibers.back().get());
+    }
+
+    chain.main.switchTo(*chain.fibers.front());
+
+    EXPECT_EQ(chain.order, (std::vector<std::size_t>{0, 1, 2, 3}));
+
+    // Resume every fiber once more, each adds its saved value
+    for (auto* fiber : chain.fibers) {
+        chain.main.switchTo(*fiber);
+    }
+
+    EXPECT_DOUBLE_EQ(chain.sum,
+                     1.0 + std::sqrt(2.0) + std::sqrt(3.0) + 2.0);
+}
+
+}  // namespace
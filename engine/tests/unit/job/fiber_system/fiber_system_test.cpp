@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "zeus/job/fiber_system.hpp"
+
+/**
+ * Tests for fiber_system.hpp
+ */
+namespace {
+
+using Zeus::Job::Affinity;
+using Zeus::Job::Counter;
+using Zeus::Job::FiberSystem;
+
+TEST(fiber_system_test, runs_every_job) {
+    FiberSystem system{4, Affinity::Unpinned};
+    Counter counter;
+    std::atomic<int> sum{0};
+
+    EXPECT_EQ(system.threadCount(), 4U);
+    EXPECT_EQ(system.workerIndex(), 0U);
+
+    for (int i = 1; i <= 1000; ++i) {
+        system.run(counter, [&sum, i] { sum.fetch_add(i); });
+    }
+
+    system.wait(counter);
+
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+TEST(fiber_system_test, main_thread_resumes_on_its_own_thread) {
+    FiberSystem system{3, Affinity::Unpinned};
+    Counter counter;
+    auto const thread = std::this_thread::get_id();
+
+    for (int i = 0; i < 64; ++i) {
+        system.run(counter, [] { std::this_thread::yield(); });
+    }
+
+    system.wait(counter);
+
+    EXPECT_EQ(std::this_thread::get_id(), thread);
+    EXPECT_EQ(system.workerIndex(), 0U);
+}
+
+TEST(fiber_system_test, waiting_jobs_free_their_worker) {
+    // A single worker can only finish the children if the parent suspends
+    FiberSystem system{1};
+    Counter outer;
+    std::vector<int> order;
+
+    system.run(outer, [&] {
+        Counter inner;
+
+        system.run(inner, [&order] { order.push_back(1); });
+        order.push_back(0);
+        system.wait(inner);
+        order.push_back(2);
+    });
+
+    system.wait(outer);
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(fiber_system_test, nested_waits) {
+    FiberSystem system{4, Affinity::Unpinned};
+    Counter outer;
+    std::atomic<int> leaves{0};
+
+    for (int i = 0; i < 32; ++i) {
+        system.run(outer, [&] {
+            Counter middle;
+
+            for (int j = 0; j < 8; ++j) {
+                system.run(middle, [&] {
+                    Counter inner;
+
+                    for (int k = 0; k < 8; ++k) {
+                        system.run(inner, [&leaves] { leaves.fetch_add(1); });
+                    }
+
+                    system.wait(inner);
+                });
+            }
+
+            system.wait(middle);
+        });
+    }
+
+    system.wait(outer);
+
+    EXPECT_EQ(leaves.load(), 32 * 8 * 8);
+}
+
+TEST(fiber_system_test, more_waits_than_fibers) {
+    // Waits beyond the pool size fall back to running jobs in place
+    FiberSystem system{2, Affinity::Unpinned, 2};
+    Counter outer;
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 64; ++i) {
+        system.run(outer, [&] {
+            Counter inner;
+
+            system.run(inner, [&count] { count.fetch_add(1); });
+            system.wait(inner);
+        });
+    }
+
+    system.wait(outer);
+
+    EXPECT_EQ(count.load(), 64);
+    EXPECT_EQ(system.fiberCount(), 2U);
+}
+
+TEST(fiber_system_test, parallel_for) {
+    FiberSystem system{4, Affinity::Unpinned};
+    std::vector<int> values(10000, 1);
+
+    Zeus::Job::parallelFor(system, values, 16, [](int* first, int* last) {
+        for (; first != last; ++first) {
+            *first *= 3;
+        }
+    });
+
+    for (int const value : values) {
+        ASSERT_EQ(value, 3);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Tests for job_system.hpp
+ */
+namespace {
+
+using Zeus::Job::Affinity;
+using Zeus::Job::Counter;
+using Zeus::Job::System;
+
+TEST(job_system_test, runs_every_job) {
+    System system{4, Affinity::Unpinned};
+    Counter counter;
+    std::atomic<int> sum{0};
+
+    EXPECT_EQ(system.threadCount(), 4U);
+    EXPECT_EQ(system.workerIndex(), 0U);
+
+    for (int i = 1; i <= 1000; ++i) {
+        system.run(counter, [&sum, i] { sum.fetch_add(i); });
+    }
+
+    system.wait(counter);
+
+    EXPECT_TRUE(counter.done());
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+TEST(job_system_test, single_thread_runs_jobs_while_waiting) {
+    System system{1};
+    Counter counter;
+    int value = 0;
+
+    system.run(counter, [&value] { value = 42; });
+
+    EXPECT_EQ(counter.value(), 1U);
+
+    system.wait(counter);
+
+    EXPECT_EQ(value, 42);
+}
+
+TEST(job_system_test, jobs_spread_over_workers) {
+    System system{4, Affinity::Unpinned};
+    Counter counter;
+    std::atomic<int> started{0};
+    std::vector<std::size_t> workers(4, System::invalid_worker);
+
+    // Every job blocks until all of them run, so each needs its own worker
+    for (std::size_t i = 0; i < 4; ++i) {
+        system.run(counter, [&, i] {
+            workers[i] = system.workerIndex();
+            started.fetch_add(1);
+
+            while (started.load() < 4) {
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    system.wait(counter);
+
+    EXPECT_EQ(std::set<std::size_t>(workers.begin(), workers.end()).size(),
+              4U);
+}
+
+TEST(job_system_test, nested_jobs) {
+    System system{3, Affinity::Unpinned};
+    Counter outer;
+    std::atomic<int> leaves{0};
+
+    for (int i = 0; i < 16; ++i) {
+        system.run(outer, [&] {
+            Counter inner;
+
+            for (int j = 0; j < 16; ++j) {
+                system.run(inner, [&leaves] { leaves.fetch_add(1); });
+            }
+
+            system.wait(inner);
+        });
+    }
+
+    system.wait(outer);
+
+    EXPECT_EQ(leaves.load(), 256);
+}
+
+TEST(job_system_test, more_jobs_than_slots) {
+    System system{2, Affinity::Unpinned, 8};
+    Counter counter;
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 10000; ++i) {
+        system.run(counter, [&count] { count.fetch_add(1); });
+    }
+
+    system.wait(counter);
+
+    EXPECT_EQ(count.load(), 10000);
+}
+
+TEST(job_system_test, not_a_worker) {
+    System system{2, Affinity::Unpinned};
+    std::size_t index = 0;
+
+    std::thread{[&] { index = system.workerIndex(); }}.join();
+
+    EXPECT_EQ(index, System::invalid_worker);
+}
+
+TEST(job_system_test, parallel_for_covers_range_once) {
+    System system{4, Affinity::Unpinned};
+    std::vector<int> hits(100003, 0);
+
+    Zeus::Job::parallelFor(system, 3, hits.size(), 64,
+                           [&hits](std::size_t first, std::size_t last) {
+                               EXPECT_LE(last - first, 64U);
+
+                               for (std::size_t i = first; i < last; ++i) {
+                                   ++hits[i];
+                               }
+                           });
+
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.begin() + 3, 0), 0);
+    EXPECT_EQ(std::accumulate(hits.begin() + 3, hits.end(), 0), 100000);
+}
+
+TEST(job_system_test, parallel_for_over_vectors) {
+    System system{4, Affinity::Unpinned};
+    std::vector<Zeus::Math::Vector3D> positions(10000, {1.0F, 2.0F, 3.0F});
+    Zeus::Math::Vector3D const velocity{1.0F, 1.0F, 1.0F};
+
+    Zeus::Job::parallelFor(
+        system, positions, 0,
+        [&velocity](Zeus::Math::Vector3D* first, Zeus::Math::Vector3D* last) {
+            for (; first != last; ++first) {
+                *first += velocity;
+            }
+        });
+
+    for (auto const& position : positions) {
+        ASSERT_EQ(position, (Zeus::Math::Vector3D{2.0F, 3.0F, 4.0F}));
+    }
+}
+
+TEST(job_system_test, parallel_for_empty_range) {
+    System system{2, Affinity::Unpinned};
+    bool called = false;
+
+    Zeus::Job::parallelFor(system, 5, 5, 1,
+                           [&called](std::size_t, std::size_t) {
+                               called = true;
+                           });
+
+    EXPECT_FALSE(called);
+}
+
+}  // namespace
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "zeus/job/work_stealing_deque.hpp"
+
+/**
+ * Tests for work_stealing_deque.hpp
+ */
+namespace {
+
+TEST(work_stealing_deque_test, owner_is_lifo) {
+    Zeus::Job::WorkStealingDeque<int> deque;
+
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.pop().has_value());
+
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+
+    EXPECT_EQ(deque.size(), 3U);
+    EXPECT_EQ(deque.pop(), 3);
+    EXPECT_EQ(deque.pop(), 2);
+    EXPECT_EQ(deque.pop(), 1);
+    EXPECT_FALSE(deque.pop().has_value());
+}
+
+TEST(work_stealing_deque_test, thieves_are_fifo) {
+    Zeus::Job::WorkStealingDeque<int> deque;
+
+    deque.push(1);
+    deque.push(2);
+
+    EXPECT_EQ(deque.steal(), 1);
+    EXPECT_EQ(deque.pop(), 2);
+    EXPECT_FALSE(deque.steal().has_value());
+}
+
+TEST(work_stealing_deque_test, grows) {
+    Zeus::Job::WorkStealingDeque<int> deque{4};
+
+    EXPECT_EQ(deque.capacity(), 4U);
+
+    for (int i = 0; i < 100; ++i) {
+        deque.push(i);
+    }
+
+    EXPECT_GE(deque.capacity(), 100U);
+    EXPECT_EQ(deque.steal(), 0);
+
+    for (int i = 99; i > 0; --i) {
+        EXPECT_EQ(deque.pop(), i);
+    }
+}
+
+TEST(work_stealing_deque_test, every_item_is_taken_once) {
+    constexpr int item_count = 200000;
+    constexpr int thief_count = 3;
+
+    Zeus::Job::WorkStealingDeque<int> deque{16};
+    std::vector<std::atomic<int>> taken(item_count);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+
+    for (int thief = 0; thief < thief_count; ++thief) {
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (auto item = deque.steal()) {
+                    taken[static_cast<std::size_t>(*item)].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < item_count; ++i) {
+        deque.push(i);
+
+        // Pop some items back so the owner races the thieves for the last one
+        if (i % 3 == 0) {
+            if (auto item = deque.pop()) {
+                taken[static_cast<std::size_t>(*item)].fetch_add(1);
+            }
+        }
+    }
+
+    while (auto item = deque.pop()) {
+        taken[static_cast<std::size_t>(*item)].fetch_add(1);
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (auto const& count : taken) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "zeus/math/matrix_3x4.hpp"
+#include "zeus/math/vector_3d.hpp"
+
+/**
+ * Tests for matrix_3x4.hpp
+ */
+namespace {
+
+using Zeus::Math::Matrix3x4;
+using Zeus::Math::Vector3D;
+
+constexpr float half_pi = 1.5707963267948966F;
+
+void expectNear(Vector3D const& actual, Vector3D const& expected) {
+    EXPECT_NEAR(actual.x, expected.x, 1e-5F);
+    EXPECT_NEAR(actual.y, expected.y, 1e-5F);
+    EXPECT_NEAR(actual.z, expected.z, 1e-5F);
+}
+
+TEST(matrix_test, identity) {
+    Vector3D const point{1.0F, -2.0F, 3.0F};
+
+    expectNear(transformPoint(Matrix3x4::identity(), point), point);
+}
+
+TEST(matrix_test, alignment) {
+    static_assert(alignof(Matrix3x4) == 16);
+    static_assert(sizeof(Matrix3x4) == 48);
+}
+
+TEST(matrix_test, translation_rotation_and_scale) {
+    Matrix3x4 const matrix = Zeus::Math::fromTransform(
+        Vector3D{10.0F, 20.0F, 30.0F}, Vector3D{0.0F, 0.0F, half_pi},
+        Vector3D{2.0F, 2.0F, 2.0F});
+
+    // Scaled to (2, 0, 0), rotated to (0, 2, 0) and then translated
+    expectNear(transformPoint(matrix, Vector3D{1.0F, 0.0F, 0.0F}),
+               Vector3D{10.0F, 22.0F, 30.0F});
+    expectNear(matrix.translation(), Vector3D{10.0F, 20.0F, 30.0F});
+}
+
+TEST(matrix_test, euler_order) {
+    // x first turns y into z, then y turns z into x
+    Matrix3x4 const matrix = Zeus::Math::fromTransform(
+        Vector3D{0.0F, 0.0F, 0.0F}, Vector3D{half_pi, half_pi, 0.0F},
+        Vector3D{1.0F, 1.0F, 1.0F});
+
+    expectNear(transformPoint(matrix, Vector3D{0.0F, 1.0F, 0.0F}),
+               Vector3D{1.0F, 0.0F, 0.0F});
+}
+
+TEST(matrix_test, composition_applies_right_first) {
+    Matrix3x4 const rotate = Zeus::Math::fromTransform(
+        Vector3D{0.0F, 0.0F, 0.0F}, Vector3D{0.0F, 0.0F, half_pi},
+        Vector3D{1.0F, 1.0F, 1.0F});
+    Matrix3x4 const translate = Zeus::Math::fromTransform(
+        Vector3D{1.0F, 0.0F, 0.0F}, Vector3D{0.0F, 0.0F, 0.0F},
+        Vector3D{1.0F, 1.0F, 1.0F});
+    Vector3D const point{1.0F, 2.0F, 3.0F};
+
+    expectNear(transformPoint(rotate * translate, point),
+               transformPoint(rotate, transformPoint(translate, point)));
+    expectNear(transformPoint(rotate * translate, point),
+               Vector3D{-2.0F, 2.0F, 3.0F});
+}
+
+}  // namespace
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "zeus/math/vector_2d.hpp"
+#include "zeus/math/vector_3d.hpp"
 
 /**
  * Super simple test for 2D vectors.
@@ -20,4 +21,33 @@ TEST(vector2d_test, copy_initialization) {
     EXPECT_EQ(vec[1], 2);
 }
 
+TEST(vector2d_test, format) {
+    Zeus::Math::Vector2D vec{1.5F, -2.0F};
+
+    EXPECT_EQ(ZEUS_FORMAT(32, "{}", vec), "(1.5, -2)");
+}
+
+TEST(vector2d_test, normalize) {
+    Zeus::Math::Vector2D const vec =
+        Zeus::Math::normalize(Zeus::Math::Vector2D{3.0F, 4.0F});
+
+    EXPECT_FLOAT_EQ(vec.x, 0.6F);
+    EXPECT_FLOAT_EQ(vec.y, 0.8F);
+}
+
+TEST(vector3d_test, normalize) {
+    Zeus::Math::Vector3D const vec =
+        Zeus::Math::normalize(Zeus::Math::Vector3D{0.0F, 3.0F, 4.0F});
+
+    EXPECT_FLOAT_EQ(vec.x, 0.0F);
+    EXPECT_FLOAT_EQ(vec.y, 0.6F);
+    EXPECT_FLOAT_EQ(vec.z, 0.8F);
+}
+
+TEST(vector3d_test, format) {
+    Zeus::Math::Vector3D vec{1.0F, 0.25F, 3.0F};
+
+    EXPECT_EQ(ZEUS_FORMAT(32, "v = {}", vec), "v = (1, 0.25, 3)");
+}
+
 }  // namespace
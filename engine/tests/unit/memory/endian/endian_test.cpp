@@ -170,4 +170,11 @@ TEST(endian_test, ostream) {
     ASSERT_EQ(big.str(), "Big");
 }
 
+TEST(endian_test, format) {
+    using Zeus::Memory::Endian::Type;
+
+    EXPECT_EQ(ZEUS_FORMAT(32, "{} {}", Type::Little, Type::Big), "Little Big");
+    EXPECT_EQ(Zeus::to_string(Type::Big), "Big");
+}
+
 }  // namespace
@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "zeus/memory/pool_allocator.hpp"
+
+/**
+ * Tests for pool_allocator.hpp
+ */
+namespace {
+
+struct Particle {
+    float position[3];
+    float velocity[3];
+    int lifetime;
+};
+
+struct alignas(128) OverAligned {
+    int value;
+};
+
+TEST(pool_allocator_test, create_destroy) {
+    Zeus::Memory::PoolAllocator<Particle> pool;
+
+    Particle* particle = pool.create(Particle{{1, 2, 3}, {4, 5, 6}, 7});
+
+    ASSERT_NE(particle, nullptr);
+    EXPECT_EQ(particle->position[1], 2);
+    EXPECT_EQ(particle->lifetime, 7);
+
+    pool.destroy(particle);
+}
+
+TEST(pool_allocator_test, reuses_freed_storage) {
+    Zeus::Memory::PoolAllocator<Particle> pool;
+
+    Particle* first = pool.allocate();
+    pool.deallocate(first);
+
+    EXPECT_EQ(pool.allocate(), first);
+}
+
+TEST(pool_allocator_test, distinct_and_aligned) {
+    Zeus::Memory::PoolAllocator<OverAligned> pool{16};
+
+    std::set<OverAligned*> pointers;
+
+    for (int i = 0; i < 100; ++i) {
+        OverAligned* ptr = pool.allocate();
+
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignof(OverAligned),
+                  0U);
+        EXPECT_TRUE(pointers.insert(ptr).second);
+    }
+
+    for (OverAligned* ptr : pointers) {
+        pool.deallocate(ptr);
+    }
+}
+
+TEST(pool_allocator_test, growth_does_not_relocate) {
+    Zeus::Memory::PoolAllocator<int> pool{8};
+
+    int* first = pool.create(42);
+
+    std::vector<int*> values;
+
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(pool.create(i));
+    }
+
+    EXPECT_GE(pool.capacity(), 1001U);
+    EXPECT_EQ(*first, 42);
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(*values[i], i);
+    }
+}
+
+TEST(pool_allocator_test, cross_thread_frees) {
+    constexpr int thread_count = 4;
+    constexpr int object_count = 10000;
+
+    Zeus::Memory::PoolAllocator<Particle> pool{64};
+
+    std::vector<std::vector<Particle*>> allocated(thread_count);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &allocated, t] {
+            for (int i = 0; i < object_count; ++i) {
+                allocated[t].push_back(pool.create(Particle{{}, {}, t}));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    threads.clear();
+
+    std::set<Particle*> unique;
+
+    for (auto const& objects : allocated) {
+        unique.insert(objects.begin(), objects.end());
+    }
+
+    ASSERT_EQ(unique.size(), std::size_t{thread_count * object_count});
+
+    // Free every object from a thread that did not allocate it
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &allocated, t] {
+            for (Particle* particle :
+                 allocated[(t + 1) % thread_count]) {
+                EXPECT_EQ(particle->lifetime, (t + 1) % thread_count);
+
+                pool.destroy(particle);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::size_t const capacity = pool.capacity();
+
+    // Everything was returned so no further growth is needed
+    for (int i = 0; i < object_count; ++i) {
+        static_cast<void>(pool.allocate());
+    }
+
+    EXPECT_EQ(pool.capacity(), capacity);
+}
+
+}  // namespace
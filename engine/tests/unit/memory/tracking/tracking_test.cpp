@@ -0,0 +1,169 @@
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "zeus/memory/pool_allocator.hpp"
+#include "zeus/memory/tracking.hpp"
+
+/**
+ * Tests for tracking.hpp
+ */
+namespace {
+
+using Zeus::Memory::MemoryTag;
+
+TEST(tracking_test, tag_names) {
+    static_assert(Zeus::Memory::tagName(MemoryTag::Rendering) == "Rendering");
+    static_assert(Zeus::Memory::tagName(MemoryTag::Count) == "Invalid");
+}
+
+TEST(tracking_test, tag_scope) {
+    EXPECT_EQ(Zeus::Memory::currentTag(), MemoryTag::Unknown);
+
+    {
+        ZEUS_MEMORY_TAG_SCOPE(MemoryTag::Audio);
+        EXPECT_EQ(Zeus::Memory::currentTag(), MemoryTag::Audio);
+
+        {
+            ZEUS_MEMORY_TAG_SCOPE(MemoryTag::Physics);
+            EXPECT_EQ(Zeus::Memory::currentTag(), MemoryTag::Physics);
+        }
+
+        EXPECT_EQ(Zeus::Memory::currentTag(), MemoryTag::Audio);
+    }
+
+    EXPECT_EQ(Zeus::Memory::currentTag(), MemoryTag::Unknown);
+}
+
+TEST(tracking_test, live_bytes_and_counts) {
+    auto const before = Zeus::Memory::snapshot()[MemoryTag::Audio];
+
+    ZEUS_TRACK_ALLOCATION(MemoryTag::Audio, 100);
+    ZEUS_TRACK_ALLOCATION(MemoryTag::Audio, 50);
+    ZEUS_TRACK_DEALLOCATION(MemoryTag::Audio, 100);
+
+    auto const after = Zeus::Memory::snapshot()[MemoryTag::Audio];
+
+    EXPECT_EQ(after.live_bytes - before.live_bytes, 50);
+    EXPECT_EQ(after.allocation_count - before.allocation_count, 2U);
+    EXPECT_EQ(after.deallocation_count - before.deallocation_count, 1U);
+}
+
+TEST(tracking_test, peak_bytes) {
+    constexpr std::size_t big = std::size_t{1} << 20;
+
+    ZEUS_TRACK_ALLOCATION(MemoryTag::Scene, big);
+    ZEUS_TRACK_DEALLOCATION(MemoryTag::Scene, big);
+
+    auto const stats = Zeus::Memory::snapshot()[MemoryTag::Scene];
+
+    EXPECT_EQ(stats.live_bytes, 0);
+    EXPECT_GE(stats.peak_bytes, static_cast<Zeus::i64>(big));
+}
+
+TEST(tracking_test, cross_thread_deallocation) {
+    constexpr int thread_count = 4;
+    constexpr int allocation_count = 10000;
+
+    auto const before = Zeus::Memory::snapshot()[MemoryTag::Jobs];
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < allocation_count; ++i) {
+                ZEUS_TRACK_ALLOCATION(MemoryTag::Jobs, 64);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const during = Zeus::Memory::snapshot()[MemoryTag::Jobs];
+
+    EXPECT_EQ(during.live_bytes - before.live_bytes,
+              Zeus::i64{64} * thread_count * allocation_count);
+
+    for (int i = 0; i < thread_count * allocation_count; ++i) {
+        ZEUS_TRACK_DEALLOCATION(MemoryTag::Jobs, 64);
+    }
+
+    auto const after = Zeus::Memory::snapshot()[MemoryTag::Jobs];
+
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+    EXPECT_EQ(after.allocation_count - before.allocation_count,
+              std::size_t{thread_count * allocation_count});
+}
+
+TEST(tracking_test, budget) {
+    constexpr std::size_t big = std::size_t{1} << 20;
+
+    auto const before = Zeus::Memory::snapshot()[MemoryTag::Rendering];
+
+    Zeus::Memory::setBudget(MemoryTag::Rendering, 1024);
+
+    ZEUS_TRACK_ALLOCATION(MemoryTag::Rendering, big);
+
+    auto const over = Zeus::Memory::snapshot()[MemoryTag::Rendering];
+
+    EXPECT_TRUE(over.over_budget);
+    EXPECT_EQ(over.budget_alarm_count - before.budget_alarm_count, 1U);
+
+    ZEUS_TRACK_DEALLOCATION(MemoryTag::Rendering, big);
+
+    auto const under = Zeus::Memory::snapshot()[MemoryTag::Rendering];
+
+    EXPECT_FALSE(under.over_budget);
+    EXPECT_EQ(under.live_bytes, 0);
+
+    Zeus::Memory::setBudget(MemoryTag::Rendering, 0);
+}
+
+TEST(tracking_test, current_tag_overloads) {
+    auto const before = Zeus::Memory::snapshot()[MemoryTag::Physics];
+
+    {
+        ZEUS_MEMORY_TAG_SCOPE(MemoryTag::Physics);
+        Zeus::Memory::recordAllocation(std::size_t{256});
+        Zeus::Memory::recordDeallocation(std::size_t{128});
+    }
+
+    auto const after = Zeus::Memory::snapshot()[MemoryTag::Physics];
+
+    EXPECT_EQ(after.live_bytes - before.live_bytes, 128);
+    EXPECT_EQ(after.allocation_count - before.allocation_count, 1U);
+    EXPECT_EQ(after.deallocation_count - before.deallocation_count, 1U);
+}
+
+TEST(tracking_test, allocator_keeps_its_tag) {
+    auto const before = Zeus::Memory::snapshot()[MemoryTag::Containers];
+
+    {
+        std::optional<Zeus::Memory::PoolAllocator<Zeus::u64>> pool;
+
+        {
+            ZEUS_MEMORY_TAG_SCOPE(MemoryTag::Containers);
+            pool.emplace(64);
+        }
+
+        // Allocated outside the scope but still charged to the pool's tag
+        Zeus::u64* value = pool->allocate();
+
+        auto const during = Zeus::Memory::snapshot()[MemoryTag::Containers];
+
+        EXPECT_GT(during.live_bytes, before.live_bytes);
+        EXPECT_EQ(during.allocation_count - before.allocation_count, 1U);
+
+        pool->deallocate(value);
+    }
+
+    auto const after = Zeus::Memory::snapshot()[MemoryTag::Containers];
+
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+}
+
+}  // namespace
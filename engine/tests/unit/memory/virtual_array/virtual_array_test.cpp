@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "zeus/memory/virtual_array.hpp"
+
+/**
+ * Tests for virtual_array.hpp
+ */
+namespace {
+
+TEST(virtual_array_test, push_back) {
+    Zeus::Memory::VirtualArray<int> array{1000};
+
+    EXPECT_TRUE(array.empty());
+    EXPECT_EQ(array.committedBytes(), 0U);
+
+    for (int i = 0; i < 1000; ++i) {
+        array.push_back(i);
+    }
+
+    ASSERT_EQ(array.size(), 1000U);
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(array[i], i);
+    }
+}
+
+TEST(virtual_array_test, elements_never_move) {
+    Zeus::Memory::VirtualArray<double> array{std::size_t{1} << 24};
+
+    double* first = &array.emplace_back(1.0);
+
+    for (int i = 0; i < 1000000; ++i) {
+        array.emplace_back(i);
+    }
+
+    EXPECT_EQ(&array[0], first);
+    EXPECT_EQ(*first, 1.0);
+}
+
+TEST(virtual_array_test, reservation_exhausted) {
+    Zeus::Memory::VirtualArray<int> array{4};
+
+    for (int i = 0; i < 4; ++i) {
+        array.push_back(i);
+    }
+
+    // The committed pages have room but the maximum size is reached
+    EXPECT_GT(array.capacity(), 4U);
+    EXPECT_THROW(array.push_back(4), std::length_error);
+}
+
+TEST(virtual_array_test, decommit_on_shrink) {
+    Zeus::Memory::VirtualArray<char> array{std::size_t{64} << 20};
+
+    array.resize(std::size_t{16} << 20);
+
+    std::size_t const committed = array.committedBytes();
+
+    EXPECT_GE(committed, std::size_t{16} << 20);
+
+    array.resize(1024);
+
+    EXPECT_LT(array.committedBytes(), committed);
+    EXPECT_GE(array.capacity(), 1024U);
+
+    array.clear();
+
+    EXPECT_EQ(array.committedBytes(), 0U);
+
+    // Decommitted pages can be committed again
+    array.resize(4096);
+    array[4095] = 'a';
+}
+
+TEST(virtual_array_test, destructs_elements) {
+    auto counter = std::make_shared<int>(0);
+
+    {
+        Zeus::Memory::VirtualArray<std::shared_ptr<int>> array{16};
+
+        array.push_back(counter);
+        array.push_back(counter);
+
+        EXPECT_EQ(counter.use_count(), 3);
+
+        array.pop_back();
+
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(virtual_array_test, move) {
+    Zeus::Memory::VirtualArray<int> array{16};
+
+    array.push_back(7);
+
+    int* element = &array[0];
+
+    Zeus::Memory::VirtualArray<int> moved{std::move(array)};
+
+    EXPECT_EQ(&moved[0], element);
+    EXPECT_EQ(moved.size(), 1U);
+}
+
+TEST(virtual_array_test, zero_max_size) {
+    Zeus::Memory::VirtualArray<int> array{0};
+
+    EXPECT_TRUE(array.empty());
+    EXPECT_EQ(array.max_size(), 0U);
+    EXPECT_EQ(array.committedBytes(), 0U);
+    EXPECT_EQ(array.begin(), array.end());
+    EXPECT_THROW(array.push_back(1), std::length_error);
+
+    array.clear();
+    array.shrink_to_fit();
+
+    Zeus::Memory::VirtualArray<int> moved{std::move(array)};
+
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(virtual_array_test, max_size_overflow) {
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+    EXPECT_DEATH(Zeus::Memory::VirtualArray<double>{SIZE_MAX / 4},
+                 "too large");
+}
+
+}  // namespace
@@ -0,0 +1,306 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "zeus/job/job_system.hpp"
+#include "zeus/math/matrix_3x4.hpp"
+#include "zeus/math/vector_3d.hpp"
+#include "zeus/scene/hierarchy.hpp"
+
+/**
+ * Tests for hierarchy.hpp
+ */
+namespace {
+
+using Zeus::Math::Matrix3x4;
+using Zeus::Math::Vector3D;
+using Zeus::Scene::Hierarchy;
+using Zeus::Scene::Node;
+
+constexpr float half_pi = 1.5707963267948966F;
+
+/**
+ * Computes a world matrix by walking up to the root.
+ */
+Matrix3x4 expectedWorld(Hierarchy const& hierarchy, Node node) {
+    Matrix3x4 world = Zeus::Math::fromTransform(hierarchy.position(node),
+                                                hierarchy.rotation(node),
+                                                hierarchy.scale(node));
+
+    for (Node parent = hierarchy.parent(node); parent;
+         parent = hierarchy.parent(parent)) {
+        world = Zeus::Math::fromTransform(hierarchy.position(parent),
+                                          hierarchy.rotation(parent),
+                                          hierarchy.scale(parent)) *
+                world;
+    }
+
+    return world;
+}
+
+void expectWorldsUpToDate(Hierarchy const& hierarchy) {
+    for (std::size_t index = 0; index < hierarchy.size(); ++index) {
+        Node const node = hierarchy.at(index);
+        Matrix3x4 const& actual = hierarchy.world(node);
+        Matrix3x4 const expected = expectedWorld(hierarchy, node);
+
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                ASSERT_NEAR(actual.m[row][column], expected.m[row][column],
+                            1e-3F);
+            }
+        }
+    }
+}
+
+/**
+ * Builds a random tree, every node picks an earlier one as its parent.
+ */
+std::vector<Node> buildTree(Hierarchy& hierarchy, std::size_t count,
+                            unsigned seed) {
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<float> value{-1.0F, 1.0F};
+    std::vector<Node> nodes;
+
+    for (std::size_t index = 0; index < count; ++index) {
+        Node parent;
+
+        if (index >= 4) {
+            parent = nodes[std::uniform_int_distribution<std::size_t>{
+                0, index - 1}(random)];
+        }
+
+        Node const node = hierarchy.create(parent);
+        hierarchy.setPosition(
+            node, Vector3D{value(random), value(random), value(random)});
+        hierarchy.setRotation(
+            node, Vector3D{value(random), value(random), value(random)});
+        nodes.push_back(node);
+    }
+
+    return nodes;
+}
+
+TEST(hierarchy_test, create_and_destroy) {
+    Hierarchy hierarchy;
+
+    Node const root = hierarchy.create();
+    Node const child = hierarchy.create(root);
+
+    EXPECT_TRUE(hierarchy.isAlive(root));
+    EXPECT_TRUE(hierarchy.isAlive(child));
+    EXPECT_FALSE(hierarchy.isAlive(Node{}));
+    EXPECT_EQ(hierarchy.parent(child), root);
+    EXPECT_EQ(hierarchy.parent(root), Node{});
+    EXPECT_EQ(hierarchy.size(), 2U);
+
+    hierarchy.destroy(root);
+
+    EXPECT_FALSE(hierarchy.isAlive(root));
+    EXPECT_FALSE(hierarchy.isAlive(child));
+    EXPECT_EQ(hierarchy.size(), 0U);
+
+    // The freed handle indices are reused with a new generation
+    Node const reused = hierarchy.create();
+
+    EXPECT_TRUE(hierarchy.isAlive(reused));
+    EXPECT_FALSE(hierarchy.isAlive(root));
+    EXPECT_FALSE(hierarchy.isAlive(child));
+}
+
+TEST(hierarchy_test, world_matrices) {
+    Hierarchy hierarchy;
+
+    Node const root = hierarchy.create();
+    Node const child = hierarchy.create(root);
+
+    hierarchy.setPosition(root, Vector3D{1.0F, 0.0F, 0.0F});
+    hierarchy.setRotation(root, Vector3D{0.0F, 0.0F, half_pi});
+    hierarchy.setPosition(child, Vector3D{0.0F, 2.0F, 0.0F});
+    hierarchy.setScale(child, Vector3D{3.0F, 3.0F, 3.0F});
+    hierarchy.update();
+
+    Vector3D const position = hierarchy.world(child).translation();
+
+    EXPECT_NEAR(position.x, -1.0F, 1e-5F);
+    EXPECT_NEAR(position.y, 0.0F, 1e-5F);
+    EXPECT_NEAR(position.z, 0.0F, 1e-5F);
+
+    // The child's x axis is scaled by 3 and turned onto the y axis
+    Vector3D const axis = transformPoint(hierarchy.world(child),
+                                         Vector3D{1.0F, 0.0F, 0.0F});
+
+    EXPECT_NEAR(axis.x, -1.0F, 1e-5F);
+    EXPECT_NEAR(axis.y, 3.0F, 1e-5F);
+    EXPECT_NEAR(axis.z, 0.0F, 1e-5F);
+}
+
+TEST(hierarchy_test, breadth_first_order) {
+    Hierarchy hierarchy;
+    buildTree(hierarchy, 500, 1);
+    hierarchy.update();
+
+    std::vector<std::size_t> depths(hierarchy.size());
+    std::vector<std::size_t> positions(hierarchy.size());
+
+    for (std::size_t index = 0; index < hierarchy.size(); ++index) {
+        Node const parent = hierarchy.parent(hierarchy.at(index));
+        std::size_t depth = 0;
+
+        if (parent) {
+            std::size_t parent_index = 0;
+
+            while (hierarchy.at(parent_index) != parent) {
+                ++parent_index;
+            }
+
+            ASSERT_LT(parent_index, index);
+            depth = depths[parent_index] + 1;
+        }
+
+        depths[index] = depth;
+
+        if (index > 0) {
+            ASSERT_GE(depth, depths[index - 1]);
+        }
+    }
+
+    EXPECT_EQ(hierarchy.levelCount(), depths.back() + 1);
+    expectWorldsUpToDate(hierarchy);
+}
+
+TEST(hierarchy_test, only_dirty_subtrees_update) {
+    Hierarchy hierarchy;
+
+    Node const root = hierarchy.create();
+    Node const left = hierarchy.create(root);
+    Node const right = hierarchy.create(root);
+    Node const left_child = hierarchy.create(left);
+    hierarchy.create(left_child);
+    hierarchy.create(right);
+
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updatedCount(), 6U);
+
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updatedCount(), 0U);
+
+    hierarchy.setPosition(left, Vector3D{1.0F, 2.0F, 3.0F});
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updatedCount(), 3U);
+    expectWorldsUpToDate(hierarchy);
+
+    hierarchy.setScale(root, Vector3D{2.0F, 2.0F, 2.0F});
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updatedCount(), 6U);
+    expectWorldsUpToDate(hierarchy);
+}
+
+TEST(hierarchy_test, set_parent) {
+    Hierarchy hierarchy;
+
+    Node const first = hierarchy.create();
+    Node const second = hierarchy.create();
+    Node const child = hierarchy.create(first);
+    Node const grandchild = hierarchy.create(child);
+
+    hierarchy.setPosition(first, Vector3D{1.0F, 0.0F, 0.0F});
+    hierarchy.setPosition(second, Vector3D{0.0F, 5.0F, 0.0F});
+    hierarchy.update();
+
+    hierarchy.setParent(child, second);
+    hierarchy.update();
+
+    EXPECT_EQ(hierarchy.parent(child), second);
+    EXPECT_EQ(hierarchy.parent(grandchild), child);
+    EXPECT_NEAR(hierarchy.world(grandchild).translation().y, 5.0F, 1e-5F);
+    expectWorldsUpToDate(hierarchy);
+
+    hierarchy.setParent(child, Node{});
+    hierarchy.update();
+
+    EXPECT_EQ(hierarchy.parent(child), Node{});
+    EXPECT_EQ(hierarchy.levelCount(), 2U);
+    expectWorldsUpToDate(hierarchy);
+}
+
+TEST(hierarchy_test, destroy_subtree) {
+    Hierarchy hierarchy;
+    std::vector<Node> const nodes = buildTree(hierarchy, 300, 2);
+    hierarchy.update();
+
+    for (std::size_t index = 10; index < nodes.size(); index += 37) {
+        hierarchy.destroy(nodes[index]);
+    }
+
+    // A node survives if none of its ancestors was destroyed
+    for (Node const node : nodes) {
+        if (!hierarchy.isAlive(node)) {
+            continue;
+        }
+
+        for (Node parent = hierarchy.parent(node); parent;
+             parent = hierarchy.parent(parent)) {
+            ASSERT_TRUE(hierarchy.isAlive(parent));
+        }
+    }
+
+    hierarchy.setPosition(hierarchy.at(0), Vector3D{4.0F, 0.0F, 0.0F});
+    hierarchy.update();
+    expectWorldsUpToDate(hierarchy);
+
+    Node const added = hierarchy.create(hierarchy.at(hierarchy.size() - 1));
+    hierarchy.update();
+
+    EXPECT_TRUE(hierarchy.isAlive(added));
+    expectWorldsUpToDate(hierarchy);
+}
+
+TEST(hierarchy_test, parallel_update) {
+    Zeus::Job::System system{4, Zeus::Job::Affinity::Unpinned};
+
+    Hierarchy serial;
+    Hierarchy parallel;
+    std::vector<Node> const serial_nodes = buildTree(serial, 5000, 3);
+    std::vector<Node> const parallel_nodes = buildTree(parallel, 5000, 3);
+
+    serial.update();
+    parallel.update(system, 64);
+
+    std::mt19937 random{4};
+
+    for (int frame = 0; frame < 10; ++frame) {
+        for (int moved = 0; moved < 100; ++moved) {
+            std::size_t const index = std::uniform_int_distribution<
+                std::size_t>{0, serial_nodes.size() - 1}(random);
+            auto const angle = static_cast<float>(frame + moved);
+
+            serial.setRotation(serial_nodes[index],
+                               Vector3D{0.0F, angle, 0.0F});
+            parallel.setRotation(parallel_nodes[index],
+                                 Vector3D{0.0F, angle, 0.0F});
+        }
+
+        serial.update();
+        parallel.update(system, 64);
+
+        ASSERT_EQ(parallel.updatedCount(), serial.updatedCount());
+
+        for (std::size_t index = 0; index < serial_nodes.size(); ++index) {
+            Matrix3x4 const& expected = serial.world(serial_nodes[index]);
+            Matrix3x4 const& actual = parallel.world(parallel_nodes[index]);
+
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 4; ++column) {
+                    ASSERT_EQ(actual.m[row][column], expected.m[row][column]);
+                }
+            }
+        }
+    }
+
+    expectWorldsUpToDate(parallel);
+}
+
+}  // namespace
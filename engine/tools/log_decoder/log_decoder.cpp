@@ -0,0 +1,69 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "zeus/core/binary_log_decoder.hpp"
+
+/**
+ * Converts a binary log written with the ZEUS_BINARY_*_LOG macros into text.
+ *
+ * Usage: zeus_log_decoder <input> [output]
+ *
+ * The text is written to the standard output stream when no output file is
+ * given.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <input> [output]\n";
+
+        return 2;
+    }
+
+    std::ifstream input{argv[1], std::ios::binary};
+
+    if (!input) {
+        std::cerr << "Could not open " << argv[1] << '\n';
+
+        return 1;
+    }
+
+    std::ofstream file;
+
+    if (argc == 3) {
+        file.open(argv[2]);
+
+        if (!file) {
+            std::cerr << "Could not open " << argv[2] << '\n';
+
+            return 1;
+        }
+    }
+
+    std::ostream& output = (argc == 3) ? file : std::cout;
+
+    if (!Zeus::BinaryLog::decode(input, output)) {
+        std::cerr << "The log is malformed or was cut off, decoded as much "
+                     "as possible\n";
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * This file is part of the Zeus Game Engine.
+ * Copyright (C) 2021 Tristan F.
+ *
+ * The Zeus Game Engine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * The Zeus Game Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * the Zeus Game Engine. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "zeus/core/log_ring.hpp"
+
+/**
+ * Prints the messages that survived in a crash log written by
+ * Zeus::Log::openCrashLog(), oldest first.
+ *
+ * Usage: zeus_log_ring_reader <crash log>
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <crash log>\n";
+
+        return 2;
+    }
+
+    std::ifstream input{argv[1], std::ios::binary};
+
+    if (!input) {
+        std::cerr << "Could not open " << argv[1] << '\n';
+
+        return 1;
+    }
+
+    std::stringstream contents;
+    contents << input.rdbuf();
+
+    if (!Zeus::LogRing::decode(contents.str(), std::cout)) {
+        std::cerr << argv[1] << " is not a crash log\n";
+
+        return 1;
+    }
+
+    return 0;
+}